@@ -0,0 +1,124 @@
+#ifndef SCU_APPEND_LOG_H
+#define SCU_APPEND_LOG_H
+
+#include "scu/error.h"
+#include "scu/io.h"
+#include "scu/types.h"
+
+/**
+ * @brief Represents an append-only log, which makes records written to a file
+ * stream durable in batches (group commit).
+ *
+ * Multiple threads may append records concurrently. The records are copied into
+ * an in-memory buffer, from which a dedicated flusher thread writes them to the
+ * file with a single write and a single `fdatasync()` per batch. While a batch
+ * is being synchronized, new records accumulate in a second buffer and form the
+ * next batch, so the cost of each synchronization is shared by all records
+ * appended in the meantime.
+ *
+ * Every append returns a log sequence number (LSN), which is the number of
+ * bytes appended to the log so far, including the record itself. A record is
+ * durable once the durable LSN of the log has reached its LSN, which can be
+ * waited for with `scu_append_log_wait()`.
+ *
+ * @note All functions are thread-safe, except for `scu_append_log_free()`.
+ */
+typedef struct ScuAppendLog ScuAppendLog;
+
+/**
+ * @brief Allocates and initializes a new append-only log writing to a specified
+ * file stream and starts its flusher thread.
+ *
+ * Records are written at the current position of the underlying file, so the
+ * file stream should usually be opened in append mode. Pending output of the
+ * file stream is flushed first.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the log with
+ * `scu_append_log_free()` when it is no longer needed. The file stream must
+ * remain open and must not be used otherwise until then.
+ *
+ * @param[in, out] file     The file stream to write to.
+ * @param[in]      capacity The capacity of each of the two buffers (in bytes),
+ *                          which bounds the size of a batch and of a single
+ *                          record. It must be at least one.
+ * @return A pointer to the new log, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuAppendLog* scu_append_log_new(ScuFile* file, Scuisize capacity);
+
+/**
+ * @brief Appends a record to a specified append-only log.
+ *
+ * The record is copied, so `data` may be reused as soon as this function
+ * returns. If the buffer of the log is full, this function blocks until the
+ * flusher thread has taken it over.
+ *
+ * @note The record is not durable when this function returns. Use
+ * `scu_append_log_wait()` with the returned LSN to wait for it.
+ *
+ * @param[in, out] log  The log to append to.
+ * @param[in]      data The data of the record.
+ * @param[in]      size The size of the record (in bytes), which must not exceed
+ *                      the capacity of the log.
+ * @param[out]     lsn  A pointer to the LSN of the record on success, otherwise
+ *                      unchanged, or `nullptr` if it is not needed.
+ * @return `SCU_ERROR_WRITING_FILE` if an earlier batch could not be written or
+ * synchronized, or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_append_log_append(
+    ScuAppendLog* restrict log,
+    const void* restrict data,
+    Scuisize size,
+    Scuisize* restrict lsn
+);
+
+/**
+ * @brief Returns the durable LSN of a specified append-only log, i.e., the
+ * number of bytes that have been written and synchronized so far.
+ *
+ * @note This function never blocks, so it can be used to poll for durability.
+ *
+ * @param[in] log The log to examine.
+ * @return The durable LSN of the specified log.
+ */
+Scuisize scu_append_log_durable(const ScuAppendLog* log);
+
+/**
+ * @brief Waits until a specified LSN of an append-only log is durable.
+ *
+ * @param[in, out] log The log to wait for.
+ * @param[in]      lsn The LSN to wait for, which must have been returned by
+ *                     `scu_append_log_append()` before.
+ * @return `SCU_ERROR_WRITING_FILE` if the batch containing the LSN could not be
+ * written or synchronized, or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_append_log_wait(ScuAppendLog* log, Scuisize lsn);
+
+/**
+ * @brief Waits until all records appended to a specified append-only log so
+ * far are durable.
+ *
+ * @param[in, out] log The log to wait for.
+ * @return `SCU_ERROR_WRITING_FILE` if a batch could not be written or
+ * synchronized, or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_append_log_sync(ScuAppendLog* log);
+
+/**
+ * @brief Deallocates a specified append-only log.
+ *
+ * @note If `log` is a `nullptr`, this function does nothing. Records still
+ * buffered are written and synchronized before the flusher thread is stopped,
+ * but errors are not reported; call `scu_append_log_sync()` first to observe
+ * them. The file stream of the log is not closed.
+ *
+ * @warning The behavior is undefined if the log is used after it has been
+ * deallocated, or if other threads are still using it.
+ *
+ * @param[in, out] log The log to deallocate.
+ */
+void scu_append_log_free(ScuAppendLog* log);
+
+#endif
\ No newline at end of file
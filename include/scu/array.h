@@ -74,4 +74,63 @@ void scu_array_sort(
     ScuCompareFunc* cmpFunc
 );
 
+/**
+ * @brief Returns the index of the first element in a specified sorted array
+ * that is not less than a specified key.
+ *
+ * @note If `count` is zero, `array` is ignored and it may even be a `nullptr`.
+ *
+ * The comparison function is always called with an element of the array as its
+ * first and `key` as its second argument, so the key does not need to be of the
+ * same type as the elements (e.g., when searching an array of structures by one
+ * of their members).
+ *
+ * @warning The behavior is undefined if `array` does not point to a block of
+ * memory of at least `count * elemSize` bytes, or if the array is not sorted
+ * in ascending order with respect to `cmpFunc`.
+ *
+ * @param[in] array    The sorted array to search.
+ * @param[in] count    The number of elements in the array.
+ * @param[in] elemSize The size of each element (in bytes).
+ * @param[in] key      The key to search for.
+ * @param[in] cmpFunc  A comparison function used to compare the elements with
+ *                     the key.
+ * @return The index of the first element that is not less than `key`, or
+ * `count` if there is no such element.
+ */
+Scuisize scu_array_lower_bound(
+    const void* array,
+    Scuisize count,
+    Scuisize elemSize,
+    const void* key,
+    ScuCompareFunc* cmpFunc
+);
+
+/**
+ * @brief Returns the index of the first element in a specified sorted array
+ * that is greater than a specified key.
+ *
+ * @note See `scu_array_lower_bound()` for more information.
+ *
+ * @warning The behavior is undefined if `array` does not point to a block of
+ * memory of at least `count * elemSize` bytes, or if the array is not sorted
+ * in ascending order with respect to `cmpFunc`.
+ *
+ * @param[in] array    The sorted array to search.
+ * @param[in] count    The number of elements in the array.
+ * @param[in] elemSize The size of each element (in bytes).
+ * @param[in] key      The key to search for.
+ * @param[in] cmpFunc  A comparison function used to compare the elements with
+ *                     the key.
+ * @return The index of the first element that is greater than `key`, or
+ * `count` if there is no such element.
+ */
+Scuisize scu_array_upper_bound(
+    const void* array,
+    Scuisize count,
+    Scuisize elemSize,
+    const void* key,
+    ScuCompareFunc* cmpFunc
+);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,220 @@
+#ifndef SCU_ASYNC_IO_H
+#define SCU_ASYNC_IO_H
+
+#include "scu/error.h"
+#include "scu/io.h"
+#include "scu/types.h"
+
+/**
+ * @brief Represents an engine performing reads and writes at given offsets of
+ * files asynchronously.
+ *
+ * Requests are submitted in batches and complete in an arbitrary order. Their
+ * completions are collected by polling or waiting, and can optionally be
+ * dispatched to a callback.
+ *
+ * On Linux, the engine is backed by an io_uring if the kernel supports it, so
+ * a whole batch of requests is submitted with a single system call and no
+ * additional threads are involved. Otherwise, the requests are performed by a
+ * pool of worker threads using positional reads and writes.
+ *
+ * @note The engine itself is not thread-safe, i.e., it must only be used by a
+ * single thread at a time. Requests bypass the buffers of the file streams they
+ * refer to, so pending output should be flushed with `scu_fflush()` before
+ * submitting requests.
+ */
+typedef struct ScuAsyncIo ScuAsyncIo;
+
+/** @brief Represents the operation of an asynchronous request. */
+typedef enum ScuAsyncIoOp {
+
+    /** @brief Indicates to read from a file into a buffer. */
+    SCU_ASYNC_IO_OP_READ,
+
+    /** @brief Indicates to write from a buffer to a file. */
+    SCU_ASYNC_IO_OP_WRITE
+
+} ScuAsyncIoOp;
+
+/** @brief Represents the completion of an asynchronous request. */
+typedef struct ScuAsyncIoCompletion {
+
+    /** @brief The user data of the completed request. */
+    void* userData;
+
+    /**
+     * @brief The number of bytes transferred, which is less than requested for
+     * reads reaching the end of the file.
+     */
+    Scuisize count;
+
+    /**
+     * @brief `SCU_ERROR_READING_FILE` or `SCU_ERROR_WRITING_FILE` if an error
+     * occurred while performing the request, or `SCU_ERROR_NONE` on success.
+     */
+    ScuError error;
+
+} ScuAsyncIoCompletion;
+
+/**
+ * @brief Represents a function called for the completion of an asynchronous
+ * request.
+ *
+ * @param[in] completion The completion of the request.
+ */
+typedef void ScuAsyncIoCompleteFunc(const ScuAsyncIoCompletion* completion);
+
+/** @brief Represents an asynchronous request. */
+typedef struct ScuAsyncIoRequest {
+
+    /** @brief The operation to perform. */
+    ScuAsyncIoOp op;
+
+    /** @brief The file stream to read from or write to. */
+    ScuFile* file;
+
+    /**
+     * @brief The buffer to read into or write from, which must remain valid
+     * until the request has completed.
+     */
+    void* buffer;
+
+    /** @brief The number of bytes to transfer (at most `INT32_MAX`). */
+    Scuisize count;
+
+    /** @brief The offset within the file to start the transfer at. */
+    Scuisize offset;
+
+    /**
+     * @brief A function called for the completion of the request, or `nullptr`
+     * if none should be called.
+     */
+    ScuAsyncIoCompleteFunc* completeFunc;
+
+    /** @brief Arbitrary user data reported with the completion. */
+    void* userData;
+
+} ScuAsyncIoRequest;
+
+/**
+ * @brief Allocates and initializes a new asynchronous I/O engine with a
+ * specified capacity.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the engine with
+ * `scu_async_io_free()` when it is no longer needed.
+ *
+ * @param[in] capacity    The maximum number of requests that can be in flight
+ *                        at the same time, which must be at least one.
+ * @param[in] threadCount The number of worker threads to start if the engine
+ *                        can not be backed by an io_uring, which must be at
+ *                        least one.
+ * @return A pointer to the new engine, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuAsyncIo* scu_async_io_new(Scuisize capacity, Scuisize threadCount);
+
+/**
+ * @brief Determines whether a specified asynchronous I/O engine is backed by
+ * an io_uring rather than a pool of worker threads.
+ *
+ * @param[in] asyncIo The engine to examine.
+ * @return `true` if the engine is backed by an io_uring, otherwise `false`.
+ */
+bool scu_async_io_is_native(const ScuAsyncIo* asyncIo);
+
+/**
+ * @brief Returns the maximum number of requests that can be in flight at the
+ * same time in a specified asynchronous I/O engine.
+ *
+ * @param[in] asyncIo The engine to examine.
+ * @return The capacity of the specified engine.
+ */
+Scuisize scu_async_io_capacity(const ScuAsyncIo* asyncIo);
+
+/**
+ * @brief Returns the number of requests submitted to a specified asynchronous
+ * I/O engine whose completions have not been collected yet.
+ *
+ * @param[in] asyncIo The engine to examine.
+ * @return The number of requests in flight.
+ */
+Scuisize scu_async_io_in_flight(const ScuAsyncIo* asyncIo);
+
+/**
+ * @brief Submits a batch of requests to a specified asynchronous I/O engine.
+ *
+ * Requests are accepted in order until the capacity of the engine is reached.
+ * The remaining requests can be submitted again once completions have been
+ * collected with `scu_async_io_poll()` or `scu_async_io_wait()`.
+ *
+ * @param[in, out] asyncIo  The engine to submit the requests to.
+ * @param[in]      requests The requests to submit.
+ * @param[in]      count    The number of requests to submit.
+ * @return The number of requests accepted.
+ */
+Scuisize scu_async_io_submit(
+    ScuAsyncIo* restrict asyncIo,
+    const ScuAsyncIoRequest* restrict requests,
+    Scuisize count
+);
+
+/**
+ * @brief Collects the completions of requests that have already completed in
+ * a specified asynchronous I/O engine without waiting.
+ *
+ * @note The completion function of each request (if any) is called on the
+ * calling thread before its completion is stored. If `completions` is a
+ * `nullptr`, the completions are only dispatched to the completion functions.
+ *
+ * @param[in, out] asyncIo     The engine to collect completions from.
+ * @param[out]     completions An array receiving the completions, or
+ *                             `nullptr`.
+ * @param[in]      maxCount    The maximum number of completions to collect.
+ * @return The number of completions collected.
+ */
+Scuisize scu_async_io_poll(
+    ScuAsyncIo* restrict asyncIo,
+    ScuAsyncIoCompletion* restrict completions,
+    Scuisize maxCount
+);
+
+/**
+ * @brief Collects the completions of requests in a specified asynchronous I/O
+ * engine, waiting until at least a specified number of them are available.
+ *
+ * @note If `minCount` exceeds the number of requests in flight, this function
+ * only waits for the requests in flight. Completions are dispatched in the
+ * same way as by `scu_async_io_poll()`.
+ *
+ * @param[in, out] asyncIo     The engine to collect completions from.
+ * @param[out]     completions An array receiving the completions, or
+ *                             `nullptr`.
+ * @param[in]      minCount    The minimum number of completions to wait for.
+ * @param[in]      maxCount    The maximum number of completions to collect,
+ *                             which must not be less than `minCount`.
+ * @return The number of completions collected.
+ */
+Scuisize scu_async_io_wait(
+    ScuAsyncIo* restrict asyncIo,
+    ScuAsyncIoCompletion* restrict completions,
+    Scuisize minCount,
+    Scuisize maxCount
+);
+
+/**
+ * @brief Deallocates a specified asynchronous I/O engine.
+ *
+ * @note If `asyncIo` is a `nullptr`, this function does nothing. Requests still
+ * in flight are waited for, but their completions are discarded without
+ * calling their completion functions.
+ *
+ * @warning The behavior is undefined if the engine is used after it has been
+ * deallocated.
+ *
+ * @param[in, out] asyncIo The engine to deallocate.
+ */
+void scu_async_io_free(ScuAsyncIo* asyncIo);
+
+#endif
\ No newline at end of file
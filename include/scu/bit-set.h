@@ -0,0 +1,261 @@
+#ifndef SCU_BIT_SET_H
+#define SCU_BIT_SET_H
+
+#include "scu/error.h"
+#include "scu/types.h"
+
+/**
+ * @brief Represents a set of integers from the universe `[0, capacity)`, stored
+ * as one bit per integer.
+ *
+ * Compared to a `ScuHashSet` of integers, a bit set requires far less memory
+ * for dense integers (e.g., node indices of a graph), and supports set
+ * operations on whole sets at once. If the processor supports AVX2 (which is
+ * detected at runtime on x86-64 when compiling with GCC or Clang), these
+ * operations process 256 bits per instruction.
+ */
+typedef struct ScuBitSet ScuBitSet;
+
+/**
+ * @brief Allocates and initializes a new, empty bit set with a specified
+ * capacity.
+ *
+ * @note This function dynamically allocates memory using `scu_calloc()`.
+ *
+ * @warning The caller is responsible for deallocating the bit set with
+ * `scu_bit_set_free()` when it is no longer needed.
+ *
+ * @param[in] capacity The size of the universe of the bit set, i.e., the bit
+ *                     set can store the integers `[0, capacity)`.
+ * @return A pointer to the new bit set, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuBitSet* scu_bit_set_new(Scuisize capacity);
+
+/**
+ * @brief Creates a copy of a specified bit set.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the cloned bit set with
+ * `scu_bit_set_free()` when it is no longer needed.
+ *
+ * @param[in] bitSet The bit set to clone.
+ * @return A pointer to the cloned bit set, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuBitSet* scu_bit_set_clone(const ScuBitSet* bitSet);
+
+/**
+ * @brief Returns the capacity of a specified bit set, i.e., the size of its
+ * universe.
+ *
+ * @param[in] bitSet The bit set to examine.
+ * @return The capacity of the specified bit set.
+ */
+Scuisize scu_bit_set_capacity(const ScuBitSet* bitSet);
+
+/**
+ * @brief Returns the number of integers in a specified bit set.
+ *
+ * @note This function counts the set bits using population count instructions
+ * where available, and thus needs time proportional to the capacity.
+ *
+ * @param[in] bitSet The bit set to examine.
+ * @return The number of integers in the specified bit set.
+ */
+Scuisize scu_bit_set_count(const ScuBitSet* bitSet);
+
+/**
+ * @brief Changes the capacity of a specified bit set.
+ *
+ * @note If the capacity is increased, the new integers are not contained in the
+ * bit set. If it is decreased, all integers greater than or equal to the new
+ * capacity are removed.
+ *
+ * This function dynamically allocates memory using `scu_realloc()`.
+ *
+ * @param[in, out] bitSet   The bit set to resize.
+ * @param[in]      capacity The new capacity of the bit set.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred
+ * (in which case the bit set is left unchanged), or `SCU_ERROR_NONE` on
+ * success.
+ */
+ScuError scu_bit_set_resize(ScuBitSet* bitSet, Scuisize capacity);
+
+/**
+ * @brief Adds an integer to a specified bit set.
+ *
+ * @warning The behavior is undefined if `index` is not in the range
+ * `[0, scu_bit_set_capacity(bitSet))`.
+ *
+ * @param[in, out] bitSet The bit set to modify.
+ * @param[in]      index  The integer to add.
+ */
+void scu_bit_set_set(ScuBitSet* bitSet, Scuisize index);
+
+/**
+ * @brief Removes an integer from a specified bit set.
+ *
+ * @warning The behavior is undefined if `index` is not in the range
+ * `[0, scu_bit_set_capacity(bitSet))`.
+ *
+ * @param[in, out] bitSet The bit set to modify.
+ * @param[in]      index  The integer to remove.
+ */
+void scu_bit_set_clear(ScuBitSet* bitSet, Scuisize index);
+
+/**
+ * @brief Determines if a specified bit set contains an integer.
+ *
+ * @warning The behavior is undefined if `index` is not in the range
+ * `[0, scu_bit_set_capacity(bitSet))`.
+ *
+ * @param[in] bitSet The bit set to examine.
+ * @param[in] index  The integer to search for.
+ * @return `true` if the integer is contained in the bit set, otherwise `false`.
+ */
+bool scu_bit_set_test(const ScuBitSet* bitSet, Scuisize index);
+
+/**
+ * @brief Adds an integer to a specified bit set and returns whether it was
+ * already contained.
+ *
+ * @note This function is useful for marking nodes as visited during a
+ * traversal, as it combines `scu_bit_set_test()` and `scu_bit_set_set()`.
+ *
+ * @warning The behavior is undefined if `index` is not in the range
+ * `[0, scu_bit_set_capacity(bitSet))`.
+ *
+ * @param[in, out] bitSet The bit set to modify.
+ * @param[in]      index  The integer to add.
+ * @return `true` if the integer was already contained in the bit set, otherwise
+ * `false`.
+ */
+bool scu_bit_set_test_and_set(ScuBitSet* bitSet, Scuisize index);
+
+/**
+ * @brief Adds all integers of the universe to a specified bit set.
+ *
+ * @param[in, out] bitSet The bit set to fill.
+ */
+void scu_bit_set_set_all(ScuBitSet* bitSet);
+
+/**
+ * @brief Removes all integers from a specified bit set.
+ *
+ * @param[in, out] bitSet The bit set to clear.
+ */
+void scu_bit_set_clear_all(ScuBitSet* bitSet);
+
+/**
+ * @brief Returns the smallest integer in a specified bit set that is greater
+ * than or equal to a specified integer.
+ *
+ * @note Empty regions are skipped one word (64 integers) at a time, and the
+ * position within a word is determined with a count-trailing-zeros instruction
+ * where available.
+ *
+ * @param[in] bitSet The bit set to search.
+ * @param[in] index  The integer to start searching from, which must be in the
+ *                   range `[0, scu_bit_set_capacity(bitSet)]`.
+ * @return The smallest integer in the bit set that is greater than or equal to
+ * `index`, or `-1` if there is no such integer.
+ */
+Scuisize scu_bit_set_next_set(const ScuBitSet* bitSet, Scuisize index);
+
+/**
+ * @brief Intersects a bit set with another one.
+ *
+ * @warning The behavior is undefined if both bit sets do not have the same
+ * capacity.
+ *
+ * @param[in, out] dest The bit set to modify.
+ * @param[in]      src  The bit set to intersect `dest` with.
+ */
+void scu_bit_set_and(ScuBitSet* restrict dest, const ScuBitSet* restrict src);
+
+/**
+ * @brief Unites a bit set with another one.
+ *
+ * @warning The behavior is undefined if both bit sets do not have the same
+ * capacity.
+ *
+ * @param[in, out] dest The bit set to modify.
+ * @param[in]      src  The bit set to unite `dest` with.
+ */
+void scu_bit_set_or(ScuBitSet* restrict dest, const ScuBitSet* restrict src);
+
+/**
+ * @brief Replaces a bit set with its symmetric difference with another one.
+ *
+ * @warning The behavior is undefined if both bit sets do not have the same
+ * capacity.
+ *
+ * @param[in, out] dest The bit set to modify.
+ * @param[in]      src  The other bit set.
+ */
+void scu_bit_set_xor(ScuBitSet* restrict dest, const ScuBitSet* restrict src);
+
+/**
+ * @brief Removes all integers contained in another bit set from a bit set.
+ *
+ * @warning The behavior is undefined if both bit sets do not have the same
+ * capacity.
+ *
+ * @param[in, out] dest The bit set to modify.
+ * @param[in]      src  The bit set whose integers to remove from `dest`.
+ */
+void scu_bit_set_andnot(
+    ScuBitSet* restrict dest,
+    const ScuBitSet* restrict src
+);
+
+/**
+ * @brief Deallocates a specified bit set.
+ *
+ * @note If `bitSet` is a `nullptr`, this function does nothing.
+ *
+ * @warning The behavior is undefined if the bit set is used after it has been
+ * deallocated.
+ *
+ * @param[in, out] bitSet The bit set to deallocate.
+ */
+void scu_bit_set_free(ScuBitSet* bitSet);
+
+/**
+ * @brief Iterates over each integer in a specified bit set in ascending order.
+ *
+ * This macro expands to a for loop that iterates over each integer in the
+ * specified bit set. During each iteration, the provided variable is assigned
+ * the current integer.
+ *
+ * The following example demonstrates the basic usage of this macro:
+ *
+ * ```c
+ * ScuBitSet* frontier = scu_bit_set_new(nodeCount);
+ * ...
+ * Scuisize node;
+ * SCU_BIT_SET_FOREACH(node, frontier) {
+ *     // Do something with node.
+ * }
+ * ```
+ *
+ * @note The variable `index` must be declared manually before the loop. It must
+ * be of type `Scuisize`.
+ *
+ * Integers may be removed from the bit set while it is being iterated over.
+ * Integers added during the iteration are only visited if they are greater than
+ * the current integer.
+ *
+ * @param[out] index  The current integer during each iteration.
+ * @param[in]  bitSet The bit set to iterate over.
+ */
+#define SCU_BIT_SET_FOREACH(index, bitSet)                    \
+    for (                                                     \
+        (index) = scu_bit_set_next_set((bitSet), 0);          \
+        (index) >= 0;                                         \
+        (index) = scu_bit_set_next_set((bitSet), (index) + 1) \
+    )
+
+#endif
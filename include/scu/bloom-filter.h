@@ -0,0 +1,239 @@
+#ifndef SCU_BLOOM_FILTER_H
+#define SCU_BLOOM_FILTER_H
+
+#include "scu/error.h"
+#include "scu/hash.h"
+#include "scu/types.h"
+
+/**
+ * @brief Represents a probabilistic set of elements with a bounded false
+ * positive rate.
+ *
+ * A Bloom filter never reports false negatives: if an element was added, it is
+ * always reported as contained. However, elements that were never added may be
+ * reported as contained with a small probability (the false positive rate).
+ * Elements cannot be removed from a Bloom filter.
+ *
+ * This implementation uses a blocked (cache-friendly) layout: each element is
+ * mapped to a single 64-byte block, which corresponds to the size of a cache
+ * line on most modern processors. Consequently, adding an element or checking
+ * for its presence touches at most one cache line, regardless of the number of
+ * bits set per element. The bit positions within a block are derived from a
+ * single call to the hash function, whose result is remixed to provide fresh
+ * bits for every position.
+ */
+typedef struct ScuBloomFilter ScuBloomFilter;
+
+/**
+ * @brief Allocates and initializes a new Bloom filter sized for a specified
+ * number of elements and false positive rate.
+ *
+ * The number of blocks and bits set per element are chosen automatically such
+ * that the false positive rate of the Bloom filter does not exceed
+ * `falsePositiveRate` after `expectedCount` distinct elements have been added.
+ * Adding more elements than expected gradually increases the false positive
+ * rate.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the Bloom filter with
+ * `scu_bloom_filter_free()` when it is no longer needed.
+ *
+ * @param[in] expectedCount     The expected number of distinct elements.
+ * @param[in] falsePositiveRate The desired false positive rate, which must be
+ *                              in the range `(0, 1)`.
+ * @param[in] hashFunc          A function used for hashing elements.
+ * @return A pointer to the new Bloom filter, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuBloomFilter* scu_bloom_filter_new(
+    Scuisize expectedCount,
+    Scuf64 falsePositiveRate,
+    ScuHashFunc* hashFunc
+);
+
+/**
+ * @brief Creates a copy of a specified Bloom filter.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the cloned Bloom filter
+ * with `scu_bloom_filter_free()` when it is no longer needed.
+ *
+ * @param[in] filter The Bloom filter to clone.
+ * @return A pointer to the cloned Bloom filter, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuBloomFilter* scu_bloom_filter_clone(const ScuBloomFilter* filter);
+
+/**
+ * @brief Returns the number of bits of a specified Bloom filter.
+ *
+ * @note The number of bits is always a multiple of 512 (i.e., the number of
+ * bits per block).
+ *
+ * @param[in] filter The Bloom filter to examine.
+ * @return The number of bits of the specified Bloom filter.
+ */
+Scuisize scu_bloom_filter_bit_count(const ScuBloomFilter* filter);
+
+/**
+ * @brief Returns the number of bits set per element of a specified Bloom
+ * filter.
+ *
+ * @param[in] filter The Bloom filter to examine.
+ * @return The number of bits set per element of the specified Bloom filter.
+ */
+Scuisize scu_bloom_filter_hash_count(const ScuBloomFilter* filter);
+
+/**
+ * @brief Adds an element to a specified Bloom filter.
+ *
+ * @param[in, out] filter The Bloom filter to add the element to.
+ * @param[in]      elem   The element to add.
+ */
+void scu_bloom_filter_add(
+    ScuBloomFilter* restrict filter,
+    const void* restrict elem
+);
+
+/**
+ * @brief Adds an element with a precomputed hash to a specified Bloom filter.
+ *
+ * @note This function is useful in combination with the batch hashing functions
+ * (e.g., `scu_hash_u64_batch()`), and is equivalent to calling
+ * `scu_bloom_filter_add()` with an element the hash function of the Bloom
+ * filter maps to `hash`.
+ *
+ * @param[in, out] filter The Bloom filter to add the element to.
+ * @param[in]      hash   The hash of the element to add.
+ */
+void scu_bloom_filter_add_hash(ScuBloomFilter* filter, Scuusize hash);
+
+/**
+ * @brief Determines if a specified Bloom filter possibly contains an element.
+ *
+ * @param[in] filter The Bloom filter to search.
+ * @param[in] elem   The element to search for.
+ * @return `true` if the element is possibly contained in the Bloom filter, or
+ * `false` if it is definitely not contained.
+ */
+bool scu_bloom_filter_contains(
+    const ScuBloomFilter* restrict filter,
+    const void* restrict elem
+);
+
+/**
+ * @brief Determines if a specified Bloom filter possibly contains an element
+ * with a precomputed hash.
+ *
+ * @note See `scu_bloom_filter_add_hash()` for more information.
+ *
+ * @param[in] filter The Bloom filter to search.
+ * @param[in] hash   The hash of the element to search for.
+ * @return `true` if the element is possibly contained in the Bloom filter, or
+ * `false` if it is definitely not contained.
+ */
+bool scu_bloom_filter_contains_hash(
+    const ScuBloomFilter* filter,
+    Scuusize hash
+);
+
+/**
+ * @brief Removes all elements from a specified Bloom filter.
+ *
+ * @param[in, out] filter The Bloom filter to clear.
+ */
+void scu_bloom_filter_clear(ScuBloomFilter* filter);
+
+/**
+ * @brief Merges the elements of a Bloom filter into another one.
+ *
+ * After a successful union, `dest` possibly contains every element that was
+ * added to either `dest` or `src`. This allows building filters in parallel
+ * (e.g., one per thread or shard) and combining them afterwards.
+ *
+ * @note Two Bloom filters can only be merged if they have the same number of
+ * bits and bits set per element (e.g., because they were created with the same
+ * parameters), and use the same hash function.
+ *
+ * @param[in, out] dest The Bloom filter to merge into.
+ * @param[in]      src  The Bloom filter to merge from.
+ * @return `true` if the Bloom filters were merged, or `false` if they are not
+ * compatible (in which case `dest` is left unchanged).
+ */
+bool scu_bloom_filter_union(
+    ScuBloomFilter* restrict dest,
+    const ScuBloomFilter* restrict src
+);
+
+/**
+ * @brief Returns the number of bytes required to serialize a specified Bloom
+ * filter.
+ *
+ * @param[in] filter The Bloom filter to examine.
+ * @return The number of bytes required to serialize the Bloom filter.
+ */
+Scuisize scu_bloom_filter_serialized_size(const ScuBloomFilter* filter);
+
+/**
+ * @brief Serializes a specified Bloom filter into a buffer.
+ *
+ * The serialized representation is independent of the byte order of the host
+ * and can be restored with `scu_bloom_filter_deserialize()`, e.g., after
+ * writing it to a file with `scu_fwrite()`.
+ *
+ * @warning The behavior is undefined if `buffer` is not a pointer to a buffer
+ * of at least `scu_bloom_filter_serialized_size(filter)` bytes.
+ *
+ * @param[in]  filter The Bloom filter to serialize.
+ * @param[out] buffer The buffer to serialize the Bloom filter into.
+ */
+void scu_bloom_filter_serialize(
+    const ScuBloomFilter* restrict filter,
+    void* restrict buffer
+);
+
+/**
+ * @brief Deserializes a Bloom filter previously serialized with
+ * `scu_bloom_filter_serialize()`.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning If the operation succeeds, the Bloom filter returned via `*filter`
+ * must be deallocated with `scu_bloom_filter_free()` when it is no longer
+ * needed.
+ *
+ * The hash function must be the same one that was used for the serialized
+ * Bloom filter, otherwise the results of all subsequent operations are
+ * meaningless.
+ *
+ * @param[out] filter   A pointer to the deserialized Bloom filter, or `nullptr`
+ *                      on failure.
+ * @param[in]  buffer   The buffer to deserialize the Bloom filter from.
+ * @param[in]  size     The size of the buffer (in bytes).
+ * @param[in]  hashFunc A function used for hashing elements.
+ * @return `SCU_ERROR_INVALID_FORMAT` if the buffer does not contain a valid
+ * serialized Bloom filter, `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory
+ * condition occurred, or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_bloom_filter_deserialize(
+    ScuBloomFilter* restrict* restrict filter,
+    const void* restrict buffer,
+    Scuisize size,
+    ScuHashFunc* hashFunc
+);
+
+/**
+ * @brief Deallocates a specified Bloom filter.
+ *
+ * @note If `filter` is a `nullptr`, this function does nothing.
+ *
+ * @warning The behavior is undefined if the Bloom filter is used after it has
+ * been deallocated.
+ *
+ * @param[in, out] filter The Bloom filter to deallocate.
+ */
+void scu_bloom_filter_free(ScuBloomFilter* filter);
+
+#endif
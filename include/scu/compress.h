@@ -0,0 +1,315 @@
+#ifndef SCU_COMPRESS_H
+#define SCU_COMPRESS_H
+
+#include "scu/error.h"
+#include "scu/io.h"
+#include "scu/types.h"
+
+/**
+ * @brief Represents a writer compressing data into independent blocks of a
+ * file stream.
+ *
+ * The data written is split into blocks of a fixed size, each of which is
+ * compressed on its own with `scu_compress()`. Blocks that do not shrink are
+ * stored uncompressed. When the writer is finished, an index of all blocks is
+ * appended, so the data can later be read sequentially or block by block in
+ * any order (and from multiple threads) with a `ScuCompressReader`.
+ *
+ * @note The writer is not thread-safe.
+ */
+typedef struct ScuCompressWriter ScuCompressWriter;
+
+/**
+ * @brief Represents a reader decompressing data written by a
+ * `ScuCompressWriter`.
+ *
+ * @note Only `scu_compress_reader_read_block()` and the accessors may be used
+ * by multiple threads concurrently. Sequential reads share the position of the
+ * reader and are not thread-safe.
+ */
+typedef struct ScuCompressReader ScuCompressReader;
+
+/**
+ * @brief Returns the maximum compressed size of data of a specified size.
+ *
+ * @param[in] size The size of the data (in bytes), which must be non-negative.
+ * @return The maximum size of the compressed data (in bytes).
+ */
+Scuisize scu_compress_bound(Scuisize size);
+
+/**
+ * @brief Compresses data into a buffer.
+ *
+ * The compressor is a byte-oriented LZ77 variant in the style of LZ4. It finds
+ * matches with a single hash probe per position and skips faster through data
+ * that does not compress, favoring speed over compression ratio. The data can
+ * be restored with `scu_decompress()`.
+ *
+ * @note Compression never fails if `capacity` is at least
+ * `scu_compress_bound(size)`.
+ *
+ * @param[in]  source         The data to compress.
+ * @param[in]  size           The size of the data (in bytes), which must be
+ *                            non-negative and less than 2 GiB.
+ * @param[out] destination    The buffer to write the compressed data to.
+ * @param[in]  capacity       The capacity of the buffer (in bytes).
+ * @param[out] compressedSize A pointer to the size of the compressed data on
+ *                            success, otherwise unchanged.
+ * @return `SCU_ERROR_WRITING_BUFFER` if the compressed data does not fit into
+ * the buffer, or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_compress(
+    const void* restrict source,
+    Scuisize size,
+    void* restrict destination,
+    Scuisize capacity,
+    Scuisize* restrict compressedSize
+);
+
+/**
+ * @brief Decompresses data produced by `scu_compress()` into a buffer.
+ *
+ * The compressed data is validated while it is decompressed, so malformed or
+ * malicious input never causes reads or writes out of bounds.
+ *
+ * @param[in]  source           The compressed data.
+ * @param[in]  size             The size of the compressed data (in bytes).
+ * @param[out] destination      The buffer to write the decompressed data to.
+ * @param[in]  capacity         The capacity of the buffer (in bytes).
+ * @param[out] decompressedSize A pointer to the size of the decompressed data
+ *                              on success, otherwise unchanged.
+ * @return `SCU_ERROR_INVALID_FORMAT` if the compressed data is malformed,
+ * `SCU_ERROR_WRITING_BUFFER` if the decompressed data does not fit into the
+ * buffer, or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_decompress(
+    const void* restrict source,
+    Scuisize size,
+    void* restrict destination,
+    Scuisize capacity,
+    Scuisize* restrict decompressedSize
+);
+
+/**
+ * @brief Allocates and initializes a new compressing writer for a specified
+ * file stream with an unspecified default block size of at least 64 KiB.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`. The
+ * header of the compressed stream is written immediately.
+ *
+ * @warning The caller is responsible for finishing the writer with
+ * `scu_compress_writer_finish()` and deallocating it with
+ * `scu_compress_writer_free()`. The file stream must remain open and must not
+ * be written to otherwise until then.
+ *
+ * @param[in, out] file The file stream to write to.
+ * @return A pointer to the new writer, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuCompressWriter* scu_compress_writer_new(ScuFile* file);
+
+/**
+ * @brief Allocates and initializes a new compressing writer for a specified
+ * file stream with a specified block size.
+ *
+ * Larger blocks compress slightly better, while smaller blocks make reading
+ * small ranges cheaper.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`. The
+ * header of the compressed stream is written immediately.
+ *
+ * @warning The caller is responsible for finishing the writer with
+ * `scu_compress_writer_finish()` and deallocating it with
+ * `scu_compress_writer_free()`. The file stream must remain open and must not
+ * be written to otherwise until then.
+ *
+ * @param[in, out] file      The file stream to write to.
+ * @param[in]      blockSize The size of each block (in bytes), which must be
+ *                           at least one and at most 1 GiB.
+ * @return A pointer to the new writer, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuCompressWriter* scu_compress_writer_new_with_block_size(
+    ScuFile* file,
+    Scuisize blockSize
+);
+
+/**
+ * @brief Writes data to a specified compressing writer.
+ *
+ * The data is buffered until a block is full, which is then compressed and
+ * written to the file stream.
+ *
+ * @param[in, out] writer The writer to write to.
+ * @param[in]      data   The data to write.
+ * @param[in]      size   The size of the data (in bytes).
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * `SCU_ERROR_WRITING_FILE` if an error occurred while writing to the file
+ * stream, or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_compress_writer_write(
+    ScuCompressWriter* restrict writer,
+    const void* restrict data,
+    Scuisize size
+);
+
+/**
+ * @brief Finishes a specified compressing writer.
+ *
+ * The last (partial) block, the index of all blocks and a footer are written,
+ * and the file stream is flushed.
+ *
+ * @warning The behavior is undefined if the writer is written to or finished
+ * again afterwards.
+ *
+ * @param[in, out] writer The writer to finish.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * `SCU_ERROR_WRITING_FILE` if an error occurred while writing to the file
+ * stream, `SCU_ERROR_FLUSHING_FILE` if an error occurred while flushing it, or
+ * `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_compress_writer_finish(ScuCompressWriter* writer);
+
+/**
+ * @brief Deallocates a specified compressing writer.
+ *
+ * @note If `writer` is a `nullptr`, this function does nothing. The file stream
+ * of the writer is not closed.
+ *
+ * @warning Data written to a writer that has not been finished is lost, and the
+ * file stream does not contain a valid compressed stream. The behavior is
+ * undefined if the writer is used after it has been deallocated.
+ *
+ * @param[in, out] writer The writer to deallocate.
+ */
+void scu_compress_writer_free(ScuCompressWriter* writer);
+
+/**
+ * @brief Allocates and initializes a new decompressing reader for a specified
+ * file stream.
+ *
+ * The compressed stream must end at the end of the file. Its footer and index
+ * are read and validated immediately; the blocks themselves are only read and
+ * validated on demand.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`. All
+ * reads are positional (see `scu_fread_at()`), so the file position indicator
+ * of the file stream is not affected.
+ *
+ * @warning The caller is responsible for deallocating the reader with
+ * `scu_compress_reader_free()` when it is no longer needed. The file stream
+ * must remain open until then.
+ *
+ * @param[in, out] file The file stream to read from.
+ * @return A pointer to the new reader, or `nullptr` if the file stream does not
+ * contain a valid compressed stream or any other error occurred.
+ */
+[[nodiscard]]
+ScuCompressReader* scu_compress_reader_new(ScuFile* file);
+
+/**
+ * @brief Returns the decompressed size of the data of a specified
+ * decompressing reader.
+ *
+ * @param[in] reader The reader to examine.
+ * @return The decompressed size of the data (in bytes).
+ */
+Scuisize scu_compress_reader_size(const ScuCompressReader* reader);
+
+/**
+ * @brief Returns the block size of a specified decompressing reader.
+ *
+ * Block `i` holds the decompressed bytes starting at offset `i * blockSize`.
+ * All blocks except the last one are full.
+ *
+ * @param[in] reader The reader to examine.
+ * @return The block size (in bytes).
+ */
+Scuisize scu_compress_reader_block_size(const ScuCompressReader* reader);
+
+/**
+ * @brief Returns the number of blocks of a specified decompressing reader.
+ *
+ * @param[in] reader The reader to examine.
+ * @return The number of blocks.
+ */
+Scuisize scu_compress_reader_block_count(const ScuCompressReader* reader);
+
+/**
+ * @brief Reads and decompresses a single block of a specified decompressing
+ * reader.
+ *
+ * This function does not modify the reader, so multiple threads may read
+ * blocks concurrently.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()` for the
+ * compressed block, which is released before it returns.
+ *
+ * @param[in]  reader The reader to read from.
+ * @param[in]  index  The index of the block to read, which must be less than
+ *                    the number of blocks.
+ * @param[out] buffer The buffer to decompress the block into, which must hold
+ *                    at least `scu_compress_reader_block_size(reader)` bytes.
+ * @param[out] size   A pointer to the decompressed size of the block on
+ *                    success, otherwise unchanged.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * `SCU_ERROR_READING_FILE` if an error occurred while reading from the file
+ * stream, `SCU_ERROR_INVALID_FORMAT` if the block is corrupted, or
+ * `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_compress_reader_read_block(
+    const ScuCompressReader* restrict reader,
+    Scuisize index,
+    void* restrict buffer,
+    Scuisize* restrict size
+);
+
+/**
+ * @brief Reads decompressed data from the current position of a specified
+ * decompressing reader.
+ *
+ * @param[in, out] reader The reader to read from.
+ * @param[out]     buffer The buffer to read into.
+ * @param[in]      count  The maximum number of bytes to read.
+ * @param[out]     read   A pointer to the number of bytes read on success,
+ *                        which is only less than `count` at the end of the
+ *                        data, otherwise unchanged.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * `SCU_ERROR_END_OF_FILE` if the position is already at the end of the data,
+ * `SCU_ERROR_READING_FILE` if an error occurred while reading from the file
+ * stream, `SCU_ERROR_INVALID_FORMAT` if a block is corrupted, or
+ * `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_compress_reader_read(
+    ScuCompressReader* restrict reader,
+    void* restrict buffer,
+    Scuisize count,
+    Scuisize* restrict read
+);
+
+/**
+ * @brief Sets the position of a specified decompressing reader.
+ *
+ * @note Only the block containing the new position is decompressed by the next
+ * read, so seeking is cheap.
+ *
+ * @param[in, out] reader   The reader to reposition.
+ * @param[in]      position The new position, which must not exceed the
+ *                          decompressed size of the data.
+ */
+void scu_compress_reader_seek(ScuCompressReader* reader, Scuisize position);
+
+/**
+ * @brief Deallocates a specified decompressing reader.
+ *
+ * @note If `reader` is a `nullptr`, this function does nothing. The file stream
+ * of the reader is not closed.
+ *
+ * @warning The behavior is undefined if the reader is used after it has been
+ * deallocated.
+ *
+ * @param[in, out] reader The reader to deallocate.
+ */
+void scu_compress_reader_free(ScuCompressReader* reader);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,153 @@
+#ifndef SCU_CONCURRENT_DISJOINT_SET_H
+#define SCU_CONCURRENT_DISJOINT_SET_H
+
+#include "scu/types.h"
+
+/**
+ * @brief Represents a partition of the integers `[0, count)` into disjoint sets
+ * that can be modified and queried by multiple threads at the same time.
+ *
+ * All operations except `scu_concurrent_disjoint_set_label()` and
+ * `scu_concurrent_disjoint_set_free()` are lock-free and may be called
+ * concurrently. Sets are merged by atomically linking the representative with
+ * the smaller index to the one with the larger index using compare-and-swap,
+ * which rules out cycles without requiring any locks. Paths are shortened with
+ * path halving, which is safe to perform concurrently as well.
+ *
+ * @note In contrast to `ScuDisjointSet`, the representative of a set is always
+ * its largest integer.
+ */
+typedef struct ScuConcurrentDisjointSet ScuConcurrentDisjointSet;
+
+/**
+ * @brief Allocates and initializes a new concurrent disjoint set with a
+ * specified number of integers, each forming a set of its own.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the concurrent disjoint
+ * set with `scu_concurrent_disjoint_set_free()` when it is no longer needed.
+ *
+ * @param[in] count The number of integers.
+ * @return A pointer to the new concurrent disjoint set, or `nullptr` on
+ * failure.
+ */
+[[nodiscard]]
+ScuConcurrentDisjointSet* scu_concurrent_disjoint_set_new(Scuisize count);
+
+/**
+ * @brief Returns the number of integers of a specified concurrent disjoint set.
+ *
+ * @param[in] disjointSet The concurrent disjoint set to examine.
+ * @return The number of integers of the specified concurrent disjoint set.
+ */
+Scuisize scu_concurrent_disjoint_set_count(
+    const ScuConcurrentDisjointSet* disjointSet
+);
+
+/**
+ * @brief Returns the number of sets of a specified concurrent disjoint set.
+ *
+ * @note If other threads are merging sets at the same time, the returned value
+ * may already be outdated.
+ *
+ * @param[in] disjointSet The concurrent disjoint set to examine.
+ * @return The number of sets of the specified concurrent disjoint set.
+ */
+Scuisize scu_concurrent_disjoint_set_set_count(
+    const ScuConcurrentDisjointSet* disjointSet
+);
+
+/**
+ * @brief Returns the representative of the set containing a specified integer.
+ *
+ * @note If other threads are merging sets at the same time, the returned value
+ * may already be outdated.
+ *
+ * @warning The behavior is undefined if `x` is not in the range
+ * `[0, scu_concurrent_disjoint_set_count(disjointSet))`.
+ *
+ * @param[in, out] disjointSet The concurrent disjoint set to search.
+ * @param[in]      x           The integer whose representative to find.
+ * @return The representative of the set containing `x`.
+ */
+Scuisize scu_concurrent_disjoint_set_find(
+    ScuConcurrentDisjointSet* disjointSet,
+    Scuisize x
+);
+
+/**
+ * @brief Merges the sets containing two specified integers.
+ *
+ * @warning The behavior is undefined if `x` or `y` is not in the range
+ * `[0, scu_concurrent_disjoint_set_count(disjointSet))`.
+ *
+ * @param[in, out] disjointSet The concurrent disjoint set to modify.
+ * @param[in]      x           The first integer.
+ * @param[in]      y           The second integer.
+ * @return `true` if the sets were merged by this call, or `false` if `x` and
+ * `y` were already in the same set.
+ */
+bool scu_concurrent_disjoint_set_union(
+    ScuConcurrentDisjointSet* disjointSet,
+    Scuisize x,
+    Scuisize y
+);
+
+/**
+ * @brief Determines if two specified integers are in the same set.
+ *
+ * @note The result is exact at some point during the call: if `true` is
+ * returned, both integers remain in the same set forever.
+ *
+ * @warning The behavior is undefined if `x` or `y` is not in the range
+ * `[0, scu_concurrent_disjoint_set_count(disjointSet))`.
+ *
+ * @param[in, out] disjointSet The concurrent disjoint set to search.
+ * @param[in]      x           The first integer.
+ * @param[in]      y           The second integer.
+ * @return `true` if `x` and `y` are in the same set, otherwise `false`.
+ */
+bool scu_concurrent_disjoint_set_same_set(
+    ScuConcurrentDisjointSet* disjointSet,
+    Scuisize x,
+    Scuisize y
+);
+
+/**
+ * @brief Labels the integers of a specified concurrent disjoint set by their
+ * sets.
+ *
+ * After calling this function, `labels[x]` holds a label in the range
+ * `[0, scu_concurrent_disjoint_set_set_count(disjointSet))` for every integer
+ * `x`, and two integers have the same label if and only if they are in the same
+ * set. Labels are assigned in order of the smallest integer of each set, i.e.,
+ * the set containing `0` has the label `0`.
+ *
+ * @warning This function must not be called while other threads are merging
+ * sets. The behavior is undefined if `labels` is not a pointer to an array of
+ * at least `scu_concurrent_disjoint_set_count(disjointSet)` elements.
+ *
+ * @param[in, out] disjointSet The concurrent disjoint set to examine.
+ * @param[out]     labels      The array to store the labels in.
+ * @return The number of sets (i.e., distinct labels).
+ */
+Scuisize scu_concurrent_disjoint_set_label(
+    ScuConcurrentDisjointSet* restrict disjointSet,
+    Scuisize* restrict labels
+);
+
+/**
+ * @brief Deallocates a specified concurrent disjoint set.
+ *
+ * @note If `disjointSet` is a `nullptr`, this function does nothing.
+ *
+ * @warning This function must not be called while other threads are still
+ * using the concurrent disjoint set. The behavior is undefined if the
+ * concurrent disjoint set is used after it has been deallocated.
+ *
+ * @param[in, out] disjointSet The concurrent disjoint set to deallocate.
+ */
+void scu_concurrent_disjoint_set_free(ScuConcurrentDisjointSet* disjointSet);
+
+#endif
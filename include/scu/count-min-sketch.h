@@ -0,0 +1,221 @@
+#ifndef SCU_COUNT_MIN_SKETCH_H
+#define SCU_COUNT_MIN_SKETCH_H
+
+#include "scu/hash.h"
+#include "scu/types.h"
+
+/**
+ * @brief Represents a probabilistic frequency table of elements.
+ *
+ * A Count-Min sketch consists of `depth` rows of `width` counters each. Every
+ * element is mapped to one counter per row, and its frequency is estimated as
+ * the minimum of these counters. Estimates are never lower than the true
+ * frequency, and with probability at least `1 - delta` they exceed it by at
+ * most `epsilon * total`, where `total` is the sum of all counts added, `width`
+ * is at least `e / epsilon` and `depth` is at least `ln(1 / delta)`.
+ *
+ * This implementation uses conservative updates, which only increment the
+ * counters that are necessary to maintain the guarantee above. This noticeably
+ * reduces the overestimation for skewed distributions.
+ */
+typedef struct ScuCountMinSketch ScuCountMinSketch;
+
+/**
+ * @brief Allocates and initializes a new Count-Min sketch with a specified
+ * width, depth and hash function.
+ *
+ * @note The width is rounded up to the next power of two.
+ *
+ * This function dynamically allocates memory using `scu_malloc()` and
+ * `scu_calloc()`.
+ *
+ * @warning The caller is responsible for deallocating the sketch with
+ * `scu_count_min_sketch_free()` when it is no longer needed.
+ *
+ * @param[in] width    The number of counters per row.
+ * @param[in] depth    The number of rows.
+ * @param[in] hashFunc A function used for hashing elements.
+ * @return A pointer to the new sketch, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuCountMinSketch* scu_count_min_sketch_new(
+    Scuisize width,
+    Scuisize depth,
+    ScuHashFunc* hashFunc
+);
+
+/**
+ * @brief Allocates and initializes a new Count-Min sketch with specified error
+ * bounds and hash function.
+ *
+ * The width and depth are chosen such that, with probability at least
+ * `1 - delta`, estimates exceed the true frequency by at most
+ * `epsilon * total`, where `total` is the sum of all counts added.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()` and
+ * `scu_calloc()`.
+ *
+ * @warning The caller is responsible for deallocating the sketch with
+ * `scu_count_min_sketch_free()` when it is no longer needed.
+ *
+ * @param[in] epsilon  The relative error bound, which must be in the range
+ *                     `(0, 1)`.
+ * @param[in] delta    The probability of exceeding the error bound, which must
+ *                     be in the range `(0, 1)`.
+ * @param[in] hashFunc A function used for hashing elements.
+ * @return A pointer to the new sketch, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuCountMinSketch* scu_count_min_sketch_new_with_error(
+    Scuf64 epsilon,
+    Scuf64 delta,
+    ScuHashFunc* hashFunc
+);
+
+/**
+ * @brief Creates a copy of a specified Count-Min sketch.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the cloned sketch with
+ * `scu_count_min_sketch_free()` when it is no longer needed.
+ *
+ * @param[in] sketch The sketch to clone.
+ * @return A pointer to the cloned sketch, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuCountMinSketch* scu_count_min_sketch_clone(const ScuCountMinSketch* sketch);
+
+/**
+ * @brief Returns the number of counters per row of a specified Count-Min
+ * sketch.
+ *
+ * @param[in] sketch The sketch to examine.
+ * @return The number of counters per row of the specified sketch.
+ */
+Scuisize scu_count_min_sketch_width(const ScuCountMinSketch* sketch);
+
+/**
+ * @brief Returns the number of rows of a specified Count-Min sketch.
+ *
+ * @param[in] sketch The sketch to examine.
+ * @return The number of rows of the specified sketch.
+ */
+Scuisize scu_count_min_sketch_depth(const ScuCountMinSketch* sketch);
+
+/**
+ * @brief Returns the sum of all counts added to a specified Count-Min sketch.
+ *
+ * @param[in] sketch The sketch to examine.
+ * @return The sum of all counts added to the specified sketch.
+ */
+Scuu64 scu_count_min_sketch_total(const ScuCountMinSketch* sketch);
+
+/**
+ * @brief Adds a number of occurrences of an element to a specified Count-Min
+ * sketch.
+ *
+ * @note Counters saturate at `SCU_U64_MAX` instead of wrapping around.
+ *
+ * @param[in, out] sketch The sketch to add the occurrences to.
+ * @param[in]      elem   The element to add.
+ * @param[in]      count  The number of occurrences to add.
+ */
+void scu_count_min_sketch_add(
+    ScuCountMinSketch* restrict sketch,
+    const void* restrict elem,
+    Scuu64 count
+);
+
+/**
+ * @brief Adds a number of occurrences of an element with a precomputed hash to
+ * a specified Count-Min sketch.
+ *
+ * @note This function is useful in combination with the batch hashing functions
+ * (e.g., `scu_hash_u64_batch()`), and is equivalent to calling
+ * `scu_count_min_sketch_add()` with an element the hash function of the sketch
+ * maps to `hash`.
+ *
+ * @param[in, out] sketch The sketch to add the occurrences to.
+ * @param[in]      hash   The hash of the element to add.
+ * @param[in]      count  The number of occurrences to add.
+ */
+void scu_count_min_sketch_add_hash(
+    ScuCountMinSketch* sketch,
+    Scuusize hash,
+    Scuu64 count
+);
+
+/**
+ * @brief Estimates the number of occurrences of an element in a specified
+ * Count-Min sketch.
+ *
+ * @param[in] sketch The sketch to examine.
+ * @param[in] elem   The element to estimate the number of occurrences of.
+ * @return The estimated number of occurrences, which is never lower than the
+ * actual number.
+ */
+Scuu64 scu_count_min_sketch_estimate(
+    const ScuCountMinSketch* restrict sketch,
+    const void* restrict elem
+);
+
+/**
+ * @brief Estimates the number of occurrences of an element with a precomputed
+ * hash in a specified Count-Min sketch.
+ *
+ * @note See `scu_count_min_sketch_add_hash()` for more information.
+ *
+ * @param[in] sketch The sketch to examine.
+ * @param[in] hash   The hash of the element to estimate the number of
+ *                   occurrences of.
+ * @return The estimated number of occurrences, which is never lower than the
+ * actual number.
+ */
+Scuu64 scu_count_min_sketch_estimate_hash(
+    const ScuCountMinSketch* sketch,
+    Scuusize hash
+);
+
+/**
+ * @brief Merges the counts of a Count-Min sketch into another one.
+ *
+ * After a successful merge, `dest` estimates the combined number of
+ * occurrences added to either `dest` or `src`. This allows counting in
+ * parallel (e.g., one sketch per thread or shard) and combining the results
+ * afterwards.
+ *
+ * @note Two sketches can only be merged if they have the same width and depth
+ * (e.g., because they were created with the same parameters), and use the same
+ * hash function.
+ *
+ * @param[in, out] dest The sketch to merge into.
+ * @param[in]      src  The sketch to merge from.
+ * @return `true` if the sketches were merged, or `false` if they are not
+ * compatible (in which case `dest` is left unchanged).
+ */
+bool scu_count_min_sketch_merge(
+    ScuCountMinSketch* restrict dest,
+    const ScuCountMinSketch* restrict src
+);
+
+/**
+ * @brief Resets all counters of a specified Count-Min sketch to zero.
+ *
+ * @param[in, out] sketch The sketch to clear.
+ */
+void scu_count_min_sketch_clear(ScuCountMinSketch* sketch);
+
+/**
+ * @brief Deallocates a specified Count-Min sketch.
+ *
+ * @note If `sketch` is a `nullptr`, this function does nothing.
+ *
+ * @warning The behavior is undefined if the sketch is used after it has been
+ * deallocated.
+ *
+ * @param[in, out] sketch The sketch to deallocate.
+ */
+void scu_count_min_sketch_free(ScuCountMinSketch* sketch);
+
+#endif
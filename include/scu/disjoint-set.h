@@ -0,0 +1,166 @@
+#ifndef SCU_DISJOINT_SET_H
+#define SCU_DISJOINT_SET_H
+
+#include "scu/types.h"
+
+/**
+ * @brief Represents a partition of the integers `[0, count)` into disjoint sets
+ * (also known as a union-find data structure).
+ *
+ * Initially, every integer forms a set of its own. Sets can be merged with
+ * `scu_disjoint_set_union()`, and the representative of the set containing an
+ * integer can be queried with `scu_disjoint_set_find()`. Both operations run in
+ * nearly constant amortized time, as the implementation uses union by size and
+ * path halving.
+ *
+ * @note See `ScuConcurrentDisjointSet` for a variant that can be used by
+ * multiple threads at the same time.
+ */
+typedef struct ScuDisjointSet ScuDisjointSet;
+
+/**
+ * @brief Allocates and initializes a new disjoint set with a specified number
+ * of integers, each forming a set of its own.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the disjoint set with
+ * `scu_disjoint_set_free()` when it is no longer needed.
+ *
+ * @param[in] count The number of integers.
+ * @return A pointer to the new disjoint set, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuDisjointSet* scu_disjoint_set_new(Scuisize count);
+
+/**
+ * @brief Creates a copy of a specified disjoint set.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the cloned disjoint set
+ * with `scu_disjoint_set_free()` when it is no longer needed.
+ *
+ * @param[in] disjointSet The disjoint set to clone.
+ * @return A pointer to the cloned disjoint set, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuDisjointSet* scu_disjoint_set_clone(const ScuDisjointSet* disjointSet);
+
+/**
+ * @brief Returns the number of integers of a specified disjoint set.
+ *
+ * @param[in] disjointSet The disjoint set to examine.
+ * @return The number of integers of the specified disjoint set.
+ */
+Scuisize scu_disjoint_set_count(const ScuDisjointSet* disjointSet);
+
+/**
+ * @brief Returns the number of sets of a specified disjoint set.
+ *
+ * @param[in] disjointSet The disjoint set to examine.
+ * @return The number of sets of the specified disjoint set.
+ */
+Scuisize scu_disjoint_set_set_count(const ScuDisjointSet* disjointSet);
+
+/**
+ * @brief Returns the representative of the set containing a specified integer.
+ *
+ * @note Two integers are in the same set if and only if they have the same
+ * representative. The representative of a set only changes when the set is
+ * merged with another one.
+ *
+ * This function shortens the path from the integer to its representative
+ * (path halving), which is why it requires a mutable disjoint set.
+ *
+ * @warning The behavior is undefined if `x` is not in the range
+ * `[0, scu_disjoint_set_count(disjointSet))`.
+ *
+ * @param[in, out] disjointSet The disjoint set to search.
+ * @param[in]      x           The integer whose representative to find.
+ * @return The representative of the set containing `x`.
+ */
+Scuisize scu_disjoint_set_find(ScuDisjointSet* disjointSet, Scuisize x);
+
+/**
+ * @brief Merges the sets containing two specified integers.
+ *
+ * @warning The behavior is undefined if `x` or `y` is not in the range
+ * `[0, scu_disjoint_set_count(disjointSet))`.
+ *
+ * @param[in, out] disjointSet The disjoint set to modify.
+ * @param[in]      x           The first integer.
+ * @param[in]      y           The second integer.
+ * @return `true` if the sets were merged, or `false` if `x` and `y` were
+ * already in the same set.
+ */
+bool scu_disjoint_set_union(
+    ScuDisjointSet* disjointSet,
+    Scuisize x,
+    Scuisize y
+);
+
+/**
+ * @brief Determines if two specified integers are in the same set.
+ *
+ * @warning The behavior is undefined if `x` or `y` is not in the range
+ * `[0, scu_disjoint_set_count(disjointSet))`.
+ *
+ * @param[in, out] disjointSet The disjoint set to search.
+ * @param[in]      x           The first integer.
+ * @param[in]      y           The second integer.
+ * @return `true` if `x` and `y` are in the same set, otherwise `false`.
+ */
+bool scu_disjoint_set_same_set(
+    ScuDisjointSet* disjointSet,
+    Scuisize x,
+    Scuisize y
+);
+
+/**
+ * @brief Returns the number of integers in the set containing a specified
+ * integer.
+ *
+ * @warning The behavior is undefined if `x` is not in the range
+ * `[0, scu_disjoint_set_count(disjointSet))`.
+ *
+ * @param[in, out] disjointSet The disjoint set to search.
+ * @param[in]      x           The integer whose set to examine.
+ * @return The number of integers in the set containing `x`.
+ */
+Scuisize scu_disjoint_set_set_size(ScuDisjointSet* disjointSet, Scuisize x);
+
+/**
+ * @brief Labels the integers of a specified disjoint set by their sets.
+ *
+ * After calling this function, `labels[x]` holds a label in the range
+ * `[0, scu_disjoint_set_set_count(disjointSet))` for every integer `x`, and two
+ * integers have the same label if and only if they are in the same set. Labels
+ * are assigned in order of the smallest integer of each set, i.e., the set
+ * containing `0` has the label `0`.
+ *
+ * @warning The behavior is undefined if `labels` is not a pointer to an array
+ * of at least `scu_disjoint_set_count(disjointSet)` elements.
+ *
+ * @param[in, out] disjointSet The disjoint set to examine.
+ * @param[out]     labels      The array to store the labels in.
+ * @return The number of sets (i.e., distinct labels).
+ */
+Scuisize scu_disjoint_set_label(
+    ScuDisjointSet* restrict disjointSet,
+    Scuisize* restrict labels
+);
+
+/**
+ * @brief Deallocates a specified disjoint set.
+ *
+ * @note If `disjointSet` is a `nullptr`, this function does nothing.
+ *
+ * @warning The behavior is undefined if the disjoint set is used after it has
+ * been deallocated.
+ *
+ * @param[in, out] disjointSet The disjoint set to deallocate.
+ */
+void scu_disjoint_set_free(ScuDisjointSet* disjointSet);
+
+#endif
@@ -57,7 +57,13 @@ typedef enum ScuError {
     SCU_ERROR_INVALID_FORMAT,
 
     /** @brief Indicates that an error occurred while measuring some time. */
-    SCU_ERROR_TIMING_FAILED
+    SCU_ERROR_TIMING_FAILED,
+
+    /**
+     * @brief Indicates that an error occurred while mapping a file into
+     * memory.
+     */
+    SCU_ERROR_MAPPING_FILE
 
 } ScuError;
 
@@ -0,0 +1,277 @@
+#ifndef SCU_FLAT_MAP_H
+#define SCU_FLAT_MAP_H
+
+#include "scu/compare.h"
+#include "scu/flat-set.h"
+#include "scu/types.h"
+
+/**
+ * @brief Represents an immutable map of key-value pairs stored in two
+ * contiguous blocks of memory.
+ *
+ * A flat map is built once from an array of keys and an array of values and
+ * can only be searched afterwards. The keys are laid out as in a `ScuFlatSet`
+ * (see `ScuFlatLayout`), and the values are stored in a parallel array, so that
+ * searches only touch the keys.
+ *
+ * Entries are referred to by their position in the underlying storage, which
+ * is in the range `[0, scu_flat_map_count(flatMap))`.
+ */
+typedef struct ScuFlatMap ScuFlatMap;
+
+/**
+ * @brief Allocates and initializes a new flat map containing the key-value
+ * pairs of two specified parallel arrays.
+ *
+ * @note If `count` is zero, `keys` and `values` are ignored and they may even
+ * be `nullptr`s. Lists can be passed directly, together with
+ * `scu_list_count()`.
+ *
+ * The keys and values are copied and sorted by key. If the array contains
+ * duplicate keys, only one of the pairs (unspecified which one) is kept.
+ *
+ * This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the flat map with
+ * `scu_flat_map_free()` when it is no longer needed.
+ *
+ * @param[in] keys      The array of keys.
+ * @param[in] values    The array of values, where each value is associated
+ *                      with the key at the same index.
+ * @param[in] count     The number of keys and values.
+ * @param[in] keySize   The size of each key (in bytes).
+ * @param[in] valueSize The size of each value (in bytes).
+ * @param[in] cmpFunc   A comparison function used to determine the order of the
+ *                      keys.
+ * @param[in] layout    The memory layout to use.
+ * @return A pointer to the new flat map, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuFlatMap* scu_flat_map_new(
+    const void* keys,
+    const void* values,
+    Scuisize count,
+    Scuisize keySize,
+    Scuisize valueSize,
+    ScuCompareFunc* cmpFunc,
+    ScuFlatLayout layout
+);
+
+/**
+ * @brief Creates a copy of a specified flat map.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the cloned flat map with
+ * `scu_flat_map_free()` when it is no longer needed.
+ *
+ * @param[in] flatMap The flat map to clone.
+ * @return A pointer to the cloned flat map, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuFlatMap* scu_flat_map_clone(const ScuFlatMap* flatMap);
+
+/**
+ * @brief Returns the number of key-value pairs of a specified flat map.
+ *
+ * @param[in] flatMap The flat map to examine.
+ * @return The number of key-value pairs of the specified flat map.
+ */
+Scuisize scu_flat_map_count(const ScuFlatMap* flatMap);
+
+/**
+ * @brief Returns the memory layout of a specified flat map.
+ *
+ * @param[in] flatMap The flat map to examine.
+ * @return The memory layout of the specified flat map.
+ */
+ScuFlatLayout scu_flat_map_layout(const ScuFlatMap* flatMap);
+
+/**
+ * @brief Returns a pointer to the key at a specified position of a specified
+ * flat map.
+ *
+ * @warning The behavior is undefined if `position` is not in the range
+ * `[0, scu_flat_map_count(flatMap))`.
+ *
+ * @param[in] flatMap  The flat map to examine.
+ * @param[in] position The position of the key-value pair.
+ * @return A pointer to the key at the specified position.
+ */
+const void* scu_flat_map_key_at(const ScuFlatMap* flatMap, Scuisize position);
+
+/**
+ * @brief Returns a pointer to the value at a specified position of a specified
+ * flat map.
+ *
+ * @note Although the keys are immutable, the values may be modified in place.
+ *
+ * @warning The behavior is undefined if `position` is not in the range
+ * `[0, scu_flat_map_count(flatMap))`.
+ *
+ * @param[in] flatMap  The flat map to examine.
+ * @param[in] position The position of the key-value pair.
+ * @return A pointer to the value at the specified position.
+ */
+void* scu_flat_map_value_at(const ScuFlatMap* flatMap, Scuisize position);
+
+/**
+ * @brief Determines whether a key is present in a specified flat map.
+ *
+ * @param[in] flatMap The flat map to search.
+ * @param[in] key     The key to search for.
+ * @return `true` if the key is present in the flat map, otherwise `false`.
+ */
+bool scu_flat_map_contains(
+    const ScuFlatMap* restrict flatMap,
+    const void* restrict key
+);
+
+/**
+ * @brief Returns the position of a key in a specified flat map.
+ *
+ * @param[in] flatMap The flat map to search.
+ * @param[in] key     The key to search for.
+ * @return The position of the key, or `-1` if it is not present.
+ */
+Scuisize scu_flat_map_find(
+    const ScuFlatMap* restrict flatMap,
+    const void* restrict key
+);
+
+/**
+ * @brief Tries to get the value associated with a key in a specified flat map.
+ *
+ * @note This function is an implementation detail and not intended to be called
+ * directly. Use the `scu_flat_map_try_get()` macro instead.
+ *
+ * @param[in]  flatMap The flat map to search.
+ * @param[in]  key     The key to look up.
+ * @param[out] value   A pointer to the value associated with the specified key
+ *                     on success, otherwise a `nullptr`.
+ * @return `true` if the key was present in the flat map, otherwise `false`.
+ */
+bool scu_flat_map_try_get_impl(
+    const ScuFlatMap* restrict flatMap,
+    const void* restrict key,
+    void* restrict* restrict value
+);
+
+/**
+ * @brief Tries to get the value associated with a key in a specified flat map.
+ *
+ * @param[in]  flatMap The flat map to search.
+ * @param[in]  key     The key to look up.
+ * @param[out] value   A pointer to the value associated with the specified key
+ *                     on success, otherwise a `nullptr`.
+ * @return `true` if the key was present in the flat map, otherwise `false`.
+ */
+#define scu_flat_map_try_get(flatMap, key, value)             \
+    scu_flat_map_try_get_impl(flatMap, key, (void**) (value))
+
+/**
+ * @brief Returns the position of the smallest key of a specified flat map that
+ * is not less than a specified key.
+ *
+ * @note The comparison function is always called with a key of the flat map as
+ * its first and `key` as its second argument.
+ *
+ * @param[in] flatMap The flat map to search.
+ * @param[in] key     The key to search for.
+ * @return The position of the smallest key not less than `key`, or `-1` if
+ * there is no such key.
+ */
+Scuisize scu_flat_map_lower_bound(
+    const ScuFlatMap* restrict flatMap,
+    const void* restrict key
+);
+
+/**
+ * @brief Returns the position of the smallest key of a specified flat map that
+ * is greater than a specified key.
+ *
+ * @note The comparison function is always called with a key of the flat map as
+ * its first and `key` as its second argument.
+ *
+ * @param[in] flatMap The flat map to search.
+ * @param[in] key     The key to search for.
+ * @return The position of the smallest key greater than `key`, or `-1` if there
+ * is no such key.
+ */
+Scuisize scu_flat_map_upper_bound(
+    const ScuFlatMap* restrict flatMap,
+    const void* restrict key
+);
+
+/**
+ * @brief Returns the position of the smallest key of a specified flat map.
+ *
+ * @param[in] flatMap The flat map to examine.
+ * @return The position of the smallest key, or `-1` if the flat map is empty.
+ */
+Scuisize scu_flat_map_first(const ScuFlatMap* flatMap);
+
+/**
+ * @brief Returns the position of the key following the key at a specified
+ * position of a specified flat map in ascending order.
+ *
+ * @warning The behavior is undefined if `position` is not in the range
+ * `[0, scu_flat_map_count(flatMap))`.
+ *
+ * @param[in] flatMap  The flat map to examine.
+ * @param[in] position The position of the current key.
+ * @return The position of the next key, or `-1` if the current key is the
+ * largest one.
+ */
+Scuisize scu_flat_map_next(const ScuFlatMap* flatMap, Scuisize position);
+
+/**
+ * @brief Deallocates a specified flat map.
+ *
+ * @note If `flatMap` is a `nullptr`, this function does nothing.
+ *
+ * @warning This function only deallocates the memory occupied by the flat map
+ * itself, but not the keys and values contained within. The caller is
+ * responsible for deallocating the individual keys and values if they are
+ * pointers to dynamically allocated objects and no other references to them
+ * exist.
+ *
+ * The behavior is undefined if the flat map is used after it has been
+ * deallocated.
+ *
+ * @param[in, out] flatMap The flat map to deallocate.
+ */
+void scu_flat_map_free(ScuFlatMap* flatMap);
+
+/**
+ * @brief Iterates over the positions of the key-value pairs of a specified flat
+ * map in ascending order of the keys.
+ *
+ * The following example demonstrates the basic usage of this macro:
+ *
+ * ```c
+ * ScuFlatMap* opcodes = scu_flat_map_new(...);
+ * ...
+ * Scuisize position;
+ * SCU_FLAT_MAP_FOREACH(position, opcodes) {
+ *     const K* key = scu_flat_map_key_at(opcodes, position);
+ *     V* value = scu_flat_map_value_at(opcodes, position);
+ *     // Do something with *key and *value.
+ * }
+ * ```
+ *
+ * @note The variable `position` must be declared manually before the loop. It
+ * must be of type `Scuisize`.
+ *
+ * @param[out] position The position of the current key-value pair during each
+ *                      iteration.
+ * @param[in]  flatMap  The flat map to iterate over.
+ */
+#define SCU_FLAT_MAP_FOREACH(position, flatMap)               \
+    for (                                                     \
+        (position) = scu_flat_map_first(flatMap);             \
+        (position) >= 0;                                      \
+        (position) = scu_flat_map_next((flatMap), (position)) \
+    )
+
+#endif
\ No newline at end of file
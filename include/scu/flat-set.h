@@ -0,0 +1,250 @@
+#ifndef SCU_FLAT_SET_H
+#define SCU_FLAT_SET_H
+
+#include "scu/compare.h"
+#include "scu/types.h"
+
+/** @brief Represents the memory layout of a flat set or flat map. */
+typedef enum ScuFlatLayout {
+
+    /**
+     * @brief Indicates that the elements are stored in ascending order and
+     * searched using binary search.
+     */
+    SCU_FLAT_LAYOUT_SORTED,
+
+    /**
+     * @brief Indicates that the elements are stored in the order of a
+     * breadth-first traversal of an implicit binary search tree (also known as
+     * the Eytzinger layout).
+     *
+     * @note The first levels of the tree are packed into the same few cache
+     * lines and the memory accessed next can be prefetched, so searches are
+     * usually faster than with `SCU_FLAT_LAYOUT_SORTED` once the elements no
+     * longer fit into the cache. Iterating in ascending order is slightly more
+     * expensive, though.
+     */
+    SCU_FLAT_LAYOUT_EYTZINGER
+
+} ScuFlatLayout;
+
+/**
+ * @brief Represents an immutable set of elements stored in a single contiguous
+ * block of memory.
+ *
+ * A flat set is built once from an array (or a list) and can only be searched
+ * afterwards. In contrast to `ScuHashSet`, it requires no additional memory
+ * besides the elements themselves and supports ordered queries such as
+ * `scu_flat_set_lower_bound()`, which makes it well suited for small, static
+ * lookup tables.
+ *
+ * Elements are referred to by their position in the underlying storage, which
+ * is in the range `[0, scu_flat_set_count(flatSet))`. Positions only coincide
+ * with the rank of an element for `SCU_FLAT_LAYOUT_SORTED`.
+ */
+typedef struct ScuFlatSet ScuFlatSet;
+
+/**
+ * @brief Allocates and initializes a new flat set containing the elements of a
+ * specified array.
+ *
+ * @note If `count` is zero, `elems` is ignored and it may even be a `nullptr`.
+ * Lists can be passed directly, together with `scu_list_count()`.
+ *
+ * The elements are copied and sorted. If the array contains duplicates, only
+ * one of them (unspecified which one) is kept.
+ *
+ * This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the flat set with
+ * `scu_flat_set_free()` when it is no longer needed.
+ *
+ * @param[in] elems    The array of elements.
+ * @param[in] count    The number of elements in the array.
+ * @param[in] elemSize The size of each element (in bytes).
+ * @param[in] cmpFunc  A comparison function used to determine the order of the
+ *                     elements.
+ * @param[in] layout   The memory layout to use.
+ * @return A pointer to the new flat set, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuFlatSet* scu_flat_set_new(
+    const void* elems,
+    Scuisize count,
+    Scuisize elemSize,
+    ScuCompareFunc* cmpFunc,
+    ScuFlatLayout layout
+);
+
+/**
+ * @brief Creates a copy of a specified flat set.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the cloned flat set with
+ * `scu_flat_set_free()` when it is no longer needed.
+ *
+ * @param[in] flatSet The flat set to clone.
+ * @return A pointer to the cloned flat set, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuFlatSet* scu_flat_set_clone(const ScuFlatSet* flatSet);
+
+/**
+ * @brief Returns the number of elements of a specified flat set.
+ *
+ * @param[in] flatSet The flat set to examine.
+ * @return The number of elements of the specified flat set.
+ */
+Scuisize scu_flat_set_count(const ScuFlatSet* flatSet);
+
+/**
+ * @brief Returns the memory layout of a specified flat set.
+ *
+ * @param[in] flatSet The flat set to examine.
+ * @return The memory layout of the specified flat set.
+ */
+ScuFlatLayout scu_flat_set_layout(const ScuFlatSet* flatSet);
+
+/**
+ * @brief Returns a pointer to the element at a specified position of a
+ * specified flat set.
+ *
+ * @warning The behavior is undefined if `position` is not in the range
+ * `[0, scu_flat_set_count(flatSet))`.
+ *
+ * @param[in] flatSet  The flat set to examine.
+ * @param[in] position The position of the element.
+ * @return A pointer to the element at the specified position.
+ */
+const void* scu_flat_set_at(const ScuFlatSet* flatSet, Scuisize position);
+
+/**
+ * @brief Determines whether an element is present in a specified flat set.
+ *
+ * @param[in] flatSet The flat set to search.
+ * @param[in] elem    The element to search for.
+ * @return `true` if the element is present in the flat set, otherwise `false`.
+ */
+bool scu_flat_set_contains(
+    const ScuFlatSet* restrict flatSet,
+    const void* restrict elem
+);
+
+/**
+ * @brief Returns the position of an element in a specified flat set.
+ *
+ * @param[in] flatSet The flat set to search.
+ * @param[in] elem    The element to search for.
+ * @return The position of the element, or `-1` if it is not present.
+ */
+Scuisize scu_flat_set_find(
+    const ScuFlatSet* restrict flatSet,
+    const void* restrict elem
+);
+
+/**
+ * @brief Returns the position of the smallest element of a specified flat set
+ * that is not less than a specified key.
+ *
+ * @note The comparison function is always called with an element of the flat
+ * set as its first and `key` as its second argument.
+ *
+ * @param[in] flatSet The flat set to search.
+ * @param[in] key     The key to search for.
+ * @return The position of the smallest element not less than `key`, or `-1` if
+ * there is no such element.
+ */
+Scuisize scu_flat_set_lower_bound(
+    const ScuFlatSet* restrict flatSet,
+    const void* restrict key
+);
+
+/**
+ * @brief Returns the position of the smallest element of a specified flat set
+ * that is greater than a specified key.
+ *
+ * @note The comparison function is always called with an element of the flat
+ * set as its first and `key` as its second argument.
+ *
+ * @param[in] flatSet The flat set to search.
+ * @param[in] key     The key to search for.
+ * @return The position of the smallest element greater than `key`, or `-1` if
+ * there is no such element.
+ */
+Scuisize scu_flat_set_upper_bound(
+    const ScuFlatSet* restrict flatSet,
+    const void* restrict key
+);
+
+/**
+ * @brief Returns the position of the smallest element of a specified flat set.
+ *
+ * @param[in] flatSet The flat set to examine.
+ * @return The position of the smallest element, or `-1` if the flat set is
+ * empty.
+ */
+Scuisize scu_flat_set_first(const ScuFlatSet* flatSet);
+
+/**
+ * @brief Returns the position of the element following the element at a
+ * specified position of a specified flat set in ascending order.
+ *
+ * @warning The behavior is undefined if `position` is not in the range
+ * `[0, scu_flat_set_count(flatSet))`.
+ *
+ * @param[in] flatSet  The flat set to examine.
+ * @param[in] position The position of the current element.
+ * @return The position of the next element, or `-1` if the current element is
+ * the largest one.
+ */
+Scuisize scu_flat_set_next(const ScuFlatSet* flatSet, Scuisize position);
+
+/**
+ * @brief Deallocates a specified flat set.
+ *
+ * @note If `flatSet` is a `nullptr`, this function does nothing.
+ *
+ * @warning This function only deallocates the memory occupied by the flat set
+ * itself, but not the elements contained within. The caller is responsible for
+ * deallocating the individual elements if they are pointers to dynamically
+ * allocated objects and no other references to them exist.
+ *
+ * The behavior is undefined if the flat set is used after it has been
+ * deallocated.
+ *
+ * @param[in, out] flatSet The flat set to deallocate.
+ */
+void scu_flat_set_free(ScuFlatSet* flatSet);
+
+/**
+ * @brief Iterates over the positions of the elements of a specified flat set in
+ * ascending order of the elements.
+ *
+ * The following example demonstrates the basic usage of this macro:
+ *
+ * ```c
+ * ScuFlatSet* keywords = scu_flat_set_new(...);
+ * ...
+ * Scuisize position;
+ * SCU_FLAT_SET_FOREACH(position, keywords) {
+ *     const char* const* keyword = scu_flat_set_at(keywords, position);
+ *     // Do something with *keyword.
+ * }
+ * ```
+ *
+ * @note The variable `position` must be declared manually before the loop. It
+ * must be of type `Scuisize`.
+ *
+ * @param[out] position The position of the current element during each
+ *                      iteration.
+ * @param[in]  flatSet  The flat set to iterate over.
+ */
+#define SCU_FLAT_SET_FOREACH(position, flatSet)               \
+    for (                                                     \
+        (position) = scu_flat_set_first(flatSet);             \
+        (position) >= 0;                                      \
+        (position) = scu_flat_set_next((flatSet), (position)) \
+    )
+
+#endif
\ No newline at end of file
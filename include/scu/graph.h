@@ -0,0 +1,215 @@
+#ifndef SCU_GRAPH_H
+#define SCU_GRAPH_H
+
+#include "scu/error.h"
+#include "scu/types.h"
+
+/**
+ * @brief Represents an immutable directed graph in compressed sparse row (CSR)
+ * form.
+ *
+ * The vertices are identified by the indices `0` to `vertexCount - 1`. The
+ * outgoing edges of all vertices are stored in a single adjacency array, in
+ * which the edges of each vertex occupy a contiguous range described by an
+ * array of offsets. Optionally, each edge is associated with a weight stored
+ * in a parallel array.
+ *
+ * @note Undirected graphs are represented by adding each edge in both
+ * directions.
+ */
+typedef struct ScuGraph ScuGraph;
+
+/**
+ * @brief Allocates and initializes a new graph with a specified number of
+ * vertices from a specified list of edges.
+ *
+ * The edge with index `i` leads from vertex `sources[i]` to vertex
+ * `targets[i]`. The edges are sorted by their source vertex using a counting
+ * sort, which runs in linear time and preserves the relative order of the
+ * outgoing edges of each vertex.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the graph with
+ * `scu_graph_free()` when it is no longer needed.
+ *
+ * The behavior is undefined if any source or target is not a valid vertex.
+ *
+ * @param[in] vertexCount The number of vertices.
+ * @param[in] edgeCount   The number of edges.
+ * @param[in] sources     The source vertex of each edge.
+ * @param[in] targets     The target vertex of each edge.
+ * @param[in] weights     The weight of each edge, or `nullptr` to create an
+ *                        unweighted graph.
+ * @return A pointer to the new graph, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuGraph* scu_graph_new(
+    Scuisize vertexCount,
+    Scuisize edgeCount,
+    const Scuisize* sources,
+    const Scuisize* targets,
+    const Scuf64* weights
+);
+
+/**
+ * @brief Creates the transpose of a specified graph, i.e., a graph with the
+ * same vertices in which the direction of each edge is reversed.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the transposed graph with
+ * `scu_graph_free()` when it is no longer needed.
+ *
+ * @param[in] graph The graph to transpose.
+ * @return A pointer to the transposed graph, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuGraph* scu_graph_transpose(const ScuGraph* graph);
+
+/**
+ * @brief Returns the number of vertices of a specified graph.
+ *
+ * @param[in] graph The graph to examine.
+ * @return The number of vertices of the specified graph.
+ */
+Scuisize scu_graph_vertex_count(const ScuGraph* graph);
+
+/**
+ * @brief Returns the number of edges of a specified graph.
+ *
+ * @param[in] graph The graph to examine.
+ * @return The number of edges of the specified graph.
+ */
+Scuisize scu_graph_edge_count(const ScuGraph* graph);
+
+/**
+ * @brief Determines whether a specified graph has edge weights.
+ *
+ * @param[in] graph The graph to examine.
+ * @return `true` if the graph has edge weights, otherwise `false`.
+ */
+bool scu_graph_is_weighted(const ScuGraph* graph);
+
+/**
+ * @brief Returns the number of outgoing edges of a vertex in a specified graph.
+ *
+ * @warning The behavior is undefined if `vertex` is not a valid vertex.
+ *
+ * @param[in] graph  The graph to examine.
+ * @param[in] vertex The vertex to examine.
+ * @return The number of outgoing edges of the specified vertex.
+ */
+Scuisize scu_graph_degree(const ScuGraph* graph, Scuisize vertex);
+
+/**
+ * @brief Returns the targets of the outgoing edges of a vertex in a specified
+ * graph.
+ *
+ * @warning The returned array contains `scu_graph_degree()` elements. The
+ * behavior is undefined if `vertex` is not a valid vertex.
+ *
+ * @param[in] graph  The graph to examine.
+ * @param[in] vertex The vertex to examine.
+ * @return A pointer to the targets of the outgoing edges of the vertex.
+ */
+const Scuisize* scu_graph_neighbors(const ScuGraph* graph, Scuisize vertex);
+
+/**
+ * @brief Returns the weights of the outgoing edges of a vertex in a specified
+ * graph.
+ *
+ * @warning The returned array contains `scu_graph_degree()` elements, which
+ * correspond to the targets returned by `scu_graph_neighbors()`. The behavior
+ * is undefined if `vertex` is not a valid vertex.
+ *
+ * @param[in] graph  The graph to examine.
+ * @param[in] vertex The vertex to examine.
+ * @return A pointer to the weights of the outgoing edges of the vertex, or a
+ * `nullptr` if the graph is unweighted.
+ */
+const Scuf64* scu_graph_weights(const ScuGraph* graph, Scuisize vertex);
+
+/**
+ * @brief Performs a breadth-first search in a specified graph and computes the
+ * number of edges on a shortest path from a source vertex to every vertex.
+ *
+ * The search is direction-optimizing: levels with a small frontier are
+ * expanded top-down by visiting the outgoing edges of the frontier, whereas
+ * levels with a large frontier are expanded bottom-up by letting each
+ * unvisited vertex search its incoming edges for a parent in the frontier. The
+ * latter requires the transpose of the graph, which is passed as `reverse`.
+ *
+ * Each level is expanded by up to `threadCount` threads, including the calling
+ * thread.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The behavior is undefined if `source` is not a valid vertex, or if
+ * `reverse` is neither a `nullptr` nor the transpose of `graph`.
+ *
+ * @param[in]  graph       The graph to search.
+ * @param[in]  reverse     The transpose of the graph (which may be the graph
+ *                         itself if it is undirected), or `nullptr` to only
+ *                         expand levels top-down.
+ * @param[in]  source      The vertex to start the search from.
+ * @param[in]  threadCount The maximum number of threads to use, which must be
+ *                         at least one.
+ * @param[out] distances   An array of `scu_graph_vertex_count()` elements that
+ *                         receives the distance of each vertex from the
+ *                         source, or `-1` if the vertex is unreachable.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_graph_bfs(
+    const ScuGraph* graph,
+    const ScuGraph* reverse,
+    Scuisize source,
+    Scuisize threadCount,
+    Scuisize* distances
+);
+
+/**
+ * @brief Computes the lengths of the shortest paths from a source vertex to
+ * every vertex in a specified graph using Dijkstra's algorithm.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`. Each
+ * edge of an unweighted graph is considered to have a weight of `1.0`.
+ *
+ * @warning The behavior is undefined if `source` is not a valid vertex, or if
+ * any edge has a negative or NaN weight.
+ *
+ * @param[in]  graph        The graph to search.
+ * @param[in]  source       The vertex to start the search from.
+ * @param[out] distances    An array of `scu_graph_vertex_count()` elements that
+ *                          receives the length of a shortest path from the
+ *                          source to each vertex, or `INFINITY` if the vertex
+ *                          is unreachable.
+ * @param[out] predecessors An array of `scu_graph_vertex_count()` elements
+ *                          that receives the predecessor of each vertex on a
+ *                          shortest path, or `-1` for the source and
+ *                          unreachable vertices. May be a `nullptr` if the
+ *                          predecessors are not needed.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_graph_shortest_paths(
+    const ScuGraph* restrict graph,
+    Scuisize source,
+    Scuf64* restrict distances,
+    Scuisize* restrict predecessors
+);
+
+/**
+ * @brief Deallocates a specified graph.
+ *
+ * @note If `graph` is a `nullptr`, this function does nothing.
+ *
+ * @warning The behavior is undefined if the graph is used after it has been
+ * deallocated.
+ *
+ * @param[in, out] graph The graph to deallocate.
+ */
+void scu_graph_free(ScuGraph* graph);
+
+#endif
\ No newline at end of file
@@ -253,6 +253,81 @@ Scuusize scu_hash_bytes(const void* block, Scuisize count);
  */
 Scuusize scu_hash_str(const void* value);
 
+/**
+ * @brief Computes the hashes of an array of `Scuu32` values.
+ *
+ * For every index `i` in `[0, count)`, `hashes[i]` is set to the same value
+ * `scu_hash_u32(&values[i])` would return. In contrast to calling the scalar
+ * function in a loop, this function avoids an indirect call per value and
+ * processes multiple values at once using SIMD instructions where available
+ * (e.g., AVX2 on x86-64 processors supporting it, which is detected at runtime
+ * when compiling with GCC or Clang).
+ *
+ * @note If `count` is zero, `values` and `hashes` are ignored (each may even be
+ * a `nullptr`).
+ *
+ * @warning The behavior is undefined if `values` or `hashes` does not point to
+ * an array of at least `count` elements, or if the two arrays overlap.
+ *
+ * @param[in]  values The values to hash.
+ * @param[out] hashes The array to store the hashes in.
+ * @param[in]  count  The number of values to hash.
+ */
+void scu_hash_u32_batch(
+    const Scuu32* restrict values,
+    Scuusize* restrict hashes,
+    Scuisize count
+);
+
+/**
+ * @brief Computes the hashes of an array of `Scuu64` values.
+ *
+ * For every index `i` in `[0, count)`, `hashes[i]` is set to the same value
+ * `scu_hash_u64(&values[i])` would return. In contrast to calling the scalar
+ * function in a loop, this function avoids an indirect call per value and
+ * processes multiple values at once using SIMD instructions where available
+ * (e.g., AVX2 on x86-64 processors supporting it, which is detected at runtime
+ * when compiling with GCC or Clang).
+ *
+ * @note If `count` is zero, `values` and `hashes` are ignored (each may even be
+ * a `nullptr`).
+ *
+ * @warning The behavior is undefined if `values` or `hashes` does not point to
+ * an array of at least `count` elements, or if the two arrays overlap.
+ *
+ * @param[in]  values The values to hash.
+ * @param[out] hashes The array to store the hashes in.
+ * @param[in]  count  The number of values to hash.
+ */
+void scu_hash_u64_batch(
+    const Scuu64* restrict values,
+    Scuusize* restrict hashes,
+    Scuisize count
+);
+
+/**
+ * @brief Computes the hashes of an array of `Scui64` values.
+ *
+ * For every index `i` in `[0, count)`, `hashes[i]` is set to the same value
+ * `scu_hash_i64(&values[i])` would return. See `scu_hash_u64_batch()` for more
+ * information.
+ *
+ * @note If `count` is zero, `values` and `hashes` are ignored (each may even be
+ * a `nullptr`).
+ *
+ * @warning The behavior is undefined if `values` or `hashes` does not point to
+ * an array of at least `count` elements, or if the two arrays overlap.
+ *
+ * @param[in]  values The values to hash.
+ * @param[out] hashes The array to store the hashes in.
+ * @param[in]  count  The number of values to hash.
+ */
+void scu_hash_i64_batch(
+    const Scui64* restrict values,
+    Scuusize* restrict hashes,
+    Scuisize count
+);
+
 /**
  * @brief Combines a hash with a specified accumulator hash.
  *
@@ -0,0 +1,174 @@
+#ifndef SCU_HEAVY_HITTERS_H
+#define SCU_HEAVY_HITTERS_H
+
+#include "scu/equal.h"
+#include "scu/hash.h"
+#include "scu/types.h"
+
+/**
+ * @brief Represents a tracker for the most frequent elements of a stream.
+ *
+ * The tracker implements the Space-Saving algorithm: it monitors a fixed number
+ * of elements (its capacity), and when an unmonitored element arrives while the
+ * tracker is full, it replaces the monitored element with the lowest count. The
+ * new element inherits that count as its potential overestimation (error).
+ *
+ * Every element whose true frequency exceeds `total / capacity` is guaranteed
+ * to be monitored, where `total` is the sum of all counts added. For each
+ * monitored element, the reported count is an upper bound and `count - error`
+ * is a lower bound of its true frequency.
+ */
+typedef struct ScuHeavyHitters ScuHeavyHitters;
+
+/** @brief Represents a monitored element of a heavy hitters tracker. */
+typedef struct ScuHeavyHitter {
+
+    /**
+     * @brief A pointer to the element.
+     *
+     * @note The element is owned by the tracker and only valid until the next
+     * modification of the tracker.
+     */
+    const void* elem;
+
+    /** @brief An upper bound of the number of occurrences of the element. */
+    Scuu64 count;
+
+    /** @brief The maximum overestimation of `count`. */
+    Scuu64 error;
+
+} ScuHeavyHitter;
+
+/**
+ * @brief Allocates and initializes a new heavy hitters tracker with a specified
+ * element size, capacity, hash function and equality function.
+ *
+ * @note All memory required by the tracker is allocated upfront, so adding
+ * elements never allocates memory.
+ *
+ * This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the tracker with
+ * `scu_heavy_hitters_free()` when it is no longer needed.
+ *
+ * @param[in] elemSize  The size of each element (in bytes).
+ * @param[in] capacity  The maximum number of monitored elements.
+ * @param[in] hashFunc  A function used for hashing elements.
+ * @param[in] equalFunc A function used for comparing elements for equality.
+ * @return A pointer to the new tracker, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuHeavyHitters* scu_heavy_hitters_new(
+    Scuisize elemSize,
+    Scuisize capacity,
+    ScuHashFunc* hashFunc,
+    ScuEqualFunc* equalFunc
+);
+
+/**
+ * @brief Returns the capacity of a specified heavy hitters tracker, i.e., the
+ * maximum number of monitored elements.
+ *
+ * @param[in] heavyHitters The tracker to examine.
+ * @return The capacity of the specified tracker.
+ */
+Scuisize scu_heavy_hitters_capacity(const ScuHeavyHitters* heavyHitters);
+
+/**
+ * @brief Returns the number of monitored elements of a specified heavy hitters
+ * tracker.
+ *
+ * @param[in] heavyHitters The tracker to examine.
+ * @return The number of monitored elements of the specified tracker.
+ */
+Scuisize scu_heavy_hitters_count(const ScuHeavyHitters* heavyHitters);
+
+/**
+ * @brief Returns the sum of all counts added to a specified heavy hitters
+ * tracker.
+ *
+ * @param[in] heavyHitters The tracker to examine.
+ * @return The sum of all counts added to the specified tracker.
+ */
+Scuu64 scu_heavy_hitters_total(const ScuHeavyHitters* heavyHitters);
+
+/**
+ * @brief Adds a number of occurrences of an element to a specified heavy
+ * hitters tracker.
+ *
+ * @note Counts saturate at `SCU_U64_MAX` instead of wrapping around.
+ *
+ * @warning If the element is not monitored yet and the tracker is full, the
+ * monitored element with the lowest count is evicted. Any pointers to it (e.g.,
+ * obtained with `scu_heavy_hitters_top()`) are invalidated.
+ *
+ * @param[in, out] heavyHitters The tracker to add the occurrences to.
+ * @param[in]      elem         The element to add.
+ * @param[in]      count        The number of occurrences to add.
+ */
+void scu_heavy_hitters_add(
+    ScuHeavyHitters* restrict heavyHitters,
+    const void* restrict elem,
+    Scuu64 count
+);
+
+/**
+ * @brief Tries to get the monitoring information of an element of a specified
+ * heavy hitters tracker.
+ *
+ * @param[in]  heavyHitters The tracker to search.
+ * @param[in]  elem         The element to search for.
+ * @param[out] hitter       The monitoring information of the element (only
+ *                          modified if the element is monitored).
+ * @return `true` if the element is monitored, otherwise `false`.
+ */
+bool scu_heavy_hitters_try_get(
+    const ScuHeavyHitters* restrict heavyHitters,
+    const void* restrict elem,
+    ScuHeavyHitter* restrict hitter
+);
+
+/**
+ * @brief Retrieves the monitored elements with the highest counts of a
+ * specified heavy hitters tracker.
+ *
+ * The elements are stored in `hitters` in order of descending count. Ties are
+ * broken in an unspecified order.
+ *
+ * @param[in]  heavyHitters The tracker to examine.
+ * @param[out] hitters      The array to store the elements in.
+ * @param[in]  count        The maximum number of elements to retrieve.
+ * @return The number of elements stored in `hitters`, which is the smaller of
+ * `count` and the number of monitored elements.
+ */
+Scuisize scu_heavy_hitters_top(
+    const ScuHeavyHitters* restrict heavyHitters,
+    ScuHeavyHitter* restrict hitters,
+    Scuisize count
+);
+
+/**
+ * @brief Removes all elements from a specified heavy hitters tracker.
+ *
+ * @param[in, out] heavyHitters The tracker to clear.
+ */
+void scu_heavy_hitters_clear(ScuHeavyHitters* heavyHitters);
+
+/**
+ * @brief Deallocates a specified heavy hitters tracker.
+ *
+ * @note If `heavyHitters` is a `nullptr`, this function does nothing.
+ *
+ * @warning This function only deallocates the memory occupied by the tracker
+ * itself, but not the elements monitored within. The caller is responsible for
+ * deallocating the individual elements if they are pointers to dynamically
+ * allocated objects and no other references to them exist.
+ *
+ * The behavior is undefined if the tracker is used after it has been
+ * deallocated.
+ *
+ * @param[in, out] heavyHitters The tracker to deallocate.
+ */
+void scu_heavy_hitters_free(ScuHeavyHitters* heavyHitters);
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef SCU_HYPER_LOG_LOG_H
+#define SCU_HYPER_LOG_LOG_H
+
+#include "scu/error.h"
+#include "scu/hash.h"
+#include "scu/types.h"
+
+/**
+ * @brief Represents a probabilistic estimator for the number of distinct
+ * elements in a multiset.
+ *
+ * A HyperLogLog sketch uses `2^precision` registers, each storing the maximum
+ * number of leading zeros observed among the hashes mapped to it. The relative
+ * standard error of the estimate is approximately `1.04 / sqrt(2^precision)`,
+ * e.g., about 1.6% for a precision of 12 (using 4 KiB of memory) and about 0.8%
+ * for a precision of 14 (using 16 KiB of memory).
+ *
+ * To keep sketches of small multisets both small and accurate, a sketch starts
+ * out with a sparse representation, which only stores the registers that were
+ * actually updated (at a higher internal precision). Once the sparse
+ * representation would need more memory than the dense one, the sketch is
+ * converted to the dense representation automatically.
+ */
+typedef struct ScuHyperLogLog ScuHyperLogLog;
+
+/** @brief The minimum precision of a HyperLogLog sketch. */
+#define SCU_HYPER_LOG_LOG_MIN_PRECISION 4
+
+/** @brief The maximum precision of a HyperLogLog sketch. */
+#define SCU_HYPER_LOG_LOG_MAX_PRECISION 18
+
+/**
+ * @brief Allocates and initializes a new, empty HyperLogLog sketch with a
+ * specified precision and hash function.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the sketch with
+ * `scu_hyper_log_log_free()` when it is no longer needed.
+ *
+ * The behavior is undefined if `precision` is not in the range
+ * `[SCU_HYPER_LOG_LOG_MIN_PRECISION, SCU_HYPER_LOG_LOG_MAX_PRECISION]`.
+ *
+ * @param[in] precision The precision, i.e., the base-2 logarithm of the number
+ *                      of registers.
+ * @param[in] hashFunc  A function used for hashing elements.
+ * @return A pointer to the new sketch, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuHyperLogLog* scu_hyper_log_log_new(
+    Scuisize precision,
+    ScuHashFunc* hashFunc
+);
+
+/**
+ * @brief Creates a copy of a specified HyperLogLog sketch.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the cloned sketch with
+ * `scu_hyper_log_log_free()` when it is no longer needed.
+ *
+ * @param[in] hll The sketch to clone.
+ * @return A pointer to the cloned sketch, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuHyperLogLog* scu_hyper_log_log_clone(const ScuHyperLogLog* hll);
+
+/**
+ * @brief Returns the precision of a specified HyperLogLog sketch.
+ *
+ * @param[in] hll The sketch to examine.
+ * @return The precision of the specified sketch.
+ */
+Scuisize scu_hyper_log_log_precision(const ScuHyperLogLog* hll);
+
+/**
+ * @brief Adds an element to a specified HyperLogLog sketch.
+ *
+ * @note This function dynamically allocates memory using `scu_realloc()` and
+ * `scu_calloc()` while the sketch uses the sparse representation.
+ *
+ * @param[in, out] hll  The sketch to add the element to.
+ * @param[in]      elem The element to add.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred
+ * (in which case the sketch is left unchanged), or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_hyper_log_log_add(
+    ScuHyperLogLog* restrict hll,
+    const void* restrict elem
+);
+
+/**
+ * @brief Adds an element with a precomputed hash to a specified HyperLogLog
+ * sketch.
+ *
+ * @note This function is useful in combination with the batch hashing functions
+ * (e.g., `scu_hash_u64_batch()`), and is equivalent to calling
+ * `scu_hyper_log_log_add()` with an element the hash function of the sketch
+ * maps to `hash`.
+ *
+ * This function dynamically allocates memory using `scu_realloc()` and
+ * `scu_calloc()` while the sketch uses the sparse representation.
+ *
+ * @param[in, out] hll  The sketch to add the element to.
+ * @param[in]      hash The hash of the element to add.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred
+ * (in which case the sketch is left unchanged), or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_hyper_log_log_add_hash(ScuHyperLogLog* hll, Scuusize hash);
+
+/**
+ * @brief Estimates the number of distinct elements added to a specified
+ * HyperLogLog sketch.
+ *
+ * The estimate is computed with the improved estimator by Otmar Ertl, which
+ * corrects the bias of the original HyperLogLog estimator for both small and
+ * large cardinalities without relying on empirically determined bias tables or
+ * switching to linear counting.
+ *
+ * @param[in] hll The sketch to examine.
+ * @return The estimated number of distinct elements.
+ */
+Scuf64 scu_hyper_log_log_estimate(const ScuHyperLogLog* hll);
+
+/**
+ * @brief Merges the elements of a HyperLogLog sketch into another one.
+ *
+ * After a successful merge, `dest` estimates the number of distinct elements
+ * added to either `dest` or `src` (i.e., the cardinality of the union).
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()` and
+ * `scu_calloc()`.
+ *
+ * @warning The behavior is undefined if the sketches do not have the same
+ * precision or do not use the same hash function.
+ *
+ * @param[in, out] dest The sketch to merge into.
+ * @param[in]      src  The sketch to merge from.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred
+ * (in which case `dest` is left unchanged), or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_hyper_log_log_merge(
+    ScuHyperLogLog* restrict dest,
+    const ScuHyperLogLog* restrict src
+);
+
+/**
+ * @brief Removes all elements from a specified HyperLogLog sketch.
+ *
+ * @note The sketch returns to the sparse representation, releasing the memory
+ * occupied by the dense representation (if any).
+ *
+ * @param[in, out] hll The sketch to clear.
+ */
+void scu_hyper_log_log_clear(ScuHyperLogLog* hll);
+
+/**
+ * @brief Deallocates a specified HyperLogLog sketch.
+ *
+ * @note If `hll` is a `nullptr`, this function does nothing.
+ *
+ * @warning The behavior is undefined if the sketch is used after it has been
+ * deallocated.
+ *
+ * @param[in, out] hll The sketch to deallocate.
+ */
+void scu_hyper_log_log_free(ScuHyperLogLog* hll);
+
+#endif
@@ -24,6 +24,90 @@ typedef enum ScuSeekOrigin {
 
 } ScuSeekOrigin;
 
+/** @brief Represents a buffering mode of a file stream. */
+typedef enum ScuBufferMode {
+
+    /**
+     * @brief Indicates that data is written to the underlying file once the
+     * buffer is full, and read from it in blocks of the buffer size.
+     */
+    SCU_BUFFER_MODE_FULL,
+
+    /**
+     * @brief Indicates that output is additionally written to the underlying
+     * file whenever a newline is written.
+     */
+    SCU_BUFFER_MODE_LINE,
+
+    /** @brief Indicates that data is not buffered at all. */
+    SCU_BUFFER_MODE_NONE
+
+} ScuBufferMode;
+
+/**
+ * @brief Represents a buffer used by vectored reads and writes, which transfer
+ * data between a file stream and multiple buffers at once.
+ */
+typedef struct ScuIoVec {
+
+    /** @brief The buffer to read into or write from. */
+    void* buffer;
+
+    /** @brief The size of the buffer (in bytes). */
+    Scuisize count;
+
+} ScuIoVec;
+
+/** @brief Represents a file (or a range of a file) mapped into memory. */
+typedef struct ScuMappedFile ScuMappedFile;
+
+/** @brief Represents a mode for mapping a file into memory. */
+typedef enum ScuMapMode {
+
+    /** @brief Indicates to map a file for reading only. */
+    SCU_MAP_MODE_READ,
+
+    /**
+     * @brief Indicates to map a file for reading and writing. Modifications
+     * are carried through to the underlying file.
+     */
+    SCU_MAP_MODE_READ_WRITE
+
+} ScuMapMode;
+
+/** @brief Represents a hint about how a mapped file is going to be accessed. */
+typedef enum ScuMapAdvice {
+
+    /** @brief Indicates that no particular access pattern is expected. */
+    SCU_MAP_ADVICE_NORMAL,
+
+    /**
+     * @brief Indicates that the mapped file is going to be accessed
+     * sequentially, so pages can be read ahead aggressively and released soon
+     * after they have been accessed.
+     */
+    SCU_MAP_ADVICE_SEQUENTIAL,
+
+    /**
+     * @brief Indicates that the mapped file is going to be accessed in random
+     * order, so reading ahead is of little use.
+     */
+    SCU_MAP_ADVICE_RANDOM,
+
+    /**
+     * @brief Indicates that the whole mapped file is going to be accessed
+     * soon, so reading it in can be started right away.
+     */
+    SCU_MAP_ADVICE_WILL_NEED,
+
+    /**
+     * @brief Indicates that the mapped file should be backed by huge pages
+     * where possible, which reduces the number of TLB misses.
+     */
+    SCU_MAP_ADVICE_HUGE_PAGE
+
+} ScuMapAdvice;
+
 /**
  * @brief Returns a pointer to a file stream associated with the standard input
  * stream.
@@ -167,6 +251,103 @@ ScuError scu_fopen(
  */
 ScuError scu_fopentmp(ScuFile** file);
 
+/**
+ * @brief Opens a file stream over a buffer in memory.
+ *
+ * The file stream reads from and writes to `buffer` instead of a file, so all
+ * other functions operating on file streams can be used without touching the
+ * disk. The file stream never grows beyond `size` bytes. The `mode` string is
+ * interpreted as for `scu_fopen()`; in particular, `"r"` and `"r+"` start with
+ * the current contents of the buffer, while `"w"` and `"w+"` start empty.
+ *
+ * @note This function is backed by `fmemopen()`, which null-terminates the
+ * contents written to the buffer when space permits. It is not available on
+ * Windows, where it always fails.
+ *
+ * This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning If the operation succeeds, the file stream returned via `*file` must
+ * be closed with `scu_fclose()` to properly release any associated resources.
+ * The buffer must remain valid until then.
+ *
+ * @param[out]     file   A pointer to a file stream associated with the
+ *                        buffer, or `nullptr` on failure.
+ * @param[in, out] buffer The buffer to read from and write to.
+ * @param[in]      size   The size of the buffer (in bytes), which must be at
+ *                        least one.
+ * @param[in]      mode   An `fopen()`-style mode string that specifies the
+ *                        mode in which to open the file stream.
+ * @return `SCU_ERROR_OPENING_FILE` if the file stream could not be opened,
+ * `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_fopenmem(
+    ScuFile* restrict* restrict file,
+    void* restrict buffer,
+    Scuisize size,
+    const char* restrict mode
+);
+
+/**
+ * @brief Opens a file stream for writing to a dynamically growing buffer in
+ * memory.
+ *
+ * Whenever the file stream is flushed or closed, `*buffer` and `*size` are
+ * updated to the current contents of the buffer and their size (excluding a
+ * terminating null character, which is always appended). The buffer grows
+ * automatically as data is written.
+ *
+ * @note This function is backed by `open_memstream()`. It is not available on
+ * Windows, where it always fails.
+ *
+ * This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning If the operation succeeds, the file stream returned via `*file` must
+ * be closed with `scu_fclose()` to properly release any associated resources.
+ * Afterwards, the caller is responsible for deallocating `*buffer`. As it is
+ * allocated by the C library, it must be deallocated with `free()` rather than
+ * `scu_free()`. The behavior is undefined if `*buffer` or `*size` is accessed
+ * before the file stream has been flushed or closed.
+ *
+ * @param[out] file   A pointer to a write-only file stream associated with
+ *                    the buffer, or `nullptr` on failure.
+ * @param[out] buffer A pointer to the buffer.
+ * @param[out] size   A pointer to the size of the buffer (in bytes).
+ * @return `SCU_ERROR_OPENING_FILE` if the file stream could not be opened,
+ * `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_fopen_dynamic(
+    ScuFile* restrict* restrict file,
+    char** restrict buffer,
+    Scuisize* restrict size
+);
+
+/**
+ * @brief Creates and opens an anonymous file residing in memory.
+ *
+ * On Linux, the file is created with `memfd_create()`, so it lives entirely in
+ * memory but still has a file descriptor, i.e., it can be passed to
+ * `scu_fcopy()`, read positionally or mapped via `scu_fileno()`.
+ * Elsewhere, this function falls back to creating a temporary file as if by
+ * calling `scu_fopentmp()`. In both cases, the file is opened in binary update
+ * mode and removed automatically once it is closed.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning If the operation succeeds, the file stream returned via `*file` must
+ * be closed with `scu_fclose()` to properly release any associated resources.
+ *
+ * @param[out] file A pointer to a file stream associated with the file, or
+ *                  `nullptr` on failure.
+ * @param[in]  name A name for the file, which is only used for debugging
+ *                  purposes (e.g., in `/proc/self/fd` on Linux).
+ * @return `SCU_ERROR_OPENING_FILE` if an error occurred while creating or
+ * opening the file, `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition
+ * occurred, or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_fopen_memfd(ScuFile** file, const char* name);
+
 /**
  * @brief Reopens a file stream with a specified name and mode.
  *
@@ -258,6 +439,57 @@ ScuError scu_fclose(ScuFile* file);
  */
 ScuError scu_fflush(ScuFile* file);
 
+/**
+ * @brief Sets the buffering mode and buffer size of a specified file stream.
+ *
+ * Larger buffers reduce the number of system calls needed to read or write a
+ * file, which pays off for streams processed in many small pieces.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()` unless
+ * `mode` is `SCU_BUFFER_MODE_NONE`. The buffer is owned by the file stream and
+ * released when it is closed.
+ *
+ * @warning This function must be called after opening the file stream but
+ * before any other operation is performed on it.
+ *
+ * @param[in, out] file The file stream to modify.
+ * @param[in]      size The size of the buffer (in bytes), which must be at
+ *                      least one. It is ignored if `mode` is
+ *                      `SCU_BUFFER_MODE_NONE`.
+ * @param[in]      mode The buffering mode.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if the buffer could not be allocated or
+ * installed, or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_fsetbuf(ScuFile* file, Scuisize size, ScuBufferMode mode);
+
+/**
+ * @brief Acquires the lock of a specified file stream, waiting until it is
+ * available.
+ *
+ * Each operation on a file stream acquires and releases its lock internally.
+ * Holding the lock explicitly allows a batch of operations to be performed
+ * atomically with respect to other threads, and is required by the
+ * `_unlocked` variants of the read and write functions, which skip the
+ * internal locking.
+ *
+ * @note The lock is recursive, i.e., it may be acquired multiple times by the
+ * same thread, and must then be released as many times.
+ *
+ * @param[in, out] file The file stream to lock.
+ */
+void scu_flock(ScuFile* file);
+
+/**
+ * @brief Releases the lock of a specified file stream acquired with
+ * `scu_flock()`.
+ *
+ * @warning The behavior is undefined if the calling thread does not hold the
+ * lock of the file stream.
+ *
+ * @param[in, out] file The file stream to unlock.
+ */
+void scu_funlock(ScuFile* file);
+
 /**
  * @brief Removes a file with a specified name.
  *
@@ -283,6 +515,65 @@ ScuError scu_fremove(const char* name);
  */
 ScuError scu_frename(const char* oldName, const char* newName);
 
+/**
+ * @brief Copies a range of bytes from one file stream to another.
+ *
+ * The bytes are read from `source` starting at `offset`, independently of its
+ * file position indicator, and written to `destination` at its current file
+ * position, which is advanced accordingly. Where possible, the data is copied
+ * within the kernel without passing through user space: on Linux, this
+ * function tries `copy_file_range()`, `sendfile()` and `splice()` in that
+ * order. Otherwise, it falls back to reading and writing large blocks.
+ *
+ * @note Both file streams are flushed before copying, so pending output to
+ * either of them is part of the copy or precedes it, respectively. The file
+ * position indicator of `source` is not affected.
+ *
+ * This function may dynamically allocate memory using `scu_malloc()` for the
+ * fallback, which is released before it returns.
+ *
+ * @warning If an error occurs, an unspecified number of bytes may already have
+ * been written to `destination`.
+ *
+ * @param[in, out] source      The file stream to copy from.
+ * @param[in, out] destination The file stream to copy to.
+ * @param[in]      offset      The offset within `source` to start copying at,
+ *                             which must be non-negative.
+ * @param[in]      count       The number of bytes to copy, or `-1` to copy up
+ *                             to the end of `source`. Copying stops early if
+ *                             the end of `source` is reached.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * `SCU_ERROR_FLUSHING_FILE` if an error occurred while flushing one of the
+ * file streams, `SCU_ERROR_READING_FILE` or `SCU_ERROR_WRITING_FILE` if an
+ * error occurred while copying, or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_fcopy(
+    ScuFile* restrict source,
+    ScuFile* restrict destination,
+    Scuisize offset,
+    Scuisize count
+);
+
+/**
+ * @brief Copies the contents of a file with a specified name to another file.
+ *
+ * The destination file is created if it does not exist, or truncated
+ * otherwise. The data is copied as if by `scu_fcopy()`, or with `CopyFile()`
+ * on Windows.
+ *
+ * @param[in] sourceName      The name of the file to copy from.
+ * @param[in] destinationName The name of the file to copy to.
+ * @return `SCU_ERROR_OPENING_FILE` if one of the files could not be opened,
+ * `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * `SCU_ERROR_READING_FILE` or `SCU_ERROR_WRITING_FILE` if an error occurred
+ * while copying, `SCU_ERROR_CLOSING_FILE` if one of the files could not be
+ * closed, or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_fcopy_path(
+    const char* restrict sourceName,
+    const char* restrict destinationName
+);
+
 /**
  * @brief Reads `count` objects of size `size` from a specified file stream into
  * a buffer.
@@ -312,6 +603,33 @@ Scuisize scu_fread(
     Scuisize size
 );
 
+/**
+ * @brief Reads `count` objects of size `size` from a specified file stream into
+ * a buffer without locking the file stream.
+ *
+ * @note Apart from not locking the file stream, this function behaves like
+ * `scu_fread()`. Where the C library offers no unlocked variant, the file
+ * stream is locked anyway, which is cheap while the caller holds the lock.
+ *
+ * @warning The calling thread must hold the lock of the file stream (see
+ * `scu_flock()`), or otherwise ensure that no other thread accesses it
+ * concurrently.
+ *
+ * @param[in, out] file   The file stream to read from.
+ * @param[out]     buffer The buffer to write the data to.
+ * @param[in]      count  The number of objects to read.
+ * @param[in]      size   The size of each object (in bytes).
+ * @return The number of objects read, which may be less than `count` if the
+ * end-of-file condition is reached or an error occurs while reading from the
+ * specified file stream.
+ */
+Scuisize scu_fread_unlocked(
+    ScuFile* restrict file,
+    void* restrict buffer,
+    Scuisize count,
+    Scuisize size
+);
+
 /**
  * @brief Reads `count` objects of size `size` from the standard input stream
  * into a buffer.
@@ -365,6 +683,32 @@ Scuisize scu_fwrite(
     Scuisize size
 );
 
+/**
+ * @brief Writes `count` objects of size `size` from a buffer to a specified
+ * file stream without locking the file stream.
+ *
+ * @note Apart from not locking the file stream, this function behaves like
+ * `scu_fwrite()`. Where the C library offers no unlocked variant, the file
+ * stream is locked anyway, which is cheap while the caller holds the lock.
+ *
+ * @warning The calling thread must hold the lock of the file stream (see
+ * `scu_flock()`), or otherwise ensure that no other thread accesses it
+ * concurrently.
+ *
+ * @param[in, out] file   The file stream to write to.
+ * @param[in]      buffer The buffer to read the data from.
+ * @param[in]      count  The number of objects to write.
+ * @param[in]      size   The size of each object (in bytes).
+ * @return The number of objects written, which may be less than `count` if an
+ * error occurs while writing to the specified file stream.
+ */
+Scuisize scu_fwrite_unlocked(
+    ScuFile* restrict file,
+    const void* restrict buffer,
+    Scuisize count,
+    Scuisize size
+);
+
 /**
  * @brief Writes `count` objects of size `size` from a buffer to the standard
  * output stream.
@@ -389,6 +733,125 @@ Scuisize scu_fwrite(
  */
 Scuisize scu_write(const void* buffer, Scuisize count, Scuisize size);
 
+/**
+ * @brief Reads from a specified file stream into multiple buffers at once.
+ *
+ * The buffers are filled in order, as if by reading into one buffer after
+ * another, but with few system calls and without copying the data through the
+ * buffer of the file stream.
+ *
+ * @note The file stream is locked for the duration of the call, and its file
+ * position indicator is advanced by the number of bytes read. If the file
+ * stream cannot be repositioned (e.g., a pipe), or on Windows, the buffers are
+ * read one after another through the buffer of the file stream, which sets the
+ * end-of-file and error indicators as `scu_fread()` does. Otherwise, the
+ * end-of-file and error indicators are not affected by reading, but pending
+ * output of the file stream is flushed first. If flushing fails, nothing is
+ * read and the error indicator of the file stream is set.
+ *
+ * @param[in, out] file   The file stream to read from.
+ * @param[in]      iov    The buffers to read into.
+ * @param[in]      count  The number of buffers.
+ * @return The number of bytes read, which may be less than the total size of
+ * the buffers if the end-of-file condition is reached or an error occurs while
+ * reading from the specified file stream.
+ */
+Scuisize scu_freadv(
+    ScuFile* restrict file,
+    const ScuIoVec* restrict iov,
+    Scuisize count
+);
+
+/**
+ * @brief Writes the contents of multiple buffers to a specified file stream at
+ * once.
+ *
+ * The buffers are written in order, as if by writing one buffer after another,
+ * but with few system calls and without copying the data into the buffer of
+ * the file stream. Pending output of the file stream is flushed first, so the
+ * order of all writes is preserved.
+ *
+ * @note The file stream is locked for the duration of the call, and its file
+ * position indicator is advanced by the number of bytes written. If flushing
+ * the pending output fails, nothing is written and the error indicator of the
+ * file stream is set. Otherwise, the error indicator is not affected by
+ * writing, except on Windows, where the buffers are written one after another
+ * through the buffer of the file stream as if by `scu_fwrite()`.
+ *
+ * @param[in, out] file   The file stream to write to.
+ * @param[in]      iov    The buffers to write.
+ * @param[in]      count  The number of buffers.
+ * @return The number of bytes written, which may be less than the total size
+ * of the buffers if an error occurs while writing to the specified file stream.
+ */
+Scuisize scu_fwritev(
+    ScuFile* restrict file,
+    const ScuIoVec* restrict iov,
+    Scuisize count
+);
+
+/**
+ * @brief Reads from a specified file stream at a specified offset.
+ *
+ * In contrast to `scu_fseek()` followed by `scu_fread()`, this function leaves
+ * the file position indicator and the buffer of the file stream alone, so
+ * multiple threads may read from the same file stream concurrently without
+ * serializing on it.
+ *
+ * @note The data is read directly from the underlying file, bypassing the
+ * buffer of the file stream. Pending output should therefore be flushed with
+ * `scu_fflush()` before reading data that has just been written. The
+ * end-of-file and error indicators of the file stream are not affected.
+ *
+ * On Windows, the file pointer of the underlying handle has to be restored
+ * after each read, so concurrent calls are serialized by locking the file
+ * stream.
+ *
+ * @param[in, out] file   The file stream to read from.
+ * @param[out]     buffer The buffer to read into.
+ * @param[in]      count  The number of bytes to read.
+ * @param[in]      offset The offset within the file to start reading at, which
+ *                        must be non-negative.
+ * @return The number of bytes read, which may be less than `count` if the end
+ * of the file is reached or an error occurs while reading from the specified
+ * file stream.
+ */
+Scuisize scu_fread_at(
+    ScuFile* restrict file,
+    void* restrict buffer,
+    Scuisize count,
+    Scuisize offset
+);
+
+/**
+ * @brief Writes to a specified file stream at a specified offset.
+ *
+ * Like `scu_fread_at()`, this function leaves the file position indicator and
+ * the buffer of the file stream alone, so multiple threads may write to
+ * disjoint ranges of the same file stream concurrently.
+ *
+ * @note The data is written directly to the underlying file, bypassing the
+ * buffer of the file stream. Data already read ahead into the buffer is not
+ * updated. The error indicator of the file stream is not affected.
+ *
+ * @warning On POSIX systems, writes to a file stream opened in append mode are
+ * appended to the end of the file regardless of `offset`.
+ *
+ * @param[in, out] file   The file stream to write to.
+ * @param[in]      buffer The buffer to write.
+ * @param[in]      count  The number of bytes to write.
+ * @param[in]      offset The offset within the file to start writing at, which
+ *                        must be non-negative.
+ * @return The number of bytes written, which may be less than `count` if an
+ * error occurs while writing to the specified file stream.
+ */
+Scuisize scu_fwrite_at(
+    ScuFile* restrict file,
+    const void* restrict buffer,
+    Scuisize count,
+    Scuisize offset
+);
+
 /**
  * @brief Reads a single byte from a specified file stream.
  *
@@ -401,6 +864,26 @@ Scuisize scu_write(const void* buffer, Scuisize count, Scuisize size);
  */
 ScuError scu_freadc(ScuFile* restrict file, char* restrict c);
 
+/**
+ * @brief Reads a single byte from a specified file stream without locking the
+ * file stream.
+ *
+ * @note Apart from not locking the file stream, this function behaves like
+ * `scu_freadc()`.
+ *
+ * @warning The calling thread must hold the lock of the file stream (see
+ * `scu_flock()`), or otherwise ensure that no other thread accesses it
+ * concurrently.
+ *
+ * @param[in, out] file The file stream to read from.
+ * @param[out]     c    The byte read from the specified file stream, or a null
+ *                      byte ('\0') on failure.
+ * @return `SCU_ERROR_END_OF_FILE` if the end-of-file condition is reached
+ * before a byte is read, `SCU_ERROR_READING_FILE` if an error occurred while
+ * reading from the specified file stream, or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_freadc_unlocked(ScuFile* restrict file, char* restrict c);
+
 /**
  * @brief Reads a single byte from the standard input stream.
  *
@@ -424,6 +907,24 @@ ScuError scu_readc(char* c);
  */
 ScuError scu_fwritec(ScuFile* file, char c);
 
+/**
+ * @brief Writes a single byte to a specified file stream without locking the
+ * file stream.
+ *
+ * @note Apart from not locking the file stream, this function behaves like
+ * `scu_fwritec()`.
+ *
+ * @warning The calling thread must hold the lock of the file stream (see
+ * `scu_flock()`), or otherwise ensure that no other thread accesses it
+ * concurrently.
+ *
+ * @param[in, out] file The file stream to write to.
+ * @param[in]      c    The byte to write.
+ * @return `SCU_ERROR_WRITING_FILE` if an error occurred while writing to the
+ * specified file stream, or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_fwritec_unlocked(ScuFile* file, char c);
+
 /**
  * @brief Writes a single byte to the standard output stream.
  *
@@ -1270,4 +1771,144 @@ bool scu_feof(ScuFile* file);
  */
 bool scu_ferror(ScuFile* file);
 
+/**
+ * @brief Returns the file descriptor underlying a specified file stream.
+ *
+ * @note Reading from or writing to the file descriptor directly bypasses the
+ * buffer of the file stream. Pending output should be flushed with
+ * `scu_fflush()` beforehand.
+ *
+ * @warning The file descriptor must not be closed, as it is still owned by the
+ * file stream.
+ *
+ * @param[in] file The file stream to examine.
+ * @return The file descriptor underlying the specified file stream.
+ */
+int scu_fileno(ScuFile* file);
+
+/**
+ * @brief Maps the whole file with a specified name into memory.
+ *
+ * In contrast to reading a file into a buffer, mapping it does not copy any
+ * data up front. Instead, the pages of the file are loaded lazily by the
+ * operating system when they are first accessed, and can be shared with the
+ * page cache and other processes mapping the same file.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`. The
+ * file itself is not needed anymore once it has been mapped, so no file
+ * descriptor or handle remains open.
+ *
+ * Mapping an empty file succeeds, but `scu_fmapdata()` returns a `nullptr` in
+ * this case.
+ *
+ * @warning If the operation succeeds, the mapped file returned via `*map` must
+ * be unmapped with `scu_funmap()` to properly release any associated
+ * resources.
+ *
+ * @param[out] map  A pointer to the mapped file, or `nullptr` on failure.
+ * @param[in]  name The name of the file to map.
+ * @param[in]  mode The mode in which to map the file.
+ * @return `SCU_ERROR_OPENING_FILE` if the file could not be opened,
+ * `SCU_ERROR_MAPPING_FILE` if the file could not be mapped into memory,
+ * `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_fmap(
+    ScuMappedFile* restrict* restrict map,
+    const char* restrict name,
+    ScuMapMode mode
+);
+
+/**
+ * @brief Maps a range of the file with a specified name into memory.
+ *
+ * @note The offset does not need to be aligned to the page size of the system.
+ * Apart from that, this function behaves like `scu_fmap()`.
+ *
+ * @warning If the operation succeeds, the mapped file returned via `*map` must
+ * be unmapped with `scu_funmap()` to properly release any associated
+ * resources.
+ *
+ * @param[out] map    A pointer to the mapped file, or `nullptr` on failure.
+ * @param[in]  name   The name of the file to map.
+ * @param[in]  mode   The mode in which to map the file.
+ * @param[in]  offset The offset of the first byte to map.
+ * @param[in]  size   The number of bytes to map.
+ * @return `SCU_ERROR_OPENING_FILE` if the file could not be opened,
+ * `SCU_ERROR_MAPPING_FILE` if the range does not lie within the file or could
+ * not be mapped into memory, `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory
+ * condition occurred, or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_fmaprange(
+    ScuMappedFile* restrict* restrict map,
+    const char* restrict name,
+    ScuMapMode mode,
+    Scuisize offset,
+    Scuisize size
+);
+
+/**
+ * @brief Returns a pointer to the first mapped byte of a specified mapped file.
+ *
+ * @warning The behavior is undefined if the mapped bytes are modified when the
+ * file was mapped with `SCU_MAP_MODE_READ` (which usually results in a
+ * segmentation fault), or if they are accessed after the file has been
+ * unmapped.
+ *
+ * @param[in] map The mapped file to examine.
+ * @return A pointer to the first mapped byte, or `nullptr` if no bytes are
+ * mapped.
+ */
+void* scu_fmapdata(const ScuMappedFile* map);
+
+/**
+ * @brief Returns the number of mapped bytes of a specified mapped file.
+ *
+ * @param[in] map The mapped file to examine.
+ * @return The number of mapped bytes.
+ */
+Scuisize scu_fmapsize(const ScuMappedFile* map);
+
+/**
+ * @brief Advises the operating system how a specified mapped file is going to
+ * be accessed.
+ *
+ * @note The advice is merely a hint and may be ignored, so this function
+ * cannot fail. Advice that is not supported by the operating system is
+ * silently ignored. In particular, huge pages are only supported on Linux.
+ *
+ * @param[in, out] map    The mapped file to advise about.
+ * @param[in]      advice The expected access pattern.
+ */
+void scu_fmadvise(ScuMappedFile* map, ScuMapAdvice advice);
+
+/**
+ * @brief Writes modifications of a specified mapped file back to the
+ * underlying file and waits until they have reached the storage device.
+ *
+ * @note If the file was mapped with `SCU_MAP_MODE_READ`, this function does
+ * nothing.
+ *
+ * @param[in, out] map The mapped file to synchronize.
+ * @return `SCU_ERROR_FLUSHING_FILE` if an error occurred while writing the
+ * modifications back, or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_fmsync(ScuMappedFile* map);
+
+/**
+ * @brief Unmaps a specified mapped file.
+ *
+ * @note Modifications of a file mapped with `SCU_MAP_MODE_READ_WRITE` are
+ * carried through to the underlying file eventually, but not necessarily
+ * before this function returns. Use `scu_fmsync()` to wait for them.
+ *
+ * @warning The behavior is undefined if the mapped file is used after it has
+ * been unmapped.
+ *
+ * @param[in, out] map The mapped file to unmap.
+ * @return `SCU_ERROR_CLOSING_FILE` if an error occurred while unmapping the
+ * file, or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_funmap(ScuMappedFile* map);
+
 #endif
\ No newline at end of file
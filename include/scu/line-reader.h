@@ -0,0 +1,106 @@
+#ifndef SCU_LINE_READER_H
+#define SCU_LINE_READER_H
+
+#include "scu/error.h"
+#include "scu/io.h"
+#include "scu/types.h"
+
+/**
+ * @brief Represents a reader that splits the contents of a file stream into
+ * lines.
+ *
+ * In contrast to `scu_freadln()`, which copies each line into a buffer owned by
+ * the caller, the reader fills a large internal buffer with few bulk reads and
+ * returns views into it. Newlines are located with `scu_memchr()`, which is
+ * usually vectorized, so each byte is only examined once.
+ *
+ * @note The reader reads ahead of the lines it has returned. Once a file stream
+ * is used with a reader, it should not be read from by other means until the
+ * reader has been deallocated. As reads block until the internal buffer is
+ * full (or the end of the file stream is reached), the reader is intended for
+ * files rather than interactive input.
+ */
+typedef struct ScuLineReader ScuLineReader;
+
+/**
+ * @brief Allocates and initializes a new line reader for a specified file
+ * stream with an unspecified default buffer capacity of at least 1 MiB.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the line reader with
+ * `scu_line_reader_free()` when it is no longer needed. The file stream must
+ * remain open until then.
+ *
+ * @param[in, out] file The file stream to read from.
+ * @return A pointer to the new line reader, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuLineReader* scu_line_reader_new(ScuFile* file);
+
+/**
+ * @brief Allocates and initializes a new line reader for a specified file
+ * stream with a specified initial buffer capacity.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`. The
+ * buffer grows automatically if a line does not fit into it.
+ *
+ * @warning The caller is responsible for deallocating the line reader with
+ * `scu_line_reader_free()` when it is no longer needed. The file stream must
+ * remain open until then.
+ *
+ * @param[in, out] file     The file stream to read from.
+ * @param[in]      capacity The initial capacity of the buffer (in bytes), which
+ *                          must be at least one.
+ * @return A pointer to the new line reader, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuLineReader* scu_line_reader_new_with_capacity(
+    ScuFile* file,
+    Scuisize capacity
+);
+
+/**
+ * @brief Reads the next line from a specified line reader.
+ *
+ * The returned line does not include the terminating newline. The last line of
+ * the file stream is returned even if it is not terminated by a newline, but an
+ * empty line is never reported after the final newline.
+ *
+ * @note This function dynamically allocates memory using `scu_realloc()` if a
+ * line does not fit into the buffer of the line reader.
+ *
+ * @warning The returned line is not null-terminated. It points into the buffer
+ * of the line reader and is only valid until the next call to this function or
+ * `scu_line_reader_free()`.
+ *
+ * @param[in, out] reader The line reader to read from.
+ * @param[out]     line   A pointer to the first character of the line on
+ *                        success, otherwise unchanged.
+ * @param[out]     length The number of characters of the line on success,
+ *                        otherwise unchanged.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * `SCU_ERROR_END_OF_FILE` if there are no more lines to read,
+ * `SCU_ERROR_READING_FILE` if an error occurred while reading from the file
+ * stream, or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_line_reader_next(
+    ScuLineReader* restrict reader,
+    const char* restrict* restrict line,
+    Scuisize* restrict length
+);
+
+/**
+ * @brief Deallocates a specified line reader.
+ *
+ * @note If `reader` is a `nullptr`, this function does nothing. The file stream
+ * of the line reader is not closed.
+ *
+ * @warning The behavior is undefined if the line reader or any line returned
+ * by it is used after it has been deallocated.
+ *
+ * @param[in, out] reader The line reader to deallocate.
+ */
+void scu_line_reader_free(ScuLineReader* reader);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,307 @@
+#ifndef SCU_LRU_CACHE_H
+#define SCU_LRU_CACHE_H
+
+#include "scu/equal.h"
+#include "scu/hash.h"
+#include "scu/types.h"
+
+/**
+ * @brief Represents a cache of key-value pairs with a least-recently-used (LRU)
+ * eviction policy.
+ *
+ * Each entry has a charge, which is `1` by default, and the cache evicts the
+ * least recently used entries whenever the total charge would exceed the
+ * maximum charge or the number of entries would exceed the capacity. Using the
+ * size of the cached objects (in bytes) as their charge limits the cache by
+ * memory instead of by count.
+ *
+ * All entries are stored in a flat arena allocated upfront, linked into a
+ * recency list by index and found through an open addressing hash index. As a
+ * result, lookups, insertions and evictions run in constant time and never
+ * allocate memory.
+ */
+typedef struct ScuLruCache ScuLruCache;
+
+/**
+ * @brief Represents a function that is called whenever an entry leaves a cache.
+ *
+ * @note The function is called for entries that are evicted, replaced by
+ * `scu_lru_cache_put()`, removed with `scu_lru_cache_remove()` or cleared with
+ * `scu_lru_cache_clear()`. It can be used to release resources owned by the
+ * entry (e.g., if the value is a pointer to dynamically allocated memory).
+ *
+ * @warning The function must not access the cache.
+ *
+ * @param[in, out] context The context passed to
+ *                        `scu_lru_cache_set_evict_func()`.
+ * @param[in]      key     A pointer to the key of the entry.
+ * @param[in, out] value   A pointer to the value of the entry.
+ */
+typedef void ScuLruCacheEvictFunc(void* context, const void* key, void* value);
+
+/** @brief Represents statistics about the usage of a cache. */
+typedef struct ScuLruCacheStats {
+
+    /** @brief The number of lookups that found an entry. */
+    Scuu64 hits;
+
+    /** @brief The number of lookups that did not find an entry. */
+    Scuu64 misses;
+
+    /** @brief The number of entries inserted. */
+    Scuu64 insertions;
+
+    /** @brief The number of entries evicted to make room for other entries. */
+    Scuu64 evictions;
+
+} ScuLruCacheStats;
+
+/**
+ * @brief Allocates and initializes a new, empty LRU cache holding at most a
+ * specified number of entries.
+ *
+ * @note All memory required by the cache is allocated upfront, so inserting
+ * entries never allocates memory.
+ *
+ * This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the cache with
+ * `scu_lru_cache_free()` when it is no longer needed.
+ *
+ * @param[in] keySize   The size of each key (in bytes).
+ * @param[in] valueSize The size of each value (in bytes).
+ * @param[in] capacity  The maximum number of entries.
+ * @param[in] hashFunc  A function used for hashing keys.
+ * @param[in] equalFunc A function used for comparing keys for equality.
+ * @return A pointer to the new cache, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuLruCache* scu_lru_cache_new(
+    Scuisize keySize,
+    Scuisize valueSize,
+    Scuisize capacity,
+    ScuHashFunc* hashFunc,
+    ScuEqualFunc* equalFunc
+);
+
+/**
+ * @brief Allocates and initializes a new, empty LRU cache holding at most a
+ * specified number of entries with a specified total charge.
+ *
+ * @note All memory required by the cache is allocated upfront, so inserting
+ * entries never allocates memory.
+ *
+ * This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the cache with
+ * `scu_lru_cache_free()` when it is no longer needed.
+ *
+ * @param[in] keySize   The size of each key (in bytes).
+ * @param[in] valueSize The size of each value (in bytes).
+ * @param[in] capacity  The maximum number of entries.
+ * @param[in] maxCharge The maximum total charge of all entries.
+ * @param[in] hashFunc  A function used for hashing keys.
+ * @param[in] equalFunc A function used for comparing keys for equality.
+ * @return A pointer to the new cache, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuLruCache* scu_lru_cache_new_with_charge(
+    Scuisize keySize,
+    Scuisize valueSize,
+    Scuisize capacity,
+    Scuisize maxCharge,
+    ScuHashFunc* hashFunc,
+    ScuEqualFunc* equalFunc
+);
+
+/**
+ * @brief Sets the function that is called whenever an entry leaves a specified
+ * LRU cache.
+ *
+ * @param[in, out] cache     The cache to modify.
+ * @param[in]      evictFunc The function to call, or `nullptr` to not call any
+ *                           function.
+ * @param[in]      context   A context passed to `evictFunc`.
+ */
+void scu_lru_cache_set_evict_func(
+    ScuLruCache* cache,
+    ScuLruCacheEvictFunc* evictFunc,
+    void* context
+);
+
+/**
+ * @brief Returns the capacity of a specified LRU cache, i.e., the maximum
+ * number of entries.
+ *
+ * @param[in] cache The cache to examine.
+ * @return The capacity of the specified cache.
+ */
+Scuisize scu_lru_cache_capacity(const ScuLruCache* cache);
+
+/**
+ * @brief Returns the number of entries of a specified LRU cache.
+ *
+ * @param[in] cache The cache to examine.
+ * @return The number of entries of the specified cache.
+ */
+Scuisize scu_lru_cache_count(const ScuLruCache* cache);
+
+/**
+ * @brief Returns the total charge of all entries of a specified LRU cache.
+ *
+ * @param[in] cache The cache to examine.
+ * @return The total charge of all entries of the specified cache.
+ */
+Scuisize scu_lru_cache_charge(const ScuLruCache* cache);
+
+/**
+ * @brief Returns the maximum total charge of a specified LRU cache.
+ *
+ * @param[in] cache The cache to examine.
+ * @return The maximum total charge of the specified cache.
+ */
+Scuisize scu_lru_cache_max_charge(const ScuLruCache* cache);
+
+/**
+ * @brief Tries to get the value associated with a key in a specified LRU cache.
+ *
+ * @note This function is an implementation detail and not intended to be called
+ * directly. Use the `scu_lru_cache_try_get()` macro instead.
+ *
+ * @param[in, out] cache The cache to search.
+ * @param[in]      key   The key to look up.
+ * @param[out]     value A pointer to the value associated with the specified
+ *                       key on success, otherwise a `nullptr`.
+ * @return `true` if the key was present in the cache, otherwise `false`.
+ */
+bool scu_lru_cache_try_get_impl(
+    ScuLruCache* restrict cache,
+    const void* restrict key,
+    void* restrict* restrict value
+);
+
+/**
+ * @brief Tries to get the value associated with a key in a specified LRU cache.
+ *
+ * @note If the key is present, its entry becomes the most recently used one.
+ * Every call counts as a hit or a miss in the statistics of the cache.
+ *
+ * @warning The pointer to the value is only valid until the cache is modified
+ * the next time.
+ *
+ * @param[in, out] cache The cache to search.
+ * @param[in]      key   The key to look up.
+ * @param[out]     value A pointer to the value associated with the specified
+ *                       key on success, otherwise a `nullptr`.
+ * @return `true` if the key was present in the cache, otherwise `false`.
+ */
+#define scu_lru_cache_try_get(cache, key, value)             \
+    scu_lru_cache_try_get_impl(cache, key, (void**) (value))
+
+/**
+ * @brief Determines whether a key is present in a specified LRU cache.
+ *
+ * @note In contrast to `scu_lru_cache_try_get()`, this function neither changes
+ * the recency of the entry nor the statistics of the cache.
+ *
+ * @param[in] cache The cache to search.
+ * @param[in] key   The key to search for.
+ * @return `true` if the key is present in the cache, otherwise `false`.
+ */
+bool scu_lru_cache_contains(
+    const ScuLruCache* restrict cache,
+    const void* restrict key
+);
+
+/**
+ * @brief Associates a key with a value in a specified LRU cache, using a charge
+ * of `1`.
+ *
+ * @note See `scu_lru_cache_put_with_charge()` for more information.
+ *
+ * @param[in, out] cache The cache to modify.
+ * @param[in]      key   The key to associate with the value.
+ * @param[in]      value The value to associate with the key.
+ */
+void scu_lru_cache_put(
+    ScuLruCache* restrict cache,
+    const void* restrict key,
+    const void* restrict value
+);
+
+/**
+ * @brief Associates a key with a value with a specified charge in a specified
+ * LRU cache.
+ *
+ * If the key is already present, its value and charge are replaced. The entry
+ * becomes the most recently used one, and the least recently used entries are
+ * evicted until both the capacity and the maximum charge are respected again.
+ *
+ * @param[in, out] cache  The cache to modify.
+ * @param[in]      key    The key to associate with the value.
+ * @param[in]      value  The value to associate with the key.
+ * @param[in]      charge The charge of the entry (e.g., the size of the cached
+ *                        object in bytes).
+ * @return `true` if the entry was inserted, or `false` if its charge exceeds
+ * the maximum charge of the cache (in which case the cache is left unchanged).
+ */
+bool scu_lru_cache_put_with_charge(
+    ScuLruCache* restrict cache,
+    const void* restrict key,
+    const void* restrict value,
+    Scuisize charge
+);
+
+/**
+ * @brief Removes the entry with a specified key from a specified LRU cache.
+ *
+ * @param[in, out] cache The cache to modify.
+ * @param[in]      key   The key of the entry to remove.
+ * @return `true` if the entry was removed, or `false` if the key was not
+ * present in the cache.
+ */
+bool scu_lru_cache_remove(
+    ScuLruCache* restrict cache,
+    const void* restrict key
+);
+
+/**
+ * @brief Removes all entries from a specified LRU cache.
+ *
+ * @note The statistics of the cache are left unchanged.
+ *
+ * @param[in, out] cache The cache to clear.
+ */
+void scu_lru_cache_clear(ScuLruCache* cache);
+
+/**
+ * @brief Returns the statistics of a specified LRU cache.
+ *
+ * @param[in] cache The cache to examine.
+ * @return The statistics of the specified cache.
+ */
+ScuLruCacheStats scu_lru_cache_stats(const ScuLruCache* cache);
+
+/**
+ * @brief Resets the statistics of a specified LRU cache to zero.
+ *
+ * @param[in, out] cache The cache to modify.
+ */
+void scu_lru_cache_reset_stats(ScuLruCache* cache);
+
+/**
+ * @brief Deallocates a specified LRU cache.
+ *
+ * @note If `cache` is a `nullptr`, this function does nothing.
+ *
+ * @warning This function does not call the eviction function for the remaining
+ * entries. Call `scu_lru_cache_clear()` first if they own any resources.
+ *
+ * The behavior is undefined if the cache is used after it has been
+ * deallocated.
+ *
+ * @param[in, out] cache The cache to deallocate.
+ */
+void scu_lru_cache_free(ScuLruCache* cache);
+
+#endif
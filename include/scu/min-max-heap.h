@@ -0,0 +1,537 @@
+#ifndef SCU_MIN_MAX_HEAP_H
+#define SCU_MIN_MAX_HEAP_H
+
+#include "scu/common.h"
+#include "scu/compare.h"
+#include "scu/error.h"
+#include "scu/types.h"
+
+/**
+ * @brief Represents a collection of elements and associated priorities that
+ * provides efficient access to both the lowest and the highest priority.
+ *
+ * A min-max heap is a double-ended priority queue. The elements with the lowest
+ * and the highest priority can be retrieved in constant time, and each of them
+ * can be removed in logarithmic time. This makes it well suited for bounded
+ * buffers which serve the best element while evicting the worst one once they
+ * are full.
+ */
+typedef struct ScuMinMaxHeap ScuMinMaxHeap;
+
+/**
+ * @brief Represents an iterator for a min-max heap.
+ *
+ * @warning The internal representation of the iterator is an implementation
+ * detail and should not be relied upon. Most importantly, the behavior is
+ * undefined if its fields are accessed directly.
+ */
+typedef struct ScuMinMaxHeapIter {
+
+    /** @brief The min-max heap being iterated over. */
+    ScuMinMaxHeap* minMaxHeap;
+
+    /** @brief The current index within the min-max heap. */
+    Scuisize index;
+
+} ScuMinMaxHeapIter;
+
+/** @brief Represents an entry in a min-max heap. */
+typedef struct ScuMinMaxHeapEntry {
+
+    /** @brief The element of the entry. */
+    void* elem;
+
+    /** @brief The priority of the entry. */
+    void* prio;
+
+} ScuMinMaxHeapEntry;
+
+/**
+ * @brief Allocates and initializes a new min-max heap with specified element
+ * size, priority size, priority comparison function, and an unspecified default
+ * capacity.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the min-max heap with
+ * `scu_min_max_heap_free()` when it is no longer needed.
+ *
+ * @param[in] elemSize    The size of each element (in bytes).
+ * @param[in] prioSize    The size of each priority (in bytes).
+ * @param[in] prioCmpFunc A function used for comparing priorities.
+ * @return A pointer to the new min-max heap, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuMinMaxHeap* scu_min_max_heap_new(
+    Scuisize elemSize,
+    Scuisize prioSize,
+    ScuCompareFunc prioCmpFunc
+);
+
+/**
+ * @brief Allocates and initializes a new min-max heap with specified element
+ * size, priority size, priority comparison function, and initial capacity.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the min-max heap with
+ * `scu_min_max_heap_free()` when it is no longer needed.
+ *
+ * @param[in] elemSize    The size of each element (in bytes).
+ * @param[in] prioSize    The size of each priority (in bytes).
+ * @param[in] capacity    The initial capacity (in number of elements).
+ * @param[in] prioCmpFunc A function used for comparing priorities.
+ * @return A pointer to the new min-max heap, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuMinMaxHeap* scu_min_max_heap_new_with_capacity(
+    Scuisize elemSize,
+    Scuisize prioSize,
+    Scuisize capacity,
+    ScuCompareFunc prioCmpFunc
+);
+
+/**
+ * @brief Creates a shallow copy of a specified min-max heap.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the cloned min-max heap
+ * with `scu_min_max_heap_free()` when it is no longer needed.
+ *
+ * @param[in] minMaxHeap The min-max heap to clone.
+ * @return A pointer to the cloned min-max heap, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuMinMaxHeap* scu_min_max_heap_clone(const ScuMinMaxHeap* minMaxHeap);
+
+/**
+ * @brief Returns the capacity of a specified min-max heap, i.e., the maximum
+ * number of elements that can be stored before a reallocation is required.
+ *
+ * @note The capacity can be influenced to a certain extent using
+ * `scu_min_max_heap_ensure_capacity()` and `scu_min_max_heap_trim_excess()`.
+ * See their respective documentation for details.
+ *
+ * @param[in] minMaxHeap The min-max heap to examine.
+ * @return The capacity of the specified min-max heap.
+ */
+Scuisize scu_min_max_heap_capacity(const ScuMinMaxHeap* minMaxHeap);
+
+/**
+ * @brief Returns the number of elements stored in a specified min-max heap.
+ *
+ * @param[in] minMaxHeap The min-max heap to examine.
+ * @return The number of elements stored in the specified min-max heap.
+ */
+Scuisize scu_min_max_heap_count(const ScuMinMaxHeap* minMaxHeap);
+
+/**
+ * @brief Ensures that a specified min-max heap has at least a specified
+ * capacity.
+ *
+ * @note This function dynamically allocates memory using `scu_realloc()`.
+ *
+ * @param[in, out] minMaxHeap The min-max heap to ensure the capacity of.
+ * @param[in]      capacity   The desired capacity (in number of elements).
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_min_max_heap_ensure_capacity(
+    ScuMinMaxHeap* minMaxHeap,
+    Scuisize capacity
+);
+
+/**
+ * @brief Enqueues a new element with a specified priority into a specified
+ * min-max heap.
+ *
+ * @note This function dynamically allocates memory using `scu_realloc()`.
+ *
+ * @param[in, out] minMaxHeap The min-max heap to enqueue the element into.
+ * @param[in]      elem       The element to enqueue.
+ * @param[in]      prio       The priority of the element.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_min_max_heap_enqueue(
+    ScuMinMaxHeap* restrict minMaxHeap,
+    const void* restrict elem,
+    const void* restrict prio
+);
+
+/**
+ * @brief Dequeues the element with the lowest priority from a specified min-max
+ * heap.
+ *
+ * @warning The behavior is undefined if the min-max heap is empty. Use
+ * `scu_min_max_heap_try_dequeue_min()` to handle this case gracefully.
+ *
+ * @param[in, out] minMaxHeap The min-max heap to dequeue the element from.
+ * @param[out]     elem       The dequeued element.
+ * @param[out]     prio       The priority of the dequeued element.
+ */
+void scu_min_max_heap_dequeue_min(
+    ScuMinMaxHeap* restrict minMaxHeap,
+    void* restrict elem,
+    void* restrict prio
+);
+
+/**
+ * @brief Tries to dequeue the element with the lowest priority from a specified
+ * min-max heap.
+ *
+ * @param[in, out] minMaxHeap The min-max heap to dequeue the element from.
+ * @param[out]     elem       The dequeued element on success, otherwise
+ *                            unchanged.
+ * @param[out]     prio       The priority of the dequeued element on success,
+ *                            otherwise unchanged.
+ * @return `true` if an element was successfully dequeued, otherwise `false`.
+ */
+bool scu_min_max_heap_try_dequeue_min(
+    ScuMinMaxHeap* restrict minMaxHeap,
+    void* restrict elem,
+    void* restrict prio
+);
+
+/**
+ * @brief Dequeues the element with the highest priority from a specified
+ * min-max heap.
+ *
+ * @warning The behavior is undefined if the min-max heap is empty. Use
+ * `scu_min_max_heap_try_dequeue_max()` to handle this case gracefully.
+ *
+ * @param[in, out] minMaxHeap The min-max heap to dequeue the element from.
+ * @param[out]     elem       The dequeued element.
+ * @param[out]     prio       The priority of the dequeued element.
+ */
+void scu_min_max_heap_dequeue_max(
+    ScuMinMaxHeap* restrict minMaxHeap,
+    void* restrict elem,
+    void* restrict prio
+);
+
+/**
+ * @brief Tries to dequeue the element with the highest priority from a
+ * specified min-max heap.
+ *
+ * @param[in, out] minMaxHeap The min-max heap to dequeue the element from.
+ * @param[out]     elem       The dequeued element on success, otherwise
+ *                            unchanged.
+ * @param[out]     prio       The priority of the dequeued element on success,
+ *                            otherwise unchanged.
+ * @return `true` if an element was successfully dequeued, otherwise `false`.
+ */
+bool scu_min_max_heap_try_dequeue_max(
+    ScuMinMaxHeap* restrict minMaxHeap,
+    void* restrict elem,
+    void* restrict prio
+);
+
+/**
+ * @brief Returns the element with the lowest priority from a specified min-max
+ * heap without removing it.
+ *
+ * @note This function is an implementation detail and not intended to be called
+ * directly. Use the `scu_min_max_heap_peek_min()` macro instead.
+ *
+ * @warning The behavior is undefined if the min-max heap is empty. Use
+ * `scu_min_max_heap_try_peek_min()` to handle this case gracefully.
+ *
+ * @param[in]  minMaxHeap The min-max heap to examine.
+ * @param[out] elem       A pointer to the element with the lowest priority.
+ * @param[out] prio       A pointer to the priority of the element with the
+ *                        lowest priority.
+ */
+void scu_min_max_heap_peek_min_impl(
+    const ScuMinMaxHeap* restrict minMaxHeap,
+    void** restrict elem,
+    void** restrict prio
+);
+
+/**
+ * @brief Returns the element with the lowest priority from a specified min-max
+ * heap without removing it.
+ *
+ * @warning The behavior is undefined if the min-max heap is empty. Use
+ * `scu_min_max_heap_try_peek_min()` to handle this case gracefully.
+ *
+ * @param[in]  minMaxHeap The min-max heap to examine.
+ * @param[out] elem       A pointer to the element with the lowest priority.
+ * @param[out] prio       A pointer to the priority of the element with the
+ *                        lowest priority.
+ */
+#define scu_min_max_heap_peek_min(minMaxHeap, elem, prio) \
+    scu_min_max_heap_peek_min_impl(                       \
+        minMaxHeap,                                       \
+        (void**) (elem),                                  \
+        (void**) (prio)                                   \
+    )
+
+/**
+ * @brief Tries to return the element with the lowest priority from a specified
+ * min-max heap without removing it.
+ *
+ * @note This function is an implementation detail and not intended to be called
+ * directly. Use the `scu_min_max_heap_try_peek_min()` macro instead.
+ *
+ * @param[in]  minMaxHeap The min-max heap to examine.
+ * @param[out] elem       A pointer to the element with the lowest priority on
+ *                        success, otherwise a `nullptr`.
+ * @param[out] prio       A pointer to the priority of the element with the
+ *                        lowest priority on success, otherwise a `nullptr`.
+ * @return `true` if an element was successfully retrieved, otherwise `false`.
+ */
+bool scu_min_max_heap_try_peek_min_impl(
+    const ScuMinMaxHeap* restrict minMaxHeap,
+    void** restrict elem,
+    void** restrict prio
+);
+
+/**
+ * @brief Tries to return the element with the lowest priority from a specified
+ * min-max heap without removing it.
+ *
+ * @param[in]  minMaxHeap The min-max heap to examine.
+ * @param[out] elem       A pointer to the element with the lowest priority on
+ *                        success, otherwise a `nullptr`.
+ * @param[out] prio       A pointer to the priority of the element with the
+ *                        lowest priority on success, otherwise a `nullptr`.
+ * @return `true` if an element was successfully retrieved, otherwise `false`.
+ */
+#define scu_min_max_heap_try_peek_min(minMaxHeap, elem, prio) \
+    scu_min_max_heap_try_peek_min_impl(                       \
+        minMaxHeap,                                           \
+        (void**) (elem),                                      \
+        (void**) (prio)                                       \
+    )
+
+/**
+ * @brief Returns the element with the highest priority from a specified min-max
+ * heap without removing it.
+ *
+ * @note This function is an implementation detail and not intended to be called
+ * directly. Use the `scu_min_max_heap_peek_max()` macro instead.
+ *
+ * @warning The behavior is undefined if the min-max heap is empty. Use
+ * `scu_min_max_heap_try_peek_max()` to handle this case gracefully.
+ *
+ * @param[in]  minMaxHeap The min-max heap to examine.
+ * @param[out] elem       A pointer to the element with the highest priority.
+ * @param[out] prio       A pointer to the priority of the element with the
+ *                        highest priority.
+ */
+void scu_min_max_heap_peek_max_impl(
+    const ScuMinMaxHeap* restrict minMaxHeap,
+    void** restrict elem,
+    void** restrict prio
+);
+
+/**
+ * @brief Returns the element with the highest priority from a specified min-max
+ * heap without removing it.
+ *
+ * @warning The behavior is undefined if the min-max heap is empty. Use
+ * `scu_min_max_heap_try_peek_max()` to handle this case gracefully.
+ *
+ * @param[in]  minMaxHeap The min-max heap to examine.
+ * @param[out] elem       A pointer to the element with the highest priority.
+ * @param[out] prio       A pointer to the priority of the element with the
+ *                        highest priority.
+ */
+#define scu_min_max_heap_peek_max(minMaxHeap, elem, prio) \
+    scu_min_max_heap_peek_max_impl(                       \
+        minMaxHeap,                                       \
+        (void**) (elem),                                  \
+        (void**) (prio)                                   \
+    )
+
+/**
+ * @brief Tries to return the element with the highest priority from a
+ * specified min-max heap without removing it.
+ *
+ * @note This function is an implementation detail and not intended to be called
+ * directly. Use the `scu_min_max_heap_try_peek_max()` macro instead.
+ *
+ * @param[in]  minMaxHeap The min-max heap to examine.
+ * @param[out] elem       A pointer to the element with the highest priority on
+ *                        success, otherwise a `nullptr`.
+ * @param[out] prio       A pointer to the priority of the element with the
+ *                        highest priority on success, otherwise a `nullptr`.
+ * @return `true` if an element was successfully retrieved, otherwise `false`.
+ */
+bool scu_min_max_heap_try_peek_max_impl(
+    const ScuMinMaxHeap* restrict minMaxHeap,
+    void** restrict elem,
+    void** restrict prio
+);
+
+/**
+ * @brief Tries to return the element with the highest priority from a
+ * specified min-max heap without removing it.
+ *
+ * @param[in]  minMaxHeap The min-max heap to examine.
+ * @param[out] elem       A pointer to the element with the highest priority on
+ *                        success, otherwise a `nullptr`.
+ * @param[out] prio       A pointer to the priority of the element with the
+ *                        highest priority on success, otherwise a `nullptr`.
+ * @return `true` if an element was successfully retrieved, otherwise `false`.
+ */
+#define scu_min_max_heap_try_peek_max(minMaxHeap, elem, prio) \
+    scu_min_max_heap_try_peek_max_impl(                       \
+        minMaxHeap,                                           \
+        (void**) (elem),                                      \
+        (void**) (prio)                                       \
+    )
+
+/**
+ * @brief Removes all elements from a specified min-max heap.
+ *
+ * @note Consider using `scu_min_max_heap_trim_excess()` if you wish to reduce
+ * the memory usage of the min-max heap after clearing it.
+ *
+ * @warning This function does not deallocate the min-max heap itself nor the
+ * elements contained within, it only resets the number of elements to zero. The
+ * caller is responsible for deallocating the individual elements if they are
+ * pointers to dynamically allocated objects and no other references to them
+ * exist.
+ *
+ * @param[in, out] minMaxHeap The min-max heap to clear.
+ */
+void scu_min_max_heap_clear(ScuMinMaxHeap* minMaxHeap);
+
+/**
+ * @brief Trims the excess capacity of a specified min-max heap to match its
+ * current number of elements.
+ *
+ * @note This function dynamically allocates memory using `scu_realloc()`.
+ *
+ * @param[in, out] minMaxHeap The min-max heap to trim.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_min_max_heap_trim_excess(ScuMinMaxHeap* minMaxHeap);
+
+/**
+ * @brief Returns an iterator for a specified min-max heap.
+ *
+ * @note The iterator is initially positioned before the first element of the
+ * min-max heap (if any). This means that `scu_min_max_heap_iter_move_next()`
+ * must be called before accessing the first and subsequent elements with
+ * `scu_min_max_heap_iter_current()`.
+ *
+ * Note that the order of iteration is explicitly unspecified and may not
+ * necessarily correspond to the order of priorities.
+ *
+ * @warning The behavior is undefined if the min-max heap being iterated over
+ * is modified (e.g., elements are enqueued or dequeued) while the iterator is
+ * in use.
+ *
+ * @param[in] minMaxHeap The min-max heap to iterate over.
+ * @return An iterator for the specified min-max heap.
+ */
+ScuMinMaxHeapIter scu_min_max_heap_iter(const ScuMinMaxHeap* minMaxHeap);
+
+/**
+ * @brief Advances a specified min-max heap iterator to the next element.
+ *
+ * @param[in, out] iter The iterator to advance.
+ * @return `true` if the iterator was successfully advanced to the next element,
+ * otherwise `false` (i.e., the min-max heap does not contain any more
+ * elements).
+ */
+bool scu_min_max_heap_iter_move_next(ScuMinMaxHeapIter* iter);
+
+/**
+ * @brief Returns the current element and its priority of a specified min-max
+ * heap iterator.
+ *
+ * @param[in] iter The iterator to examine.
+ * @return An entry containing the current element and its priority.
+ */
+ScuMinMaxHeapEntry scu_min_max_heap_iter_current(const ScuMinMaxHeapIter* iter);
+
+/**
+ * @brief Resets a specified min-max heap iterator to its initial position.
+ *
+ * @note The iterator is initially positioned before the first element of the
+ * min-max heap (if any). This means that `scu_min_max_heap_iter_move_next()`
+ * must be called before accessing the first and subsequent elements with
+ * `scu_min_max_heap_iter_current()`.
+ *
+ * @param[in, out] iter The iterator to reset.
+ */
+void scu_min_max_heap_iter_reset(ScuMinMaxHeapIter* iter);
+
+/**
+ * @brief Deallocates a specified min-max heap.
+ *
+ * @note If `minMaxHeap` is a `nullptr`, this function does nothing.
+ *
+ * @warning This function only deallocates the memory occupied by the min-max
+ * heap itself, but not the elements and priorities contained within. The caller
+ * is responsible for deallocating the individual elements and priorities if
+ * they are pointers to dynamically allocated objects and no other references
+ * to them exist.
+ *
+ * The behavior is undefined if the min-max heap is used after it has been
+ * deallocated.
+ *
+ * @param[in] minMaxHeap The min-max heap to deallocate.
+ */
+void scu_min_max_heap_free(ScuMinMaxHeap* minMaxHeap);
+
+/**
+ * @brief Iterates over each element and its priority in a specified min-max
+ * heap.
+ *
+ * This macro expands to a for loop that iterates over each element and its
+ * priority in the specified min-max heap. During each iteration, the provided
+ * variable is assigned an entry containing the current element and its
+ * priority.
+ *
+ * The following example demonstrates the basic usage of this macro:
+ *
+ * ```c
+ * // E and P are the types of the elements and priorities, respectively.
+ * ScuMinMaxHeap* minMaxHeap = scu_min_max_heap_new(
+ *     SCU_SIZEOF(E),
+ *     SCU_SIZEOF(P),
+ *     ...
+ * );
+ * ...
+ * ScuMinMaxHeapEntry entry;
+ * SCU_MIN_MAX_HEAP_FOREACH(entry, minMaxHeap) {
+ *     // Do something with the element and its priority.
+ *     E* elem = entry.elem;
+ *     P* prio = entry.prio;
+ * }
+ * ```
+ *
+ * @note The variable `entry` must be declared manually before the loop. It must
+ * be of type `ScuMinMaxHeapEntry`.
+ *
+ * Note that the order of iteration is explicitly unspecified and may not
+ * necessarily correspond to the order of priorities.
+ *
+ * @warning The behavior is undefined if the min-max heap is modified (e.g.,
+ * elements are enqueued or dequeued) while being iterated over.
+ *
+ * @param[out] entry      An entry containing the current element and its
+ *                        priority.
+ * @param[in]  minMaxHeap The min-max heap to iterate over.
+ */
+#define SCU_MIN_MAX_HEAP_FOREACH(entry, minMaxHeap)                            \
+    for (                                                                      \
+        ScuMinMaxHeapIter SCU_XCONCAT(it, __LINE__)                            \
+            = scu_min_max_heap_iter(minMaxHeap);                               \
+        scu_min_max_heap_iter_move_next(&SCU_XCONCAT(it, __LINE__))            \
+            && (                                                               \
+                (entry) = scu_min_max_heap_iter_current(                       \
+                    &SCU_XCONCAT(it, __LINE__)                                 \
+                ),                                                             \
+                true                                                           \
+            );                                                                 \
+    )
+
+#endif
\ No newline at end of file
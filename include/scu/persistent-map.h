@@ -0,0 +1,333 @@
+#ifndef SCU_PERSISTENT_MAP_H
+#define SCU_PERSISTENT_MAP_H
+
+#include "scu/common.h"
+#include "scu/equal.h"
+#include "scu/hash.h"
+#include "scu/types.h"
+
+/**
+ * @brief Represents an immutable, unordered collection of key-value pairs.
+ *
+ * A persistent map is never modified in place. Instead,
+ * `scu_persistent_map_set()` and `scu_persistent_map_remove()` return a new
+ * version of the map, leaving the original version untouched. Both versions
+ * share all parts of the underlying hash array mapped trie (HAMT) that were not
+ * affected by the update, so an update only copies `O(log32(n))` small nodes.
+ * Taking a snapshot with `scu_persistent_map_clone()` does not copy anything
+ * at all.
+ *
+ * The nodes of the trie are reference counted atomically, so different versions
+ * of the same map may be read and deallocated by different threads at the same
+ * time without any further synchronization. This makes persistent maps well
+ * suited for publishing consistent views of frequently updated tables.
+ *
+ * The following example demonstrates how a map is typically updated:
+ *
+ * ```c
+ * ScuPersistentMap* next = scu_persistent_map_set(map, &key, &value);
+ * if (next == nullptr) {
+ *     // Handle the out-of-memory condition.
+ * }
+ * scu_persistent_map_free(map);
+ * map = next;
+ * ```
+ */
+typedef struct ScuPersistentMap ScuPersistentMap;
+
+/**
+ * @brief Represents an iterator for a persistent map.
+ *
+ * @warning The internal representation of the iterator is an implementation
+ * detail and should not be relied upon. Most importantly, the behavior is
+ * undefined if its fields are accessed directly.
+ */
+typedef struct ScuPersistentMapIter {
+
+    /** @brief The persistent map being iterated over. */
+    const ScuPersistentMap* map;
+
+    /** @brief The current depth within the trie, or `-1` if exhausted. */
+    Scuisize depth;
+
+    /**
+     * @brief The nodes on the path from the root to the current node.
+     *
+     * @note The trie has at most 13 levels for 64-bit hashes, plus one level
+     * for keys whose hashes collide completely.
+     */
+    void* nodes[14];
+
+    /** @brief The position of the next item to visit within each node. */
+    Scuisize positions[14];
+
+} ScuPersistentMapIter;
+
+/** @brief Represents an entry in a persistent map. */
+typedef struct ScuPersistentMapEntry {
+
+    /** @brief The key of the entry. */
+    const void* key;
+
+    /** @brief The value of the entry. */
+    const void* value;
+
+} ScuPersistentMapEntry;
+
+/**
+ * @brief Allocates and initializes a new, empty persistent map with the
+ * specified key and value sizes, and hash and equality functions.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the persistent map with
+ * `scu_persistent_map_free()` when it is no longer needed.
+ *
+ * @param[in] keySize   The size of each key (in bytes).
+ * @param[in] valueSize The size of each value (in bytes).
+ * @param[in] hashFunc  A function used for hashing keys.
+ * @param[in] equalFunc A function used for comparing keys for equality.
+ * @return A pointer to the new persistent map, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuPersistentMap* scu_persistent_map_new(
+    Scuisize keySize,
+    Scuisize valueSize,
+    ScuHashFunc* hashFunc,
+    ScuEqualFunc* equalFunc
+);
+
+/**
+ * @brief Creates a snapshot of a specified persistent map in constant time.
+ *
+ * @note The snapshot shares all nodes with the original map. This function
+ * dynamically allocates memory using `scu_malloc()`, but only for the handle of
+ * the snapshot.
+ *
+ * @warning The caller is responsible for deallocating the snapshot with
+ * `scu_persistent_map_free()` when it is no longer needed.
+ *
+ * @param[in] map The persistent map to clone.
+ * @return A pointer to the snapshot, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuPersistentMap* scu_persistent_map_clone(const ScuPersistentMap* map);
+
+/**
+ * @brief Returns the number of key-value pairs of a specified persistent map.
+ *
+ * @param[in] map The persistent map to examine.
+ * @return The number of key-value pairs of the specified persistent map.
+ */
+Scuisize scu_persistent_map_count(const ScuPersistentMap* map);
+
+/**
+ * @brief Tries to get the value associated with a key in a specified persistent
+ * map.
+ *
+ * @note This function is an implementation detail and not intended to be called
+ * directly. Use the `scu_persistent_map_try_get()` macro instead.
+ *
+ * @param[in]  map   The persistent map to examine.
+ * @param[in]  key   The key to look up.
+ * @param[out] value A pointer to the value associated with the specified key on
+ *                   success, otherwise a `nullptr`.
+ * @return `true` if the key was present in the persistent map, otherwise
+ * `false`.
+ */
+bool scu_persistent_map_try_get_impl(
+    const ScuPersistentMap* restrict map,
+    const void* restrict key,
+    const void* restrict* restrict value
+);
+
+/**
+ * @brief Tries to get the value associated with a key in a specified persistent
+ * map.
+ *
+ * @warning The value is shared with other versions of the map and must not be
+ * modified.
+ *
+ * @param[in]  map   The persistent map to examine.
+ * @param[in]  key   The key to look up.
+ * @param[out] value A pointer to the value associated with the specified key on
+ *                   success, otherwise a `nullptr`.
+ * @return `true` if the key was present in the persistent map, otherwise
+ * `false`.
+ */
+#define scu_persistent_map_try_get(map, key, value)                   \
+    scu_persistent_map_try_get_impl(map, key, (const void**) (value))
+
+/**
+ * @brief Determines whether a key is present in a specified persistent map.
+ *
+ * @param[in] map The persistent map to examine.
+ * @param[in] key The key to search for.
+ * @return `true` if the key is present in the persistent map, otherwise
+ * `false`.
+ */
+bool scu_persistent_map_contains_key(
+    const ScuPersistentMap* restrict map,
+    const void* restrict key
+);
+
+/**
+ * @brief Returns a new version of a specified persistent map in which a key is
+ * associated with a value.
+ *
+ * @note If the key is already present, its associated value is replaced in the
+ * new version. The specified persistent map itself is left unchanged.
+ *
+ * This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the new version with
+ * `scu_persistent_map_free()` when it is no longer needed.
+ *
+ * @param[in] map   The persistent map to update.
+ * @param[in] key   The key to associate with the value.
+ * @param[in] value The value to associate with the key.
+ * @return A pointer to the new version, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuPersistentMap* scu_persistent_map_set(
+    const ScuPersistentMap* restrict map,
+    const void* restrict key,
+    const void* restrict value
+);
+
+/**
+ * @brief Returns a new version of a specified persistent map without a key.
+ *
+ * @note If the key is not present, the new version is equivalent to a snapshot
+ * created with `scu_persistent_map_clone()`. The specified persistent map
+ * itself is left unchanged.
+ *
+ * This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the new version with
+ * `scu_persistent_map_free()` when it is no longer needed.
+ *
+ * @param[in] map The persistent map to update.
+ * @param[in] key The key to remove.
+ * @return A pointer to the new version, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuPersistentMap* scu_persistent_map_remove(
+    const ScuPersistentMap* restrict map,
+    const void* restrict key
+);
+
+/**
+ * @brief Returns an iterator for a specified persistent map.
+ *
+ * @note The iterator is initially positioned before the first key-value pair of
+ * the persistent map (if any). This means that
+ * `scu_persistent_map_iter_move_next()` must be called before accessing the
+ * first and subsequent key-value pairs with
+ * `scu_persistent_map_iter_current()`.
+ *
+ * As persistent maps are immutable, creating new versions while iterating is
+ * allowed.
+ *
+ * @param[in] map The persistent map to iterate over.
+ * @return An iterator for the specified persistent map.
+ */
+ScuPersistentMapIter scu_persistent_map_iter(const ScuPersistentMap* map);
+
+/**
+ * @brief Advances a specified persistent map iterator to the next key-value
+ * pair.
+ *
+ * @param[in, out] iter The iterator to advance.
+ * @return `true` if the iterator was successfully advanced to the next
+ * key-value pair, otherwise `false` (i.e., the persistent map does not contain
+ * any more key-value pairs).
+ */
+bool scu_persistent_map_iter_move_next(ScuPersistentMapIter* iter);
+
+/**
+ * @brief Returns the current key-value pair of a specified persistent map
+ * iterator.
+ *
+ * @param[in] iter The iterator to examine.
+ * @return An entry representing the current key-value pair of the iterator.
+ */
+ScuPersistentMapEntry scu_persistent_map_iter_current(
+    const ScuPersistentMapIter* iter
+);
+
+/**
+ * @brief Resets a specified persistent map iterator to its initial position.
+ *
+ * @note The iterator is initially positioned before the first key-value pair of
+ * the persistent map (if any). This means that
+ * `scu_persistent_map_iter_move_next()` must be called before accessing the
+ * first and subsequent key-value pairs with
+ * `scu_persistent_map_iter_current()`.
+ *
+ * @param[in, out] iter The iterator to reset.
+ */
+void scu_persistent_map_iter_reset(ScuPersistentMapIter* iter);
+
+/**
+ * @brief Deallocates a specified persistent map.
+ *
+ * @note If `map` is a `nullptr`, this function does nothing.
+ *
+ * Nodes shared with other versions of the map are only deallocated once the
+ * last version referring to them is deallocated.
+ *
+ * @warning This function only deallocates the memory occupied by the persistent
+ * map itself, but not the key-value pairs contained within. The caller is
+ * responsible for deallocating the individual keys and values if they are
+ * pointers to dynamically allocated objects and no other references to them
+ * exist.
+ *
+ * The behavior is undefined if the persistent map is used after it has been
+ * deallocated.
+ *
+ * @param[in, out] map The persistent map to deallocate.
+ */
+void scu_persistent_map_free(ScuPersistentMap* map);
+
+/**
+ * @brief Iterates over each key-value pair in a specified persistent map.
+ *
+ * This macro expands to a for loop that iterates over each key-value pair in
+ * the specified persistent map. During each iteration, the provided variable is
+ * assigned an entry representing the current key-value pair.
+ *
+ * The following example demonstrates the basic usage of this macro:
+ *
+ * ```c
+ * // K and V are the types of the keys and values stored in the map.
+ * ScuPersistentMap* map = scu_persistent_map_new(SCU_SIZEOF(K), ...);
+ * ...
+ * ScuPersistentMapEntry entry;
+ * SCU_PERSISTENT_MAP_FOREACH(entry, map) {
+ *     // Do something with the key and value.
+ *     const K* key = entry.key;
+ *     const V* value = entry.value;
+ * }
+ * ```
+ *
+ * @note The variable `entry` must be declared manually before the loop. It must
+ * be of type `ScuPersistentMapEntry`.
+ *
+ * @param[out] entry An entry representing the current key-value pair.
+ * @param[in]  map   The persistent map to iterate over.
+ */
+#define SCU_PERSISTENT_MAP_FOREACH(entry, map)                                 \
+    for (                                                                      \
+        ScuPersistentMapIter SCU_XCONCAT(it, __LINE__)                         \
+            = scu_persistent_map_iter(map);                                    \
+        scu_persistent_map_iter_move_next(&SCU_XCONCAT(it, __LINE__))          \
+            && (                                                               \
+                (entry) = scu_persistent_map_iter_current(                     \
+                    &SCU_XCONCAT(it, __LINE__)                                 \
+                ),                                                             \
+                true                                                           \
+            );                                                                 \
+    )
+
+#endif
\ No newline at end of file
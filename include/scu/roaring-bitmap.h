@@ -0,0 +1,390 @@
+#ifndef SCU_ROARING_BITMAP_H
+#define SCU_ROARING_BITMAP_H
+
+#include "scu/common.h"
+#include "scu/error.h"
+#include "scu/types.h"
+
+/**
+ * @brief Represents a compressed set of `Scuu32` values.
+ *
+ * A roaring bitmap partitions the 32-bit value space into chunks of 2^16 values
+ * sharing the same upper 16 bits. Each non-empty chunk is stored in a container
+ * chosen according to its contents:
+ *
+ * - An array container stores up to 4096 values as a sorted array of 16-bit
+ *   integers.
+ *
+ * - A bitmap container stores more than 4096 values as a fixed bitmap of 2^16
+ *   bits (8 KiB).
+ *
+ * - A run container stores a sorted list of runs of consecutive values, which
+ *   is the most compact representation for clustered data. Run containers are
+ *   created by `scu_roaring_bitmap_run_optimize()` (and when deserializing).
+ *
+ * Set operations are performed container by container, and operations on
+ * bitmap containers work on whole 64-bit words at once, which the compiler can
+ * vectorize using SIMD instructions (e.g., when compiling with `NATIVE`).
+ */
+typedef struct ScuRoaringBitmap ScuRoaringBitmap;
+
+/**
+ * @brief Represents an iterator for a roaring bitmap.
+ *
+ * @warning The internal representation of the iterator is an implementation
+ * detail and should not be relied upon. Most importantly, the behavior is
+ * undefined if its fields are accessed directly.
+ */
+typedef struct ScuRoaringBitmapIter {
+
+    /** @brief The roaring bitmap being iterated over. */
+    const ScuRoaringBitmap* bitmap;
+
+    /** @brief The index of the current container within the roaring bitmap. */
+    Scuisize containerIndex;
+
+    /** @brief The current position within the current container. */
+    Scuisize position;
+
+    /** @brief The current offset within the current run (if applicable). */
+    Scuisize offset;
+
+    /** @brief The current value. */
+    Scuu32 value;
+
+} ScuRoaringBitmapIter;
+
+/**
+ * @brief Allocates and initializes a new, empty roaring bitmap.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the roaring bitmap with
+ * `scu_roaring_bitmap_free()` when it is no longer needed.
+ *
+ * @return A pointer to the new roaring bitmap, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuRoaringBitmap* scu_roaring_bitmap_new();
+
+/**
+ * @brief Creates a copy of a specified roaring bitmap.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the cloned roaring bitmap
+ * with `scu_roaring_bitmap_free()` when it is no longer needed.
+ *
+ * @param[in] bitmap The roaring bitmap to clone.
+ * @return A pointer to the cloned roaring bitmap, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuRoaringBitmap* scu_roaring_bitmap_clone(const ScuRoaringBitmap* bitmap);
+
+/**
+ * @brief Returns the number of values in a specified roaring bitmap.
+ *
+ * @note The cardinality of each container is cached, so this function only
+ * needs time proportional to the number of containers.
+ *
+ * @param[in] bitmap The roaring bitmap to examine.
+ * @return The number of values in the specified roaring bitmap.
+ */
+Scuisize scu_roaring_bitmap_count(const ScuRoaringBitmap* bitmap);
+
+/**
+ * @brief Adds a value to a specified roaring bitmap.
+ *
+ * @note Adding a value that is already present has no effect.
+ *
+ * This function dynamically allocates memory using `scu_malloc()` and
+ * `scu_realloc()`.
+ *
+ * @param[in, out] bitmap The roaring bitmap to add the value to.
+ * @param[in]      value  The value to add.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred
+ * (in which case the roaring bitmap is left unchanged), or `SCU_ERROR_NONE` on
+ * success.
+ */
+ScuError scu_roaring_bitmap_add(ScuRoaringBitmap* bitmap, Scuu32 value);
+
+/**
+ * @brief Determines if a specified roaring bitmap contains a value.
+ *
+ * @param[in] bitmap The roaring bitmap to search.
+ * @param[in] value  The value to search for.
+ * @return `true` if the value is contained in the roaring bitmap, otherwise
+ * `false`.
+ */
+bool scu_roaring_bitmap_contains(const ScuRoaringBitmap* bitmap, Scuu32 value);
+
+/**
+ * @brief Removes a value from a specified roaring bitmap.
+ *
+ * @note Removing a value that is not present has no effect.
+ *
+ * This function dynamically allocates memory using `scu_malloc()` and
+ * `scu_realloc()`, which may be necessary to split a run of values or to
+ * convert a container into a more compact representation.
+ *
+ * @param[in, out] bitmap The roaring bitmap to remove the value from.
+ * @param[in]      value  The value to remove.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred
+ * (in which case the roaring bitmap is left unchanged), or `SCU_ERROR_NONE` on
+ * success.
+ */
+ScuError scu_roaring_bitmap_remove(ScuRoaringBitmap* bitmap, Scuu32 value);
+
+/**
+ * @brief Removes all values from a specified roaring bitmap.
+ *
+ * @param[in, out] bitmap The roaring bitmap to clear.
+ */
+void scu_roaring_bitmap_clear(ScuRoaringBitmap* bitmap);
+
+/**
+ * @brief Converts the containers of a specified roaring bitmap into run
+ * containers where this reduces their size, and vice versa.
+ *
+ * @note Calling this function after adding a large number of (clustered)
+ * values, e.g., after building a posting list, can reduce the memory usage and
+ * serialized size of the roaring bitmap considerably.
+ *
+ * This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @param[in, out] bitmap The roaring bitmap to optimize.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred
+ * (in which case some containers may not have been optimized), or
+ * `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_roaring_bitmap_run_optimize(ScuRoaringBitmap* bitmap);
+
+/**
+ * @brief Computes the intersection of two roaring bitmaps.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the resulting roaring
+ * bitmap with `scu_roaring_bitmap_free()` when it is no longer needed.
+ *
+ * @param[in] left  The first roaring bitmap.
+ * @param[in] right The second roaring bitmap.
+ * @return A pointer to a new roaring bitmap containing the values present in
+ * both `left` and `right`, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuRoaringBitmap* scu_roaring_bitmap_and(
+    const ScuRoaringBitmap* left,
+    const ScuRoaringBitmap* right
+);
+
+/**
+ * @brief Computes the union of two roaring bitmaps.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the resulting roaring
+ * bitmap with `scu_roaring_bitmap_free()` when it is no longer needed.
+ *
+ * @param[in] left  The first roaring bitmap.
+ * @param[in] right The second roaring bitmap.
+ * @return A pointer to a new roaring bitmap containing the values present in
+ * `left` or `right` (or both), or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuRoaringBitmap* scu_roaring_bitmap_or(
+    const ScuRoaringBitmap* left,
+    const ScuRoaringBitmap* right
+);
+
+/**
+ * @brief Computes the difference of two roaring bitmaps.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the resulting roaring
+ * bitmap with `scu_roaring_bitmap_free()` when it is no longer needed.
+ *
+ * @param[in] left  The first roaring bitmap.
+ * @param[in] right The second roaring bitmap.
+ * @return A pointer to a new roaring bitmap containing the values present in
+ * `left` but not in `right`, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuRoaringBitmap* scu_roaring_bitmap_andnot(
+    const ScuRoaringBitmap* left,
+    const ScuRoaringBitmap* right
+);
+
+/**
+ * @brief Computes the symmetric difference of two roaring bitmaps.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the resulting roaring
+ * bitmap with `scu_roaring_bitmap_free()` when it is no longer needed.
+ *
+ * @param[in] left  The first roaring bitmap.
+ * @param[in] right The second roaring bitmap.
+ * @return A pointer to a new roaring bitmap containing the values present in
+ * exactly one of `left` and `right`, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuRoaringBitmap* scu_roaring_bitmap_xor(
+    const ScuRoaringBitmap* left,
+    const ScuRoaringBitmap* right
+);
+
+/**
+ * @brief Returns the number of bytes required to serialize a specified roaring
+ * bitmap.
+ *
+ * @param[in] bitmap The roaring bitmap to examine.
+ * @return The number of bytes required to serialize the roaring bitmap.
+ */
+Scuisize scu_roaring_bitmap_serialized_size(const ScuRoaringBitmap* bitmap);
+
+/**
+ * @brief Serializes a specified roaring bitmap into a buffer.
+ *
+ * The serialized representation is independent of the byte order of the host
+ * and preserves the container types. It can be restored with
+ * `scu_roaring_bitmap_deserialize()`, e.g., after writing it to a file with
+ * `scu_fwrite()`.
+ *
+ * @warning The behavior is undefined if `buffer` is not a pointer to a buffer
+ * of at least `scu_roaring_bitmap_serialized_size(bitmap)` bytes.
+ *
+ * @param[in]  bitmap The roaring bitmap to serialize.
+ * @param[out] buffer The buffer to serialize the roaring bitmap into.
+ */
+void scu_roaring_bitmap_serialize(
+    const ScuRoaringBitmap* restrict bitmap,
+    void* restrict buffer
+);
+
+/**
+ * @brief Deserializes a roaring bitmap previously serialized with
+ * `scu_roaring_bitmap_serialize()`.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning If the operation succeeds, the roaring bitmap returned via `*bitmap`
+ * must be deallocated with `scu_roaring_bitmap_free()` when it is no longer
+ * needed.
+ *
+ * @param[out] bitmap A pointer to the deserialized roaring bitmap, or `nullptr`
+ *                    on failure.
+ * @param[in]  buffer The buffer to deserialize the roaring bitmap from.
+ * @param[in]  size   The size of the buffer (in bytes).
+ * @return `SCU_ERROR_INVALID_FORMAT` if the buffer does not contain a valid
+ * serialized roaring bitmap, `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory
+ * condition occurred, or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_roaring_bitmap_deserialize(
+    ScuRoaringBitmap* restrict* restrict bitmap,
+    const void* restrict buffer,
+    Scuisize size
+);
+
+/**
+ * @brief Returns an iterator for a specified roaring bitmap.
+ *
+ * @note The iterator is initially positioned before the smallest value of the
+ * roaring bitmap (if any). This means that
+ * `scu_roaring_bitmap_iter_move_next()` must be called before accessing the
+ * first and subsequent values with `scu_roaring_bitmap_iter_current()`. Values are visited in ascending order.
+ *
+ * @warning The behavior is undefined if the roaring bitmap being iterated over
+ * is modified (e.g., values are added or removed) while the iterator is in use.
+ *
+ * @param[in] bitmap The roaring bitmap to iterate over.
+ * @return An iterator for the specified roaring bitmap.
+ */
+ScuRoaringBitmapIter scu_roaring_bitmap_iter(const ScuRoaringBitmap* bitmap);
+
+/**
+ * @brief Advances a specified roaring bitmap iterator to the next value.
+ *
+ * @param[in, out] iter The iterator to advance.
+ * @return `true` if the iterator was successfully advanced to the next value,
+ * otherwise `false` (i.e., the roaring bitmap does not contain any more
+ * values).
+ */
+bool scu_roaring_bitmap_iter_move_next(ScuRoaringBitmapIter* iter);
+
+/**
+ * @brief Returns the current value of a specified roaring bitmap iterator.
+ *
+ * @param[in] iter The iterator to examine.
+ * @return The current value.
+ */
+Scuu32 scu_roaring_bitmap_iter_current(const ScuRoaringBitmapIter* iter);
+
+/**
+ * @brief Resets a specified roaring bitmap iterator to its initial position.
+ *
+ * @note The iterator is initially positioned before the smallest value of the
+ * roaring bitmap (if any). This means that
+ * `scu_roaring_bitmap_iter_move_next()` must be called before accessing the
+ * first and subsequent values with `scu_roaring_bitmap_iter_current()`.
+ *
+ * @param[in, out] iter The iterator to reset.
+ */
+void scu_roaring_bitmap_iter_reset(ScuRoaringBitmapIter* iter);
+
+/**
+ * @brief Deallocates a specified roaring bitmap.
+ *
+ * @note If `bitmap` is a `nullptr`, this function does nothing.
+ *
+ * @warning The behavior is undefined if the roaring bitmap is used after it has
+ * been deallocated.
+ *
+ * @param[in, out] bitmap The roaring bitmap to deallocate.
+ */
+void scu_roaring_bitmap_free(ScuRoaringBitmap* bitmap);
+
+/**
+ * @brief Iterates over each value in a specified roaring bitmap in ascending
+ * order.
+ *
+ * This macro expands to a for loop that iterates over each value in the
+ * specified roaring bitmap. During each iteration, the provided variable is
+ * assigned the current value.
+ *
+ * The following example demonstrates the basic usage of this macro:
+ *
+ * ```c
+ * ScuRoaringBitmap* ids = scu_roaring_bitmap_new();
+ * ...
+ * Scuu32 id;
+ * SCU_ROARING_BITMAP_FOREACH(id, ids) {
+ *     // Do something with id.
+ * }
+ * ```
+ *
+ * @note The variable `value` must be declared manually before the loop. It must
+ * be of type `Scuu32`.
+ *
+ * @warning The behavior is undefined if the roaring bitmap is modified (e.g.,
+ * values are added or removed) while being iterated over.
+ *
+ * @param[out] value  The current value during each iteration.
+ * @param[in]  bitmap The roaring bitmap to iterate over.
+ */
+#define SCU_ROARING_BITMAP_FOREACH(value, bitmap)                            \
+    for (                                                                    \
+        ScuRoaringBitmapIter SCU_XCONCAT(it, __LINE__)                       \
+            = scu_roaring_bitmap_iter(bitmap);                               \
+        scu_roaring_bitmap_iter_move_next(&SCU_XCONCAT(it, __LINE__))        \
+            && (                                                             \
+                (value)                                                      \
+                    = scu_roaring_bitmap_iter_current(                       \
+                        &SCU_XCONCAT(it, __LINE__)                           \
+                    ),                                                       \
+                true                                                         \
+            );                                                               \
+    )
+
+#endif
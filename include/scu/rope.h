@@ -0,0 +1,387 @@
+#ifndef SCU_ROPE_H
+#define SCU_ROPE_H
+
+#include "scu/common.h"
+#include "scu/error.h"
+#include "scu/types.h"
+
+/**
+ * @brief Represents a sequence of bytes that can be edited efficiently at
+ * arbitrary positions.
+ *
+ * A rope stores its bytes in small chunks at the leaves of a balanced binary
+ * tree. Every node caches the number of bytes and newlines (`'\n'`) below it,
+ * so inserting, removing and splitting off bytes at any position, as well as
+ * looking up the start of a line, take `O(log(n))` time instead of the `O(n)`
+ * time required for a contiguous buffer. This makes ropes well suited for
+ * large text documents which are subject to many small edits.
+ *
+ * Bytes are referred to by their index in the range
+ * `[0, scu_rope_length(rope))`, and lines by their index in the range
+ * `[0, scu_rope_line_count(rope))`. A line ends after its terminating newline
+ * (if any).
+ */
+typedef struct ScuRope ScuRope;
+
+/**
+ * @brief Represents an iterator for the chunks of a rope.
+ *
+ * @warning The internal representation of the iterator is an implementation
+ * detail and should not be relied upon. Most importantly, the behavior is
+ * undefined if its fields are accessed directly.
+ */
+typedef struct ScuRopeIter {
+
+    /** @brief The rope being iterated over. */
+    const ScuRope* rope;
+
+    /** @brief The number of nodes on the stack. */
+    Scuisize depth;
+
+    /**
+     * @brief The nodes still to be visited.
+     *
+     * @note The tree is balanced, so its height is far below the size of the
+     * stack for any rope that fits into memory.
+     */
+    const void* nodes[96];
+
+    /** @brief The current chunk, or `nullptr` if there is none. */
+    const void* current;
+
+} ScuRopeIter;
+
+/** @brief Represents a contiguous chunk of bytes of a rope. */
+typedef struct ScuRopeChunk {
+
+    /** @brief The bytes of the chunk. */
+    const char* bytes;
+
+    /** @brief The number of bytes of the chunk. */
+    Scuisize count;
+
+} ScuRopeChunk;
+
+/**
+ * @brief Allocates and initializes a new, empty rope.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the rope with
+ * `scu_rope_free()` when it is no longer needed.
+ *
+ * @return A pointer to the new rope, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuRope* scu_rope_new();
+
+/**
+ * @brief Allocates and initializes a new rope containing a copy of a specified
+ * sequence of bytes.
+ *
+ * @note If `count` is zero, `bytes` is ignored and it may even be a `nullptr`.
+ *
+ * This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the rope with
+ * `scu_rope_free()` when it is no longer needed.
+ *
+ * @param[in] bytes The bytes to copy.
+ * @param[in] count The number of bytes to copy.
+ * @return A pointer to the new rope, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuRope* scu_rope_from_bytes(const char* bytes, Scuisize count);
+
+/**
+ * @brief Creates a copy of a specified rope.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the cloned rope with
+ * `scu_rope_free()` when it is no longer needed.
+ *
+ * @param[in] rope The rope to clone.
+ * @return A pointer to the cloned rope, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuRope* scu_rope_clone(const ScuRope* rope);
+
+/**
+ * @brief Returns the number of bytes of a specified rope.
+ *
+ * @param[in] rope The rope to examine.
+ * @return The number of bytes of the specified rope.
+ */
+Scuisize scu_rope_length(const ScuRope* rope);
+
+/**
+ * @brief Returns the number of lines of a specified rope.
+ *
+ * @note The number of lines is always one more than the number of newlines, so
+ * an empty rope consists of a single, empty line.
+ *
+ * @param[in] rope The rope to examine.
+ * @return The number of lines of the specified rope.
+ */
+Scuisize scu_rope_line_count(const ScuRope* rope);
+
+/**
+ * @brief Returns the byte at a specified index of a specified rope.
+ *
+ * @warning The behavior is undefined if `index` is not in the range
+ * `[0, scu_rope_length(rope))`.
+ *
+ * @param[in] rope  The rope to examine.
+ * @param[in] index The index of the byte.
+ * @return The byte at the specified index.
+ */
+char scu_rope_byte_at(const ScuRope* rope, Scuisize index);
+
+/**
+ * @brief Copies a range of bytes of a specified rope into a buffer.
+ *
+ * @warning The behavior is undefined if the range `[index, index + count)` is
+ * not within `[0, scu_rope_length(rope)]`, or if `buffer` is not a pointer to
+ * an array of at least `count` bytes.
+ *
+ * @param[in]  rope   The rope to copy the bytes from.
+ * @param[in]  index  The index of the first byte to copy.
+ * @param[in]  count  The number of bytes to copy.
+ * @param[out] buffer The buffer to copy the bytes into.
+ */
+void scu_rope_copy_to(
+    const ScuRope* restrict rope,
+    Scuisize index,
+    Scuisize count,
+    char* restrict buffer
+);
+
+/**
+ * @brief Inserts a sequence of bytes at a specified index into a specified
+ * rope.
+ *
+ * @note Note that `index` may be equal to `scu_rope_length(rope)`, in which
+ * case the bytes are appended to the end of the rope. If `count` is zero,
+ * `bytes` is ignored and it may even be a `nullptr`.
+ *
+ * This function dynamically allocates memory using `scu_malloc()`. If an error
+ * occurs, the rope is left unchanged.
+ *
+ * @warning The behavior is undefined if `index` is not in the range
+ * `[0, scu_rope_length(rope)]`.
+ *
+ * @param[in, out] rope  The rope to insert the bytes into.
+ * @param[in]      index The index at which to insert the bytes.
+ * @param[in]      bytes The bytes to insert.
+ * @param[in]      count The number of bytes to insert.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_rope_insert(
+    ScuRope* restrict rope,
+    Scuisize index,
+    const char* restrict bytes,
+    Scuisize count
+);
+
+/**
+ * @brief Removes a range of bytes from a specified rope.
+ *
+ * @note This function may dynamically allocate memory using `scu_malloc()`, as
+ * the chunks at both ends of the range have to be split. If an error occurs,
+ * the rope is left unchanged.
+ *
+ * @warning The behavior is undefined if the range `[index, index + count)` is
+ * not within `[0, scu_rope_length(rope)]`.
+ *
+ * @param[in, out] rope  The rope to remove the bytes from.
+ * @param[in]      index The index of the first byte to remove.
+ * @param[in]      count The number of bytes to remove.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_rope_remove_range(ScuRope* rope, Scuisize index, Scuisize count);
+
+/**
+ * @brief Creates a new rope containing a copy of a range of bytes of a
+ * specified rope.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the new rope with
+ * `scu_rope_free()` when it is no longer needed. The behavior is undefined if
+ * the range `[index, index + count)` is not within
+ * `[0, scu_rope_length(rope)]`.
+ *
+ * @param[in] rope  The rope to copy the bytes from.
+ * @param[in] index The index of the first byte to copy.
+ * @param[in] count The number of bytes to copy.
+ * @return A pointer to the new rope, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuRope* scu_rope_slice(const ScuRope* rope, Scuisize index, Scuisize count);
+
+/**
+ * @brief Splits a specified rope at a specified index, moving all bytes at and
+ * after the index into a new rope.
+ *
+ * @note In contrast to `scu_rope_slice()`, no bytes are copied besides the
+ * chunk containing the index, so this function takes `O(log(n))` time.
+ *
+ * This function dynamically allocates memory using `scu_malloc()`. If an error
+ * occurs, the rope is left unchanged.
+ *
+ * @warning The caller is responsible for deallocating the new rope with
+ * `scu_rope_free()` when it is no longer needed. The behavior is undefined if
+ * `index` is not in the range `[0, scu_rope_length(rope)]`.
+ *
+ * @param[in, out] rope  The rope to split.
+ * @param[in]      index The index at which to split the rope.
+ * @return A pointer to the new rope, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuRope* scu_rope_split_off(ScuRope* rope, Scuisize index);
+
+/**
+ * @brief Moves all bytes of a specified rope to the end of another rope.
+ *
+ * @note This function takes `O(log(n))` time. Afterwards, `other` is empty but
+ * still has to be deallocated by the caller.
+ *
+ * This function dynamically allocates memory using `scu_malloc()`. If an error
+ * occurs, both ropes are left unchanged.
+ *
+ * @warning The behavior is undefined if `rope` and `other` are the same rope.
+ *
+ * @param[in, out] rope  The rope to append the bytes to.
+ * @param[in, out] other The rope whose bytes to move.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_rope_append(ScuRope* restrict rope, ScuRope* restrict other);
+
+/**
+ * @brief Returns the index of the first byte of a specified line of a
+ * specified rope.
+ *
+ * @warning The behavior is undefined if `line` is not in the range
+ * `[0, scu_rope_line_count(rope))`.
+ *
+ * @param[in] rope The rope to examine.
+ * @param[in] line The index of the line.
+ * @return The index of the first byte of the line. For an empty last line, this
+ * is `scu_rope_length(rope)`.
+ */
+Scuisize scu_rope_line_start(const ScuRope* rope, Scuisize line);
+
+/**
+ * @brief Returns the index of the line containing a specified byte of a
+ * specified rope.
+ *
+ * @note A newline belongs to the line it terminates.
+ *
+ * @warning The behavior is undefined if `index` is not in the range
+ * `[0, scu_rope_length(rope)]`.
+ *
+ * @param[in] rope  The rope to examine.
+ * @param[in] index The index of the byte.
+ * @return The index of the line containing the byte, i.e., the number of
+ * newlines before it.
+ */
+Scuisize scu_rope_line_of(const ScuRope* rope, Scuisize index);
+
+/**
+ * @brief Returns an iterator for the chunks of a specified rope.
+ *
+ * @note The iterator is initially positioned before the first chunk of the rope
+ * (if any). This means that `scu_rope_iter_move_next()` must be called before
+ * accessing the first and subsequent chunks with `scu_rope_iter_current()`.
+ *
+ * The chunks are visited in order and together contain all bytes of the rope.
+ * They can be passed to functions such as `scu_fwrite()` directly.
+ *
+ * @warning The behavior is undefined if the rope being iterated over is
+ * modified while the iterator is in use.
+ *
+ * @param[in] rope The rope to iterate over.
+ * @return An iterator for the specified rope.
+ */
+ScuRopeIter scu_rope_iter(const ScuRope* rope);
+
+/**
+ * @brief Advances a specified rope iterator to the next chunk.
+ *
+ * @param[in, out] iter The iterator to advance.
+ * @return `true` if the iterator was successfully advanced to the next chunk,
+ * otherwise `false` (i.e., the rope does not contain any more chunks).
+ */
+bool scu_rope_iter_move_next(ScuRopeIter* iter);
+
+/**
+ * @brief Returns the current chunk of a specified rope iterator.
+ *
+ * @param[in] iter The iterator to examine.
+ * @return The current chunk of the iterator.
+ */
+ScuRopeChunk scu_rope_iter_current(const ScuRopeIter* iter);
+
+/**
+ * @brief Resets a specified rope iterator to its initial position.
+ *
+ * @note The iterator is initially positioned before the first chunk of the rope
+ * (if any). This means that `scu_rope_iter_move_next()` must be called before
+ * accessing the first and subsequent chunks with `scu_rope_iter_current()`.
+ *
+ * @param[in, out] iter The iterator to reset.
+ */
+void scu_rope_iter_reset(ScuRopeIter* iter);
+
+/**
+ * @brief Deallocates a specified rope.
+ *
+ * @note If `rope` is a `nullptr`, this function does nothing.
+ *
+ * @warning The behavior is undefined if the rope is used after it has been
+ * deallocated.
+ *
+ * @param[in, out] rope The rope to deallocate.
+ */
+void scu_rope_free(ScuRope* rope);
+
+/**
+ * @brief Iterates over each chunk of a specified rope.
+ *
+ * This macro expands to a for loop that iterates over each chunk of the
+ * specified rope in order. During each iteration, the provided variable is
+ * assigned the current chunk.
+ *
+ * The following example demonstrates how to write a rope to a file:
+ *
+ * ```c
+ * ScuRope* document = scu_rope_from_bytes(...);
+ * ...
+ * ScuRopeChunk chunk;
+ * SCU_ROPE_FOREACH(chunk, document) {
+ *     scu_fwrite(file, chunk.bytes, chunk.count, 1);
+ * }
+ * ```
+ *
+ * @note The variable `chunk` must be declared manually before the loop. It must
+ * be of type `ScuRopeChunk`.
+ *
+ * @warning The behavior is undefined if the rope is modified while being
+ * iterated over.
+ *
+ * @param[out] chunk The current chunk during each iteration.
+ * @param[in]  rope  The rope to iterate over.
+ */
+#define SCU_ROPE_FOREACH(chunk, rope)                                          \
+    for (                                                                      \
+        ScuRopeIter SCU_XCONCAT(it, __LINE__) = scu_rope_iter(rope);           \
+        scu_rope_iter_move_next(&SCU_XCONCAT(it, __LINE__))                    \
+            && ((chunk) = scu_rope_iter_current(&SCU_XCONCAT(it, __LINE__)),   \
+                true);                                                         \
+    )
+
+#endif
\ No newline at end of file
@@ -2,25 +2,46 @@
 #define SCU_H
 
 #include "scu/alloc.h"
+#include "scu/append-log.h"
 #include "scu/array.h"
 #include "scu/assert.h"
+#include "scu/async-io.h"
 #include "scu/bench.h"
+#include "scu/bit-set.h"
+#include "scu/bloom-filter.h"
 #include "scu/common.h"
 #include "scu/compare.h"
+#include "scu/compress.h"
+#include "scu/concurrent-disjoint-set.h"
+#include "scu/count-min-sketch.h"
+#include "scu/disjoint-set.h"
 #include "scu/equal.h"
 #include "scu/error.h"
+#include "scu/flat-map.h"
+#include "scu/flat-set.h"
+#include "scu/graph.h"
 #include "scu/hash-map.h"
 #include "scu/hash-set.h"
 #include "scu/hash.h"
+#include "scu/heavy-hitters.h"
+#include "scu/hyper-log-log.h"
 #include "scu/io.h"
+#include "scu/line-reader.h"
 #include "scu/list.h"
+#include "scu/lru-cache.h"
 #include "scu/math.h"
 #include "scu/memory.h"
+#include "scu/min-max-heap.h"
+#include "scu/persistent-map.h"
 #include "scu/prio-queue.h"
 #include "scu/queue.h"
+#include "scu/roaring-bitmap.h"
+#include "scu/rope.h"
+#include "scu/skip-list.h"
 #include "scu/stack.h"
 #include "scu/string.h"
 #include "scu/time.h"
+#include "scu/tiny-lfu-cache.h"
 #include "scu/types.h"
 
 /** @brief The major version number of SCU. */
@@ -0,0 +1,278 @@
+#ifndef SCU_SKIP_LIST_H
+#define SCU_SKIP_LIST_H
+
+#include "scu/common.h"
+#include "scu/compare.h"
+#include "scu/error.h"
+#include "scu/types.h"
+
+/**
+ * @brief Represents an ordered collection of key-value pairs that can be
+ * modified and queried by multiple threads at the same time.
+ *
+ * All operations except `scu_skip_list_free()` may be called concurrently.
+ * Adding a key-value pair is lock-free: each level of the new node is linked
+ * into the list with a single compare-and-swap, and a thread losing the race
+ * simply retries from its current position. Lookups and iteration never wait
+ * for or retry because of other threads.
+ *
+ * Nodes are allocated from an internal arena and never move, so pointers to
+ * keys and values remain valid until the skip list is deallocated. In turn,
+ * key-value pairs can not be removed individually.
+ *
+ * @note Values may be modified in place, but the skip list does not synchronize
+ * such modifications in any way.
+ */
+typedef struct ScuSkipList ScuSkipList;
+
+/**
+ * @brief Represents an iterator for a skip list.
+ *
+ * @warning The internal representation of the iterator is an implementation
+ * detail and should not be relied upon. Most importantly, the behavior is
+ * undefined if its fields are accessed directly.
+ */
+typedef struct ScuSkipListIter {
+
+    /** @brief The skip list being iterated over. */
+    ScuSkipList* skipList;
+
+    /** @brief The current node within the skip list. */
+    void* node;
+
+} ScuSkipListIter;
+
+/** @brief Represents an entry in a skip list. */
+typedef struct ScuSkipListEntry {
+
+    /** @brief The key of the entry. */
+    const void* key;
+
+    /** @brief The value of the entry. */
+    void* value;
+
+} ScuSkipListEntry;
+
+/**
+ * @brief Allocates and initializes a new, empty skip list with specified key
+ * size, value size and key comparison function.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the skip list with
+ * `scu_skip_list_free()` when it is no longer needed.
+ *
+ * @param[in] keySize   The size of each key (in bytes).
+ * @param[in] valueSize The size of each value (in bytes).
+ * @param[in] cmpFunc   A comparison function used to determine the order of the
+ *                      keys.
+ * @return A pointer to the new skip list, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuSkipList* scu_skip_list_new(
+    Scuisize keySize,
+    Scuisize valueSize,
+    ScuCompareFunc* cmpFunc
+);
+
+/**
+ * @brief Returns the number of key-value pairs of a specified skip list.
+ *
+ * @note If other threads are adding key-value pairs at the same time, the
+ * returned value may already be outdated.
+ *
+ * @param[in] skipList The skip list to examine.
+ * @return The number of key-value pairs of the specified skip list.
+ */
+Scuisize scu_skip_list_count(const ScuSkipList* skipList);
+
+/**
+ * @brief Tries to add a new key-value pair to a specified skip list.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`. Memory
+ * is allocated in large chunks shared by many nodes.
+ *
+ * @param[in, out] skipList The skip list to add the key-value pair to.
+ * @param[in]      key      The key to add.
+ * @param[in]      value    The value to associate with the key.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * `SCU_ERROR_ALREADY_PRESENT` if the key is already present in the skip list,
+ * or `SCU_ERROR_NONE` on success.
+ */
+ScuError scu_skip_list_try_add(
+    ScuSkipList* restrict skipList,
+    const void* restrict key,
+    const void* restrict value
+);
+
+/**
+ * @brief Tries to get the value associated with a key in a specified skip list.
+ *
+ * @note This function is an implementation detail and not intended to be called
+ * directly. Use the `scu_skip_list_try_get()` macro instead.
+ *
+ * @param[in]  skipList The skip list to examine.
+ * @param[in]  key      The key to look up.
+ * @param[out] value    A pointer to the value associated with the specified
+ *                      key on success, otherwise a `nullptr`.
+ * @return `true` if the key was present in the skip list, otherwise `false`.
+ */
+bool scu_skip_list_try_get_impl(
+    const ScuSkipList* restrict skipList,
+    const void* restrict key,
+    void* restrict* restrict value
+);
+
+/**
+ * @brief Tries to get the value associated with a key in a specified skip list.
+ *
+ * @param[in]  skipList The skip list to examine.
+ * @param[in]  key      The key to look up.
+ * @param[out] value    A pointer to the value associated with the specified
+ *                      key on success, otherwise a `nullptr`.
+ * @return `true` if the key was present in the skip list, otherwise `false`.
+ */
+#define scu_skip_list_try_get(skipList, key, value)             \
+    scu_skip_list_try_get_impl(skipList, key, (void**) (value))
+
+/**
+ * @brief Determines whether a key is present in a specified skip list.
+ *
+ * @param[in] skipList The skip list to examine.
+ * @param[in] key      The key to search for.
+ * @return `true` if the key is present in the skip list, otherwise `false`.
+ */
+bool scu_skip_list_contains_key(
+    const ScuSkipList* restrict skipList,
+    const void* restrict key
+);
+
+/**
+ * @brief Returns an iterator for a specified skip list.
+ *
+ * @note The iterator is initially positioned before the first key-value pair of
+ * the skip list (if any). This means that `scu_skip_list_iter_move_next()` must
+ * be called before accessing the first and subsequent key-value pairs with
+ * `scu_skip_list_iter_current()`.
+ *
+ * The key-value pairs are visited in ascending order of their keys. Other
+ * threads may add key-value pairs while the iterator is in use. Those added
+ * after the current position of the iterator may or may not be visited, but
+ * no key-value pair is visited more than once.
+ *
+ * @param[in] skipList The skip list to iterate over.
+ * @return An iterator for the specified skip list.
+ */
+ScuSkipListIter scu_skip_list_iter(const ScuSkipList* skipList);
+
+/**
+ * @brief Positions a specified skip list iterator before the first key-value
+ * pair whose key is not less than a specified key.
+ *
+ * @note After this call, `scu_skip_list_iter_move_next()` advances the iterator
+ * to the smallest key not less than `key` (if any), which allows iterating
+ * over a range of keys.
+ *
+ * @param[in, out] iter The iterator to position.
+ * @param[in]      key  The key to search for.
+ */
+void scu_skip_list_iter_seek(
+    ScuSkipListIter* restrict iter,
+    const void* restrict key
+);
+
+/**
+ * @brief Advances a specified skip list iterator to the next key-value pair.
+ *
+ * @note If `false` is returned, the iterator keeps its position, so a later
+ * call may still advance it to key-value pairs added in the meantime.
+ *
+ * @param[in, out] iter The iterator to advance.
+ * @return `true` if the iterator was successfully advanced to the next
+ * key-value pair, otherwise `false` (i.e., the skip list does not contain any
+ * more key-value pairs).
+ */
+bool scu_skip_list_iter_move_next(ScuSkipListIter* iter);
+
+/**
+ * @brief Returns the current key-value pair of a specified skip list iterator.
+ *
+ * @param[in] iter The iterator to examine.
+ * @return An entry representing the current key-value pair of the iterator.
+ */
+ScuSkipListEntry scu_skip_list_iter_current(const ScuSkipListIter* iter);
+
+/**
+ * @brief Resets a specified skip list iterator to its initial position.
+ *
+ * @note The iterator is initially positioned before the first key-value pair of
+ * the skip list (if any). This means that `scu_skip_list_iter_move_next()` must
+ * be called before accessing the first and subsequent key-value pairs with
+ * `scu_skip_list_iter_current()`.
+ *
+ * @param[in, out] iter The iterator to reset.
+ */
+void scu_skip_list_iter_reset(ScuSkipListIter* iter);
+
+/**
+ * @brief Deallocates a specified skip list.
+ *
+ * @note If `skipList` is a `nullptr`, this function does nothing.
+ *
+ * @warning This function must not be called while other threads are still
+ * using the skip list. It only deallocates the memory occupied by the skip list
+ * itself, but not the key-value pairs contained within. The caller is
+ * responsible for deallocating the individual keys and values if they are
+ * pointers to dynamically allocated objects and no other references to them
+ * exist.
+ *
+ * The behavior is undefined if the skip list is used after it has been
+ * deallocated.
+ *
+ * @param[in, out] skipList The skip list to deallocate.
+ */
+void scu_skip_list_free(ScuSkipList* skipList);
+
+/**
+ * @brief Iterates over each key-value pair in a specified skip list in
+ * ascending order of the keys.
+ *
+ * This macro expands to a for loop that iterates over each key-value pair in
+ * the specified skip list. During each iteration, the provided variable is
+ * assigned an entry representing the current key-value pair.
+ *
+ * The following example demonstrates the basic usage of this macro:
+ *
+ * ```c
+ * // K and V are the types of the keys and values stored in the skip list.
+ * ScuSkipList* skipList = scu_skip_list_new(SCU_SIZEOF(K), ...);
+ * ...
+ * ScuSkipListEntry entry;
+ * SCU_SKIP_LIST_FOREACH(entry, skipList) {
+ *     // Do something with the key and value.
+ *     const K* key = entry.key;
+ *     V* value = entry.value;
+ * }
+ * ```
+ *
+ * @note The variable `entry` must be declared manually before the loop. It must
+ * be of type `ScuSkipListEntry`.
+ *
+ * @param[out] entry    An entry representing the current key-value pair.
+ * @param[in]  skipList The skip list to iterate over.
+ */
+#define SCU_SKIP_LIST_FOREACH(entry, skipList)                                 \
+    for (                                                                      \
+        ScuSkipListIter SCU_XCONCAT(it, __LINE__) = scu_skip_list_iter(        \
+            skipList                                                           \
+        );                                                                     \
+        scu_skip_list_iter_move_next(&SCU_XCONCAT(it, __LINE__))               \
+            && (                                                               \
+                (entry) = scu_skip_list_iter_current(                          \
+                    &SCU_XCONCAT(it, __LINE__)                                 \
+                ),                                                             \
+                true                                                           \
+            );                                                                 \
+    )
+
+#endif
\ No newline at end of file
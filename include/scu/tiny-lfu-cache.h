@@ -0,0 +1,274 @@
+#ifndef SCU_TINY_LFU_CACHE_H
+#define SCU_TINY_LFU_CACHE_H
+
+#include "scu/equal.h"
+#include "scu/hash.h"
+#include "scu/types.h"
+
+/**
+ * @brief Represents a cache of key-value pairs with a W-TinyLFU admission and
+ * eviction policy.
+ *
+ * New entries are first inserted into a small window LRU (about 1% of the
+ * capacity). Entries leaving the window compete with the least recently used
+ * entry of the main cache, a segmented LRU consisting of a probation and a
+ * protected segment, and only the one that was accessed more frequently is
+ * kept. Access frequencies are estimated by a Count-Min sketch with 4-bit
+ * counters, which are halved periodically so that old accesses age out.
+ *
+ * In contrast to `ScuLruCache`, a scan over many keys that are accessed only
+ * once can not flush frequently accessed entries out of the cache.
+ *
+ * @note All entries are stored in a flat arena allocated upfront, so lookups,
+ * insertions and evictions run in constant time and never allocate memory.
+ */
+typedef struct ScuTinyLfuCache ScuTinyLfuCache;
+
+/**
+ * @brief Represents a function that is called whenever an entry leaves a cache.
+ *
+ * @note The function is called for entries that are evicted or rejected,
+ * replaced by `scu_tiny_lfu_cache_put()`, removed with
+ * `scu_tiny_lfu_cache_remove()` or cleared with `scu_tiny_lfu_cache_clear()`.
+ *
+ * @warning The function must not access the cache.
+ *
+ * @param[in, out] context The context passed to
+ *                         `scu_tiny_lfu_cache_set_evict_func()`.
+ * @param[in]      key     A pointer to the key of the entry.
+ * @param[in, out] value   A pointer to the value of the entry.
+ */
+typedef void ScuTinyLfuCacheEvictFunc(
+    void* context,
+    const void* key,
+    void* value
+);
+
+/** @brief Represents statistics about the usage of a cache. */
+typedef struct ScuTinyLfuCacheStats {
+
+    /** @brief The number of lookups that found an entry. */
+    Scuu64 hits;
+
+    /** @brief The number of lookups that did not find an entry. */
+    Scuu64 misses;
+
+    /** @brief The number of entries inserted. */
+    Scuu64 insertions;
+
+    /**
+     * @brief The number of entries evicted to make room for other entries.
+     *
+     * @note This includes new entries that were rejected by the admission
+     * policy when leaving the window.
+     */
+    Scuu64 evictions;
+
+} ScuTinyLfuCacheStats;
+
+/**
+ * @brief Allocates and initializes a new, empty W-TinyLFU cache holding at most
+ * a specified number of entries.
+ *
+ * @note All memory required by the cache is allocated upfront, so inserting
+ * entries never allocates memory.
+ *
+ * This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @warning The caller is responsible for deallocating the cache with
+ * `scu_tiny_lfu_cache_free()` when it is no longer needed.
+ *
+ * @param[in] keySize   The size of each key (in bytes).
+ * @param[in] valueSize The size of each value (in bytes).
+ * @param[in] capacity  The maximum number of entries.
+ * @param[in] hashFunc  A function used for hashing keys (e.g., one of the
+ *                      `scu_hash_*()` functions).
+ * @param[in] equalFunc A function used for comparing keys for equality.
+ * @return A pointer to the new cache, or `nullptr` on failure.
+ */
+[[nodiscard]]
+ScuTinyLfuCache* scu_tiny_lfu_cache_new(
+    Scuisize keySize,
+    Scuisize valueSize,
+    Scuisize capacity,
+    ScuHashFunc* hashFunc,
+    ScuEqualFunc* equalFunc
+);
+
+/**
+ * @brief Sets the function that is called whenever an entry leaves a specified
+ * W-TinyLFU cache.
+ *
+ * @param[in, out] cache     The cache to modify.
+ * @param[in]      evictFunc The function to call, or `nullptr` to not call any
+ *                           function.
+ * @param[in]      context   A context passed to `evictFunc`.
+ */
+void scu_tiny_lfu_cache_set_evict_func(
+    ScuTinyLfuCache* cache,
+    ScuTinyLfuCacheEvictFunc* evictFunc,
+    void* context
+);
+
+/**
+ * @brief Returns the capacity of a specified W-TinyLFU cache, i.e., the maximum
+ * number of entries.
+ *
+ * @param[in] cache The cache to examine.
+ * @return The capacity of the specified cache.
+ */
+Scuisize scu_tiny_lfu_cache_capacity(const ScuTinyLfuCache* cache);
+
+/**
+ * @brief Returns the number of entries of a specified W-TinyLFU cache.
+ *
+ * @param[in] cache The cache to examine.
+ * @return The number of entries of the specified cache.
+ */
+Scuisize scu_tiny_lfu_cache_count(const ScuTinyLfuCache* cache);
+
+/**
+ * @brief Returns the estimated access frequency of a key in a specified
+ * W-TinyLFU cache.
+ *
+ * @note The estimate is in the range `[0, 15]` and may overestimate the actual
+ * frequency. It is tracked regardless of whether the key is present.
+ *
+ * @param[in] cache The cache to examine.
+ * @param[in] key   The key whose frequency to estimate.
+ * @return The estimated access frequency of the key.
+ */
+Scuisize scu_tiny_lfu_cache_frequency(
+    const ScuTinyLfuCache* restrict cache,
+    const void* restrict key
+);
+
+/**
+ * @brief Tries to get the value associated with a key in a specified W-TinyLFU
+ * cache.
+ *
+ * @note This function is an implementation detail and not intended to be called
+ * directly. Use the `scu_tiny_lfu_cache_try_get()` macro instead.
+ *
+ * @param[in, out] cache The cache to search.
+ * @param[in]      key   The key to look up.
+ * @param[out]     value A pointer to the value associated with the specified
+ *                       key on success, otherwise a `nullptr`.
+ * @return `true` if the key was present in the cache, otherwise `false`.
+ */
+bool scu_tiny_lfu_cache_try_get_impl(
+    ScuTinyLfuCache* restrict cache,
+    const void* restrict key,
+    void* restrict* restrict value
+);
+
+/**
+ * @brief Tries to get the value associated with a key in a specified W-TinyLFU
+ * cache.
+ *
+ * @note Every call records an access of the key (whether it is present or not)
+ * and counts as a hit or a miss in the statistics of the cache.
+ *
+ * @warning The pointer to the value is only valid until the cache is modified
+ * the next time.
+ *
+ * @param[in, out] cache The cache to search.
+ * @param[in]      key   The key to look up.
+ * @param[out]     value A pointer to the value associated with the specified
+ *                       key on success, otherwise a `nullptr`.
+ * @return `true` if the key was present in the cache, otherwise `false`.
+ */
+#define scu_tiny_lfu_cache_try_get(cache, key, value)             \
+    scu_tiny_lfu_cache_try_get_impl(cache, key, (void**) (value))
+
+/**
+ * @brief Determines whether a key is present in a specified W-TinyLFU cache.
+ *
+ * @note In contrast to `scu_tiny_lfu_cache_try_get()`, this function neither
+ * records an access nor changes the statistics of the cache.
+ *
+ * @param[in] cache The cache to search.
+ * @param[in] key   The key to search for.
+ * @return `true` if the key is present in the cache, otherwise `false`.
+ */
+bool scu_tiny_lfu_cache_contains(
+    const ScuTinyLfuCache* restrict cache,
+    const void* restrict key
+);
+
+/**
+ * @brief Associates a key with a value in a specified W-TinyLFU cache.
+ *
+ * If the key is already present, its value is replaced and an access is
+ * recorded. Otherwise, the entry is inserted into the window, which may cause
+ * another entry to be evicted.
+ *
+ * @note A new entry is always inserted, but it may be evicted again once it
+ * leaves the window if it is accessed less frequently than the entries of the
+ * main cache.
+ *
+ * @param[in, out] cache The cache to modify.
+ * @param[in]      key   The key to associate with the value.
+ * @param[in]      value The value to associate with the key.
+ */
+void scu_tiny_lfu_cache_put(
+    ScuTinyLfuCache* restrict cache,
+    const void* restrict key,
+    const void* restrict value
+);
+
+/**
+ * @brief Removes the entry with a specified key from a specified W-TinyLFU
+ * cache.
+ *
+ * @param[in, out] cache The cache to modify.
+ * @param[in]      key   The key of the entry to remove.
+ * @return `true` if the entry was removed, or `false` if the key was not
+ * present in the cache.
+ */
+bool scu_tiny_lfu_cache_remove(
+    ScuTinyLfuCache* restrict cache,
+    const void* restrict key
+);
+
+/**
+ * @brief Removes all entries from a specified W-TinyLFU cache.
+ *
+ * @note The frequency sketch and the statistics of the cache are left
+ * unchanged.
+ *
+ * @param[in, out] cache The cache to clear.
+ */
+void scu_tiny_lfu_cache_clear(ScuTinyLfuCache* cache);
+
+/**
+ * @brief Returns the statistics of a specified W-TinyLFU cache.
+ *
+ * @param[in] cache The cache to examine.
+ * @return The statistics of the specified cache.
+ */
+ScuTinyLfuCacheStats scu_tiny_lfu_cache_stats(const ScuTinyLfuCache* cache);
+
+/**
+ * @brief Resets the statistics of a specified W-TinyLFU cache to zero.
+ *
+ * @param[in, out] cache The cache to modify.
+ */
+void scu_tiny_lfu_cache_reset_stats(ScuTinyLfuCache* cache);
+
+/**
+ * @brief Deallocates a specified W-TinyLFU cache.
+ *
+ * @note If `cache` is a `nullptr`, this function does nothing.
+ *
+ * @warning This function does not call the eviction function for the remaining
+ * entries. Call `scu_tiny_lfu_cache_clear()` first if they own any resources.
+ *
+ * The behavior is undefined if the cache is used after it has been
+ * deallocated.
+ *
+ * @param[in, out] cache The cache to deallocate.
+ */
+void scu_tiny_lfu_cache_free(ScuTinyLfuCache* cache);
+
+#endif
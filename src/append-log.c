@@ -0,0 +1,286 @@
+#define SCU_SHORT_ALIASES
+
+#ifndef _POSIX_C_SOURCE
+    #define _POSIX_C_SOURCE 200809L
+#endif
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <errno.h>
+    #include <unistd.h>
+#endif
+#include <pthread.h>
+#include <stdatomic.h>
+#include "scu/alloc.h"
+#include "scu/append-log.h"
+#include "scu/assert.h"
+#include "scu/math.h"
+#include "scu/memory.h"
+
+struct ScuAppendLog {
+
+    /** @brief The file descriptor of the file stream to write to. */
+    int fd;
+
+    /** @brief The buffer records are appended to. */
+    byte* active;
+
+    /** @brief The buffer currently being written by the flusher thread. */
+    byte* flushing;
+
+    /** @brief The capacity of each buffer (in bytes). */
+    isize capacity;
+
+    /** @brief The number of bytes used in the active buffer. */
+    isize used;
+
+    /** @brief The LSN of the last record appended. */
+    isize appended;
+
+    /** @brief The LSN up to which all records are durable. */
+    _Atomic isize durable;
+
+    /** @brief The error of the first batch that failed, if any. */
+    ScuError error;
+
+    /** @brief Whether the flusher thread has been asked to stop. */
+    bool isStopping;
+
+    /** @brief The mutex protecting the state of the log. */
+    pthread_mutex_t mutex;
+
+    /** @brief Signaled when records are appended to an empty buffer. */
+    pthread_cond_t recordAppended;
+
+    /** @brief Signaled when the flusher thread takes over the active buffer. */
+    pthread_cond_t bufferSwapped;
+
+    /** @brief Signaled when a batch has been written and synchronized. */
+    pthread_cond_t batchSynced;
+
+    /** @brief The flusher thread. */
+    pthread_t flusher;
+
+};
+
+/**
+ * @brief Writes a batch to a file descriptor and synchronizes its data with the
+ * storage device.
+ *
+ * @param[in] fd     The file descriptor to write to.
+ * @param[in] buffer The batch to write.
+ * @param[in] count  The size of the batch (in bytes).
+ * @return `true` on success, otherwise `false`.
+ */
+static bool scu_write_batch(int fd, const byte* buffer, isize count) {
+    isize written = 0;
+    while (written < count) {
+#ifdef _WIN32
+        isize transferred = _write(
+            fd,
+            &buffer[written],
+            (unsigned int) SCU_MIN(count - written, (isize) INT32_MAX)
+        );
+        if (transferred < 0) {
+            return false;
+        }
+#else
+        isize transferred = write(
+            fd,
+            &buffer[written],
+            (usize) (count - written)
+        );
+        if (transferred < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+#endif
+        written += transferred;
+    }
+#if defined(_WIN32)
+    return _commit(fd) == 0;
+#elif defined(__APPLE__)
+    return fsync(fd) == 0;
+#else
+    // Only the data and the metadata needed to read it back (such as the file
+    // size) have to reach the device, which saves a journal commit for the
+    // modification time.
+    return fdatasync(fd) == 0;
+#endif
+}
+
+/**
+ * @brief Runs the flusher thread, which writes and synchronizes batches until
+ * the log is deallocated and all records have been written.
+ *
+ * @param[in, out] arg The log the flusher thread belongs to.
+ * @return Always `nullptr`.
+ */
+static void* scu_flush(void* arg) {
+    ScuAppendLog* log = arg;
+    pthread_mutex_lock(&log->mutex);
+    while (true) {
+        while ((log->used == 0) && !log->isStopping) {
+            pthread_cond_wait(&log->recordAppended, &log->mutex);
+        }
+        if (log->used == 0) {
+            break;
+        }
+        byte* batch = log->active;
+        isize count = log->used;
+        isize end = log->appended;
+        log->active = log->flushing;
+        log->flushing = batch;
+        log->used = 0;
+        pthread_cond_broadcast(&log->bufferSwapped);
+        // Once a batch has failed, the position of the file is unknown, so
+        // later batches are discarded rather than written after a gap.
+        bool hasFailed = (log->error != SCU_ERROR_NONE);
+        pthread_mutex_unlock(&log->mutex);
+        bool isWritten = !hasFailed && scu_write_batch(log->fd, batch, count);
+        pthread_mutex_lock(&log->mutex);
+        if (isWritten) {
+            atomic_store_explicit(&log->durable, end, memory_order_release);
+        }
+        else {
+            log->error = SCU_ERROR_WRITING_FILE;
+        }
+        pthread_cond_broadcast(&log->batchSynced);
+    }
+    pthread_mutex_unlock(&log->mutex);
+    return nullptr;
+}
+
+[[nodiscard]]
+ScuAppendLog* scu_append_log_new(ScuFile* file, isize capacity) {
+    SCU_ASSERT(file != nullptr);
+    SCU_ASSERT(capacity >= 1);
+    if (scu_fflush(file) != SCU_ERROR_NONE) {
+        return nullptr;
+    }
+    ScuAppendLog* log = scu_malloc(SCU_SIZEOF(ScuAppendLog));
+    if (log == nullptr) {
+        return nullptr;
+    }
+    log->active = scu_malloc(capacity * SCU_SIZEOF(byte));
+    log->flushing = scu_malloc(capacity * SCU_SIZEOF(byte));
+    if ((log->active == nullptr) || (log->flushing == nullptr)) {
+        scu_free(log->flushing);
+        scu_free(log->active);
+        scu_free(log);
+        return nullptr;
+    }
+    log->fd = scu_fileno(file);
+    log->capacity = capacity;
+    log->used = 0;
+    log->appended = 0;
+    atomic_init(&log->durable, 0);
+    log->error = SCU_ERROR_NONE;
+    log->isStopping = false;
+    pthread_mutex_init(&log->mutex, nullptr);
+    pthread_cond_init(&log->recordAppended, nullptr);
+    pthread_cond_init(&log->bufferSwapped, nullptr);
+    pthread_cond_init(&log->batchSynced, nullptr);
+    if (pthread_create(&log->flusher, nullptr, scu_flush, log) != 0) {
+        pthread_cond_destroy(&log->batchSynced);
+        pthread_cond_destroy(&log->bufferSwapped);
+        pthread_cond_destroy(&log->recordAppended);
+        pthread_mutex_destroy(&log->mutex);
+        scu_free(log->flushing);
+        scu_free(log->active);
+        scu_free(log);
+        return nullptr;
+    }
+    return log;
+}
+
+ScuError scu_append_log_append(
+    ScuAppendLog* restrict log,
+    const void* restrict data,
+    isize size,
+    isize* restrict lsn
+) {
+    SCU_ASSERT(log != nullptr);
+    SCU_ASSERT((size >= 0) && (size <= log->capacity));
+    SCU_ASSERT((size == 0) || (data != nullptr));
+    pthread_mutex_lock(&log->mutex);
+    while (
+        (log->used + size > log->capacity)
+        && (log->error == SCU_ERROR_NONE)
+    ) {
+        pthread_cond_wait(&log->bufferSwapped, &log->mutex);
+    }
+    ScuError error = log->error;
+    if (error == SCU_ERROR_NONE) {
+        if (size > 0) {
+            scu_memcpy(&log->active[log->used], data, size);
+        }
+        if (log->used == 0) {
+            pthread_cond_signal(&log->recordAppended);
+        }
+        log->used += size;
+        log->appended += size;
+        if (lsn != nullptr) {
+            *lsn = log->appended;
+        }
+    }
+    pthread_mutex_unlock(&log->mutex);
+    return error;
+}
+
+isize scu_append_log_durable(const ScuAppendLog* log) {
+    SCU_ASSERT(log != nullptr);
+    return atomic_load_explicit(&log->durable, memory_order_acquire);
+}
+
+ScuError scu_append_log_wait(ScuAppendLog* log, isize lsn) {
+    SCU_ASSERT(log != nullptr);
+    SCU_ASSERT(lsn >= 0);
+    if (atomic_load_explicit(&log->durable, memory_order_acquire) >= lsn) {
+        return SCU_ERROR_NONE;
+    }
+    pthread_mutex_lock(&log->mutex);
+    SCU_ASSERT(lsn <= log->appended);
+    while (
+        (atomic_load_explicit(&log->durable, memory_order_relaxed) < lsn)
+        && (log->error == SCU_ERROR_NONE)
+    ) {
+        pthread_cond_wait(&log->batchSynced, &log->mutex);
+    }
+    ScuError error =
+        (atomic_load_explicit(&log->durable, memory_order_relaxed) >= lsn)
+            ? SCU_ERROR_NONE
+            : log->error;
+    pthread_mutex_unlock(&log->mutex);
+    return error;
+}
+
+ScuError scu_append_log_sync(ScuAppendLog* log) {
+    SCU_ASSERT(log != nullptr);
+    pthread_mutex_lock(&log->mutex);
+    isize lsn = log->appended;
+    pthread_mutex_unlock(&log->mutex);
+    return scu_append_log_wait(log, lsn);
+}
+
+void scu_append_log_free(ScuAppendLog* log) {
+    if (log != nullptr) {
+        pthread_mutex_lock(&log->mutex);
+        log->isStopping = true;
+        pthread_cond_signal(&log->recordAppended);
+        pthread_mutex_unlock(&log->mutex);
+        pthread_join(log->flusher, nullptr);
+        pthread_cond_destroy(&log->batchSynced);
+        pthread_cond_destroy(&log->bufferSwapped);
+        pthread_cond_destroy(&log->recordAppended);
+        pthread_mutex_destroy(&log->mutex);
+        scu_free(log->flushing);
+        log->flushing = nullptr;
+        scu_free(log->active);
+        log->active = nullptr;
+        scu_free(log);
+    }
+}
\ No newline at end of file
@@ -18,4 +18,56 @@ void scu_array_sort(
     }
     SCU_ASSERT(array != nullptr);
     qsort(array, (usize) count, (usize) elemSize, cmpFunc);
+}
+
+isize scu_array_lower_bound(
+    const void* array,
+    isize count,
+    isize elemSize,
+    const void* key,
+    ScuCompareFunc* cmpFunc
+) {
+    SCU_ASSERT(count >= 0);
+    SCU_ASSERT(elemSize > 0);
+    SCU_ASSERT(cmpFunc != nullptr);
+    SCU_ASSERT((array != nullptr) || (count == 0));
+    const byte* elems = array;
+    isize first = 0;
+    while (count > 0) {
+        isize step = count / 2;
+        if (cmpFunc(&elems[(first + step) * elemSize], key) < 0) {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else {
+            count = step;
+        }
+    }
+    return first;
+}
+
+isize scu_array_upper_bound(
+    const void* array,
+    isize count,
+    isize elemSize,
+    const void* key,
+    ScuCompareFunc* cmpFunc
+) {
+    SCU_ASSERT(count >= 0);
+    SCU_ASSERT(elemSize > 0);
+    SCU_ASSERT(cmpFunc != nullptr);
+    SCU_ASSERT((array != nullptr) || (count == 0));
+    const byte* elems = array;
+    isize first = 0;
+    while (count > 0) {
+        isize step = count / 2;
+        if (cmpFunc(&elems[(first + step) * elemSize], key) <= 0) {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else {
+            count = step;
+        }
+    }
+    return first;
 }
\ No newline at end of file
@@ -0,0 +1,830 @@
+#define SCU_SHORT_ALIASES
+
+#ifndef _POSIX_C_SOURCE
+    #define _POSIX_C_SOURCE 200809L
+#endif
+#ifndef _DEFAULT_SOURCE
+    #define _DEFAULT_SOURCE
+#endif
+#ifndef _FILE_OFFSET_BITS
+    #define _FILE_OFFSET_BITS 64
+#endif
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <io.h>
+    #include <windows.h>
+#else
+    #include <errno.h>
+    #include <unistd.h>
+    #if defined(__linux__) && __has_include(<linux/io_uring.h>)
+        #include <linux/io_uring.h>
+        #include <sys/mman.h>
+        #include <sys/syscall.h>
+        #ifdef __NR_io_uring_setup
+            #define SCU_HAS_IO_URING
+        #endif
+    #endif
+#endif
+#include <pthread.h>
+#include <stdatomic.h>
+#include "scu/alloc.h"
+#include "scu/assert.h"
+#include "scu/async-io.h"
+#include "scu/math.h"
+#include "scu/memory.h"
+
+/** @brief The maximum number of completions collected at once. */
+static constexpr isize SCU_REAP_BATCH = 64;
+
+/** @brief Represents the state of a request in flight. */
+typedef struct ScuSlot {
+
+    /** @brief The request. */
+    ScuAsyncIoRequest request;
+
+    /** @brief The file descriptor of the file stream of the request. */
+    int fd;
+
+    /** @brief The number of bytes transferred so far. */
+    isize count;
+
+    /** @brief The error of the request once it completed. */
+    ScuError error;
+
+    /** @brief The index of the next free slot, or `-1` if there is none. */
+    isize nextFree;
+
+} ScuSlot;
+
+#ifdef SCU_HAS_IO_URING
+    /** @brief The maximum number of entries of an io_uring. */
+    static constexpr isize SCU_URING_MAX_ENTRIES = 32768;
+
+    /** @brief Represents an io_uring shared with the kernel. */
+    typedef struct ScuUring {
+
+        /** @brief The file descriptor of the io_uring. */
+        int fd;
+
+        /** @brief The mapped submission queue ring. */
+        void* sqRing;
+
+        /** @brief The size of the mapped submission queue ring (in bytes). */
+        usize sqRingSize;
+
+        /** @brief The mapped completion queue ring. */
+        void* cqRing;
+
+        /** @brief The size of the mapped completion queue ring (in bytes). */
+        usize cqRingSize;
+
+        /** @brief The mapped submission queue entries. */
+        struct io_uring_sqe* sqes;
+
+        /** @brief The size of the mapped entries (in bytes). */
+        usize sqesSize;
+
+        /** @brief The tail of the submission queue, written by us. */
+        _Atomic(u32)* sqTail;
+
+        /** @brief The mask applied to indices of the submission queue. */
+        u32 sqMask;
+
+        /** @brief The indirection array of the submission queue. */
+        u32* sqArray;
+
+        /** @brief The head of the completion queue, written by us. */
+        _Atomic(u32)* cqHead;
+
+        /** @brief The tail of the completion queue, written by the kernel. */
+        _Atomic(u32)* cqTail;
+
+        /** @brief The mask applied to indices of the completion queue. */
+        u32 cqMask;
+
+        /** @brief The completion queue entries. */
+        struct io_uring_cqe* cqes;
+
+        /** @brief The number of entries queued but not yet submitted. */
+        u32 unsubmitted;
+
+    } ScuUring;
+#endif
+
+struct ScuAsyncIo {
+
+    /** @brief The maximum number of requests in flight. */
+    isize capacity;
+
+    /** @brief The number of requests in flight. */
+    isize inFlight;
+
+    /** @brief The slots of the requests in flight, indexed by user data. */
+    ScuSlot* slots;
+
+    /** @brief The index of the first free slot, or `-1` if there is none. */
+    isize firstFree;
+
+    /** @brief Whether the engine is backed by an io_uring. */
+    bool isNative;
+
+#ifdef SCU_HAS_IO_URING
+    /** @brief The io_uring backing the engine (if `isNative` is `true`). */
+    ScuUring ring;
+#endif
+
+    /** @brief The mutex protecting the queues of the worker threads. */
+    pthread_mutex_t mutex;
+
+    /** @brief Signaled when a request has been queued for the workers. */
+    pthread_cond_t requestQueued;
+
+    /** @brief Signaled when a worker has completed a request. */
+    pthread_cond_t requestCompleted;
+
+    /** @brief The slots of the queued requests (a ring buffer). */
+    isize* queued;
+
+    /** @brief The index of the first queued request. */
+    isize queuedHead;
+
+    /** @brief The number of queued requests. */
+    isize queuedCount;
+
+    /** @brief The slots of the completed requests (a ring buffer). */
+    isize* completed;
+
+    /** @brief The index of the first completed request. */
+    isize completedHead;
+
+    /** @brief The number of completed requests. */
+    isize completedCount;
+
+    /** @brief The worker threads. */
+    pthread_t* threads;
+
+    /** @brief The number of worker threads started. */
+    isize threadCount;
+
+    /** @brief Whether the worker threads should stop. */
+    bool isStopping;
+
+};
+
+/**
+ * @brief Returns the error reported for a failed request.
+ *
+ * @param[in] op The operation of the request.
+ * @return The error reported for a failed request.
+ */
+static inline ScuError scu_op_error(ScuAsyncIoOp op) {
+    return (op == SCU_ASYNC_IO_OP_READ)
+        ? SCU_ERROR_READING_FILE
+        : SCU_ERROR_WRITING_FILE;
+}
+
+#ifdef SCU_HAS_IO_URING
+    /**
+     * @brief Sets up an io_uring with a specified number of entries.
+     *
+     * @param[out] ring    The io_uring to set up.
+     * @param[in]  entries The minimum number of entries.
+     * @return `true` if the kernel supports io_uring with positional reads and
+     * writes and the io_uring was set up successfully, otherwise `false`.
+     */
+    static bool scu_uring_init(ScuUring* ring, isize entries) {
+        struct io_uring_params params;
+        scu_memset(&params, 0, SCU_SIZEOF(params));
+        int fd = (int) syscall(
+            __NR_io_uring_setup,
+            (unsigned) entries,
+            &params
+        );
+        if (fd < 0) {
+            return false;
+        }
+        // IORING_OP_READ and IORING_OP_WRITE were introduced together with
+        // this feature flag.
+        if ((params.features & IORING_FEAT_RW_CUR_POS) == 0) {
+            close(fd);
+            return false;
+        }
+        ring->fd = fd;
+        ring->sqRingSize = params.sq_off.array
+            + (params.sq_entries * sizeof(u32));
+        ring->cqRingSize = params.cq_off.cqes
+            + (params.cq_entries * sizeof(struct io_uring_cqe));
+        ring->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+        ring->sqRing = mmap(
+            nullptr,
+            ring->sqRingSize,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED,
+            fd,
+            IORING_OFF_SQ_RING
+        );
+        ring->cqRing = mmap(
+            nullptr,
+            ring->cqRingSize,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED,
+            fd,
+            IORING_OFF_CQ_RING
+        );
+        void* sqes = mmap(
+            nullptr,
+            ring->sqesSize,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED,
+            fd,
+            IORING_OFF_SQES
+        );
+        if (
+            (ring->sqRing == MAP_FAILED)
+                || (ring->cqRing == MAP_FAILED)
+                || (sqes == MAP_FAILED)
+        ) {
+            if (ring->sqRing != MAP_FAILED) {
+                munmap(ring->sqRing, ring->sqRingSize);
+            }
+            if (ring->cqRing != MAP_FAILED) {
+                munmap(ring->cqRing, ring->cqRingSize);
+            }
+            if (sqes != MAP_FAILED) {
+                munmap(sqes, ring->sqesSize);
+            }
+            close(fd);
+            return false;
+        }
+        byte* sq = ring->sqRing;
+        byte* cq = ring->cqRing;
+        ring->sqes = sqes;
+        ring->sqTail = (_Atomic(u32)*) (sq + params.sq_off.tail);
+        ring->sqMask = *(u32*) (sq + params.sq_off.ring_mask);
+        ring->sqArray = (u32*) (sq + params.sq_off.array);
+        ring->cqHead = (_Atomic(u32)*) (cq + params.cq_off.head);
+        ring->cqTail = (_Atomic(u32)*) (cq + params.cq_off.tail);
+        ring->cqMask = *(u32*) (cq + params.cq_off.ring_mask);
+        ring->cqes = (struct io_uring_cqe*) (cq + params.cq_off.cqes);
+        ring->unsubmitted = 0;
+        return true;
+    }
+
+    /**
+     * @brief Tears down a specified io_uring.
+     *
+     * @param[in, out] ring The io_uring to tear down.
+     */
+    static void scu_uring_deinit(ScuUring* ring) {
+        munmap(ring->sqes, ring->sqesSize);
+        munmap(ring->cqRing, ring->cqRingSize);
+        munmap(ring->sqRing, ring->sqRingSize);
+        close(ring->fd);
+    }
+
+    /**
+     * @brief Queues a request in the submission queue of a specified io_uring.
+     *
+     * @note The request is only passed to the kernel by the next call to
+     * `scu_uring_enter()`.
+     *
+     * @param[in, out] ring  The io_uring to queue the request in.
+     * @param[in]      slot  The slot of the request.
+     * @param[in]      index The index of the slot.
+     */
+    static void scu_uring_queue(
+        ScuUring* restrict ring,
+        const ScuSlot* restrict slot,
+        isize index
+    ) {
+        // Only this thread writes the tail, so it can be read without
+        // synchronization.
+        u32 tail = atomic_load_explicit(ring->sqTail, memory_order_relaxed);
+        u32 position = tail & ring->sqMask;
+        struct io_uring_sqe* sqe = &ring->sqes[position];
+        scu_memset(sqe, 0, SCU_SIZEOF(*sqe));
+        sqe->opcode = (slot->request.op == SCU_ASYNC_IO_OP_READ)
+            ? IORING_OP_READ
+            : IORING_OP_WRITE;
+        // Only the part of the request not yet transferred is queued, so that
+        // short transfers can be continued.
+        const byte* buffer = slot->request.buffer;
+        sqe->fd = slot->fd;
+        sqe->addr = (u64) (uptr) &buffer[slot->count];
+        sqe->len = (u32) (slot->request.count - slot->count);
+        sqe->off = (u64) (slot->request.offset + slot->count);
+        sqe->user_data = (u64) index;
+        ring->sqArray[position] = position;
+        // Publish the entry before the kernel can observe the new tail.
+        atomic_store_explicit(ring->sqTail, tail + 1, memory_order_release);
+        ring->unsubmitted++;
+    }
+
+    /**
+     * @brief Passes the queued requests of a specified io_uring to the kernel
+     * and optionally waits for completions.
+     *
+     * @note If the kernel can not accept all queued requests at the moment,
+     * the remaining ones are passed by a later call.
+     *
+     * @param[in, out] ring     The io_uring to enter.
+     * @param[in]      minCount The number of completions to wait for.
+     */
+    static void scu_uring_enter(ScuUring* ring, u32 minCount) {
+        while (true) {
+            long submitted = syscall(
+                __NR_io_uring_enter,
+                ring->fd,
+                ring->unsubmitted,
+                minCount,
+                (minCount > 0) ? IORING_ENTER_GETEVENTS : 0,
+                nullptr,
+                0
+            );
+            if (submitted >= 0) {
+                ring->unsubmitted -= (u32) submitted;
+                return;
+            }
+            if (errno != EINTR) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Collects completions from the completion queue of a specified
+     * io_uring.
+     *
+     * @note As in `scu_perform()`, short transfers are continued by queuing
+     * the remainder of the request again, so that only reads reaching the end
+     * of the file complete with fewer bytes than requested.
+     *
+     * @param[in, out] asyncIo  The engine backed by the io_uring.
+     * @param[out]     indices  An array receiving the slots of the completed
+     *                          requests.
+     * @param[in]      maxCount The maximum number of completions to collect.
+     * @return The number of completions collected.
+     */
+    static isize scu_uring_reap(
+        ScuAsyncIo* restrict asyncIo,
+        isize* restrict indices,
+        isize maxCount
+    ) {
+        ScuUring* ring = &asyncIo->ring;
+        u32 head = atomic_load_explicit(ring->cqHead, memory_order_relaxed);
+        u32 tail = atomic_load_explicit(ring->cqTail, memory_order_acquire);
+        isize count = 0;
+        while ((head != tail) && (count < maxCount)) {
+            const struct io_uring_cqe* cqe = &ring->cqes[head & ring->cqMask];
+            isize index = (isize) cqe->user_data;
+            ScuSlot* slot = &asyncIo->slots[index];
+            i32 result = cqe->res;
+            head++;
+            if (result < 0) {
+                slot->error = scu_op_error(slot->request.op);
+                indices[count++] = index;
+                continue;
+            }
+            slot->count += result;
+            if ((result > 0) && (slot->count < slot->request.count)) {
+                scu_uring_queue(ring, slot, index);
+                continue;
+            }
+            indices[count++] = index;
+        }
+        // Hand the consumed entries back to the kernel.
+        atomic_store_explicit(ring->cqHead, head, memory_order_release);
+        if (ring->unsubmitted > 0) {
+            scu_uring_enter(ring, 0);
+        }
+        return count;
+    }
+#endif
+
+/**
+ * @brief Transfers bytes between a buffer and a specified offset of a file.
+ *
+ * @param[in]      fd     The file descriptor of the file.
+ * @param[in]      op     The operation to perform.
+ * @param[in, out] buffer The buffer to read into or write from.
+ * @param[in]      count  The number of bytes to transfer.
+ * @param[in]      offset The offset within the file.
+ * @return The number of bytes transferred (which may be less than requested),
+ * or `-1` on failure.
+ */
+static isize scu_transfer(
+    int fd,
+    ScuAsyncIoOp op,
+    byte* buffer,
+    isize count,
+    isize offset
+) {
+#ifdef _WIN32
+    HANDLE handle = (HANDLE) _get_osfhandle(fd);
+    OVERLAPPED overlapped = {
+        .Offset = (DWORD) offset,
+        .OffsetHigh = (DWORD) ((u64) offset >> 32)
+    };
+    DWORD transferred;
+    BOOL success = (op == SCU_ASYNC_IO_OP_READ)
+        ? ReadFile(handle, buffer, (DWORD) count, &transferred, &overlapped)
+        : WriteFile(handle, buffer, (DWORD) count, &transferred, &overlapped);
+    if (!success) {
+        return (GetLastError() == ERROR_HANDLE_EOF) ? 0 : -1;
+    }
+    return (isize) transferred;
+#else
+    while (true) {
+        isize transferred = (op == SCU_ASYNC_IO_OP_READ)
+            ? pread(fd, buffer, (usize) count, (off_t) offset)
+            : pwrite(fd, buffer, (usize) count, (off_t) offset);
+        if ((transferred >= 0) || (errno != EINTR)) {
+            return transferred;
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Performs a request synchronously on a worker thread.
+ *
+ * @param[in, out] slot The slot of the request to perform.
+ */
+static void scu_perform(ScuSlot* slot) {
+    const ScuAsyncIoRequest* request = &slot->request;
+    byte* buffer = request->buffer;
+    // Short transfers are continued, so that only reads reaching the end of
+    // the file complete with fewer bytes than requested.
+    while (slot->count < request->count) {
+        isize transferred = scu_transfer(
+            slot->fd,
+            request->op,
+            &buffer[slot->count],
+            request->count - slot->count,
+            request->offset + slot->count
+        );
+        if (transferred < 0) {
+            slot->error = scu_op_error(request->op);
+            return;
+        }
+        if (transferred == 0) {
+            return;
+        }
+        slot->count += transferred;
+    }
+}
+
+/**
+ * @brief Runs a worker thread, which performs queued requests until the
+ * engine is deallocated.
+ *
+ * @param[in, out] arg The engine the worker belongs to.
+ * @return Always `nullptr`.
+ */
+static void* scu_work(void* arg) {
+    ScuAsyncIo* asyncIo = arg;
+    pthread_mutex_lock(&asyncIo->mutex);
+    while (true) {
+        while ((asyncIo->queuedCount == 0) && !asyncIo->isStopping) {
+            pthread_cond_wait(&asyncIo->requestQueued, &asyncIo->mutex);
+        }
+        if (asyncIo->queuedCount == 0) {
+            break;
+        }
+        isize index = asyncIo->queued[asyncIo->queuedHead];
+        asyncIo->queuedHead = (asyncIo->queuedHead + 1) % asyncIo->capacity;
+        asyncIo->queuedCount--;
+        pthread_mutex_unlock(&asyncIo->mutex);
+        scu_perform(&asyncIo->slots[index]);
+        pthread_mutex_lock(&asyncIo->mutex);
+        isize tail = (asyncIo->completedHead + asyncIo->completedCount)
+            % asyncIo->capacity;
+        asyncIo->completed[tail] = index;
+        asyncIo->completedCount++;
+        pthread_cond_signal(&asyncIo->requestCompleted);
+    }
+    pthread_mutex_unlock(&asyncIo->mutex);
+    return nullptr;
+}
+
+/**
+ * @brief Initializes the pool of worker threads of a specified engine.
+ *
+ * @param[in, out] asyncIo     The engine to initialize.
+ * @param[in]      threadCount The number of worker threads to start.
+ * @return `true` if at least one worker thread was started, otherwise `false`.
+ */
+static bool scu_pool_init(ScuAsyncIo* asyncIo, isize threadCount) {
+    asyncIo->queued = scu_malloc(asyncIo->capacity * SCU_SIZEOF(isize));
+    asyncIo->completed = scu_malloc(asyncIo->capacity * SCU_SIZEOF(isize));
+    asyncIo->threads = scu_malloc(threadCount * SCU_SIZEOF(pthread_t));
+    if (
+        (asyncIo->queued == nullptr)
+            || (asyncIo->completed == nullptr)
+            || (asyncIo->threads == nullptr)
+    ) {
+        return false;
+    }
+    asyncIo->queuedHead = 0;
+    asyncIo->queuedCount = 0;
+    asyncIo->completedHead = 0;
+    asyncIo->completedCount = 0;
+    asyncIo->isStopping = false;
+    pthread_mutex_init(&asyncIo->mutex, nullptr);
+    pthread_cond_init(&asyncIo->requestQueued, nullptr);
+    pthread_cond_init(&asyncIo->requestCompleted, nullptr);
+    for (isize i = 0; i < threadCount; i++) {
+        if (
+            pthread_create(
+                &asyncIo->threads[asyncIo->threadCount],
+                nullptr,
+                scu_work,
+                asyncIo
+            ) == 0
+        ) {
+            asyncIo->threadCount++;
+        }
+    }
+    if (asyncIo->threadCount == 0) {
+        pthread_cond_destroy(&asyncIo->requestCompleted);
+        pthread_cond_destroy(&asyncIo->requestQueued);
+        pthread_mutex_destroy(&asyncIo->mutex);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Stops the worker threads of a specified engine, after they have
+ * performed all queued requests.
+ *
+ * @param[in, out] asyncIo The engine to stop the worker threads of.
+ */
+static void scu_pool_deinit(ScuAsyncIo* asyncIo) {
+    pthread_mutex_lock(&asyncIo->mutex);
+    asyncIo->isStopping = true;
+    pthread_cond_broadcast(&asyncIo->requestQueued);
+    pthread_mutex_unlock(&asyncIo->mutex);
+    for (isize i = 0; i < asyncIo->threadCount; i++) {
+        pthread_join(asyncIo->threads[i], nullptr);
+    }
+    asyncIo->threadCount = 0;
+    pthread_cond_destroy(&asyncIo->requestCompleted);
+    pthread_cond_destroy(&asyncIo->requestQueued);
+    pthread_mutex_destroy(&asyncIo->mutex);
+}
+
+[[nodiscard]]
+ScuAsyncIo* scu_async_io_new(isize capacity, isize threadCount) {
+    SCU_ASSERT(capacity >= 1);
+    SCU_ASSERT(threadCount >= 1);
+    ScuAsyncIo* asyncIo = scu_malloc(SCU_SIZEOF(ScuAsyncIo));
+    if (asyncIo == nullptr) {
+        return nullptr;
+    }
+#ifdef SCU_HAS_IO_URING
+    capacity = SCU_MIN(capacity, SCU_URING_MAX_ENTRIES);
+#endif
+    asyncIo->capacity = capacity;
+    asyncIo->inFlight = 0;
+    asyncIo->slots = scu_malloc(capacity * SCU_SIZEOF(ScuSlot));
+    asyncIo->queued = nullptr;
+    asyncIo->completed = nullptr;
+    asyncIo->threads = nullptr;
+    asyncIo->threadCount = 0;
+    if (asyncIo->slots == nullptr) {
+        scu_free(asyncIo);
+        return nullptr;
+    }
+    for (isize i = 0; i < capacity; i++) {
+        asyncIo->slots[i].nextFree = (i + 1 < capacity) ? i + 1 : -1;
+    }
+    asyncIo->firstFree = 0;
+#ifdef SCU_HAS_IO_URING
+    // The completion queue is at least twice as large as the submission queue,
+    // so it can never overflow while at most `capacity` requests are in flight.
+    asyncIo->isNative = scu_uring_init(&asyncIo->ring, capacity);
+#else
+    asyncIo->isNative = false;
+#endif
+    if (!asyncIo->isNative && !scu_pool_init(asyncIo, threadCount)) {
+        scu_free(asyncIo->threads);
+        scu_free(asyncIo->completed);
+        scu_free(asyncIo->queued);
+        scu_free(asyncIo->slots);
+        scu_free(asyncIo);
+        return nullptr;
+    }
+    return asyncIo;
+}
+
+bool scu_async_io_is_native(const ScuAsyncIo* asyncIo) {
+    SCU_ASSERT(asyncIo != nullptr);
+    return asyncIo->isNative;
+}
+
+isize scu_async_io_capacity(const ScuAsyncIo* asyncIo) {
+    SCU_ASSERT(asyncIo != nullptr);
+    return asyncIo->capacity;
+}
+
+isize scu_async_io_in_flight(const ScuAsyncIo* asyncIo) {
+    SCU_ASSERT(asyncIo != nullptr);
+    return asyncIo->inFlight;
+}
+
+isize scu_async_io_submit(
+    ScuAsyncIo* restrict asyncIo,
+    const ScuAsyncIoRequest* restrict requests,
+    isize count
+) {
+    SCU_ASSERT(asyncIo != nullptr);
+    SCU_ASSERT(count >= 0);
+    SCU_ASSERT((count == 0) || (requests != nullptr));
+    count = SCU_MIN(count, asyncIo->capacity - asyncIo->inFlight);
+    if (count == 0) {
+        return 0;
+    }
+    if (!asyncIo->isNative) {
+        pthread_mutex_lock(&asyncIo->mutex);
+    }
+    for (isize i = 0; i < count; i++) {
+        const ScuAsyncIoRequest* request = &requests[i];
+        SCU_ASSERT(
+            (request->op == SCU_ASYNC_IO_OP_READ)
+                || (request->op == SCU_ASYNC_IO_OP_WRITE)
+        );
+        SCU_ASSERT(request->file != nullptr);
+        SCU_ASSERT((request->count >= 0) && (request->count <= I32_MAX));
+        SCU_ASSERT((request->count == 0) || (request->buffer != nullptr));
+        SCU_ASSERT(request->offset >= 0);
+        isize index = asyncIo->firstFree;
+        ScuSlot* slot = &asyncIo->slots[index];
+        asyncIo->firstFree = slot->nextFree;
+        slot->request = *request;
+        slot->fd = scu_fileno(request->file);
+        slot->count = 0;
+        slot->error = SCU_ERROR_NONE;
+#ifdef SCU_HAS_IO_URING
+        if (asyncIo->isNative) {
+            scu_uring_queue(&asyncIo->ring, slot, index);
+            continue;
+        }
+#endif
+        isize tail = (asyncIo->queuedHead + asyncIo->queuedCount)
+            % asyncIo->capacity;
+        asyncIo->queued[tail] = index;
+        asyncIo->queuedCount++;
+    }
+    asyncIo->inFlight += count;
+#ifdef SCU_HAS_IO_URING
+    if (asyncIo->isNative) {
+        scu_uring_enter(&asyncIo->ring, 0);
+        return count;
+    }
+#endif
+    pthread_cond_broadcast(&asyncIo->requestQueued);
+    pthread_mutex_unlock(&asyncIo->mutex);
+    return count;
+}
+
+/**
+ * @brief Collects the completions of requests that have already completed in
+ * a specified engine without waiting.
+ *
+ * @param[in, out] asyncIo     The engine to collect completions from.
+ * @param[out]     completions An array receiving the completions, or
+ *                             `nullptr`.
+ * @param[in]      maxCount    The maximum number of completions to collect.
+ * @return The number of completions collected.
+ */
+static isize scu_async_io_reap(
+    ScuAsyncIo* restrict asyncIo,
+    ScuAsyncIoCompletion* restrict completions,
+    isize maxCount
+) {
+    isize indices[SCU_REAP_BATCH];
+    isize total = 0;
+    while (total < maxCount) {
+        isize limit = SCU_MIN(maxCount - total, SCU_REAP_BATCH);
+        isize count = 0;
+#ifdef SCU_HAS_IO_URING
+        if (asyncIo->isNative) {
+            count = scu_uring_reap(asyncIo, indices, limit);
+        }
+#endif
+        if (!asyncIo->isNative) {
+            pthread_mutex_lock(&asyncIo->mutex);
+            count = SCU_MIN(limit, asyncIo->completedCount);
+            for (isize i = 0; i < count; i++) {
+                indices[i] = asyncIo->completed[asyncIo->completedHead];
+                asyncIo->completedHead = (asyncIo->completedHead + 1)
+                    % asyncIo->capacity;
+            }
+            asyncIo->completedCount -= count;
+            pthread_mutex_unlock(&asyncIo->mutex);
+        }
+        if (count == 0) {
+            break;
+        }
+        for (isize i = 0; i < count; i++) {
+            ScuSlot* slot = &asyncIo->slots[indices[i]];
+            ScuAsyncIoCompletion completion = {
+                .userData = slot->request.userData,
+                .count = slot->count,
+                .error = slot->error
+            };
+            ScuAsyncIoCompleteFunc* completeFunc = slot->request.completeFunc;
+            // Release the slot first, so the completion function may already
+            // submit new requests.
+            slot->nextFree = asyncIo->firstFree;
+            asyncIo->firstFree = indices[i];
+            asyncIo->inFlight--;
+            if (completeFunc != nullptr) {
+                completeFunc(&completion);
+            }
+            if (completions != nullptr) {
+                completions[total] = completion;
+            }
+            total++;
+        }
+    }
+    return total;
+}
+
+isize scu_async_io_poll(
+    ScuAsyncIo* restrict asyncIo,
+    ScuAsyncIoCompletion* restrict completions,
+    isize maxCount
+) {
+    SCU_ASSERT(asyncIo != nullptr);
+    SCU_ASSERT(maxCount >= 0);
+    return scu_async_io_reap(asyncIo, completions, maxCount);
+}
+
+isize scu_async_io_wait(
+    ScuAsyncIo* restrict asyncIo,
+    ScuAsyncIoCompletion* restrict completions,
+    isize minCount,
+    isize maxCount
+) {
+    SCU_ASSERT(asyncIo != nullptr);
+    SCU_ASSERT((minCount >= 0) && (minCount <= maxCount));
+    minCount = SCU_MIN(minCount, asyncIo->inFlight);
+    isize count = 0;
+    while (true) {
+        count += scu_async_io_reap(
+            asyncIo,
+            (completions != nullptr) ? &completions[count] : nullptr,
+            maxCount - count
+        );
+        if (count >= minCount) {
+            return count;
+        }
+#ifdef SCU_HAS_IO_URING
+        if (asyncIo->isNative) {
+            scu_uring_enter(&asyncIo->ring, (u32) (minCount - count));
+            continue;
+        }
+#endif
+        pthread_mutex_lock(&asyncIo->mutex);
+        while (asyncIo->completedCount == 0) {
+            pthread_cond_wait(&asyncIo->requestCompleted, &asyncIo->mutex);
+        }
+        pthread_mutex_unlock(&asyncIo->mutex);
+    }
+}
+
+void scu_async_io_free(ScuAsyncIo* asyncIo) {
+    if (asyncIo != nullptr) {
+        // The kernel or the workers may still access the buffers of requests
+        // in flight, so wait for them before releasing anything.
+        for (isize i = 0; i < asyncIo->capacity; i++) {
+            asyncIo->slots[i].request.completeFunc = nullptr;
+        }
+        scu_async_io_wait(
+            asyncIo,
+            nullptr,
+            asyncIo->inFlight,
+            asyncIo->inFlight
+        );
+#ifdef SCU_HAS_IO_URING
+        if (asyncIo->isNative) {
+            scu_uring_deinit(&asyncIo->ring);
+        }
+#endif
+        if (!asyncIo->isNative) {
+            scu_pool_deinit(asyncIo);
+        }
+        scu_free(asyncIo->threads);
+        asyncIo->threads = nullptr;
+        scu_free(asyncIo->completed);
+        asyncIo->completed = nullptr;
+        scu_free(asyncIo->queued);
+        asyncIo->queued = nullptr;
+        scu_free(asyncIo->slots);
+        asyncIo->slots = nullptr;
+        scu_free(asyncIo);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,363 @@
+#define SCU_SHORT_ALIASES
+
+#include "scu/alloc.h"
+#include "scu/assert.h"
+#include "scu/bit-set.h"
+#include "scu/math.h"
+#include "scu/memory.h"
+#include "bits.h"
+
+#ifdef SCU_AVX2_DISPATCH
+    #include <immintrin.h>
+#endif
+
+struct ScuBitSet {
+
+    /** @brief The size of the universe of the bit set. */
+    isize capacity;
+
+    /** @brief The number of words. */
+    isize wordCount;
+
+    /**
+     * @brief The words storing the bits.
+     *
+     * @note This is a dynamically allocated array of `wordCount` words. Bits at
+     * positions greater than or equal to `capacity` are always zero.
+     */
+    u64* words;
+
+};
+
+/** @brief The number of bits per word. */
+static constexpr isize SCU_BITS_PER_WORD = 64;
+
+/** @brief Represents a set operation between two bit sets. */
+typedef enum ScuSetOperation {
+
+    /** @brief The intersection of two sets. */
+    SCU_SET_OPERATION_AND,
+
+    /** @brief The union of two sets. */
+    SCU_SET_OPERATION_OR,
+
+    /** @brief The symmetric difference of two sets. */
+    SCU_SET_OPERATION_XOR,
+
+    /** @brief The difference of two sets. */
+    SCU_SET_OPERATION_ANDNOT
+
+} ScuSetOperation;
+
+/**
+ * @brief Returns the number of words required for a specified capacity.
+ *
+ * @param[in] capacity The capacity to examine.
+ * @return The number of words required for the capacity.
+ */
+static inline isize scu_word_count(isize capacity) {
+    SCU_ASSERT(capacity >= 0);
+    return (capacity / SCU_BITS_PER_WORD)
+        + (((capacity % SCU_BITS_PER_WORD) != 0) ? 1 : 0);
+}
+
+/**
+ * @brief Clears the bits of the last word of a specified bit set that lie
+ * outside of its universe.
+ *
+ * @param[in, out] bitSet The bit set to modify.
+ */
+static inline void scu_bit_set_trim(ScuBitSet* bitSet) {
+    SCU_ASSERT(bitSet != nullptr);
+    isize remainder = bitSet->capacity % SCU_BITS_PER_WORD;
+    if (remainder != 0) {
+        bitSet->words[bitSet->wordCount - 1] &= U64_MAX >> (64 - remainder);
+    }
+}
+
+[[nodiscard]]
+ScuBitSet* scu_bit_set_new(isize capacity) {
+    SCU_ASSERT(capacity >= 0);
+    ScuBitSet* bitSet = scu_malloc(SCU_SIZEOF(ScuBitSet));
+    if (bitSet == nullptr) {
+        return nullptr;
+    }
+    isize wordCount = scu_word_count(capacity);
+    bitSet->words = scu_calloc(SCU_MAX(wordCount, 1), SCU_SIZEOF(u64));
+    if (bitSet->words == nullptr) {
+        scu_free(bitSet);
+        return nullptr;
+    }
+    bitSet->capacity = capacity;
+    bitSet->wordCount = wordCount;
+    return bitSet;
+}
+
+[[nodiscard]]
+ScuBitSet* scu_bit_set_clone(const ScuBitSet* bitSet) {
+    SCU_ASSERT(bitSet != nullptr);
+    ScuBitSet* clone = scu_malloc(SCU_SIZEOF(ScuBitSet));
+    if (clone == nullptr) {
+        return nullptr;
+    }
+    isize size = bitSet->wordCount * SCU_SIZEOF(u64);
+    clone->words = scu_malloc(SCU_MAX(size, SCU_SIZEOF(u64)));
+    if (clone->words == nullptr) {
+        scu_free(clone);
+        return nullptr;
+    }
+    scu_memcpy(clone->words, bitSet->words, size);
+    clone->capacity = bitSet->capacity;
+    clone->wordCount = bitSet->wordCount;
+    return clone;
+}
+
+isize scu_bit_set_capacity(const ScuBitSet* bitSet) {
+    SCU_ASSERT(bitSet != nullptr);
+    return bitSet->capacity;
+}
+
+isize scu_bit_set_count(const ScuBitSet* bitSet) {
+    SCU_ASSERT(bitSet != nullptr);
+    isize count = 0;
+    for (isize i = 0; i < bitSet->wordCount; i++) {
+        count += scu_popcount_u64(bitSet->words[i]);
+    }
+    return count;
+}
+
+ScuError scu_bit_set_resize(ScuBitSet* bitSet, isize capacity) {
+    SCU_ASSERT(bitSet != nullptr);
+    SCU_ASSERT(capacity >= 0);
+    isize wordCount = scu_word_count(capacity);
+    if (wordCount != bitSet->wordCount) {
+        u64* words = scu_realloc(
+            bitSet->words,
+            SCU_MAX(wordCount, 1) * SCU_SIZEOF(u64)
+        );
+        if (words == nullptr) {
+            return SCU_ERROR_OUT_OF_MEMORY;
+        }
+        if (wordCount > bitSet->wordCount) {
+            scu_memset(
+                &words[bitSet->wordCount],
+                0,
+                (wordCount - bitSet->wordCount) * SCU_SIZEOF(u64)
+            );
+        }
+        bitSet->words = words;
+        bitSet->wordCount = wordCount;
+    }
+    bitSet->capacity = capacity;
+    scu_bit_set_trim(bitSet);
+    return SCU_ERROR_NONE;
+}
+
+void scu_bit_set_set(ScuBitSet* bitSet, isize index) {
+    SCU_ASSERT(bitSet != nullptr);
+    SCU_ASSERT((index >= 0) && (index < bitSet->capacity));
+    bitSet->words[index / SCU_BITS_PER_WORD]
+        |= (u64) 1 << (index % SCU_BITS_PER_WORD);
+}
+
+void scu_bit_set_clear(ScuBitSet* bitSet, isize index) {
+    SCU_ASSERT(bitSet != nullptr);
+    SCU_ASSERT((index >= 0) && (index < bitSet->capacity));
+    bitSet->words[index / SCU_BITS_PER_WORD]
+        &= ~((u64) 1 << (index % SCU_BITS_PER_WORD));
+}
+
+bool scu_bit_set_test(const ScuBitSet* bitSet, isize index) {
+    SCU_ASSERT(bitSet != nullptr);
+    SCU_ASSERT((index >= 0) && (index < bitSet->capacity));
+    u64 word = bitSet->words[index / SCU_BITS_PER_WORD];
+    return ((word >> (index % SCU_BITS_PER_WORD)) & 1) != 0;
+}
+
+bool scu_bit_set_test_and_set(ScuBitSet* bitSet, isize index) {
+    SCU_ASSERT(bitSet != nullptr);
+    SCU_ASSERT((index >= 0) && (index < bitSet->capacity));
+    u64* word = &bitSet->words[index / SCU_BITS_PER_WORD];
+    u64 mask = (u64) 1 << (index % SCU_BITS_PER_WORD);
+    bool wasSet = (*word & mask) != 0;
+    *word |= mask;
+    return wasSet;
+}
+
+void scu_bit_set_set_all(ScuBitSet* bitSet) {
+    SCU_ASSERT(bitSet != nullptr);
+    scu_memset(bitSet->words, 0xFF, bitSet->wordCount * SCU_SIZEOF(u64));
+    scu_bit_set_trim(bitSet);
+}
+
+void scu_bit_set_clear_all(ScuBitSet* bitSet) {
+    SCU_ASSERT(bitSet != nullptr);
+    scu_memset(bitSet->words, 0, bitSet->wordCount * SCU_SIZEOF(u64));
+}
+
+isize scu_bit_set_next_set(const ScuBitSet* bitSet, isize index) {
+    SCU_ASSERT(bitSet != nullptr);
+    SCU_ASSERT((index >= 0) && (index <= bitSet->capacity));
+    isize i = index / SCU_BITS_PER_WORD;
+    if (i >= bitSet->wordCount) {
+        return -1;
+    }
+    u64 word = bitSet->words[i] & (U64_MAX << (index % SCU_BITS_PER_WORD));
+    while (word == 0) {
+        if (++i == bitSet->wordCount) {
+            return -1;
+        }
+        word = bitSet->words[i];
+    }
+    return (i * SCU_BITS_PER_WORD) + scu_trailing_zeros_u64(word);
+}
+
+#ifdef SCU_AVX2_DISPATCH
+    /**
+     * @brief Performs a set operation on the words of two bit sets using AVX2,
+     * four words at a time.
+     *
+     * @note The words are only guaranteed to be aligned to eight bytes, so
+     * unaligned loads and stores are required.
+     *
+     * @param[in]      operation The set operation to perform.
+     * @param[in, out] d         The words of the first bit set, which receive
+     *                           the result.
+     * @param[in]      s         The words of the second bit set.
+     * @param[in]      n         The number of words.
+     * @return The number of words processed, which is `n` rounded down to a
+     * multiple of four.
+     */
+    __attribute__((target("avx2")))
+    static isize scu_bit_set_operation_avx2(
+        ScuSetOperation operation,
+        u64* restrict d,
+        const u64* restrict s,
+        isize n
+    ) {
+        isize i = 0;
+        switch (operation) {
+            case SCU_SET_OPERATION_AND:
+                for (; (i + 4) <= n; i += 4) {
+                    __m256i a = _mm256_loadu_si256((const __m256i*) &d[i]);
+                    __m256i b = _mm256_loadu_si256((const __m256i*) &s[i]);
+                    _mm256_storeu_si256(
+                        (__m256i*) &d[i],
+                        _mm256_and_si256(a, b)
+                    );
+                }
+                break;
+            case SCU_SET_OPERATION_OR:
+                for (; (i + 4) <= n; i += 4) {
+                    __m256i a = _mm256_loadu_si256((const __m256i*) &d[i]);
+                    __m256i b = _mm256_loadu_si256((const __m256i*) &s[i]);
+                    _mm256_storeu_si256(
+                        (__m256i*) &d[i],
+                        _mm256_or_si256(a, b)
+                    );
+                }
+                break;
+            case SCU_SET_OPERATION_XOR:
+                for (; (i + 4) <= n; i += 4) {
+                    __m256i a = _mm256_loadu_si256((const __m256i*) &d[i]);
+                    __m256i b = _mm256_loadu_si256((const __m256i*) &s[i]);
+                    _mm256_storeu_si256(
+                        (__m256i*) &d[i],
+                        _mm256_xor_si256(a, b)
+                    );
+                }
+                break;
+            case SCU_SET_OPERATION_ANDNOT:
+                for (; (i + 4) <= n; i += 4) {
+                    __m256i a = _mm256_loadu_si256((const __m256i*) &d[i]);
+                    __m256i b = _mm256_loadu_si256((const __m256i*) &s[i]);
+                    _mm256_storeu_si256(
+                        (__m256i*) &d[i],
+                        _mm256_andnot_si256(b, a)
+                    );
+                }
+                break;
+        }
+        return i;
+    }
+#endif
+
+/**
+ * @brief Performs a set operation on two bit sets, storing the result in the
+ * first one.
+ *
+ * @param[in]      operation The set operation to perform.
+ * @param[in, out] dest      The first bit set, which receives the result.
+ * @param[in]      src       The second bit set.
+ */
+static inline void scu_bit_set_operation(
+    ScuSetOperation operation,
+    ScuBitSet* restrict dest,
+    const ScuBitSet* restrict src
+) {
+    SCU_ASSERT(dest != nullptr);
+    SCU_ASSERT(src != nullptr);
+    SCU_ASSERT(dest->capacity == src->capacity);
+    u64* restrict d = dest->words;
+    const u64* restrict s = src->words;
+    isize n = dest->wordCount;
+    isize i = 0;
+#ifdef SCU_AVX2_DISPATCH
+    if (scu_has_avx2()) {
+        i = scu_bit_set_operation_avx2(operation, d, s, n);
+    }
+#endif
+    // Each operation has a loop of its own, so that the loops do not branch on
+    // the operation for every word.
+    switch (operation) {
+        case SCU_SET_OPERATION_AND:
+            for (; i < n; i++) {
+                d[i] &= s[i];
+            }
+            break;
+        case SCU_SET_OPERATION_OR:
+            for (; i < n; i++) {
+                d[i] |= s[i];
+            }
+            break;
+        case SCU_SET_OPERATION_XOR:
+            for (; i < n; i++) {
+                d[i] ^= s[i];
+            }
+            break;
+        case SCU_SET_OPERATION_ANDNOT:
+            for (; i < n; i++) {
+                d[i] &= ~s[i];
+            }
+            break;
+    }
+}
+
+void scu_bit_set_and(ScuBitSet* restrict dest, const ScuBitSet* restrict src) {
+    scu_bit_set_operation(SCU_SET_OPERATION_AND, dest, src);
+}
+
+void scu_bit_set_or(ScuBitSet* restrict dest, const ScuBitSet* restrict src) {
+    scu_bit_set_operation(SCU_SET_OPERATION_OR, dest, src);
+}
+
+void scu_bit_set_xor(ScuBitSet* restrict dest, const ScuBitSet* restrict src) {
+    scu_bit_set_operation(SCU_SET_OPERATION_XOR, dest, src);
+}
+
+void scu_bit_set_andnot(
+    ScuBitSet* restrict dest,
+    const ScuBitSet* restrict src
+) {
+    scu_bit_set_operation(SCU_SET_OPERATION_ANDNOT, dest, src);
+}
+
+void scu_bit_set_free(ScuBitSet* bitSet) {
+    if (bitSet != nullptr) {
+        scu_free(bitSet->words);
+        bitSet->words = nullptr;
+        bitSet->capacity = 0;
+        bitSet->wordCount = 0;
+        scu_free(bitSet);
+    }
+}
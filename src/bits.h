@@ -0,0 +1,162 @@
+#ifndef SCU_BITS_H
+#define SCU_BITS_H
+
+// Bit manipulation helpers shared by the implementation files. This header is
+// internal to the library and expects `SCU_SHORT_ALIASES` to be defined.
+
+#include "scu/assert.h"
+#include "scu/types.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+    /**
+     * @brief Indicates whether AVX2 code paths can be compiled (using the
+     * `target("avx2")` attribute), which are selected at runtime with
+     * `scu_has_avx2()`.
+     */
+    #define SCU_AVX2_DISPATCH
+#endif
+
+/**
+ * @brief Mixes the bits of a specified `u64` value (the SplitMix64 finalizer).
+ *
+ * @note Applying a finalizer on top of a user-provided hash function makes a
+ * data structure robust against hash functions with weak lower or upper bits,
+ * as well as against hash functions only producing 32-bit hashes.
+ *
+ * @param[in] v The value to mix.
+ * @return The mixed value.
+ */
+static inline u64 scu_mix_u64(u64 v) {
+    v ^= v >> 30;
+    v *= 0xBF58476D1CE4E5B9;
+    v ^= v >> 27;
+    v *= 0x94D049BB133111EB;
+    v ^= v >> 31;
+    return v;
+}
+
+/**
+ * @brief Returns the number of set bits of a specified `u32` value.
+ *
+ * @param[in] v The value to examine.
+ * @return The number of set bits.
+ */
+static inline isize scu_popcount_u32(u32 v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcount(v);
+#else
+    v = v - ((v >> 1) & 0x55555555);
+    v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+    v = (v + (v >> 4)) & 0x0F0F0F0F;
+    return (isize) ((v * 0x01010101) >> 24);
+#endif
+}
+
+/**
+ * @brief Returns the number of set bits of a specified `u64` value.
+ *
+ * @param[in] v The value to examine.
+ * @return The number of set bits.
+ */
+static inline isize scu_popcount_u64(u64 v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(v);
+#else
+    v = v - ((v >> 1) & 0x5555555555555555);
+    v = (v & 0x3333333333333333) + ((v >> 2) & 0x3333333333333333);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0F;
+    return (isize) ((v * 0x0101010101010101) >> 56);
+#endif
+}
+
+/**
+ * @brief Returns the number of leading zero bits of a specified `u64` value.
+ *
+ * @warning The behavior is undefined if `v` is zero.
+ *
+ * @param[in] v The value to examine.
+ * @return The number of leading zero bits.
+ */
+static inline isize scu_leading_zeros_u64(u64 v) {
+    SCU_ASSERT(v != 0);
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(v);
+#else
+    isize count = 0;
+    while ((v & ((u64) 1 << 63)) == 0) {
+        v <<= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Returns the number of trailing zero bits of a specified `u64` value.
+ *
+ * @warning The behavior is undefined if `v` is zero.
+ *
+ * @param[in] v The value to examine.
+ * @return The number of trailing zero bits.
+ */
+static inline isize scu_trailing_zeros_u64(u64 v) {
+    SCU_ASSERT(v != 0);
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(v);
+#else
+    isize count = 0;
+    while ((v & 1) == 0) {
+        v >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+#ifdef SCU_AVX2_DISPATCH
+    /**
+     * @brief Checks whether the processor supports AVX2.
+     *
+     * @note The capabilities of the processor are only queried once, after
+     * which this is a single load.
+     *
+     * @return `true` if the processor supports AVX2, otherwise `false`.
+     */
+    static inline bool scu_has_avx2() {
+    #ifdef __AVX2__
+        return true;
+    #else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+    #endif
+    }
+#endif
+
+/**
+ * @brief Returns the smallest power of two greater than or equal to a specified
+ * value.
+ *
+ * @param[in] n The value to examine.
+ * @return The smallest power of two greater than or equal to the specified
+ * value.
+ */
+static inline isize scu_next_power_of_two(isize n) {
+    SCU_ASSERT((n >= 0) && (n <= (ISIZE_MAX / 2)));
+    if (n <= 1) {
+        return 1;
+    }
+    usize v = (usize) n;
+    v--;
+    v |= v >> 1;
+    v |= v >> 2;
+    v |= v >> 4;
+    v |= v >> 8;
+    v |= v >> 16;
+#if ISIZE_WIDTH == 64
+    v |= v >> 32;
+#endif
+    v++;
+    return (isize) v;
+}
+
+#endif
\ No newline at end of file
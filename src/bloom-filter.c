@@ -0,0 +1,461 @@
+#define SCU_SHORT_ALIASES
+
+#include <math.h>
+#include "scu/alloc.h"
+#include "scu/assert.h"
+#include "scu/bloom-filter.h"
+#include "scu/math.h"
+#include "scu/memory.h"
+#include "bits.h"
+
+struct ScuBloomFilter {
+
+    /** @brief The number of blocks. */
+    isize blockCount;
+
+    /** @brief The number of bits set per element. */
+    isize hashCount;
+
+    /** @brief A function used for hashing elements. */
+    ScuHashFunc* hashFunc;
+
+    /**
+     * @brief The dynamically allocated memory backing the blocks.
+     *
+     * @note The allocation is slightly larger than the blocks themselves, so
+     * that they can be aligned to the size of a block.
+     */
+    void* allocation;
+
+    /**
+     * @brief The words making up the blocks.
+     *
+     * @note This is an array of `blockCount * SCU_WORDS_PER_BLOCK` words, which
+     * is aligned to the size of a block and points into `allocation`.
+     */
+    u64* words;
+
+};
+
+/** @brief The size of each block (in bytes). */
+static constexpr isize SCU_BLOCK_SIZE = 64;
+
+/** @brief The number of words per block. */
+static constexpr isize SCU_WORDS_PER_BLOCK = 8;
+
+/** @brief The number of bits per block. */
+static constexpr isize SCU_BITS_PER_BLOCK = 512;
+
+/** @brief The maximum number of blocks of a Bloom filter. */
+static constexpr isize SCU_MAX_BLOCK_COUNT = ((isize) 1 << 31);
+
+/** @brief The maximum number of bits set per element. */
+static constexpr isize SCU_MAX_HASH_COUNT = 16;
+
+/** @brief The magic number identifying a serialized Bloom filter. */
+static constexpr u32 SCU_SERIAL_MAGIC = 0x464C4253;
+
+/** @brief The version of the serialization format. */
+static constexpr u32 SCU_SERIAL_VERSION = 2;
+
+/** @brief The number of bits of a hash needed to select a bit of a block. */
+static constexpr isize SCU_BITS_PER_PROBE = 9;
+
+/** @brief The number of bit positions taken from a single mixed `u64` value. */
+static constexpr isize SCU_PROBES_PER_WORD = 7;
+
+/** @brief The size of the header of a serialized Bloom filter (in bytes). */
+static constexpr isize SCU_SERIAL_HEADER_SIZE = 16;
+
+/**
+ * @brief Computes the probability of a false positive of a blocked Bloom
+ * filter.
+ *
+ * @note The number of elements mapped to a block follows a Poisson distribution
+ * with mean `count / blockCount`, so the false positive rate is the weighted
+ * average of the false positive rates of classic Bloom filters with 512 bits
+ * and the respective number of elements.
+ *
+ * @param[in] count      The number of elements.
+ * @param[in] blockCount The number of blocks.
+ * @param[in] hashCount  The number of bits set per element.
+ * @return The probability of a false positive.
+ */
+static inline f64 scu_false_positive_rate(
+    isize count,
+    isize blockCount,
+    isize hashCount
+) {
+    SCU_ASSERT(count > 0);
+    SCU_ASSERT(blockCount > 0);
+    SCU_ASSERT(hashCount > 0);
+    f64 mean = (f64) count / (f64) blockCount;
+    f64 spread = (10.0 * sqrt(mean)) + 10.0;
+    isize first = (isize) fmax(0.0, mean - spread);
+    isize last = (isize) (mean + spread);
+    f64 missRate = 1.0 - (1.0 / (f64) SCU_BITS_PER_BLOCK);
+    f64 rate = 0.0;
+    for (isize i = first; i <= last; i++) {
+        f64 weight = exp(
+            ((f64) i * log(mean)) - mean - lgamma((f64) i + 1.0)
+        );
+        f64 setRate = 1.0 - pow(missRate, (f64) (i * hashCount));
+        rate += weight * pow(setRate, (f64) hashCount);
+    }
+    return rate;
+}
+
+/**
+ * @brief Allocates a new, empty Bloom filter with a specified number of blocks
+ * and bits set per element.
+ *
+ * @param[in] blockCount The number of blocks.
+ * @param[in] hashCount  The number of bits set per element.
+ * @param[in] hashFunc   A function used for hashing elements.
+ * @return A pointer to the new Bloom filter, or `nullptr` on failure.
+ */
+static inline ScuBloomFilter* scu_bloom_filter_alloc(
+    isize blockCount,
+    isize hashCount,
+    ScuHashFunc* hashFunc
+) {
+    SCU_ASSERT((blockCount > 0) && (blockCount <= SCU_MAX_BLOCK_COUNT));
+    SCU_ASSERT((hashCount > 0) && (hashCount <= SCU_MAX_HASH_COUNT));
+    SCU_ASSERT(hashFunc != nullptr);
+    if (blockCount > ((ISIZE_MAX / SCU_BLOCK_SIZE) - 1)) {
+        return nullptr;
+    }
+    ScuBloomFilter* filter = scu_malloc(SCU_SIZEOF(ScuBloomFilter));
+    if (filter == nullptr) {
+        return nullptr;
+    }
+    filter->allocation = scu_calloc(blockCount + 1, SCU_BLOCK_SIZE);
+    if (filter->allocation == nullptr) {
+        scu_free(filter);
+        return nullptr;
+    }
+    uptr address = (uptr) filter->allocation;
+    uptr alignedAddress = (address + (uptr) (SCU_BLOCK_SIZE - 1))
+        & ~((uptr) (SCU_BLOCK_SIZE - 1));
+    filter->words = (u64*) (void*) ((byte*) filter->allocation
+        + (alignedAddress - address));
+    filter->blockCount = blockCount;
+    filter->hashCount = hashCount;
+    filter->hashFunc = hashFunc;
+    return filter;
+}
+
+[[nodiscard]]
+ScuBloomFilter* scu_bloom_filter_new(
+    isize expectedCount,
+    f64 falsePositiveRate,
+    ScuHashFunc* hashFunc
+) {
+    SCU_ASSERT(expectedCount >= 0);
+    SCU_ASSERT((falsePositiveRate > 0.0) && (falsePositiveRate < 1.0));
+    SCU_ASSERT(hashFunc != nullptr);
+    isize count = SCU_MAX(expectedCount, 1);
+    f64 ln2 = log(2.0);
+    f64 bitsPerElem = -log(falsePositiveRate) / (ln2 * ln2);
+    isize hashCount = (isize) lround(bitsPerElem * ln2);
+    hashCount = SCU_MAX(hashCount, 1);
+    hashCount = SCU_MIN(hashCount, SCU_MAX_HASH_COUNT);
+    f64 blockCount = ceil(
+        ((f64) count * bitsPerElem) / (f64) SCU_BITS_PER_BLOCK
+    );
+    blockCount = fmax(blockCount, 1.0);
+    // Mapping every element to a single block makes the number of bits set per
+    // block uneven, which slightly increases the false positive rate compared
+    // to a classic Bloom filter. Compensate by adding blocks until the target
+    // false positive rate is met.
+    while (true) {
+        if (blockCount > (f64) SCU_MAX_BLOCK_COUNT) {
+            return nullptr;
+        }
+        f64 rate = scu_false_positive_rate(
+            count,
+            (isize) blockCount,
+            hashCount
+        );
+        if (rate <= falsePositiveRate) {
+            break;
+        }
+        blockCount += fmax(1.0, floor(blockCount / 32.0));
+    }
+    return scu_bloom_filter_alloc((isize) blockCount, hashCount, hashFunc);
+}
+
+[[nodiscard]]
+ScuBloomFilter* scu_bloom_filter_clone(const ScuBloomFilter* filter) {
+    SCU_ASSERT(filter != nullptr);
+    ScuBloomFilter* clone = scu_bloom_filter_alloc(
+        filter->blockCount,
+        filter->hashCount,
+        filter->hashFunc
+    );
+    if (clone == nullptr) {
+        return nullptr;
+    }
+    scu_memcpy(
+        clone->words,
+        filter->words,
+        filter->blockCount * SCU_BLOCK_SIZE
+    );
+    return clone;
+}
+
+isize scu_bloom_filter_bit_count(const ScuBloomFilter* filter) {
+    SCU_ASSERT(filter != nullptr);
+    return filter->blockCount * SCU_BITS_PER_BLOCK;
+}
+
+isize scu_bloom_filter_hash_count(const ScuBloomFilter* filter) {
+    SCU_ASSERT(filter != nullptr);
+    return filter->hashCount;
+}
+
+/**
+ * @brief Computes the block and the bit mask of the block corresponding to a
+ * specified hash.
+ *
+ * The upper half of the mixed hash selects the block. Each bit position within
+ * the block is taken from its own 9-bit slice of a stream of mixed values, so
+ * the positions are independent of each other, as assumed when sizing the
+ * Bloom filter in `scu_false_positive_rate()`. Double hashing would be cheaper,
+ * but its positions are strongly correlated within a block of only 512 bits,
+ * which noticeably increases the false positive rate at low targets.
+ *
+ * @param[in]  filter The Bloom filter to examine.
+ * @param[in]  hash   The hash to examine.
+ * @param[out] mask   The bit mask of the block (`SCU_WORDS_PER_BLOCK` words).
+ * @return A pointer to the first word of the block.
+ */
+static inline u64* scu_bloom_filter_block(
+    const ScuBloomFilter* restrict filter,
+    usize hash,
+    u64* restrict mask
+) {
+    SCU_ASSERT(filter != nullptr);
+    SCU_ASSERT(mask != nullptr);
+    u64 v = scu_mix_u64(hash);
+    // Map the upper half onto the range [0, blockCount) without a division.
+    isize blockIndex = (isize) (((v >> 32) * (u64) filter->blockCount) >> 32);
+    for (isize i = 0; i < SCU_WORDS_PER_BLOCK; i++) {
+        mask[i] = 0;
+    }
+    u64 state = v;
+    u64 bits = 0;
+    for (isize i = 0; i < filter->hashCount; i++) {
+        // Each mixed value provides seven fresh 9-bit slices (63 bits).
+        if ((i % SCU_PROBES_PER_WORD) == 0) {
+            state = scu_mix_u64(state);
+            bits = state;
+        }
+        u64 bit = bits & (u64) (SCU_BITS_PER_BLOCK - 1);
+        bits >>= SCU_BITS_PER_PROBE;
+        mask[bit >> 6] |= (u64) 1 << (bit & 63);
+    }
+    return &filter->words[blockIndex * SCU_WORDS_PER_BLOCK];
+}
+
+void scu_bloom_filter_add(
+    ScuBloomFilter* restrict filter,
+    const void* restrict elem
+) {
+    SCU_ASSERT(filter != nullptr);
+    SCU_ASSERT(elem != nullptr);
+    scu_bloom_filter_add_hash(filter, filter->hashFunc(elem));
+}
+
+void scu_bloom_filter_add_hash(ScuBloomFilter* filter, usize hash) {
+    SCU_ASSERT(filter != nullptr);
+    u64 mask[SCU_WORDS_PER_BLOCK];
+    u64* block = scu_bloom_filter_block(filter, hash, mask);
+    for (isize i = 0; i < SCU_WORDS_PER_BLOCK; i++) {
+        block[i] |= mask[i];
+    }
+}
+
+bool scu_bloom_filter_contains(
+    const ScuBloomFilter* restrict filter,
+    const void* restrict elem
+) {
+    SCU_ASSERT(filter != nullptr);
+    SCU_ASSERT(elem != nullptr);
+    return scu_bloom_filter_contains_hash(filter, filter->hashFunc(elem));
+}
+
+bool scu_bloom_filter_contains_hash(const ScuBloomFilter* filter, usize hash) {
+    SCU_ASSERT(filter != nullptr);
+    u64 mask[SCU_WORDS_PER_BLOCK];
+    const u64* block = scu_bloom_filter_block(filter, hash, mask);
+    // Check all words without branching, which allows the compiler to compare
+    // the whole block at once using SIMD instructions.
+    u64 missing = 0;
+    for (isize i = 0; i < SCU_WORDS_PER_BLOCK; i++) {
+        missing |= mask[i] & ~block[i];
+    }
+    return missing == 0;
+}
+
+void scu_bloom_filter_clear(ScuBloomFilter* filter) {
+    SCU_ASSERT(filter != nullptr);
+    scu_memset(filter->words, 0, filter->blockCount * SCU_BLOCK_SIZE);
+}
+
+bool scu_bloom_filter_union(
+    ScuBloomFilter* restrict dest,
+    const ScuBloomFilter* restrict src
+) {
+    SCU_ASSERT(dest != nullptr);
+    SCU_ASSERT(src != nullptr);
+    if (
+        (dest->blockCount != src->blockCount)
+            || (dest->hashCount != src->hashCount)
+            || (dest->hashFunc != src->hashFunc)
+    ) {
+        return false;
+    }
+    isize wordCount = dest->blockCount * SCU_WORDS_PER_BLOCK;
+    for (isize i = 0; i < wordCount; i++) {
+        dest->words[i] |= src->words[i];
+    }
+    return true;
+}
+
+isize scu_bloom_filter_serialized_size(const ScuBloomFilter* filter) {
+    SCU_ASSERT(filter != nullptr);
+    return SCU_SERIAL_HEADER_SIZE + (filter->blockCount * SCU_BLOCK_SIZE);
+}
+
+/**
+ * @brief Stores a `u32` value in little-endian byte order.
+ *
+ * @param[out] p The buffer to store the value in.
+ * @param[in]  v The value to store.
+ */
+static inline void scu_store_u32_le(byte* p, u32 v) {
+    SCU_ASSERT(p != nullptr);
+    for (isize i = 0; i < 4; i++) {
+        p[i] = (byte) (v >> (8 * i));
+    }
+}
+
+/**
+ * @brief Stores a `u64` value in little-endian byte order.
+ *
+ * @param[out] p The buffer to store the value in.
+ * @param[in]  v The value to store.
+ */
+static inline void scu_store_u64_le(byte* p, u64 v) {
+    SCU_ASSERT(p != nullptr);
+    for (isize i = 0; i < 8; i++) {
+        p[i] = (byte) (v >> (8 * i));
+    }
+}
+
+/**
+ * @brief Loads a `u32` value stored in little-endian byte order.
+ *
+ * @param[in] p The buffer to load the value from.
+ * @return The loaded value.
+ */
+static inline u32 scu_load_u32_le(const byte* p) {
+    SCU_ASSERT(p != nullptr);
+    u32 v = 0;
+    for (isize i = 0; i < 4; i++) {
+        v |= (u32) p[i] << (8 * i);
+    }
+    return v;
+}
+
+/**
+ * @brief Loads a `u64` value stored in little-endian byte order.
+ *
+ * @param[in] p The buffer to load the value from.
+ * @return The loaded value.
+ */
+static inline u64 scu_load_u64_le(const byte* p) {
+    SCU_ASSERT(p != nullptr);
+    u64 v = 0;
+    for (isize i = 0; i < 8; i++) {
+        v |= (u64) p[i] << (8 * i);
+    }
+    return v;
+}
+
+void scu_bloom_filter_serialize(
+    const ScuBloomFilter* restrict filter,
+    void* restrict buffer
+) {
+    SCU_ASSERT(filter != nullptr);
+    SCU_ASSERT(buffer != nullptr);
+    byte* p = (byte*) buffer;
+    scu_store_u32_le(&p[0], SCU_SERIAL_MAGIC);
+    scu_store_u32_le(&p[4], SCU_SERIAL_VERSION);
+    scu_store_u32_le(&p[8], (u32) filter->hashCount);
+    scu_store_u32_le(&p[12], (u32) filter->blockCount);
+    p += SCU_SERIAL_HEADER_SIZE;
+    isize wordCount = filter->blockCount * SCU_WORDS_PER_BLOCK;
+    for (isize i = 0; i < wordCount; i++) {
+        scu_store_u64_le(&p[i * SCU_SIZEOF(u64)], filter->words[i]);
+    }
+}
+
+ScuError scu_bloom_filter_deserialize(
+    ScuBloomFilter* restrict* restrict filter,
+    const void* restrict buffer,
+    isize size,
+    ScuHashFunc* hashFunc
+) {
+    SCU_ASSERT(filter != nullptr);
+    SCU_ASSERT(buffer != nullptr);
+    SCU_ASSERT(size >= 0);
+    SCU_ASSERT(hashFunc != nullptr);
+    *filter = nullptr;
+    const byte* p = (const byte*) buffer;
+    if (
+        (size < SCU_SERIAL_HEADER_SIZE)
+            || (scu_load_u32_le(&p[0]) != SCU_SERIAL_MAGIC)
+            || (scu_load_u32_le(&p[4]) != SCU_SERIAL_VERSION)
+    ) {
+        return SCU_ERROR_INVALID_FORMAT;
+    }
+    isize hashCount = scu_load_u32_le(&p[8]);
+    isize blockCount = scu_load_u32_le(&p[12]);
+    if (
+        (hashCount < 1)
+            || (hashCount > SCU_MAX_HASH_COUNT)
+            || (blockCount < 1)
+            || (blockCount > SCU_MAX_BLOCK_COUNT)
+            || (blockCount != ((size - SCU_SERIAL_HEADER_SIZE) / SCU_BLOCK_SIZE))
+            || (((size - SCU_SERIAL_HEADER_SIZE) % SCU_BLOCK_SIZE) != 0)
+    ) {
+        return SCU_ERROR_INVALID_FORMAT;
+    }
+    ScuBloomFilter* newFilter = scu_bloom_filter_alloc(
+        blockCount,
+        hashCount,
+        hashFunc
+    );
+    if (newFilter == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    p += SCU_SERIAL_HEADER_SIZE;
+    isize wordCount = blockCount * SCU_WORDS_PER_BLOCK;
+    for (isize i = 0; i < wordCount; i++) {
+        newFilter->words[i] = scu_load_u64_le(&p[i * SCU_SIZEOF(u64)]);
+    }
+    *filter = newFilter;
+    return SCU_ERROR_NONE;
+}
+
+void scu_bloom_filter_free(ScuBloomFilter* filter) {
+    if (filter != nullptr) {
+        scu_free(filter->allocation);
+        filter->allocation = nullptr;
+        filter->words = nullptr;
+        filter->blockCount = 0;
+        scu_free(filter);
+    }
+}
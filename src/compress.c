@@ -0,0 +1,1061 @@
+#define SCU_SHORT_ALIASES
+
+#include <string.h>
+#include "scu/alloc.h"
+#include "scu/assert.h"
+#include "scu/compress.h"
+#include "scu/math.h"
+#include "scu/memory.h"
+#include "bits.h"
+
+/** @brief The minimum length of a match (in bytes). */
+static constexpr isize SCU_MIN_MATCH = 4;
+
+/**
+ * @brief The number of bytes at the end of the input that are always emitted
+ * as literals.
+ */
+static constexpr isize SCU_LAST_LITERALS = 5;
+
+/**
+ * @brief The minimum distance between the start of a match and the end of the
+ * input (in bytes), which leaves room for the last literals.
+ */
+static constexpr isize SCU_MF_LIMIT = 12;
+
+/** @brief The maximum distance between a match and its reference (in bytes). */
+static constexpr isize SCU_MAX_OFFSET = 65535;
+
+/** @brief The base-2 logarithm of the number of entries of the hash table. */
+static constexpr isize SCU_HASH_LOG = 12;
+
+/** @brief The number of entries of the hash table. */
+static constexpr isize SCU_HASH_SIZE = (isize) 1 << SCU_HASH_LOG;
+
+/**
+ * @brief The base-2 logarithm of the number of failed match attempts after
+ * which the step between attempts is increased.
+ */
+static constexpr isize SCU_SKIP_TRIGGER = 6;
+
+/** @brief The value of a length nibble indicating additional length bytes. */
+static constexpr isize SCU_RUN_MASK = 15;
+
+/** @brief The magic number identifying a compressed stream ("SCUZ"). */
+static constexpr u32 SCU_MAGIC = 0x5A554353;
+
+/** @brief The version of the format of a compressed stream. */
+static constexpr u32 SCU_VERSION = 1;
+
+/** @brief The size of the header of a compressed stream (in bytes). */
+static constexpr isize SCU_HEADER_SIZE = 16;
+
+/** @brief The size of an index entry of a compressed stream (in bytes). */
+static constexpr isize SCU_ENTRY_SIZE = 8;
+
+/** @brief The size of the footer of a compressed stream (in bytes). */
+static constexpr isize SCU_FOOTER_SIZE = 32;
+
+/** @brief The flag marking a block stored without compression. */
+static constexpr u32 SCU_RAW_FLAG = (u32) 1 << 31;
+
+/** @brief The default block size (in bytes). */
+static constexpr isize SCU_DEFAULT_BLOCK_SIZE = 256 * 1024;
+
+/** @brief The maximum block size (in bytes). */
+static constexpr isize SCU_MAX_BLOCK_SIZE = 1024 * 1024 * 1024;
+
+/** @brief The initial capacity of the index of a writer (in blocks). */
+static constexpr isize SCU_INITIAL_INDEX_CAPACITY = 16;
+
+/** @brief The factor used when growing the index of a writer. */
+static constexpr isize SCU_GROWTH_FACTOR = 2;
+
+struct ScuCompressWriter {
+
+    /** @brief The file stream to write to. */
+    ScuFile* file;
+
+    /** @brief The buffer collecting the data of the current block. */
+    byte* block;
+
+    /** @brief The buffer receiving the compressed data of a block. */
+    byte* compressed;
+
+    /** @brief The size of each block (in bytes). */
+    isize blockSize;
+
+    /** @brief The number of bytes used in the current block. */
+    isize used;
+
+    /**
+     * @brief The stored size (including the raw flag) of each block written,
+     * in the format of the index.
+     */
+    u32* storedSizes;
+
+    /** @brief The number of blocks written. */
+    isize blockCount;
+
+    /** @brief The capacity of `storedSizes` (in blocks). */
+    isize indexCapacity;
+
+    /** @brief The offset of the next block relative to the stream start. */
+    isize position;
+
+    /** @brief The number of bytes written to the writer. */
+    isize size;
+
+};
+
+struct ScuCompressReader {
+
+    /** @brief The file stream to read from. */
+    ScuFile* file;
+
+    /** @brief The size of each block (in bytes). */
+    isize blockSize;
+
+    /** @brief The number of blocks. */
+    isize blockCount;
+
+    /** @brief The decompressed size of the data (in bytes). */
+    isize size;
+
+    /**
+     * @brief The offsets of the blocks within the file, followed by the offset
+     * of the index.
+     */
+    isize* offsets;
+
+    /** @brief Whether each block is stored without compression. */
+    bool* isRaw;
+
+    /** @brief The buffer holding the compressed data of a block. */
+    byte* compressed;
+
+    /** @brief The buffer holding the decompressed data of the cached block. */
+    byte* block;
+
+    /** @brief The index of the cached block, or `-1` if there is none. */
+    isize cachedIndex;
+
+    /** @brief The position of the next sequential read. */
+    isize position;
+
+};
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    /** @brief Indicates that values must be byte-swapped to little-endian. */
+    #define SCU_IS_BIG_ENDIAN
+#endif
+
+// The loads and stores below are on the hot paths of the compressor and the
+// decompressor. A fixed-size `memcpy()` compiles to a single (unaligned) move
+// instruction, whereas loops over the individual bytes often do not.
+
+/**
+ * @brief Loads a `u32` value stored in little-endian byte order.
+ *
+ * @param[in] p The buffer to load the value from.
+ * @return The loaded value.
+ */
+static inline u32 scu_load_u32_le(const byte* p) {
+    u32 v;
+    memcpy(&v, p, sizeof(v));
+#ifdef SCU_IS_BIG_ENDIAN
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+/**
+ * @brief Loads a `u64` value stored in little-endian byte order.
+ *
+ * @param[in] p The buffer to load the value from.
+ * @return The loaded value.
+ */
+static inline u64 scu_load_u64_le(const byte* p) {
+    u64 v;
+    memcpy(&v, p, sizeof(v));
+#ifdef SCU_IS_BIG_ENDIAN
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+/**
+ * @brief Stores a `u32` value in little-endian byte order.
+ *
+ * @param[out] p The buffer to store the value in.
+ * @param[in]  v The value to store.
+ */
+static inline void scu_store_u32_le(byte* p, u32 v) {
+#ifdef SCU_IS_BIG_ENDIAN
+    v = __builtin_bswap32(v);
+#endif
+    memcpy(p, &v, sizeof(v));
+}
+
+/**
+ * @brief Stores a `u64` value in little-endian byte order.
+ *
+ * @param[out] p The buffer to store the value in.
+ * @param[in]  v The value to store.
+ */
+static inline void scu_store_u64_le(byte* p, u64 v) {
+#ifdef SCU_IS_BIG_ENDIAN
+    v = __builtin_bswap64(v);
+#endif
+    memcpy(p, &v, sizeof(v));
+}
+
+/**
+ * @brief Copies a block of memory in chunks of sixteen bytes.
+ *
+ * @warning Up to sixteen bytes beyond the end of both blocks may be read or
+ * written, respectively, even if `count` is zero. The blocks may only overlap
+ * if `target` lies at least eight bytes after `source`.
+ *
+ * @param[out] target The location to copy to.
+ * @param[in]  source The location to copy from.
+ * @param[in]  count  The number of bytes to copy.
+ */
+static inline void scu_wild_copy(
+    byte* target,
+    const byte* source,
+    isize count
+) {
+    // Short copies are by far the most common, so the first sixteen bytes are
+    // copied unconditionally rather than in a loop of unpredictable length.
+    isize copied = 0;
+    do {
+        scu_store_u64_le(&target[copied], scu_load_u64_le(&source[copied]));
+        scu_store_u64_le(
+            &target[copied + 8],
+            scu_load_u64_le(&source[copied + 8])
+        );
+        copied += 16;
+    } while (copied < count);
+}
+
+/**
+ * @brief Hashes the four bytes at the start of a potential match.
+ *
+ * @param[in] sequence The four bytes to hash.
+ * @return The index of the corresponding entry of the hash table.
+ */
+static inline isize scu_hash_sequence(u32 sequence) {
+    return (isize) ((sequence * 2654435761U) >> (32 - SCU_HASH_LOG));
+}
+
+/**
+ * @brief Returns the length of the common prefix of two positions of the input,
+ * limited by a specified end.
+ *
+ * @param[in] in    The input.
+ * @param[in] ip    The current position.
+ * @param[in] ref   The earlier position to compare against.
+ * @param[in] limit The position the common prefix must not extend beyond.
+ * @return The length of the common prefix (in bytes).
+ */
+static inline isize scu_common_length(
+    const byte* in,
+    isize ip,
+    isize ref,
+    isize limit
+) {
+    isize length = 0;
+    // Eight bytes are compared at a time, and the first differing byte of a
+    // mismatch is located by its trailing zero bits.
+    while (ip + length + 8 <= limit) {
+        u64 difference = scu_load_u64_le(&in[ip + length])
+            ^ scu_load_u64_le(&in[ref + length]);
+        if (difference != 0) {
+            return length + scu_trailing_zeros_u64(difference) / 8;
+        }
+        length += 8;
+    }
+    while ((ip + length < limit) && (in[ip + length] == in[ref + length])) {
+        length++;
+    }
+    return length;
+}
+
+/**
+ * @brief Writes the additional bytes of a length that does not fit into its
+ * nibble of the token.
+ *
+ * @param[out]     out    The output buffer.
+ * @param[in, out] op     The position to write to, which is advanced.
+ * @param[in]      length The remaining length, i.e., the length minus
+ *                        `SCU_RUN_MASK`.
+ */
+static inline void scu_write_length(byte* out, isize* op, isize length) {
+    while (length >= 255) {
+        out[(*op)++] = 255;
+        length -= 255;
+    }
+    out[(*op)++] = (byte) length;
+}
+
+/**
+ * @brief Writes a sequence consisting of literals and (optionally) a match.
+ *
+ * @param[out]     out         The output buffer.
+ * @param[in]      capacity    The capacity of the output buffer.
+ * @param[in, out] op          The position to write to, which is advanced.
+ * @param[in]      literals    The literals of the sequence.
+ * @param[in]      literalSize The number of literals.
+ * @param[in]      offset      The distance to the reference of the match.
+ * @param[in]      matchLength The length of the match, or zero for the last
+ *                             sequence, which has no match.
+ * @return `SCU_ERROR_WRITING_BUFFER` if the sequence does not fit into the
+ * output buffer, or `SCU_ERROR_NONE` on success.
+ */
+static ScuError scu_write_sequence(
+    byte* restrict out,
+    isize capacity,
+    isize* restrict op,
+    const byte* restrict literals,
+    isize literalSize,
+    isize offset,
+    isize matchLength
+) {
+    isize needed = 1 + literalSize + (literalSize / 255) + 1;
+    if (matchLength > 0) {
+        needed += 2 + ((matchLength - SCU_MIN_MATCH) / 255) + 1;
+    }
+    if (needed > capacity - *op) {
+        return SCU_ERROR_WRITING_BUFFER;
+    }
+    isize tokenPosition = (*op)++;
+    byte token;
+    if (literalSize >= SCU_RUN_MASK) {
+        token = (byte) (SCU_RUN_MASK << 4);
+        scu_write_length(out, op, literalSize - SCU_RUN_MASK);
+    }
+    else {
+        token = (byte) (literalSize << 4);
+    }
+    scu_memcpy(&out[*op], literals, literalSize);
+    *op += literalSize;
+    if (matchLength > 0) {
+        out[(*op)++] = (byte) offset;
+        out[(*op)++] = (byte) (offset >> 8);
+        isize length = matchLength - SCU_MIN_MATCH;
+        if (length >= SCU_RUN_MASK) {
+            token |= (byte) SCU_RUN_MASK;
+            scu_write_length(out, op, length - SCU_RUN_MASK);
+        }
+        else {
+            token |= (byte) length;
+        }
+    }
+    out[tokenPosition] = token;
+    return SCU_ERROR_NONE;
+}
+
+isize scu_compress_bound(isize size) {
+    SCU_ASSERT(size >= 0);
+    return size + (size / 255) + 16;
+}
+
+ScuError scu_compress(
+    const void* restrict source,
+    isize size,
+    void* restrict destination,
+    isize capacity,
+    isize* restrict compressedSize
+) {
+    SCU_ASSERT((size >= 0) && (size <= INT32_MAX));
+    SCU_ASSERT((size == 0) || (source != nullptr));
+    SCU_ASSERT(capacity >= 0);
+    SCU_ASSERT((capacity == 0) || (destination != nullptr));
+    SCU_ASSERT(compressedSize != nullptr);
+    const byte* in = source;
+    byte* out = destination;
+    isize op = 0;
+    isize anchor = 0;
+    if (size > SCU_MF_LIMIT) {
+        // Each entry holds the last position whose first four bytes hashed to
+        // it. Stale or colliding entries are filtered out by comparing bytes.
+        u32 table[SCU_HASH_SIZE];
+        scu_memset(table, 0, SCU_SIZEOF(table));
+        isize mfLimit = size - SCU_MF_LIMIT;
+        isize matchLimit = size - SCU_LAST_LITERALS;
+        isize ip = 1;
+        while (true) {
+            isize ref = 0;
+            bool isFound = false;
+            // The step between attempts grows with the number of failures, so
+            // incompressible data is skipped quickly.
+            isize attempts = (isize) 1 << SCU_SKIP_TRIGGER;
+            while (ip <= mfLimit) {
+                u32 sequence = scu_load_u32_le(&in[ip]);
+                isize hash = scu_hash_sequence(sequence);
+                ref = table[hash];
+                table[hash] = (u32) ip;
+                if (
+                    (ip - ref <= SCU_MAX_OFFSET)
+                    && (scu_load_u32_le(&in[ref]) == sequence)
+                ) {
+                    isFound = true;
+                    break;
+                }
+                ip += attempts++ >> SCU_SKIP_TRIGGER;
+            }
+            if (!isFound) {
+                break;
+            }
+            while ((ip > anchor) && (ref > 0) && (in[ip - 1] == in[ref - 1])) {
+                ip--;
+                ref--;
+            }
+            isize matchLength = SCU_MIN_MATCH + scu_common_length(
+                in,
+                ip + SCU_MIN_MATCH,
+                ref + SCU_MIN_MATCH,
+                matchLimit
+            );
+            ScuError error = scu_write_sequence(
+                out,
+                capacity,
+                &op,
+                &in[anchor],
+                ip - anchor,
+                ip - ref,
+                matchLength
+            );
+            if (error != SCU_ERROR_NONE) {
+                return error;
+            }
+            ip += matchLength;
+            anchor = ip;
+            if (ip > mfLimit) {
+                break;
+            }
+            // The position just before the end of the match is likely to
+            // start a match as well, e.g., for repeated records.
+            table[scu_hash_sequence(scu_load_u32_le(&in[ip - 2]))] =
+                (u32) (ip - 2);
+        }
+    }
+    ScuError error = scu_write_sequence(
+        out,
+        capacity,
+        &op,
+        &in[anchor],
+        size - anchor,
+        0,
+        0
+    );
+    if (error != SCU_ERROR_NONE) {
+        return error;
+    }
+    *compressedSize = op;
+    return SCU_ERROR_NONE;
+}
+
+/**
+ * @brief Reads the additional bytes of a length that did not fit into its
+ * nibble of the token.
+ *
+ * @param[in]      in     The compressed data.
+ * @param[in]      size   The size of the compressed data.
+ * @param[in, out] ip     The position to read from, which is advanced.
+ * @param[in, out] length The length, which is increased by the bytes read.
+ * @return `true` on success, or `false` if the compressed data ends early or
+ * the length exceeds the size of the compressed data.
+ */
+static bool scu_read_length(
+    const byte* restrict in,
+    isize size,
+    isize* restrict ip,
+    isize* restrict length
+) {
+    byte b;
+    do {
+        if (*ip >= size) {
+            return false;
+        }
+        b = in[(*ip)++];
+        *length += b;
+        // No valid length can exceed the size of the compressed data by more
+        // than a factor of 255, which also rules out overflows.
+        if (*length > size * 255) {
+            return false;
+        }
+    } while (b == 255);
+    return true;
+}
+
+ScuError scu_decompress(
+    const void* restrict source,
+    isize size,
+    void* restrict destination,
+    isize capacity,
+    isize* restrict decompressedSize
+) {
+    SCU_ASSERT(size >= 0);
+    SCU_ASSERT((size == 0) || (source != nullptr));
+    SCU_ASSERT(capacity >= 0);
+    SCU_ASSERT((capacity == 0) || (destination != nullptr));
+    SCU_ASSERT(decompressedSize != nullptr);
+    const byte* in = source;
+    byte* out = destination;
+    isize ip = 0;
+    isize op = 0;
+    while (true) {
+        if (ip >= size) {
+            return SCU_ERROR_INVALID_FORMAT;
+        }
+        byte token = in[ip++];
+        isize literalSize = token >> 4;
+        if (
+            (literalSize == SCU_RUN_MASK)
+            && !scu_read_length(in, size, &ip, &literalSize)
+        ) {
+            return SCU_ERROR_INVALID_FORMAT;
+        }
+        if (literalSize > size - ip) {
+            return SCU_ERROR_INVALID_FORMAT;
+        }
+        if (literalSize > capacity - op) {
+            return SCU_ERROR_WRITING_BUFFER;
+        }
+        if (
+            (literalSize + 16 <= size - ip)
+            && (literalSize + 16 <= capacity - op)
+        ) {
+            scu_wild_copy(&out[op], &in[ip], literalSize);
+        }
+        else {
+            scu_memcpy(&out[op], &in[ip], literalSize);
+        }
+        ip += literalSize;
+        op += literalSize;
+        if (ip == size) {
+            break;
+        }
+        if (size - ip < 2) {
+            return SCU_ERROR_INVALID_FORMAT;
+        }
+        isize offset = (isize) in[ip] | ((isize) in[ip + 1] << 8);
+        ip += 2;
+        if ((offset == 0) || (offset > op)) {
+            return SCU_ERROR_INVALID_FORMAT;
+        }
+        isize matchLength = token & SCU_RUN_MASK;
+        if (
+            (matchLength == SCU_RUN_MASK)
+            && !scu_read_length(in, size, &ip, &matchLength)
+        ) {
+            return SCU_ERROR_INVALID_FORMAT;
+        }
+        matchLength += SCU_MIN_MATCH;
+        if (matchLength > capacity - op) {
+            return SCU_ERROR_WRITING_BUFFER;
+        }
+        byte* match = &out[op - offset];
+        byte* target = &out[op];
+        if ((offset >= 8) && (matchLength + 16 <= capacity - op)) {
+            scu_wild_copy(target, match, matchLength);
+        }
+        else {
+            // Matches may overlap their own output (e.g., for runs). As the
+            // output is periodic from the start of the match on, each copy
+            // from there may span everything written so far, which doubles the
+            // size of the copies without ever overlapping.
+            isize copied = 0;
+            while (copied < matchLength) {
+                isize count = SCU_MIN(copied + offset, matchLength - copied);
+                scu_memcpy(&target[copied], match, count);
+                copied += count;
+            }
+        }
+        op += matchLength;
+    }
+    *decompressedSize = op;
+    return SCU_ERROR_NONE;
+}
+
+[[nodiscard]]
+ScuCompressWriter* scu_compress_writer_new(ScuFile* file) {
+    return scu_compress_writer_new_with_block_size(
+        file,
+        SCU_DEFAULT_BLOCK_SIZE
+    );
+}
+
+[[nodiscard]]
+ScuCompressWriter* scu_compress_writer_new_with_block_size(
+    ScuFile* file,
+    isize blockSize
+) {
+    SCU_ASSERT(file != nullptr);
+    SCU_ASSERT((blockSize >= 1) && (blockSize <= SCU_MAX_BLOCK_SIZE));
+    ScuCompressWriter* writer = scu_malloc(SCU_SIZEOF(ScuCompressWriter));
+    if (writer == nullptr) {
+        return nullptr;
+    }
+    writer->block = scu_malloc(blockSize * SCU_SIZEOF(byte));
+    writer->compressed = scu_malloc(blockSize * SCU_SIZEOF(byte));
+    writer->storedSizes = scu_malloc(
+        SCU_INITIAL_INDEX_CAPACITY * SCU_SIZEOF(u32)
+    );
+    if (
+        (writer->block == nullptr)
+            || (writer->compressed == nullptr)
+            || (writer->storedSizes == nullptr)
+    ) {
+        scu_compress_writer_free(writer);
+        return nullptr;
+    }
+    byte header[SCU_HEADER_SIZE];
+    scu_store_u32_le(&header[0], SCU_MAGIC);
+    scu_store_u32_le(&header[4], SCU_VERSION);
+    scu_store_u32_le(&header[8], (u32) blockSize);
+    scu_store_u32_le(&header[12], 0);
+    if (scu_fwrite(file, header, 1, SCU_HEADER_SIZE) != 1) {
+        scu_compress_writer_free(writer);
+        return nullptr;
+    }
+    writer->file = file;
+    writer->blockSize = blockSize;
+    writer->used = 0;
+    writer->blockCount = 0;
+    writer->indexCapacity = SCU_INITIAL_INDEX_CAPACITY;
+    writer->position = SCU_HEADER_SIZE;
+    writer->size = 0;
+    return writer;
+}
+
+/**
+ * @brief Compresses the current block of a specified writer and writes it to
+ * the file stream.
+ *
+ * @note The block is stored uncompressed if compression does not shrink it.
+ * Nothing is written if the block is empty.
+ *
+ * @param[in, out] writer The writer whose block to write.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * `SCU_ERROR_WRITING_FILE` if an error occurred while writing to the file
+ * stream, or `SCU_ERROR_NONE` on success.
+ */
+static ScuError scu_compress_writer_flush(ScuCompressWriter* writer) {
+    if (writer->used == 0) {
+        return SCU_ERROR_NONE;
+    }
+    if (writer->blockCount == writer->indexCapacity) {
+        isize newCapacity = writer->indexCapacity * SCU_GROWTH_FACTOR;
+        u32* newStoredSizes = scu_realloc(
+            writer->storedSizes,
+            newCapacity * SCU_SIZEOF(u32)
+        );
+        if (newStoredSizes == nullptr) {
+            return SCU_ERROR_OUT_OF_MEMORY;
+        }
+        writer->storedSizes = newStoredSizes;
+        writer->indexCapacity = newCapacity;
+    }
+    // Limiting the output to one byte less than the input makes compression
+    // fail as soon as it would not save anything.
+    isize compressedSize;
+    bool isRaw = (
+        scu_compress(
+            writer->block,
+            writer->used,
+            writer->compressed,
+            writer->used - 1,
+            &compressedSize
+        ) != SCU_ERROR_NONE
+    );
+    const byte* data = isRaw ? writer->block : writer->compressed;
+    isize storedSize = isRaw ? writer->used : compressedSize;
+    if (scu_fwrite(writer->file, data, 1, storedSize) != 1) {
+        return SCU_ERROR_WRITING_FILE;
+    }
+    writer->storedSizes[writer->blockCount] =
+        (u32) storedSize | (isRaw ? SCU_RAW_FLAG : 0);
+    writer->blockCount++;
+    writer->position += storedSize;
+    writer->used = 0;
+    return SCU_ERROR_NONE;
+}
+
+ScuError scu_compress_writer_write(
+    ScuCompressWriter* restrict writer,
+    const void* restrict data,
+    isize size
+) {
+    SCU_ASSERT(writer != nullptr);
+    SCU_ASSERT(size >= 0);
+    SCU_ASSERT((size == 0) || (data != nullptr));
+    const byte* bytes = data;
+    while (size > 0) {
+        isize count = SCU_MIN(size, writer->blockSize - writer->used);
+        scu_memcpy(&writer->block[writer->used], bytes, count);
+        writer->used += count;
+        writer->size += count;
+        bytes += count;
+        size -= count;
+        if (writer->used == writer->blockSize) {
+            ScuError error = scu_compress_writer_flush(writer);
+            if (error != SCU_ERROR_NONE) {
+                return error;
+            }
+        }
+    }
+    return SCU_ERROR_NONE;
+}
+
+ScuError scu_compress_writer_finish(ScuCompressWriter* writer) {
+    SCU_ASSERT(writer != nullptr);
+    ScuError error = scu_compress_writer_flush(writer);
+    if (error != SCU_ERROR_NONE) {
+        return error;
+    }
+    for (isize i = 0; i < writer->blockCount; i++) {
+        // All blocks except the last one are full, so their decompressed
+        // sizes are stored for validation only.
+        isize rawSize = (i < writer->blockCount - 1)
+            ? writer->blockSize
+            : writer->size - (i * writer->blockSize);
+        byte entry[SCU_ENTRY_SIZE];
+        scu_store_u32_le(&entry[0], writer->storedSizes[i]);
+        scu_store_u32_le(&entry[4], (u32) rawSize);
+        if (scu_fwrite(writer->file, entry, 1, SCU_ENTRY_SIZE) != 1) {
+            return SCU_ERROR_WRITING_FILE;
+        }
+    }
+    byte footer[SCU_FOOTER_SIZE];
+    scu_store_u64_le(&footer[0], (u64) writer->position);
+    scu_store_u64_le(&footer[8], (u64) writer->blockCount);
+    scu_store_u64_le(&footer[16], (u64) writer->size);
+    scu_store_u32_le(&footer[24], 0);
+    scu_store_u32_le(&footer[28], SCU_MAGIC);
+    if (scu_fwrite(writer->file, footer, 1, SCU_FOOTER_SIZE) != 1) {
+        return SCU_ERROR_WRITING_FILE;
+    }
+    return scu_fflush(writer->file);
+}
+
+void scu_compress_writer_free(ScuCompressWriter* writer) {
+    if (writer != nullptr) {
+        scu_free(writer->storedSizes);
+        writer->storedSizes = nullptr;
+        scu_free(writer->compressed);
+        writer->compressed = nullptr;
+        scu_free(writer->block);
+        writer->block = nullptr;
+        scu_free(writer);
+    }
+}
+
+/**
+ * @brief Reads the footer, header and index of a compressed stream into a
+ * specified reader and validates them.
+ *
+ * @param[in, out] reader The reader to initialize, whose file stream is set.
+ * @return `true` if the compressed stream is valid, otherwise `false`.
+ */
+static bool scu_compress_reader_init(ScuCompressReader* reader) {
+    ScuFile* file = reader->file;
+    isize previous = scu_ftell(file);
+    if (
+        (previous < 0)
+            || (scu_fseek(file, SCU_SEEK_ORIGIN_END, 0) != SCU_ERROR_NONE)
+    ) {
+        return false;
+    }
+    isize fileSize = scu_ftell(file);
+    if (scu_fseek(file, SCU_SEEK_ORIGIN_SET, previous) != SCU_ERROR_NONE) {
+        return false;
+    }
+    byte footer[SCU_FOOTER_SIZE];
+    if (
+        (fileSize < SCU_HEADER_SIZE + SCU_FOOTER_SIZE)
+            || (
+                scu_fread_at(
+                    file,
+                    footer,
+                    SCU_FOOTER_SIZE,
+                    fileSize - SCU_FOOTER_SIZE
+                ) != SCU_FOOTER_SIZE
+            )
+            || (scu_load_u32_le(&footer[28]) != SCU_MAGIC)
+    ) {
+        return false;
+    }
+    u64 indexOffset = scu_load_u64_le(&footer[0]);
+    u64 blockCount = scu_load_u64_le(&footer[8]);
+    u64 size = scu_load_u64_le(&footer[16]);
+    // The index and the blocks must fit into the file, which also bounds all
+    // values read so far and rules out overflows below.
+    u64 available = (u64) (fileSize - SCU_FOOTER_SIZE);
+    if (
+        (blockCount > available / (u64) SCU_ENTRY_SIZE)
+            || (indexOffset > available - (blockCount * (u64) SCU_ENTRY_SIZE))
+            || (indexOffset < SCU_HEADER_SIZE)
+            || (size > (u64) ISIZE_MAX)
+    ) {
+        return false;
+    }
+    isize start = fileSize - SCU_FOOTER_SIZE
+        - ((isize) blockCount * SCU_ENTRY_SIZE) - (isize) indexOffset;
+    byte header[SCU_HEADER_SIZE];
+    if (
+        (scu_fread_at(file, header, SCU_HEADER_SIZE, start) != SCU_HEADER_SIZE)
+            || (scu_load_u32_le(&header[0]) != SCU_MAGIC)
+            || (scu_load_u32_le(&header[4]) != SCU_VERSION)
+    ) {
+        return false;
+    }
+    isize blockSize = scu_load_u32_le(&header[8]);
+    if (
+        (blockSize < 1)
+            || (blockSize > SCU_MAX_BLOCK_SIZE)
+            || (blockCount != ((size + (u64) blockSize - 1) / (u64) blockSize))
+    ) {
+        return false;
+    }
+    reader->blockSize = blockSize;
+    reader->blockCount = (isize) blockCount;
+    reader->size = (isize) size;
+    reader->offsets = scu_malloc(
+        (reader->blockCount + 1) * SCU_SIZEOF(isize)
+    );
+    reader->isRaw = scu_malloc(
+        SCU_MAX(reader->blockCount, 1) * SCU_SIZEOF(bool)
+    );
+    isize indexSize = reader->blockCount * SCU_ENTRY_SIZE;
+    byte* index = scu_malloc(SCU_MAX(indexSize, 1) * SCU_SIZEOF(byte));
+    bool isValid = (reader->offsets != nullptr)
+        && (reader->isRaw != nullptr)
+        && (index != nullptr)
+        && (
+            scu_fread_at(file, index, indexSize, start + (isize) indexOffset)
+                == indexSize
+        );
+    if (isValid) {
+        reader->offsets[0] = start + SCU_HEADER_SIZE;
+        for (isize i = 0; isValid && (i < reader->blockCount); i++) {
+            u32 stored = scu_load_u32_le(&index[i * SCU_ENTRY_SIZE]);
+            isize rawSize = scu_load_u32_le(&index[(i * SCU_ENTRY_SIZE) + 4]);
+            isize storedSize = stored & ~SCU_RAW_FLAG;
+            reader->isRaw[i] = ((stored & SCU_RAW_FLAG) != 0);
+            reader->offsets[i + 1] = reader->offsets[i] + storedSize;
+            isize expectedSize = SCU_MIN(
+                blockSize,
+                reader->size - (i * blockSize)
+            );
+            isValid = (rawSize == expectedSize)
+                && (storedSize >= 1)
+                && (reader->isRaw[i] ? (storedSize == rawSize)
+                                     : (storedSize < rawSize))
+                && (reader->offsets[i + 1] <= start + (isize) indexOffset);
+        }
+        isValid = isValid
+            && (reader->offsets[reader->blockCount]
+                == start + (isize) indexOffset);
+    }
+    scu_free(index);
+    return isValid;
+}
+
+[[nodiscard]]
+ScuCompressReader* scu_compress_reader_new(ScuFile* file) {
+    SCU_ASSERT(file != nullptr);
+    ScuCompressReader* reader = scu_malloc(SCU_SIZEOF(ScuCompressReader));
+    if (reader == nullptr) {
+        return nullptr;
+    }
+    reader->file = file;
+    reader->offsets = nullptr;
+    reader->isRaw = nullptr;
+    reader->compressed = nullptr;
+    reader->block = nullptr;
+    reader->cachedIndex = -1;
+    reader->position = 0;
+    if (!scu_compress_reader_init(reader)) {
+        scu_compress_reader_free(reader);
+        return nullptr;
+    }
+    // Compressed blocks are always smaller than their decompressed size.
+    reader->compressed = scu_malloc(reader->blockSize * SCU_SIZEOF(byte));
+    reader->block = scu_malloc(reader->blockSize * SCU_SIZEOF(byte));
+    if ((reader->compressed == nullptr) || (reader->block == nullptr)) {
+        scu_compress_reader_free(reader);
+        return nullptr;
+    }
+    return reader;
+}
+
+isize scu_compress_reader_size(const ScuCompressReader* reader) {
+    SCU_ASSERT(reader != nullptr);
+    return reader->size;
+}
+
+isize scu_compress_reader_block_size(const ScuCompressReader* reader) {
+    SCU_ASSERT(reader != nullptr);
+    return reader->blockSize;
+}
+
+isize scu_compress_reader_block_count(const ScuCompressReader* reader) {
+    SCU_ASSERT(reader != nullptr);
+    return reader->blockCount;
+}
+
+/**
+ * @brief Reads and decompresses a single block of a specified reader using a
+ * specified buffer for the compressed data.
+ *
+ * @param[in]  reader     The reader to read from.
+ * @param[in]  index      The index of the block to read.
+ * @param[out] compressed A buffer large enough for the compressed block.
+ * @param[out] buffer     The buffer to decompress the block into.
+ * @param[out] size       A pointer to the decompressed size of the block on
+ *                        success, otherwise unchanged.
+ * @return `SCU_ERROR_READING_FILE` if an error occurred while reading from the
+ * file stream, `SCU_ERROR_INVALID_FORMAT` if the block is corrupted, or
+ * `SCU_ERROR_NONE` on success.
+ */
+static ScuError scu_compress_reader_decode(
+    const ScuCompressReader* restrict reader,
+    isize index,
+    byte* restrict compressed,
+    byte* restrict buffer,
+    isize* restrict size
+) {
+    isize offset = reader->offsets[index];
+    isize storedSize = reader->offsets[index + 1] - offset;
+    isize rawSize = SCU_MIN(
+        reader->blockSize,
+        reader->size - (index * reader->blockSize)
+    );
+    if (reader->isRaw[index]) {
+        if (scu_fread_at(reader->file, buffer, rawSize, offset) != rawSize) {
+            return SCU_ERROR_READING_FILE;
+        }
+        *size = rawSize;
+        return SCU_ERROR_NONE;
+    }
+    if (
+        scu_fread_at(reader->file, compressed, storedSize, offset)
+            != storedSize
+    ) {
+        return SCU_ERROR_READING_FILE;
+    }
+    isize decompressedSize;
+    if (
+        (
+            scu_decompress(
+                compressed,
+                storedSize,
+                buffer,
+                rawSize,
+                &decompressedSize
+            ) != SCU_ERROR_NONE
+        )
+            || (decompressedSize != rawSize)
+    ) {
+        return SCU_ERROR_INVALID_FORMAT;
+    }
+    *size = rawSize;
+    return SCU_ERROR_NONE;
+}
+
+ScuError scu_compress_reader_read_block(
+    const ScuCompressReader* restrict reader,
+    isize index,
+    void* restrict buffer,
+    isize* restrict size
+) {
+    SCU_ASSERT(reader != nullptr);
+    SCU_ASSERT((index >= 0) && (index < reader->blockCount));
+    SCU_ASSERT(buffer != nullptr);
+    SCU_ASSERT(size != nullptr);
+    isize storedSize = reader->offsets[index + 1] - reader->offsets[index];
+    byte* compressed = scu_malloc(storedSize * SCU_SIZEOF(byte));
+    if (compressed == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    ScuError error = scu_compress_reader_decode(
+        reader,
+        index,
+        compressed,
+        buffer,
+        size
+    );
+    scu_free(compressed);
+    return error;
+}
+
+ScuError scu_compress_reader_read(
+    ScuCompressReader* restrict reader,
+    void* restrict buffer,
+    isize count,
+    isize* restrict read
+) {
+    SCU_ASSERT(reader != nullptr);
+    SCU_ASSERT(count >= 0);
+    SCU_ASSERT((count == 0) || (buffer != nullptr));
+    SCU_ASSERT(read != nullptr);
+    if ((reader->position == reader->size) && (count > 0)) {
+        return SCU_ERROR_END_OF_FILE;
+    }
+    byte* bytes = buffer;
+    isize total = 0;
+    while ((total < count) && (reader->position < reader->size)) {
+        isize index = reader->position / reader->blockSize;
+        if (index != reader->cachedIndex) {
+            // The cache is invalidated first, so a failed decode does not
+            // leave a partially overwritten block behind.
+            reader->cachedIndex = -1;
+            isize blockLength;
+            ScuError error = scu_compress_reader_decode(
+                reader,
+                index,
+                reader->compressed,
+                reader->block,
+                &blockLength
+            );
+            if (error != SCU_ERROR_NONE) {
+                return error;
+            }
+            reader->cachedIndex = index;
+        }
+        isize blockOffset = reader->position - (index * reader->blockSize);
+        isize blockLength = SCU_MIN(
+            reader->blockSize,
+            reader->size - (index * reader->blockSize)
+        );
+        isize n = SCU_MIN(count - total, blockLength - blockOffset);
+        scu_memcpy(&bytes[total], &reader->block[blockOffset], n);
+        total += n;
+        reader->position += n;
+    }
+    *read = total;
+    return SCU_ERROR_NONE;
+}
+
+void scu_compress_reader_seek(ScuCompressReader* reader, isize position) {
+    SCU_ASSERT(reader != nullptr);
+    SCU_ASSERT((position >= 0) && (position <= reader->size));
+    reader->position = position;
+}
+
+void scu_compress_reader_free(ScuCompressReader* reader) {
+    if (reader != nullptr) {
+        scu_free(reader->block);
+        reader->block = nullptr;
+        scu_free(reader->compressed);
+        reader->compressed = nullptr;
+        scu_free(reader->isRaw);
+        reader->isRaw = nullptr;
+        scu_free(reader->offsets);
+        reader->offsets = nullptr;
+        scu_free(reader);
+    }
+}
\ No newline at end of file
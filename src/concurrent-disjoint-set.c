@@ -0,0 +1,195 @@
+#define SCU_SHORT_ALIASES
+
+#include <stdatomic.h>
+#include "scu/alloc.h"
+#include "scu/assert.h"
+#include "scu/concurrent-disjoint-set.h"
+#include "scu/math.h"
+#include "scu/memory.h"
+
+struct ScuConcurrentDisjointSet {
+
+    /** @brief The number of integers. */
+    isize count;
+
+    /** @brief The number of sets. */
+    _Atomic(isize) setCount;
+
+    /**
+     * @brief The parent of each integer.
+     *
+     * @note This is a dynamically allocated array of `count` integers. The
+     * representative of each set is its own parent, and every other integer
+     * has a parent greater than itself.
+     */
+    _Atomic(isize)* parents;
+
+};
+
+[[nodiscard]]
+ScuConcurrentDisjointSet* scu_concurrent_disjoint_set_new(isize count) {
+    SCU_ASSERT(count >= 0);
+    if (count > (ISIZE_MAX / SCU_SIZEOF(_Atomic(isize)))) {
+        return nullptr;
+    }
+    ScuConcurrentDisjointSet* disjointSet = scu_malloc(
+        SCU_SIZEOF(ScuConcurrentDisjointSet)
+    );
+    if (disjointSet == nullptr) {
+        return nullptr;
+    }
+    disjointSet->parents = scu_malloc(
+        SCU_MAX(count, 1) * SCU_SIZEOF(_Atomic(isize))
+    );
+    if (disjointSet->parents == nullptr) {
+        scu_free(disjointSet);
+        return nullptr;
+    }
+    for (isize i = 0; i < count; i++) {
+        atomic_init(&disjointSet->parents[i], i);
+    }
+    disjointSet->count = count;
+    atomic_init(&disjointSet->setCount, count);
+    return disjointSet;
+}
+
+isize scu_concurrent_disjoint_set_count(
+    const ScuConcurrentDisjointSet* disjointSet
+) {
+    SCU_ASSERT(disjointSet != nullptr);
+    return disjointSet->count;
+}
+
+isize scu_concurrent_disjoint_set_set_count(
+    const ScuConcurrentDisjointSet* disjointSet
+) {
+    SCU_ASSERT(disjointSet != nullptr);
+    return atomic_load_explicit(&disjointSet->setCount, memory_order_relaxed);
+}
+
+isize scu_concurrent_disjoint_set_find(
+    ScuConcurrentDisjointSet* disjointSet,
+    isize x
+) {
+    SCU_ASSERT(disjointSet != nullptr);
+    SCU_ASSERT((x >= 0) && (x < disjointSet->count));
+    _Atomic(isize)* parents = disjointSet->parents;
+    while (true) {
+        isize parent = atomic_load_explicit(&parents[x], memory_order_acquire);
+        if (parent == x) {
+            return x;
+        }
+        isize grandparent = atomic_load_explicit(
+            &parents[parent],
+            memory_order_acquire
+        );
+        if (grandparent != parent) {
+            // Path halving. The grandparent is in the same set as `x`, so it is
+            // always valid to link `x` to it. If another thread changed the
+            // parent in the meantime, the update is simply skipped.
+            atomic_compare_exchange_weak_explicit(
+                &parents[x],
+                &parent,
+                grandparent,
+                memory_order_release,
+                memory_order_relaxed
+            );
+        }
+        x = grandparent;
+    }
+}
+
+bool scu_concurrent_disjoint_set_union(
+    ScuConcurrentDisjointSet* disjointSet,
+    isize x,
+    isize y
+) {
+    SCU_ASSERT(disjointSet != nullptr);
+    while (true) {
+        x = scu_concurrent_disjoint_set_find(disjointSet, x);
+        y = scu_concurrent_disjoint_set_find(disjointSet, y);
+        if (x == y) {
+            return false;
+        }
+        // Always link the smaller representative to the larger one. As parents
+        // only ever increase, no cycles can be formed.
+        if (x > y) {
+            isize temp = x;
+            x = y;
+            y = temp;
+        }
+        isize expected = x;
+        if (
+            atomic_compare_exchange_strong_explicit(
+                &disjointSet->parents[x],
+                &expected,
+                y,
+                memory_order_acq_rel,
+                memory_order_acquire
+            )
+        ) {
+            atomic_fetch_sub_explicit(
+                &disjointSet->setCount,
+                1,
+                memory_order_relaxed
+            );
+            return true;
+        }
+        // Another thread linked `x` in the meantime, so try again.
+    }
+}
+
+bool scu_concurrent_disjoint_set_same_set(
+    ScuConcurrentDisjointSet* disjointSet,
+    isize x,
+    isize y
+) {
+    SCU_ASSERT(disjointSet != nullptr);
+    while (true) {
+        x = scu_concurrent_disjoint_set_find(disjointSet, x);
+        y = scu_concurrent_disjoint_set_find(disjointSet, y);
+        if (x == y) {
+            return true;
+        }
+        // If `x` is still a representative, the sets of `x` and `y` were
+        // distinct at the time `y` was found. Otherwise, the sets may have been
+        // merged in the meantime, so try again.
+        if (
+            atomic_load_explicit(
+                &disjointSet->parents[x],
+                memory_order_acquire
+            ) == x
+        ) {
+            return false;
+        }
+    }
+}
+
+isize scu_concurrent_disjoint_set_label(
+    ScuConcurrentDisjointSet* restrict disjointSet,
+    isize* restrict labels
+) {
+    SCU_ASSERT(disjointSet != nullptr);
+    SCU_ASSERT((labels != nullptr) || (disjointSet->count == 0));
+    for (isize i = 0; i < disjointSet->count; i++) {
+        labels[i] = -1;
+    }
+    isize labelCount = 0;
+    for (isize i = 0; i < disjointSet->count; i++) {
+        isize root = scu_concurrent_disjoint_set_find(disjointSet, i);
+        if (labels[root] < 0) {
+            labels[root] = labelCount++;
+        }
+        labels[i] = labels[root];
+    }
+    return labelCount;
+}
+
+void scu_concurrent_disjoint_set_free(ScuConcurrentDisjointSet* disjointSet) {
+    if (disjointSet != nullptr) {
+        scu_free(disjointSet->parents);
+        disjointSet->parents = nullptr;
+        disjointSet->count = 0;
+        scu_free(disjointSet);
+    }
+}
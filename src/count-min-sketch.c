@@ -0,0 +1,274 @@
+#define SCU_SHORT_ALIASES
+
+#include <math.h>
+#include "scu/alloc.h"
+#include "scu/assert.h"
+#include "scu/count-min-sketch.h"
+#include "scu/math.h"
+#include "scu/memory.h"
+#include "bits.h"
+
+struct ScuCountMinSketch {
+
+    /** @brief The number of counters per row (always a power of two). */
+    isize width;
+
+    /** @brief The number of rows. */
+    isize depth;
+
+    /** @brief The sum of all counts added. */
+    u64 total;
+
+    /** @brief A function used for hashing elements. */
+    ScuHashFunc* hashFunc;
+
+    /**
+     * @brief The counters.
+     *
+     * @note This is a dynamically allocated array of `depth * width` counters,
+     * stored row by row.
+     */
+    u64* counters;
+
+};
+
+[[nodiscard]]
+ScuCountMinSketch* scu_count_min_sketch_new(
+    isize width,
+    isize depth,
+    ScuHashFunc* hashFunc
+) {
+    SCU_ASSERT(width > 0);
+    SCU_ASSERT(depth > 0);
+    SCU_ASSERT(hashFunc != nullptr);
+    width = scu_next_power_of_two(width);
+    if (width > ((ISIZE_MAX / SCU_SIZEOF(u64)) / depth)) {
+        return nullptr;
+    }
+    ScuCountMinSketch* sketch = scu_malloc(SCU_SIZEOF(ScuCountMinSketch));
+    if (sketch == nullptr) {
+        return nullptr;
+    }
+    sketch->counters = scu_calloc(width * depth, SCU_SIZEOF(u64));
+    if (sketch->counters == nullptr) {
+        scu_free(sketch);
+        return nullptr;
+    }
+    sketch->width = width;
+    sketch->depth = depth;
+    sketch->total = 0;
+    sketch->hashFunc = hashFunc;
+    return sketch;
+}
+
+[[nodiscard]]
+ScuCountMinSketch* scu_count_min_sketch_new_with_error(
+    f64 epsilon,
+    f64 delta,
+    ScuHashFunc* hashFunc
+) {
+    SCU_ASSERT((epsilon > 0.0) && (epsilon < 1.0));
+    SCU_ASSERT((delta > 0.0) && (delta < 1.0));
+    SCU_ASSERT(hashFunc != nullptr);
+    f64 width = ceil(exp(1.0) / epsilon);
+    f64 depth = ceil(log(1.0 / delta));
+    if (width > (f64) (ISIZE_MAX / 2)) {
+        return nullptr;
+    }
+    return scu_count_min_sketch_new(
+        (isize) width,
+        SCU_MAX((isize) depth, 1),
+        hashFunc
+    );
+}
+
+[[nodiscard]]
+ScuCountMinSketch* scu_count_min_sketch_clone(const ScuCountMinSketch* sketch) {
+    SCU_ASSERT(sketch != nullptr);
+    ScuCountMinSketch* clone = scu_malloc(SCU_SIZEOF(ScuCountMinSketch));
+    if (clone == nullptr) {
+        return nullptr;
+    }
+    isize size = sketch->width * sketch->depth * SCU_SIZEOF(u64);
+    clone->counters = scu_malloc(size);
+    if (clone->counters == nullptr) {
+        scu_free(clone);
+        return nullptr;
+    }
+    scu_memcpy(clone->counters, sketch->counters, size);
+    clone->width = sketch->width;
+    clone->depth = sketch->depth;
+    clone->total = sketch->total;
+    clone->hashFunc = sketch->hashFunc;
+    return clone;
+}
+
+isize scu_count_min_sketch_width(const ScuCountMinSketch* sketch) {
+    SCU_ASSERT(sketch != nullptr);
+    return sketch->width;
+}
+
+isize scu_count_min_sketch_depth(const ScuCountMinSketch* sketch) {
+    SCU_ASSERT(sketch != nullptr);
+    return sketch->depth;
+}
+
+u64 scu_count_min_sketch_total(const ScuCountMinSketch* sketch) {
+    SCU_ASSERT(sketch != nullptr);
+    return sketch->total;
+}
+
+/**
+ * @brief Adds two `u64` values, saturating at `U64_MAX`.
+ *
+ * @param[in] a The first value.
+ * @param[in] b The second value.
+ * @return The saturated sum of both values.
+ */
+static inline u64 scu_saturating_add(u64 a, u64 b) {
+    return (a > (U64_MAX - b)) ? U64_MAX : (a + b);
+}
+
+/**
+ * @brief Returns the minimum of the counters of an element with a specified
+ * hash.
+ *
+ * @note The index of the counter in row `i` is derived from a single hash using
+ * double hashing, i.e., it is `(h1 + (i * h2)) mod width`.
+ *
+ * @param[in] sketch The sketch to examine.
+ * @param[in] hash   The hash of the element.
+ * @return The minimum of the counters of the element.
+ */
+static inline u64 scu_count_min_sketch_min(
+    const ScuCountMinSketch* sketch,
+    usize hash
+) {
+    SCU_ASSERT(sketch != nullptr);
+    u64 h1 = scu_mix_u64(hash);
+    u64 h2 = scu_mix_u64(h1) | 1;
+    u64 mask = (u64) sketch->width - 1;
+    const u64* row = sketch->counters;
+    u64 estimate = U64_MAX;
+    for (isize i = 0; i < sketch->depth; i++) {
+        estimate = SCU_MIN(estimate, row[h1 & mask]);
+        h1 += h2;
+        row += sketch->width;
+    }
+    return estimate;
+}
+
+/**
+ * @brief Raises all counters of an element with a specified hash to at least a
+ * specified value.
+ *
+ * @param[in, out] sketch The sketch to modify.
+ * @param[in]      hash   The hash of the element.
+ * @param[in]      value  The minimum value of the counters.
+ */
+static inline void scu_count_min_sketch_raise(
+    ScuCountMinSketch* sketch,
+    usize hash,
+    u64 value
+) {
+    SCU_ASSERT(sketch != nullptr);
+    u64 h1 = scu_mix_u64(hash);
+    u64 h2 = scu_mix_u64(h1) | 1;
+    u64 mask = (u64) sketch->width - 1;
+    u64* row = sketch->counters;
+    for (isize i = 0; i < sketch->depth; i++) {
+        row[h1 & mask] = SCU_MAX(row[h1 & mask], value);
+        h1 += h2;
+        row += sketch->width;
+    }
+}
+
+void scu_count_min_sketch_add(
+    ScuCountMinSketch* restrict sketch,
+    const void* restrict elem,
+    u64 count
+) {
+    SCU_ASSERT(sketch != nullptr);
+    SCU_ASSERT(elem != nullptr);
+    scu_count_min_sketch_add_hash(sketch, sketch->hashFunc(elem), count);
+}
+
+void scu_count_min_sketch_add_hash(
+    ScuCountMinSketch* sketch,
+    usize hash,
+    u64 count
+) {
+    SCU_ASSERT(sketch != nullptr);
+    // Conservative update: only raise the counters that are lower than the new
+    // estimate, as all other counters already overestimate the frequency.
+    u64 estimate = scu_count_min_sketch_min(sketch, hash);
+    scu_count_min_sketch_raise(
+        sketch,
+        hash,
+        scu_saturating_add(estimate, count)
+    );
+    sketch->total = scu_saturating_add(sketch->total, count);
+}
+
+u64 scu_count_min_sketch_estimate(
+    const ScuCountMinSketch* restrict sketch,
+    const void* restrict elem
+) {
+    SCU_ASSERT(sketch != nullptr);
+    SCU_ASSERT(elem != nullptr);
+    return scu_count_min_sketch_estimate_hash(sketch, sketch->hashFunc(elem));
+}
+
+u64 scu_count_min_sketch_estimate_hash(
+    const ScuCountMinSketch* sketch,
+    usize hash
+) {
+    SCU_ASSERT(sketch != nullptr);
+    return scu_count_min_sketch_min(sketch, hash);
+}
+
+bool scu_count_min_sketch_merge(
+    ScuCountMinSketch* restrict dest,
+    const ScuCountMinSketch* restrict src
+) {
+    SCU_ASSERT(dest != nullptr);
+    SCU_ASSERT(src != nullptr);
+    if (
+        (dest->width != src->width)
+            || (dest->depth != src->depth)
+            || (dest->hashFunc != src->hashFunc)
+    ) {
+        return false;
+    }
+    // Summing conservatively updated counters still yields an overestimate for
+    // every element, so the guarantees of the sketch are preserved.
+    isize counterCount = dest->width * dest->depth;
+    for (isize i = 0; i < counterCount; i++) {
+        dest->counters[i] = scu_saturating_add(
+            dest->counters[i],
+            src->counters[i]
+        );
+    }
+    dest->total = scu_saturating_add(dest->total, src->total);
+    return true;
+}
+
+void scu_count_min_sketch_clear(ScuCountMinSketch* sketch) {
+    SCU_ASSERT(sketch != nullptr);
+    scu_memset(
+        sketch->counters,
+        0,
+        sketch->width * sketch->depth * SCU_SIZEOF(u64)
+    );
+    sketch->total = 0;
+}
+
+void scu_count_min_sketch_free(ScuCountMinSketch* sketch) {
+    if (sketch != nullptr) {
+        scu_free(sketch->counters);
+        sketch->counters = nullptr;
+        sketch->width = 0;
+        sketch->depth = 0;
+        scu_free(sketch);
+    }
+}
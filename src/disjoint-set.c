@@ -0,0 +1,181 @@
+#define SCU_SHORT_ALIASES
+
+#include "scu/alloc.h"
+#include "scu/assert.h"
+#include "scu/disjoint-set.h"
+#include "scu/math.h"
+#include "scu/memory.h"
+
+struct ScuDisjointSet {
+
+    /** @brief The number of integers. */
+    isize count;
+
+    /** @brief The number of sets. */
+    isize setCount;
+
+    /**
+     * @brief The parent of each integer.
+     *
+     * @note This is a dynamically allocated array of `count` integers. The
+     * representative of each set is its own parent.
+     */
+    isize* parents;
+
+    /**
+     * @brief The size of the set of each representative.
+     *
+     * @note This is a dynamically allocated array of `count` sizes, which are
+     * only meaningful for representatives.
+     */
+    isize* sizes;
+
+};
+
+/**
+ * @brief Allocates a new disjoint set with a specified number of integers
+ * without initializing them.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @param[in] count The number of integers.
+ * @return A pointer to the new disjoint set, or `nullptr` on failure.
+ */
+static inline ScuDisjointSet* scu_disjoint_set_alloc(isize count) {
+    SCU_ASSERT(count >= 0);
+    if (count > (ISIZE_MAX / (2 * SCU_SIZEOF(isize)))) {
+        return nullptr;
+    }
+    ScuDisjointSet* disjointSet = scu_malloc(SCU_SIZEOF(ScuDisjointSet));
+    if (disjointSet == nullptr) {
+        return nullptr;
+    }
+    // Both arrays share a single allocation.
+    isize size = SCU_MAX(count, 1) * SCU_SIZEOF(isize);
+    disjointSet->parents = scu_malloc(2 * size);
+    if (disjointSet->parents == nullptr) {
+        scu_free(disjointSet);
+        return nullptr;
+    }
+    disjointSet->sizes = &disjointSet->parents[SCU_MAX(count, 1)];
+    disjointSet->count = count;
+    disjointSet->setCount = count;
+    return disjointSet;
+}
+
+[[nodiscard]]
+ScuDisjointSet* scu_disjoint_set_new(isize count) {
+    SCU_ASSERT(count >= 0);
+    ScuDisjointSet* disjointSet = scu_disjoint_set_alloc(count);
+    if (disjointSet == nullptr) {
+        return nullptr;
+    }
+    for (isize i = 0; i < count; i++) {
+        disjointSet->parents[i] = i;
+        disjointSet->sizes[i] = 1;
+    }
+    return disjointSet;
+}
+
+[[nodiscard]]
+ScuDisjointSet* scu_disjoint_set_clone(const ScuDisjointSet* disjointSet) {
+    SCU_ASSERT(disjointSet != nullptr);
+    ScuDisjointSet* clone = scu_disjoint_set_alloc(disjointSet->count);
+    if (clone == nullptr) {
+        return nullptr;
+    }
+    isize size = disjointSet->count * SCU_SIZEOF(isize);
+    scu_memcpy(clone->parents, disjointSet->parents, size);
+    scu_memcpy(clone->sizes, disjointSet->sizes, size);
+    clone->setCount = disjointSet->setCount;
+    return clone;
+}
+
+isize scu_disjoint_set_count(const ScuDisjointSet* disjointSet) {
+    SCU_ASSERT(disjointSet != nullptr);
+    return disjointSet->count;
+}
+
+isize scu_disjoint_set_set_count(const ScuDisjointSet* disjointSet) {
+    SCU_ASSERT(disjointSet != nullptr);
+    return disjointSet->setCount;
+}
+
+isize scu_disjoint_set_find(ScuDisjointSet* disjointSet, isize x) {
+    SCU_ASSERT(disjointSet != nullptr);
+    SCU_ASSERT((x >= 0) && (x < disjointSet->count));
+    isize* parents = disjointSet->parents;
+    // Path halving: make every other node on the path point to its
+    // grandparent, which roughly halves the length of the path.
+    while (parents[x] != x) {
+        parents[x] = parents[parents[x]];
+        x = parents[x];
+    }
+    return x;
+}
+
+bool scu_disjoint_set_union(ScuDisjointSet* disjointSet, isize x, isize y) {
+    SCU_ASSERT(disjointSet != nullptr);
+    isize rootX = scu_disjoint_set_find(disjointSet, x);
+    isize rootY = scu_disjoint_set_find(disjointSet, y);
+    if (rootX == rootY) {
+        return false;
+    }
+    // Union by size: attach the smaller tree to the root of the larger one.
+    if (disjointSet->sizes[rootX] < disjointSet->sizes[rootY]) {
+        isize temp = rootX;
+        rootX = rootY;
+        rootY = temp;
+    }
+    disjointSet->parents[rootY] = rootX;
+    disjointSet->sizes[rootX] += disjointSet->sizes[rootY];
+    disjointSet->setCount--;
+    return true;
+}
+
+bool scu_disjoint_set_same_set(
+    ScuDisjointSet* disjointSet,
+    isize x,
+    isize y
+) {
+    SCU_ASSERT(disjointSet != nullptr);
+    return scu_disjoint_set_find(disjointSet, x)
+        == scu_disjoint_set_find(disjointSet, y);
+}
+
+isize scu_disjoint_set_set_size(ScuDisjointSet* disjointSet, isize x) {
+    SCU_ASSERT(disjointSet != nullptr);
+    return disjointSet->sizes[scu_disjoint_set_find(disjointSet, x)];
+}
+
+isize scu_disjoint_set_label(
+    ScuDisjointSet* restrict disjointSet,
+    isize* restrict labels
+) {
+    SCU_ASSERT(disjointSet != nullptr);
+    SCU_ASSERT((labels != nullptr) || (disjointSet->count == 0));
+    for (isize i = 0; i < disjointSet->count; i++) {
+        labels[i] = -1;
+    }
+    isize labelCount = 0;
+    for (isize i = 0; i < disjointSet->count; i++) {
+        isize root = scu_disjoint_set_find(disjointSet, i);
+        if (labels[root] < 0) {
+            labels[root] = labelCount++;
+        }
+        labels[i] = labels[root];
+    }
+    SCU_ASSERT(labelCount == disjointSet->setCount);
+    return labelCount;
+}
+
+void scu_disjoint_set_free(ScuDisjointSet* disjointSet) {
+    if (disjointSet != nullptr) {
+        scu_free(disjointSet->parents);
+        disjointSet->parents = nullptr;
+        disjointSet->sizes = nullptr;
+        disjointSet->count = 0;
+        disjointSet->setCount = 0;
+        scu_free(disjointSet);
+    }
+}
@@ -0,0 +1,175 @@
+#ifndef SCU_FLAT_LAYOUT_H
+#define SCU_FLAT_LAYOUT_H
+
+// Navigation and search of arrays stored in one of the layouts of
+// `ScuFlatLayout`, shared by the flat set and the flat map. This header is
+// internal to the library and expects `SCU_SHORT_ALIASES` to be defined.
+
+#include "scu/array.h"
+#include "scu/assert.h"
+#include "scu/compare.h"
+#include "scu/flat-set.h"
+#include "scu/types.h"
+#include "bits.h"
+
+/**
+ * @brief The number of levels of the implicit tree to prefetch ahead during a
+ * search in the Eytzinger layout.
+ */
+static constexpr isize SCU_PREFETCH_LEVELS = 4;
+
+/**
+ * @brief Hints the processor to load the memory at a specified address into the
+ * cache.
+ *
+ * @param[in] address The address to prefetch.
+ */
+static inline void scu_prefetch(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#else
+    (void) address;
+#endif
+}
+
+/**
+ * @brief Returns the first node (one-based) of the implicit tree of the
+ * Eytzinger layout in ascending order.
+ *
+ * @note In the Eytzinger layout, the node `k` (one-based) of the implicit tree
+ * is stored at position `k - 1`, and its children are the nodes `2 * k` and
+ * `2 * k + 1`.
+ *
+ * @param[in] count The number of nodes.
+ * @return The first node in ascending order, or `0` if there are no nodes.
+ */
+static inline isize scu_eytzinger_first(isize count) {
+    SCU_ASSERT(count >= 0);
+    if (count == 0) {
+        return 0;
+    }
+    isize k = 1;
+    while ((2 * k) <= count) {
+        k = 2 * k;
+    }
+    return k;
+}
+
+/**
+ * @brief Returns the node (one-based) of the implicit tree of the Eytzinger
+ * layout following a specified node in ascending order.
+ *
+ * @param[in] count The number of nodes.
+ * @param[in] k     The current node.
+ * @return The next node in ascending order, or `0` if `k` is the last node.
+ */
+static inline isize scu_eytzinger_next(isize count, isize k) {
+    SCU_ASSERT((k >= 1) && (k <= count));
+    if (((2 * k) + 1) <= count) {
+        // Descend to the leftmost node of the right subtree.
+        k = (2 * k) + 1;
+        while ((2 * k) <= count) {
+            k = 2 * k;
+        }
+        return k;
+    }
+    // Ascend past all ancestors of which the current node is in the right
+    // subtree, i.e., remove all trailing one bits and one more bit.
+    return k >> (scu_trailing_zeros_u64(~(u64) k) + 1);
+}
+
+/**
+ * @brief Returns the position of the smallest element of an array in a
+ * specified layout that is not less than (or greater than) a specified key.
+ *
+ * @param[in] elems    The array to search.
+ * @param[in] count    The number of elements.
+ * @param[in] elemSize The size of each element (in bytes).
+ * @param[in] layout   The layout of the array.
+ * @param[in] cmpFunc  The comparison function determining the order.
+ * @param[in] key      The key to search for.
+ * @param[in] isUpper  `true` to search for the smallest element greater than
+ *                     the key, or `false` to search for the smallest element
+ *                     not less than the key.
+ * @return The position of the element, or `-1` if there is no such element.
+ */
+static inline isize scu_flat_layout_bound(
+    const byte* restrict elems,
+    isize count,
+    isize elemSize,
+    ScuFlatLayout layout,
+    ScuCompareFunc* cmpFunc,
+    const void* restrict key,
+    bool isUpper
+) {
+    SCU_ASSERT((elems != nullptr) || (count == 0));
+    SCU_ASSERT(key != nullptr);
+    if (layout == SCU_FLAT_LAYOUT_SORTED) {
+        isize position = isUpper
+            ? scu_array_upper_bound(elems, count, elemSize, key, cmpFunc)
+            : scu_array_lower_bound(elems, count, elemSize, key, cmpFunc);
+        return (position < count) ? position : -1;
+    }
+    // An element is "left" of the bound if it is less than (or equal to) the
+    // key, so the bound is the first element that is not.
+    int threshold = isUpper ? 1 : 0;
+    isize k = 1;
+    while (k <= count) {
+        // The descendants of k that are SCU_PREFETCH_LEVELS levels deeper are
+        // stored contiguously, so a single prefetch covers most of them.
+        if (k <= (count >> SCU_PREFETCH_LEVELS)) {
+            isize descendant = k << SCU_PREFETCH_LEVELS;
+            scu_prefetch(&elems[(descendant - 1) * elemSize]);
+        }
+        const byte* elem = &elems[(k - 1) * elemSize];
+        k = (2 * k) + ((cmpFunc(elem, key) < threshold) ? 1 : 0);
+    }
+    // The path went right whenever the element was left of the bound, so the
+    // bound is the node where it went left for the last time.
+    k >>= scu_trailing_zeros_u64(~(u64) k) + 1;
+    return k - 1;
+}
+
+/**
+ * @brief Returns the position of the smallest element of an array in a
+ * specified layout.
+ *
+ * @param[in] count  The number of elements.
+ * @param[in] layout The layout of the array.
+ * @return The position of the smallest element, or `-1` if there are no
+ * elements.
+ */
+static inline isize scu_flat_layout_first(isize count, ScuFlatLayout layout) {
+    SCU_ASSERT(count >= 0);
+    if (count == 0) {
+        return -1;
+    }
+    if (layout == SCU_FLAT_LAYOUT_SORTED) {
+        return 0;
+    }
+    return scu_eytzinger_first(count) - 1;
+}
+
+/**
+ * @brief Returns the position of the element of an array in a specified layout
+ * following the element at a specified position in ascending order.
+ *
+ * @param[in] count    The number of elements.
+ * @param[in] layout   The layout of the array.
+ * @param[in] position The current position.
+ * @return The position of the next element, or `-1` if the current element is
+ * the largest one.
+ */
+static inline isize scu_flat_layout_next(
+    isize count,
+    ScuFlatLayout layout,
+    isize position
+) {
+    SCU_ASSERT((position >= 0) && (position < count));
+    if (layout == SCU_FLAT_LAYOUT_SORTED) {
+        return ((position + 1) < count) ? (position + 1) : -1;
+    }
+    return scu_eytzinger_next(count, position + 1) - 1;
+}
+
+#endif
\ No newline at end of file
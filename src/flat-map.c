@@ -0,0 +1,321 @@
+#define SCU_SHORT_ALIASES
+
+#include <stddef.h>
+#include "scu/alloc.h"
+#include "scu/array.h"
+#include "scu/assert.h"
+#include "scu/flat-map.h"
+#include "scu/math.h"
+#include "scu/memory.h"
+#include "flat-layout.h"
+
+struct ScuFlatMap {
+
+    /** @brief The size of each key (in bytes). */
+    isize keySize;
+
+    /** @brief The size of each value (in bytes). */
+    isize valueSize;
+
+    /** @brief The number of key-value pairs. */
+    isize count;
+
+    /** @brief The memory layout of the keys and values. */
+    ScuFlatLayout layout;
+
+    /** @brief A comparison function used to determine the order of keys. */
+    ScuCompareFunc* cmpFunc;
+
+    /**
+     * @brief The keys of the flat map.
+     *
+     * @note This is a dynamically allocated array of `count` keys. For the
+     * Eytzinger layout, the node `k` (one-based) of the implicit tree is stored
+     * at position `k - 1`, and its children are the nodes `2 * k` and
+     * `2 * k + 1`.
+     */
+    byte* keys;
+
+    /**
+     * @brief The values of the flat map.
+     *
+     * @note This is a dynamically allocated array of `count` values, where the
+     * value at each position is associated with the key at the same position.
+     */
+    byte* values;
+
+};
+
+/**
+ * @brief Rounds up a value to the next multiple of a specified alignment.
+ *
+ * @warning The behavior is undefined if `alignment` is not a power of two.
+ *
+ * @param[in] value     The value to round up.
+ * @param[in] alignment The required alignment.
+ * @return The smallest multiple of `alignment` greater than or equal to
+ * `value`.
+ */
+static inline isize scu_align_up(isize value, isize alignment) {
+    SCU_ASSERT(value >= 0);
+    SCU_ASSERT(alignment > 0);
+    SCU_ASSERT((alignment & (alignment - 1)) == 0);
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+[[nodiscard]]
+ScuFlatMap* scu_flat_map_new(
+    const void* keys,
+    const void* values,
+    isize count,
+    isize keySize,
+    isize valueSize,
+    ScuCompareFunc* cmpFunc,
+    ScuFlatLayout layout
+) {
+    SCU_ASSERT(((keys != nullptr) && (values != nullptr)) || (count == 0));
+    SCU_ASSERT(count >= 0);
+    SCU_ASSERT(keySize > 0);
+    SCU_ASSERT(valueSize > 0);
+    SCU_ASSERT(cmpFunc != nullptr);
+    SCU_ASSERT(
+        (layout == SCU_FLAT_LAYOUT_SORTED)
+            || (layout == SCU_FLAT_LAYOUT_EYTZINGER)
+    );
+    // The pairs are sorted as records holding a key followed by its value.
+    // Records are padded, so that every key is suitably aligned for the
+    // comparison function.
+    isize valueOffset = scu_align_up(keySize, SCU_ALIGNOF(max_align_t));
+    if (
+        (valueSize > (ISIZE_MAX / 2))
+            || (valueOffset > ((ISIZE_MAX / 2) - valueSize))
+    ) {
+        return nullptr;
+    }
+    isize recordSize = scu_align_up(
+        valueOffset + valueSize,
+        SCU_ALIGNOF(max_align_t)
+    );
+    if (count > (ISIZE_MAX / recordSize)) {
+        return nullptr;
+    }
+    ScuFlatMap* flatMap = scu_malloc(SCU_SIZEOF(ScuFlatMap));
+    if (flatMap == nullptr) {
+        return nullptr;
+    }
+    byte* records = scu_malloc(SCU_MAX(count * recordSize, 1));
+    if (records == nullptr) {
+        scu_free(flatMap);
+        return nullptr;
+    }
+    const byte* keyBytes = keys;
+    const byte* valueBytes = values;
+    for (isize i = 0; i < count; i++) {
+        byte* record = &records[i * recordSize];
+        scu_memcpy(record, &keyBytes[i * keySize], keySize);
+        scu_memcpy(&record[valueOffset], &valueBytes[i * valueSize], valueSize);
+    }
+    scu_array_sort(records, count, recordSize, cmpFunc);
+    isize uniqueCount = SCU_MIN(count, 1);
+    for (isize i = 1; i < count; i++) {
+        byte* record = &records[i * recordSize];
+        byte* last = &records[(uniqueCount - 1) * recordSize];
+        if (cmpFunc(last, record) != 0) {
+            if (uniqueCount != i) {
+                scu_memcpy(
+                    &records[uniqueCount * recordSize],
+                    record,
+                    recordSize
+                );
+            }
+            uniqueCount++;
+        }
+    }
+    flatMap->keys = scu_malloc(SCU_MAX(uniqueCount * keySize, 1));
+    flatMap->values = scu_malloc(SCU_MAX(uniqueCount * valueSize, 1));
+    if ((flatMap->keys == nullptr) || (flatMap->values == nullptr)) {
+        scu_free(flatMap->keys);
+        scu_free(flatMap->values);
+        scu_free(records);
+        scu_free(flatMap);
+        return nullptr;
+    }
+    flatMap->keySize = keySize;
+    flatMap->valueSize = valueSize;
+    flatMap->count = uniqueCount;
+    flatMap->layout = layout;
+    flatMap->cmpFunc = cmpFunc;
+    // Visiting the nodes in ascending order yields the position of each pair
+    // in the Eytzinger layout.
+    isize k = scu_eytzinger_first(uniqueCount);
+    for (isize i = 0; i < uniqueCount; i++) {
+        isize position = (layout == SCU_FLAT_LAYOUT_SORTED) ? i : (k - 1);
+        byte* record = &records[i * recordSize];
+        scu_memcpy(&flatMap->keys[position * keySize], record, keySize);
+        scu_memcpy(
+            &flatMap->values[position * valueSize],
+            &record[valueOffset],
+            valueSize
+        );
+        if (layout == SCU_FLAT_LAYOUT_EYTZINGER) {
+            k = scu_eytzinger_next(uniqueCount, k);
+        }
+    }
+    scu_free(records);
+    return flatMap;
+}
+
+[[nodiscard]]
+ScuFlatMap* scu_flat_map_clone(const ScuFlatMap* flatMap) {
+    SCU_ASSERT(flatMap != nullptr);
+    ScuFlatMap* clone = scu_malloc(SCU_SIZEOF(ScuFlatMap));
+    if (clone == nullptr) {
+        return nullptr;
+    }
+    isize keysSize = flatMap->count * flatMap->keySize;
+    isize valuesSize = flatMap->count * flatMap->valueSize;
+    clone->keys = scu_malloc(SCU_MAX(keysSize, 1));
+    clone->values = scu_malloc(SCU_MAX(valuesSize, 1));
+    if ((clone->keys == nullptr) || (clone->values == nullptr)) {
+        scu_free(clone->keys);
+        scu_free(clone->values);
+        scu_free(clone);
+        return nullptr;
+    }
+    if (flatMap->count > 0) {
+        scu_memcpy(clone->keys, flatMap->keys, keysSize);
+        scu_memcpy(clone->values, flatMap->values, valuesSize);
+    }
+    clone->keySize = flatMap->keySize;
+    clone->valueSize = flatMap->valueSize;
+    clone->count = flatMap->count;
+    clone->layout = flatMap->layout;
+    clone->cmpFunc = flatMap->cmpFunc;
+    return clone;
+}
+
+isize scu_flat_map_count(const ScuFlatMap* flatMap) {
+    SCU_ASSERT(flatMap != nullptr);
+    return flatMap->count;
+}
+
+ScuFlatLayout scu_flat_map_layout(const ScuFlatMap* flatMap) {
+    SCU_ASSERT(flatMap != nullptr);
+    return flatMap->layout;
+}
+
+const void* scu_flat_map_key_at(const ScuFlatMap* flatMap, isize position) {
+    SCU_ASSERT(flatMap != nullptr);
+    SCU_ASSERT((position >= 0) && (position < flatMap->count));
+    return &flatMap->keys[position * flatMap->keySize];
+}
+
+void* scu_flat_map_value_at(const ScuFlatMap* flatMap, isize position) {
+    SCU_ASSERT(flatMap != nullptr);
+    SCU_ASSERT((position >= 0) && (position < flatMap->count));
+    return &flatMap->values[position * flatMap->valueSize];
+}
+
+/**
+ * @brief Returns the position of the smallest key of a specified flat map that
+ * is not less than (or greater than) a specified key.
+ *
+ * @param[in] flatMap The flat map to search.
+ * @param[in] key     The key to search for.
+ * @param[in] isUpper `true` to search for the smallest key greater than the
+ *                    key, or `false` to search for the smallest key not less
+ *                    than the key.
+ * @return The position of the key, or `-1` if there is no such key.
+ */
+static inline isize scu_flat_map_bound(
+    const ScuFlatMap* restrict flatMap,
+    const void* restrict key,
+    bool isUpper
+) {
+    SCU_ASSERT(flatMap != nullptr);
+    return scu_flat_layout_bound(
+        flatMap->keys,
+        flatMap->count,
+        flatMap->keySize,
+        flatMap->layout,
+        flatMap->cmpFunc,
+        key,
+        isUpper
+    );
+}
+
+bool scu_flat_map_contains(
+    const ScuFlatMap* restrict flatMap,
+    const void* restrict key
+) {
+    return scu_flat_map_find(flatMap, key) >= 0;
+}
+
+isize scu_flat_map_find(
+    const ScuFlatMap* restrict flatMap,
+    const void* restrict key
+) {
+    isize position = scu_flat_map_bound(flatMap, key, false);
+    if (
+        (position >= 0)
+            && (
+                flatMap->cmpFunc(
+                    scu_flat_map_key_at(flatMap, position),
+                    key
+                ) == 0
+            )
+    ) {
+        return position;
+    }
+    return -1;
+}
+
+bool scu_flat_map_try_get_impl(
+    const ScuFlatMap* restrict flatMap,
+    const void* restrict key,
+    void* restrict* restrict value
+) {
+    SCU_ASSERT(value != nullptr);
+    isize position = scu_flat_map_find(flatMap, key);
+    if (position < 0) {
+        *value = nullptr;
+        return false;
+    }
+    *value = scu_flat_map_value_at(flatMap, position);
+    return true;
+}
+
+isize scu_flat_map_lower_bound(
+    const ScuFlatMap* restrict flatMap,
+    const void* restrict key
+) {
+    return scu_flat_map_bound(flatMap, key, false);
+}
+
+isize scu_flat_map_upper_bound(
+    const ScuFlatMap* restrict flatMap,
+    const void* restrict key
+) {
+    return scu_flat_map_bound(flatMap, key, true);
+}
+
+isize scu_flat_map_first(const ScuFlatMap* flatMap) {
+    SCU_ASSERT(flatMap != nullptr);
+    return scu_flat_layout_first(flatMap->count, flatMap->layout);
+}
+
+isize scu_flat_map_next(const ScuFlatMap* flatMap, isize position) {
+    SCU_ASSERT(flatMap != nullptr);
+    return scu_flat_layout_next(flatMap->count, flatMap->layout, position);
+}
+
+void scu_flat_map_free(ScuFlatMap* flatMap) {
+    if (flatMap != nullptr) {
+        scu_free(flatMap->keys);
+        scu_free(flatMap->values);
+        flatMap->keys = nullptr;
+        flatMap->values = nullptr;
+        flatMap->count = 0;
+        scu_free(flatMap);
+    }
+}
\ No newline at end of file
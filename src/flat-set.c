@@ -0,0 +1,247 @@
+#define SCU_SHORT_ALIASES
+
+#include "scu/alloc.h"
+#include "scu/array.h"
+#include "scu/assert.h"
+#include "scu/flat-set.h"
+#include "scu/math.h"
+#include "scu/memory.h"
+#include "flat-layout.h"
+
+struct ScuFlatSet {
+
+    /** @brief The size of each element (in bytes). */
+    isize elemSize;
+
+    /** @brief The number of elements. */
+    isize count;
+
+    /** @brief The memory layout of the elements. */
+    ScuFlatLayout layout;
+
+    /** @brief A comparison function used to determine the order of elements. */
+    ScuCompareFunc* cmpFunc;
+
+    /**
+     * @brief The elements of the flat set.
+     *
+     * @note This is a dynamically allocated array of `count` elements. For the
+     * Eytzinger layout, the node `k` (one-based) of the implicit tree is stored
+     * at position `k - 1`, and its children are the nodes `2 * k` and
+     * `2 * k + 1`.
+     */
+    byte* elems;
+
+};
+
+/**
+ * @brief Returns a pointer to the element at a specified position.
+ *
+ * @param[in] flatSet  The flat set to examine.
+ * @param[in] position The position of the element.
+ * @return A pointer to the element at the specified position.
+ */
+static inline const byte* scu_flat_set_elem_at(
+    const ScuFlatSet* flatSet,
+    isize position
+) {
+    SCU_ASSERT(flatSet != nullptr);
+    SCU_ASSERT((position >= 0) && (position < flatSet->count));
+    return &flatSet->elems[position * flatSet->elemSize];
+}
+
+[[nodiscard]]
+ScuFlatSet* scu_flat_set_new(
+    const void* elems,
+    isize count,
+    isize elemSize,
+    ScuCompareFunc* cmpFunc,
+    ScuFlatLayout layout
+) {
+    SCU_ASSERT((elems != nullptr) || (count == 0));
+    SCU_ASSERT(count >= 0);
+    SCU_ASSERT(elemSize > 0);
+    SCU_ASSERT(cmpFunc != nullptr);
+    SCU_ASSERT(
+        (layout == SCU_FLAT_LAYOUT_SORTED)
+            || (layout == SCU_FLAT_LAYOUT_EYTZINGER)
+    );
+    if (count > (ISIZE_MAX / elemSize)) {
+        return nullptr;
+    }
+    ScuFlatSet* flatSet = scu_malloc(SCU_SIZEOF(ScuFlatSet));
+    if (flatSet == nullptr) {
+        return nullptr;
+    }
+    byte* sorted = scu_malloc(SCU_MAX(count * elemSize, 1));
+    if (sorted == nullptr) {
+        scu_free(flatSet);
+        return nullptr;
+    }
+    if (count > 0) {
+        scu_memcpy(sorted, elems, count * elemSize);
+    }
+    scu_array_sort(sorted, count, elemSize, cmpFunc);
+    isize uniqueCount = SCU_MIN(count, 1);
+    for (isize i = 1; i < count; i++) {
+        byte* elem = &sorted[i * elemSize];
+        byte* last = &sorted[(uniqueCount - 1) * elemSize];
+        if (cmpFunc(last, elem) != 0) {
+            if (uniqueCount != i) {
+                scu_memcpy(&sorted[uniqueCount * elemSize], elem, elemSize);
+            }
+            uniqueCount++;
+        }
+    }
+    flatSet->elemSize = elemSize;
+    flatSet->count = uniqueCount;
+    flatSet->layout = layout;
+    flatSet->cmpFunc = cmpFunc;
+    if (layout == SCU_FLAT_LAYOUT_SORTED) {
+        flatSet->elems = sorted;
+        return flatSet;
+    }
+    flatSet->elems = scu_malloc(SCU_MAX(uniqueCount * elemSize, 1));
+    if (flatSet->elems == nullptr) {
+        scu_free(sorted);
+        scu_free(flatSet);
+        return nullptr;
+    }
+    // Visiting the nodes in ascending order yields the position of each
+    // element of the sorted array in the Eytzinger layout.
+    isize k = scu_eytzinger_first(uniqueCount);
+    for (isize i = 0; i < uniqueCount; i++) {
+        scu_memcpy(
+            &flatSet->elems[(k - 1) * elemSize],
+            &sorted[i * elemSize],
+            elemSize
+        );
+        k = scu_eytzinger_next(uniqueCount, k);
+    }
+    scu_free(sorted);
+    return flatSet;
+}
+
+[[nodiscard]]
+ScuFlatSet* scu_flat_set_clone(const ScuFlatSet* flatSet) {
+    SCU_ASSERT(flatSet != nullptr);
+    ScuFlatSet* clone = scu_malloc(SCU_SIZEOF(ScuFlatSet));
+    if (clone == nullptr) {
+        return nullptr;
+    }
+    isize size = flatSet->count * flatSet->elemSize;
+    clone->elems = scu_malloc(SCU_MAX(size, 1));
+    if (clone->elems == nullptr) {
+        scu_free(clone);
+        return nullptr;
+    }
+    if (size > 0) {
+        scu_memcpy(clone->elems, flatSet->elems, size);
+    }
+    clone->elemSize = flatSet->elemSize;
+    clone->count = flatSet->count;
+    clone->layout = flatSet->layout;
+    clone->cmpFunc = flatSet->cmpFunc;
+    return clone;
+}
+
+isize scu_flat_set_count(const ScuFlatSet* flatSet) {
+    SCU_ASSERT(flatSet != nullptr);
+    return flatSet->count;
+}
+
+ScuFlatLayout scu_flat_set_layout(const ScuFlatSet* flatSet) {
+    SCU_ASSERT(flatSet != nullptr);
+    return flatSet->layout;
+}
+
+const void* scu_flat_set_at(const ScuFlatSet* flatSet, isize position) {
+    return scu_flat_set_elem_at(flatSet, position);
+}
+
+/**
+ * @brief Returns the position of the smallest element of a specified flat set
+ * that is not less than (or greater than) a specified key.
+ *
+ * @param[in] flatSet The flat set to search.
+ * @param[in] key     The key to search for.
+ * @param[in] isUpper `true` to search for the smallest element greater than the
+ *                    key, or `false` to search for the smallest element not
+ *                    less than the key.
+ * @return The position of the element, or `-1` if there is no such element.
+ */
+static inline isize scu_flat_set_bound(
+    const ScuFlatSet* restrict flatSet,
+    const void* restrict key,
+    bool isUpper
+) {
+    SCU_ASSERT(flatSet != nullptr);
+    return scu_flat_layout_bound(
+        flatSet->elems,
+        flatSet->count,
+        flatSet->elemSize,
+        flatSet->layout,
+        flatSet->cmpFunc,
+        key,
+        isUpper
+    );
+}
+
+bool scu_flat_set_contains(
+    const ScuFlatSet* restrict flatSet,
+    const void* restrict elem
+) {
+    return scu_flat_set_find(flatSet, elem) >= 0;
+}
+
+isize scu_flat_set_find(
+    const ScuFlatSet* restrict flatSet,
+    const void* restrict elem
+) {
+    isize position = scu_flat_set_bound(flatSet, elem, false);
+    if (
+        (position >= 0)
+            && (
+                flatSet->cmpFunc(
+                    scu_flat_set_elem_at(flatSet, position),
+                    elem
+                ) == 0
+            )
+    ) {
+        return position;
+    }
+    return -1;
+}
+
+isize scu_flat_set_lower_bound(
+    const ScuFlatSet* restrict flatSet,
+    const void* restrict key
+) {
+    return scu_flat_set_bound(flatSet, key, false);
+}
+
+isize scu_flat_set_upper_bound(
+    const ScuFlatSet* restrict flatSet,
+    const void* restrict key
+) {
+    return scu_flat_set_bound(flatSet, key, true);
+}
+
+isize scu_flat_set_first(const ScuFlatSet* flatSet) {
+    SCU_ASSERT(flatSet != nullptr);
+    return scu_flat_layout_first(flatSet->count, flatSet->layout);
+}
+
+isize scu_flat_set_next(const ScuFlatSet* flatSet, isize position) {
+    SCU_ASSERT(flatSet != nullptr);
+    return scu_flat_layout_next(flatSet->count, flatSet->layout, position);
+}
+
+void scu_flat_set_free(ScuFlatSet* flatSet) {
+    if (flatSet != nullptr) {
+        scu_free(flatSet->elems);
+        flatSet->elems = nullptr;
+        flatSet->count = 0;
+        scu_free(flatSet);
+    }
+}
\ No newline at end of file
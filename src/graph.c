@@ -0,0 +1,697 @@
+#define SCU_SHORT_ALIASES
+
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "scu/alloc.h"
+#include "scu/assert.h"
+#include "scu/compare.h"
+#include "scu/graph.h"
+#include "scu/math.h"
+#include "scu/memory.h"
+#include "scu/prio-queue.h"
+#include "bits.h"
+
+/**
+ * @brief The factor by which the number of edges to check from the frontier
+ * must be exceeded by the number of edges of unvisited vertices to keep
+ * expanding levels top-down.
+ */
+static constexpr isize SCU_BFS_ALPHA = 14;
+
+/**
+ * @brief The factor by which the number of vertices must exceed the size of the
+ * frontier to switch back from expanding levels bottom-up to top-down.
+ */
+static constexpr isize SCU_BFS_BETA = 24;
+
+/**
+ * @brief The number of frontier vertices a thread claims at once when expanding
+ * a level top-down.
+ */
+static constexpr isize SCU_BFS_TOP_DOWN_BLOCK = 64;
+
+/**
+ * @brief The number of vertices a thread claims at once when expanding a level
+ * bottom-up.
+ *
+ * @note This must be a multiple of 64, so that each word of the bitmap of the
+ * next frontier is only written by a single thread.
+ */
+static constexpr isize SCU_BFS_BOTTOM_UP_BLOCK = 4096;
+
+/**
+ * @brief The number of vertices a thread buffers locally before appending them
+ * to the next frontier when expanding a level top-down.
+ */
+static constexpr isize SCU_BFS_BUFFER_SIZE = 256;
+
+/**
+ * @brief The minimum amount of work (in number of vertices to process) per
+ * additional thread when expanding a level.
+ */
+static constexpr isize SCU_BFS_WORK_PER_THREAD = 4096;
+
+struct ScuGraph {
+
+    /** @brief The number of vertices. */
+    isize vertexCount;
+
+    /** @brief The number of edges. */
+    isize edgeCount;
+
+    /**
+     * @brief The offsets of the outgoing edges of each vertex.
+     *
+     * @note This array contains `vertexCount + 1` elements. The outgoing edges
+     * of vertex `v` occupy the range `[offsets[v], offsets[v + 1])` of the
+     * `targets` and `weights` arrays.
+     */
+    isize* offsets;
+
+    /** @brief The target vertex of each edge. */
+    isize* targets;
+
+    /** @brief The weight of each edge, or `nullptr` if unweighted. */
+    f64* weights;
+
+};
+
+/**
+ * @brief Represents the state shared by all threads expanding a level of a
+ * breadth-first search.
+ */
+typedef struct ScuBfsState {
+
+    /** @brief The graph being searched. */
+    const ScuGraph* graph;
+
+    /** @brief The transpose of the graph, or `nullptr` if not available. */
+    const ScuGraph* reverse;
+
+    /** @brief The distance of each vertex, or `-1` if not yet visited. */
+    _Atomic(isize)* distances;
+
+    /** @brief The distance assigned to vertices discovered on this level. */
+    isize level;
+
+    /** @brief The next unclaimed index of the work of this level. */
+    _Atomic(isize) cursor;
+
+    /** @brief The vertices of the frontier when expanding top-down. */
+    const isize* frontier;
+
+    /** @brief The number of vertices of the frontier. */
+    isize frontierCount;
+
+    /** @brief The vertices of the next frontier when expanding top-down. */
+    isize* next;
+
+    /** @brief The number of vertices of the next frontier. */
+    _Atomic(isize) nextCount;
+
+    /** @brief The bitmap of the frontier when expanding bottom-up. */
+    const u64* frontierBits;
+
+    /** @brief The bitmap of the next frontier when expanding bottom-up. */
+    u64* nextBits;
+
+} ScuBfsState;
+
+/** @brief Represents a thread expanding a level of a breadth-first search. */
+typedef struct ScuBfsWorker {
+
+    /** @brief The state shared by all threads. */
+    ScuBfsState* state;
+
+    /** @brief The handle of the thread. */
+    pthread_t thread;
+
+    /** @brief Whether the thread was successfully started. */
+    bool isRunning;
+
+    /** @brief The number of vertices discovered by the thread. */
+    isize discovered;
+
+    /** @brief The sum of the degrees of the vertices discovered. */
+    isize discoveredEdges;
+
+} ScuBfsWorker;
+
+/**
+ * @brief Allocates a new graph with uninitialized offsets, targets and weights.
+ *
+ * @param[in] vertexCount The number of vertices.
+ * @param[in] edgeCount   The number of edges.
+ * @param[in] isWeighted  Whether the graph has edge weights.
+ * @return A pointer to the new graph, or `nullptr` on failure.
+ */
+static ScuGraph* scu_graph_alloc(
+    isize vertexCount,
+    isize edgeCount,
+    bool isWeighted
+) {
+    ScuGraph* graph = scu_malloc(SCU_SIZEOF(ScuGraph));
+    if (graph == nullptr) {
+        return nullptr;
+    }
+    graph->vertexCount = vertexCount;
+    graph->edgeCount = edgeCount;
+    graph->offsets = scu_calloc(vertexCount + 1, SCU_SIZEOF(isize));
+    graph->targets = scu_malloc(SCU_MAX(edgeCount, 1) * SCU_SIZEOF(isize));
+    graph->weights = isWeighted
+        ? scu_malloc(SCU_MAX(edgeCount, 1) * SCU_SIZEOF(f64))
+        : nullptr;
+    if (
+        (graph->offsets == nullptr)
+            || (graph->targets == nullptr)
+            || (isWeighted && (graph->weights == nullptr))
+    ) {
+        scu_graph_free(graph);
+        return nullptr;
+    }
+    return graph;
+}
+
+/**
+ * @brief Turns the degree of each vertex into the offset of its first edge.
+ *
+ * @note On entry, `offsets[v]` contains the degree of vertex `v`. On exit, it
+ * contains the sum of the degrees of all preceding vertices.
+ *
+ * @param[in, out] offsets     The offsets to compute.
+ * @param[in]      vertexCount The number of vertices.
+ */
+static void scu_offsets_from_degrees(isize* offsets, isize vertexCount) {
+    isize sum = 0;
+    for (isize v = 0; v < vertexCount; v++) {
+        isize degree = offsets[v];
+        offsets[v] = sum;
+        sum += degree;
+    }
+    offsets[vertexCount] = sum;
+}
+
+/**
+ * @brief Restores the offsets after the edges have been placed.
+ *
+ * @note Placing an edge of vertex `v` increments `offsets[v]`, so once all
+ * edges have been placed, `offsets[v]` contains the original value of
+ * `offsets[v + 1]`. This function shifts the offsets back into place.
+ *
+ * @param[in, out] offsets     The offsets to restore.
+ * @param[in]      vertexCount The number of vertices.
+ */
+static void scu_offsets_restore(isize* offsets, isize vertexCount) {
+    for (isize v = vertexCount; v > 0; v--) {
+        offsets[v] = offsets[v - 1];
+    }
+    offsets[0] = 0;
+}
+
+[[nodiscard]]
+ScuGraph* scu_graph_new(
+    isize vertexCount,
+    isize edgeCount,
+    const isize* sources,
+    const isize* targets,
+    const f64* weights
+) {
+    SCU_ASSERT(vertexCount >= 0);
+    SCU_ASSERT(edgeCount >= 0);
+    SCU_ASSERT(
+        (edgeCount == 0) || ((sources != nullptr) && (targets != nullptr))
+    );
+    ScuGraph* graph = scu_graph_alloc(
+        vertexCount,
+        edgeCount,
+        weights != nullptr
+    );
+    if (graph == nullptr) {
+        return nullptr;
+    }
+    for (isize i = 0; i < edgeCount; i++) {
+        SCU_ASSERT((sources[i] >= 0) && (sources[i] < vertexCount));
+        SCU_ASSERT((targets[i] >= 0) && (targets[i] < vertexCount));
+        graph->offsets[sources[i]]++;
+    }
+    scu_offsets_from_degrees(graph->offsets, vertexCount);
+    for (isize i = 0; i < edgeCount; i++) {
+        isize position = graph->offsets[sources[i]]++;
+        graph->targets[position] = targets[i];
+        if (weights != nullptr) {
+            graph->weights[position] = weights[i];
+        }
+    }
+    scu_offsets_restore(graph->offsets, vertexCount);
+    return graph;
+}
+
+[[nodiscard]]
+ScuGraph* scu_graph_transpose(const ScuGraph* graph) {
+    SCU_ASSERT(graph != nullptr);
+    ScuGraph* reverse = scu_graph_alloc(
+        graph->vertexCount,
+        graph->edgeCount,
+        graph->weights != nullptr
+    );
+    if (reverse == nullptr) {
+        return nullptr;
+    }
+    for (isize i = 0; i < graph->edgeCount; i++) {
+        reverse->offsets[graph->targets[i]]++;
+    }
+    scu_offsets_from_degrees(reverse->offsets, reverse->vertexCount);
+    for (isize u = 0; u < graph->vertexCount; u++) {
+        for (isize i = graph->offsets[u]; i < graph->offsets[u + 1]; i++) {
+            isize position = reverse->offsets[graph->targets[i]]++;
+            reverse->targets[position] = u;
+            if (graph->weights != nullptr) {
+                reverse->weights[position] = graph->weights[i];
+            }
+        }
+    }
+    scu_offsets_restore(reverse->offsets, reverse->vertexCount);
+    return reverse;
+}
+
+isize scu_graph_vertex_count(const ScuGraph* graph) {
+    SCU_ASSERT(graph != nullptr);
+    return graph->vertexCount;
+}
+
+isize scu_graph_edge_count(const ScuGraph* graph) {
+    SCU_ASSERT(graph != nullptr);
+    return graph->edgeCount;
+}
+
+bool scu_graph_is_weighted(const ScuGraph* graph) {
+    SCU_ASSERT(graph != nullptr);
+    return graph->weights != nullptr;
+}
+
+isize scu_graph_degree(const ScuGraph* graph, isize vertex) {
+    SCU_ASSERT(graph != nullptr);
+    SCU_ASSERT((vertex >= 0) && (vertex < graph->vertexCount));
+    return graph->offsets[vertex + 1] - graph->offsets[vertex];
+}
+
+const isize* scu_graph_neighbors(const ScuGraph* graph, isize vertex) {
+    SCU_ASSERT(graph != nullptr);
+    SCU_ASSERT((vertex >= 0) && (vertex < graph->vertexCount));
+    return &graph->targets[graph->offsets[vertex]];
+}
+
+const f64* scu_graph_weights(const ScuGraph* graph, isize vertex) {
+    SCU_ASSERT(graph != nullptr);
+    SCU_ASSERT((vertex >= 0) && (vertex < graph->vertexCount));
+    return (graph->weights != nullptr)
+        ? &graph->weights[graph->offsets[vertex]]
+        : nullptr;
+}
+
+/**
+ * @brief Appends a buffer of discovered vertices to the next frontier.
+ *
+ * @param[in, out] state  The state of the breadth-first search.
+ * @param[in]      buffer The vertices to append.
+ * @param[in]      count  The number of vertices to append.
+ */
+static void scu_bfs_flush(
+    ScuBfsState* restrict state,
+    const isize* restrict buffer,
+    isize count
+) {
+    if (count > 0) {
+        isize position = atomic_fetch_add_explicit(
+            &state->nextCount,
+            count,
+            memory_order_relaxed
+        );
+        scu_memcpy(
+            &state->next[position],
+            buffer,
+            count * SCU_SIZEOF(isize)
+        );
+    }
+}
+
+/**
+ * @brief Expands a level of a breadth-first search top-down, i.e., by visiting
+ * the outgoing edges of the vertices of the frontier.
+ *
+ * @note Vertices are claimed with a compare-and-swap on their distance, so each
+ * vertex is added to the next frontier exactly once, even if it is reached by
+ * multiple threads at the same time.
+ *
+ * @param[in, out] arg The worker expanding the level.
+ * @return Always `nullptr`.
+ */
+static void* scu_bfs_top_down(void* arg) {
+    ScuBfsWorker* worker = arg;
+    ScuBfsState* state = worker->state;
+    const ScuGraph* graph = state->graph;
+    isize buffer[SCU_BFS_BUFFER_SIZE];
+    isize buffered = 0;
+    isize discovered = 0;
+    isize discoveredEdges = 0;
+    while (true) {
+        isize start = atomic_fetch_add_explicit(
+            &state->cursor,
+            SCU_BFS_TOP_DOWN_BLOCK,
+            memory_order_relaxed
+        );
+        if (start >= state->frontierCount) {
+            break;
+        }
+        isize end = SCU_MIN(
+            start + SCU_BFS_TOP_DOWN_BLOCK,
+            state->frontierCount
+        );
+        for (isize i = start; i < end; i++) {
+            isize u = state->frontier[i];
+            for (isize j = graph->offsets[u]; j < graph->offsets[u + 1]; j++) {
+                isize v = graph->targets[j];
+                if (
+                    atomic_load_explicit(
+                        &state->distances[v],
+                        memory_order_relaxed
+                    ) != -1
+                ) {
+                    continue;
+                }
+                isize expected = -1;
+                if (
+                    !atomic_compare_exchange_strong_explicit(
+                        &state->distances[v],
+                        &expected,
+                        state->level,
+                        memory_order_relaxed,
+                        memory_order_relaxed
+                    )
+                ) {
+                    continue;
+                }
+                if (buffered == SCU_BFS_BUFFER_SIZE) {
+                    scu_bfs_flush(state, buffer, buffered);
+                    buffered = 0;
+                }
+                buffer[buffered++] = v;
+                discovered++;
+                discoveredEdges += graph->offsets[v + 1] - graph->offsets[v];
+            }
+        }
+    }
+    scu_bfs_flush(state, buffer, buffered);
+    worker->discovered = discovered;
+    worker->discoveredEdges = discoveredEdges;
+    return nullptr;
+}
+
+/**
+ * @brief Expands a level of a breadth-first search bottom-up, i.e., by letting
+ * each unvisited vertex search its incoming edges for a vertex of the frontier.
+ *
+ * @note Each thread claims a block of vertices at a time and only writes the
+ * distances and bitmap words of its own block, so no synchronization is
+ * required apart from claiming blocks.
+ *
+ * @param[in, out] arg The worker expanding the level.
+ * @return Always `nullptr`.
+ */
+static void* scu_bfs_bottom_up(void* arg) {
+    ScuBfsWorker* worker = arg;
+    ScuBfsState* state = worker->state;
+    const ScuGraph* graph = state->graph;
+    const ScuGraph* reverse = state->reverse;
+    isize discovered = 0;
+    isize discoveredEdges = 0;
+    while (true) {
+        isize start = atomic_fetch_add_explicit(
+            &state->cursor,
+            SCU_BFS_BOTTOM_UP_BLOCK,
+            memory_order_relaxed
+        );
+        if (start >= graph->vertexCount) {
+            break;
+        }
+        isize end = SCU_MIN(
+            start + SCU_BFS_BOTTOM_UP_BLOCK,
+            graph->vertexCount
+        );
+        for (isize v = start; v < end; v++) {
+            if (
+                atomic_load_explicit(
+                    &state->distances[v],
+                    memory_order_relaxed
+                ) != -1
+            ) {
+                continue;
+            }
+            for (
+                isize j = reverse->offsets[v];
+                j < reverse->offsets[v + 1];
+                j++
+            ) {
+                isize u = reverse->targets[j];
+                if (((state->frontierBits[u / 64] >> (u % 64)) & 1) != 0) {
+                    atomic_store_explicit(
+                        &state->distances[v],
+                        state->level,
+                        memory_order_relaxed
+                    );
+                    state->nextBits[v / 64] |= (u64) 1 << (v % 64);
+                    discovered++;
+                    discoveredEdges += graph->offsets[v + 1]
+                        - graph->offsets[v];
+                    break;
+                }
+            }
+        }
+    }
+    worker->discovered = discovered;
+    worker->discoveredEdges = discoveredEdges;
+    return nullptr;
+}
+
+/**
+ * @brief Expands a level of a breadth-first search using a specified number of
+ * threads, including the calling thread.
+ *
+ * @note If a thread can not be started, its share of the work is taken over by
+ * the remaining threads, as work is claimed dynamically.
+ *
+ * @param[in, out] workers     The workers expanding the level.
+ * @param[in]      threadCount The number of threads to use.
+ * @param[in]      expand      The function expanding the level.
+ */
+static void scu_bfs_expand(
+    ScuBfsWorker* workers,
+    isize threadCount,
+    void* (*expand)(void*)
+) {
+    for (isize i = 1; i < threadCount; i++) {
+        workers[i].isRunning = pthread_create(
+            &workers[i].thread,
+            nullptr,
+            expand,
+            &workers[i]
+        ) == 0;
+    }
+    expand(&workers[0]);
+    for (isize i = 1; i < threadCount; i++) {
+        if (workers[i].isRunning) {
+            pthread_join(workers[i].thread, nullptr);
+        }
+        else {
+            expand(&workers[i]);
+        }
+    }
+}
+
+ScuError scu_graph_bfs(
+    const ScuGraph* graph,
+    const ScuGraph* reverse,
+    isize source,
+    isize threadCount,
+    isize* distances
+) {
+    SCU_ASSERT(graph != nullptr);
+    SCU_ASSERT(
+        (reverse == nullptr) || (reverse->vertexCount == graph->vertexCount)
+    );
+    SCU_ASSERT((source >= 0) && (source < graph->vertexCount));
+    SCU_ASSERT(threadCount >= 1);
+    SCU_ASSERT(distances != nullptr);
+    isize vertexCount = graph->vertexCount;
+    isize wordCount = (vertexCount + 63) / 64;
+    // All buffers share a single allocation. The workers are placed first, as
+    // their alignment is at least as strict as that of the remaining arrays.
+    ScuBfsWorker* workers = scu_malloc(
+        (threadCount * SCU_SIZEOF(ScuBfsWorker))
+            + (2 * vertexCount * SCU_SIZEOF(isize))
+            + (2 * wordCount * SCU_SIZEOF(u64))
+            + (vertexCount * SCU_SIZEOF(_Atomic(isize)))
+    );
+    if (workers == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    isize* frontier = (isize*) &workers[threadCount];
+    isize* next = &frontier[vertexCount];
+    u64* frontierBits = (u64*) &next[vertexCount];
+    u64* nextBits = &frontierBits[wordCount];
+    _Atomic(isize)* levels = (_Atomic(isize)*) &nextBits[wordCount];
+    for (isize v = 0; v < vertexCount; v++) {
+        atomic_init(&levels[v], (v == source) ? 0 : -1);
+    }
+    ScuBfsState state = {
+        .graph = graph,
+        .reverse = reverse,
+        .distances = levels
+    };
+    for (isize i = 0; i < threadCount; i++) {
+        workers[i].state = &state;
+    }
+    frontier[0] = source;
+    isize frontierCount = 1;
+    isize frontierEdges = scu_graph_degree(graph, source);
+    isize unexploredEdges = graph->edgeCount - frontierEdges;
+    bool isBottomUp = false;
+    for (isize level = 1; frontierCount > 0; level++) {
+        if (
+            !isBottomUp
+                && (reverse != nullptr)
+                && (frontierEdges > unexploredEdges / SCU_BFS_ALPHA)
+        ) {
+            scu_memset(frontierBits, 0, wordCount * SCU_SIZEOF(u64));
+            for (isize i = 0; i < frontierCount; i++) {
+                frontierBits[frontier[i] / 64] |= (u64) 1 << (frontier[i] % 64);
+            }
+            isBottomUp = true;
+        }
+        else if (isBottomUp && (frontierCount < vertexCount / SCU_BFS_BETA)) {
+            frontierCount = 0;
+            for (isize i = 0; i < wordCount; i++) {
+                for (u64 word = frontierBits[i]; word != 0; word &= word - 1) {
+                    frontier[frontierCount++] = (i * 64)
+                        + scu_trailing_zeros_u64(word);
+                }
+            }
+            isBottomUp = false;
+        }
+        state.level = level;
+        atomic_init(&state.cursor, 0);
+        isize work = isBottomUp ? vertexCount : frontierCount;
+        isize stepThreadCount = SCU_MIN(
+            threadCount,
+            1 + (work / SCU_BFS_WORK_PER_THREAD)
+        );
+        if (isBottomUp) {
+            state.frontierBits = frontierBits;
+            state.nextBits = nextBits;
+            scu_memset(nextBits, 0, wordCount * SCU_SIZEOF(u64));
+            scu_bfs_expand(workers, stepThreadCount, scu_bfs_bottom_up);
+            u64* bits = frontierBits;
+            frontierBits = nextBits;
+            nextBits = bits;
+        }
+        else {
+            state.frontier = frontier;
+            state.frontierCount = frontierCount;
+            state.next = next;
+            atomic_init(&state.nextCount, 0);
+            scu_bfs_expand(workers, stepThreadCount, scu_bfs_top_down);
+            isize* vertices = frontier;
+            frontier = next;
+            next = vertices;
+        }
+        frontierCount = 0;
+        frontierEdges = 0;
+        for (isize i = 0; i < stepThreadCount; i++) {
+            frontierCount += workers[i].discovered;
+            frontierEdges += workers[i].discoveredEdges;
+        }
+        unexploredEdges -= frontierEdges;
+    }
+    for (isize v = 0; v < vertexCount; v++) {
+        distances[v] = atomic_load_explicit(&levels[v], memory_order_relaxed);
+    }
+    scu_free(workers);
+    return SCU_ERROR_NONE;
+}
+
+ScuError scu_graph_shortest_paths(
+    const ScuGraph* restrict graph,
+    isize source,
+    f64* restrict distances,
+    isize* restrict predecessors
+) {
+    SCU_ASSERT(graph != nullptr);
+    SCU_ASSERT((source >= 0) && (source < graph->vertexCount));
+    SCU_ASSERT(distances != nullptr);
+    ScuPrioQueue* queue = scu_prio_queue_new(
+        SCU_SIZEOF(isize),
+        SCU_SIZEOF(f64),
+        scu_compare_f64
+    );
+    if (queue == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    for (isize v = 0; v < graph->vertexCount; v++) {
+        distances[v] = INFINITY;
+        if (predecessors != nullptr) {
+            predecessors[v] = -1;
+        }
+    }
+    distances[source] = 0.0;
+    if (
+        scu_prio_queue_enqueue(queue, &source, &distances[source])
+            != SCU_ERROR_NONE
+    ) {
+        scu_prio_queue_free(queue);
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    isize u;
+    f64 distance;
+    // Instead of decreasing the priority of a vertex already in the queue, the
+    // vertex is enqueued again. Outdated entries are skipped when dequeued.
+    while (scu_prio_queue_try_dequeue(queue, &u, &distance)) {
+        if (distance > distances[u]) {
+            continue;
+        }
+        for (isize i = graph->offsets[u]; i < graph->offsets[u + 1]; i++) {
+            isize v = graph->targets[i];
+            f64 weight = (graph->weights != nullptr) ? graph->weights[i] : 1.0;
+            SCU_ASSERT(weight >= 0.0);
+            f64 candidate = distance + weight;
+            if (candidate >= distances[v]) {
+                continue;
+            }
+            distances[v] = candidate;
+            if (predecessors != nullptr) {
+                predecessors[v] = u;
+            }
+            if (
+                scu_prio_queue_enqueue(queue, &v, &candidate)
+                    != SCU_ERROR_NONE
+            ) {
+                scu_prio_queue_free(queue);
+                return SCU_ERROR_OUT_OF_MEMORY;
+            }
+        }
+    }
+    scu_prio_queue_free(queue);
+    return SCU_ERROR_NONE;
+}
+
+void scu_graph_free(ScuGraph* graph) {
+    if (graph != nullptr) {
+        scu_free(graph->weights);
+        graph->weights = nullptr;
+        scu_free(graph->targets);
+        graph->targets = nullptr;
+        scu_free(graph->offsets);
+        graph->offsets = nullptr;
+        scu_free(graph);
+    }
+}
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "scu/assert.h"
 #include "scu/hash-map.h"
 #include "scu/memory.h"
+#include "bits.h"
 
 /** @brief Represents a bucket in a hash map. */
 typedef struct ScuBucket {
@@ -125,33 +126,6 @@ static inline isize scu_align_up(isize value, isize alignment) {
     return (value + alignment - 1) & ~(alignment - 1);
 }
 
-/**
- * @brief Returns the smallest power of two greater than or equal to a specified
- * value.
- *
- * @param[in] n The value to examine.
- * @return The smallest power of two greater than or equal to the specified
- * value.
- */
-static inline isize scu_next_power_of_two(isize n) {
-    SCU_ASSERT((n >= 0) && (n <= (ISIZE_MAX / 2)));
-    if (n <= 1) {
-        return 1;
-    }
-    usize v = (usize) n;
-    v--;
-    v |= v >> 1;
-    v |= v >> 2;
-    v |= v >> 4;
-    v |= v >> 8;
-    v |= v >> 16;
-#if SCU_ISIZE_WIDTH == 64
-    v |= v >> 32;
-#endif
-    v++;
-    return (isize) v;
-}
-
 [[nodiscard]]
 ScuHashMap* scu_hash_map_new_with_capacity(
     isize keySize,
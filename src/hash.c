@@ -4,6 +4,17 @@
 #include "scu/assert.h"
 #include "scu/hash.h"
 #include "scu/memory.h"
+#include "bits.h"
+
+#if (USIZE_WIDTH == 64) && defined(SCU_AVX2_DISPATCH)
+    /**
+     * @brief Indicates whether the batch functions have an AVX2 path, which is
+     * selected at runtime depending on the capabilities of the processor.
+     */
+    #define SCU_HASH_AVX2
+
+    #include <immintrin.h>
+#endif
 
 #if USIZE_WIDTH == 32
     /** @brief The FNV-1a offset basis for 32-bit hashes. */
@@ -61,12 +72,7 @@
      * @return The mixed value.
      */
     static inline usize scu_hash_mix_usize(usize v) {
-        v ^= v >> 30;
-        v *= 0xBF58476D1CE4E5B9;
-        v ^= v >> 27;
-        v *= 0x94D049BB133111EB;
-        v ^= v >> 31;
-        return v;
+        return scu_mix_u64(v);
     }
 
     /**
@@ -80,6 +86,96 @@
     }
 #endif
 
+#ifdef SCU_HASH_AVX2
+    /**
+     * @brief Multiplies four pairs of 64-bit lanes, keeping the lower 64 bits
+     * of each product.
+     *
+     * @note AVX2 lacks a 64-bit multiplication, so the product is assembled
+     * from three 32-bit multiplications (the upper halves multiplied with each
+     * other only affect bits that are discarded anyway).
+     *
+     * @param[in] a The first factors.
+     * @param[in] b The second factors.
+     * @return The lower 64 bits of the four products.
+     */
+    __attribute__((target("avx2")))
+    static inline __m256i scu_mul_u64x4(__m256i a, __m256i b) {
+        __m256i low = _mm256_mul_epu32(a, b);
+        __m256i cross = _mm256_add_epi64(
+            _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+            _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32))
+        );
+        return _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+    }
+
+    /**
+     * @brief Mixes the bits of four `u64` values at once.
+     *
+     * @note This is a vectorized version of `scu_hash_mix_usize()` and produces
+     * exactly the same results for each lane.
+     *
+     * @param[in] v The values to mix.
+     * @return The mixed values.
+     */
+    __attribute__((target("avx2")))
+    static inline __m256i scu_hash_mix_u64x4(__m256i v) {
+        v = _mm256_xor_si256(v, _mm256_srli_epi64(v, 30));
+        v = scu_mul_u64x4(v, _mm256_set1_epi64x((i64) 0xBF58476D1CE4E5B9));
+        v = _mm256_xor_si256(v, _mm256_srli_epi64(v, 27));
+        v = scu_mul_u64x4(v, _mm256_set1_epi64x((i64) 0x94D049BB133111EB));
+        v = _mm256_xor_si256(v, _mm256_srli_epi64(v, 31));
+        return v;
+    }
+
+    /**
+     * @brief Computes the hashes of an array of `u32` values four at a time.
+     *
+     * @param[in]  values The values to hash.
+     * @param[out] hashes The array to store the hashes in.
+     * @param[in]  count  The number of values.
+     * @return The number of values hashed, which is `count` rounded down to a
+     * multiple of four.
+     */
+    __attribute__((target("avx2")))
+    static isize scu_hash_u32_batch_avx2(
+        const u32* restrict values,
+        usize* restrict hashes,
+        isize count
+    ) {
+        isize i = 0;
+        for (; (i + 4) <= count; i += 4) {
+            __m128i v = _mm_loadu_si128((const __m128i*) &values[i]);
+            __m256i h = scu_hash_mix_u64x4(_mm256_cvtepu32_epi64(v));
+            _mm256_storeu_si256((__m256i*) &hashes[i], h);
+        }
+        return i;
+    }
+
+    /**
+     * @brief Computes the hashes of an array of `u64` values four at a time.
+     *
+     * @param[in]  values The values to hash.
+     * @param[out] hashes The array to store the hashes in.
+     * @param[in]  count  The number of values.
+     * @return The number of values hashed, which is `count` rounded down to a
+     * multiple of four.
+     */
+    __attribute__((target("avx2")))
+    static isize scu_hash_u64_batch_avx2(
+        const u64* restrict values,
+        usize* restrict hashes,
+        isize count
+    ) {
+        isize i = 0;
+        for (; (i + 4) <= count; i += 4) {
+            __m256i v = _mm256_loadu_si256((const __m256i*) &values[i]);
+            _mm256_storeu_si256((__m256i*) &hashes[i], scu_hash_mix_u64x4(v));
+        }
+        return i;
+    }
+#endif
+
 usize scu_hash_bool(const void* value) {
     SCU_ASSERT(value != nullptr);
     usize v = *(const bool*) value;
@@ -237,6 +333,54 @@ usize scu_hash_str(const void* value) {
     return v;
 }
 
+void scu_hash_u32_batch(
+    const u32* restrict values,
+    usize* restrict hashes,
+    isize count
+) {
+    SCU_ASSERT((values != nullptr) || (count == 0));
+    SCU_ASSERT((hashes != nullptr) || (count == 0));
+    SCU_ASSERT(count >= 0);
+    isize i = 0;
+#ifdef SCU_HASH_AVX2
+    if (scu_has_avx2()) {
+        i = scu_hash_u32_batch_avx2(values, hashes, count);
+    }
+#endif
+    for (; i < count; i++) {
+        hashes[i] = scu_hash_mix_usize(values[i]);
+    }
+}
+
+void scu_hash_u64_batch(
+    const u64* restrict values,
+    usize* restrict hashes,
+    isize count
+) {
+    SCU_ASSERT((values != nullptr) || (count == 0));
+    SCU_ASSERT((hashes != nullptr) || (count == 0));
+    SCU_ASSERT(count >= 0);
+    isize i = 0;
+#ifdef SCU_HASH_AVX2
+    if (scu_has_avx2()) {
+        i = scu_hash_u64_batch_avx2(values, hashes, count);
+    }
+#endif
+    for (; i < count; i++) {
+        hashes[i] = scu_hash_mix_u64(values[i]);
+    }
+}
+
+void scu_hash_i64_batch(
+    const i64* restrict values,
+    usize* restrict hashes,
+    isize count
+) {
+    // Signed and unsigned variants of the same integer type may alias each
+    // other, and scu_hash_i64() hashes the two's complement representation.
+    scu_hash_u64_batch((const u64*) values, hashes, count);
+}
+
 usize scu_hash_combine(usize seed, usize hash) {
     return seed ^ (hash + SCU_HASH_MULTIPLIER + (seed << 6) + (seed >> 2));
 }
\ No newline at end of file
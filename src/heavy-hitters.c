@@ -0,0 +1,447 @@
+#define SCU_SHORT_ALIASES
+
+#include <stddef.h>
+#include "scu/alloc.h"
+#include "scu/array.h"
+#include "scu/assert.h"
+#include "scu/heavy-hitters.h"
+#include "scu/memory.h"
+#include "open-index.h"
+
+struct ScuHeavyHitters {
+
+    /** @brief The size of each element (in bytes). */
+    isize elemSize;
+
+    /** @brief The maximum number of monitored elements. */
+    isize capacity;
+
+    /** @brief The current number of monitored elements. */
+    isize count;
+
+    /** @brief The sum of all counts added. */
+    u64 total;
+
+    /** @brief A function used for hashing elements. */
+    ScuHashFunc* hashFunc;
+
+    /**
+     * @brief The counts of the slots.
+     *
+     * @note This and all following arrays point into a single dynamically
+     * allocated block of memory. All arrays except for `index` and `elems` have
+     * `capacity` entries, one per slot.
+     */
+    u64* counts;
+
+    /** @brief The errors of the slots. */
+    u64* errors;
+
+    /** @brief The hashes of the elements of the slots. */
+    usize* hashes;
+
+    /** @brief A min-heap of slots ordered by their counts. */
+    isize* heap;
+
+    /** @brief The positions of the slots within `heap`. */
+    isize* heapPositions;
+
+    /**
+     * @brief An open addressing hash table mapping elements to their slots.
+     *
+     * @note The positions of the index are an array of `index.capacity`
+     * slot numbers within the same block of memory.
+     */
+    ScuOpenIndex index;
+
+    /** @brief The elements of the slots (`capacity * elemSize` bytes). */
+    byte* elems;
+
+};
+
+/**
+ * @brief Rounds up a value to the next multiple of a specified alignment.
+ *
+ * @warning The behavior is undefined if `alignment` is not a power of two.
+ *
+ * @param[in] value     The value to round up.
+ * @param[in] alignment The required alignment.
+ * @return The smallest multiple of `alignment` greater than or equal to
+ * `value`.
+ */
+static inline isize scu_align_up(isize value, isize alignment) {
+    SCU_ASSERT(value >= 0);
+    SCU_ASSERT(alignment > 0);
+    SCU_ASSERT((alignment & (alignment - 1)) == 0);
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+[[nodiscard]]
+ScuHeavyHitters* scu_heavy_hitters_new(
+    isize elemSize,
+    isize capacity,
+    ScuHashFunc* hashFunc,
+    ScuEqualFunc* equalFunc
+) {
+    SCU_ASSERT(elemSize > 0);
+    SCU_ASSERT(capacity > 0);
+    SCU_ASSERT(hashFunc != nullptr);
+    SCU_ASSERT(equalFunc != nullptr);
+    // Bound the capacity first, so that the size of the index cannot overflow.
+    if (capacity > (ISIZE_MAX / 4 / SCU_SIZEOF(isize))) {
+        return nullptr;
+    }
+    isize indexCapacity = scu_open_index_capacity_for(capacity);
+    isize slotSize = (2 * SCU_SIZEOF(u64)) + SCU_SIZEOF(usize)
+        + (2 * SCU_SIZEOF(isize));
+    isize metadataSize = indexCapacity * SCU_SIZEOF(isize);
+    if (capacity > ((ISIZE_MAX - metadataSize) / slotSize)) {
+        return nullptr;
+    }
+    metadataSize += capacity * slotSize;
+    // Leave room for aligning the elements as well.
+    isize alignment = SCU_ALIGNOF(max_align_t);
+    if (capacity > ((ISIZE_MAX - metadataSize - alignment) / elemSize)) {
+        return nullptr;
+    }
+    ScuHeavyHitters* heavyHitters = scu_malloc(SCU_SIZEOF(ScuHeavyHitters));
+    if (heavyHitters == nullptr) {
+        return nullptr;
+    }
+    isize elemsOffset = scu_align_up(metadataSize, alignment);
+    byte* storage = scu_malloc(elemsOffset + (capacity * elemSize));
+    if (storage == nullptr) {
+        scu_free(heavyHitters);
+        return nullptr;
+    }
+    heavyHitters->elemSize = elemSize;
+    heavyHitters->capacity = capacity;
+    heavyHitters->hashFunc = hashFunc;
+    heavyHitters->counts = (u64*) (void*) storage;
+    heavyHitters->errors = heavyHitters->counts + capacity;
+    heavyHitters->hashes = (usize*) (void*) (heavyHitters->errors + capacity);
+    heavyHitters->heap = (isize*) (void*) (heavyHitters->hashes + capacity);
+    heavyHitters->heapPositions = heavyHitters->heap + capacity;
+    heavyHitters->index = (ScuOpenIndex) {
+        .capacity = indexCapacity,
+        .positions = heavyHitters->heapPositions + capacity,
+        .hashes = heavyHitters->hashes,
+        .keys = storage + elemsOffset,
+        .keySize = elemSize,
+        .equalFunc = equalFunc
+    };
+    heavyHitters->elems = storage + elemsOffset;
+    scu_heavy_hitters_clear(heavyHitters);
+    return heavyHitters;
+}
+
+isize scu_heavy_hitters_capacity(const ScuHeavyHitters* heavyHitters) {
+    SCU_ASSERT(heavyHitters != nullptr);
+    return heavyHitters->capacity;
+}
+
+isize scu_heavy_hitters_count(const ScuHeavyHitters* heavyHitters) {
+    SCU_ASSERT(heavyHitters != nullptr);
+    return heavyHitters->count;
+}
+
+u64 scu_heavy_hitters_total(const ScuHeavyHitters* heavyHitters) {
+    SCU_ASSERT(heavyHitters != nullptr);
+    return heavyHitters->total;
+}
+
+/**
+ * @brief Adds two `u64` values, saturating at `U64_MAX`.
+ *
+ * @param[in] a The first value.
+ * @param[in] b The second value.
+ * @return The saturated sum of both values.
+ */
+static inline u64 scu_saturating_add(u64 a, u64 b) {
+    return (a > (U64_MAX - b)) ? U64_MAX : (a + b);
+}
+
+/**
+ * @brief Returns a pointer to the element of a slot.
+ *
+ * @param[in] heavyHitters The tracker to examine.
+ * @param[in] slot         The slot to examine.
+ * @return A pointer to the element of the slot.
+ */
+static inline byte* scu_heavy_hitters_elem_at(
+    const ScuHeavyHitters* heavyHitters,
+    isize slot
+) {
+    SCU_ASSERT(heavyHitters != nullptr);
+    SCU_ASSERT((slot >= 0) && (slot < heavyHitters->capacity));
+    return &heavyHitters->elems[slot * heavyHitters->elemSize];
+}
+
+/**
+ * @brief Swaps two entries of the heap of a specified tracker.
+ *
+ * @param[in, out] heavyHitters The tracker to modify.
+ * @param[in]      i            The position of the first entry.
+ * @param[in]      j            The position of the second entry.
+ */
+static inline void scu_heavy_hitters_heap_swap(
+    ScuHeavyHitters* heavyHitters,
+    isize i,
+    isize j
+) {
+    SCU_ASSERT(heavyHitters != nullptr);
+    isize slot = heavyHitters->heap[i];
+    heavyHitters->heap[i] = heavyHitters->heap[j];
+    heavyHitters->heap[j] = slot;
+    heavyHitters->heapPositions[heavyHitters->heap[i]] = i;
+    heavyHitters->heapPositions[heavyHitters->heap[j]] = j;
+}
+
+/**
+ * @brief Moves an entry of the heap of a specified tracker up until the heap
+ * property is restored.
+ *
+ * @param[in, out] heavyHitters The tracker to modify.
+ * @param[in]      position     The position of the entry.
+ */
+static inline void scu_heavy_hitters_sift_up(
+    ScuHeavyHitters* heavyHitters,
+    isize position
+) {
+    SCU_ASSERT(heavyHitters != nullptr);
+    const u64* counts = heavyHitters->counts;
+    while (position > 0) {
+        isize parent = (position - 1) / 2;
+        if (
+            counts[heavyHitters->heap[parent]]
+                <= counts[heavyHitters->heap[position]]
+        ) {
+            break;
+        }
+        scu_heavy_hitters_heap_swap(heavyHitters, parent, position);
+        position = parent;
+    }
+}
+
+/**
+ * @brief Moves an entry of the heap of a specified tracker down until the heap
+ * property is restored.
+ *
+ * @param[in, out] heavyHitters The tracker to modify.
+ * @param[in]      position     The position of the entry.
+ */
+static inline void scu_heavy_hitters_sift_down(
+    ScuHeavyHitters* heavyHitters,
+    isize position
+) {
+    SCU_ASSERT(heavyHitters != nullptr);
+    const u64* counts = heavyHitters->counts;
+    while (true) {
+        isize smallest = position;
+        isize left = (2 * position) + 1;
+        isize right = left + 1;
+        if (
+            (left < heavyHitters->count)
+                && (counts[heavyHitters->heap[left]]
+                    < counts[heavyHitters->heap[smallest]])
+        ) {
+            smallest = left;
+        }
+        if (
+            (right < heavyHitters->count)
+                && (counts[heavyHitters->heap[right]]
+                    < counts[heavyHitters->heap[smallest]])
+        ) {
+            smallest = right;
+        }
+        if (smallest == position) {
+            break;
+        }
+        scu_heavy_hitters_heap_swap(heavyHitters, smallest, position);
+        position = smallest;
+    }
+}
+
+void scu_heavy_hitters_add(
+    ScuHeavyHitters* restrict heavyHitters,
+    const void* restrict elem,
+    u64 count
+) {
+    SCU_ASSERT(heavyHitters != nullptr);
+    SCU_ASSERT(elem != nullptr);
+    heavyHitters->total = scu_saturating_add(heavyHitters->total, count);
+    usize hash = heavyHitters->hashFunc(elem);
+    isize position = scu_open_index_find(&heavyHitters->index, elem, hash);
+    if (position != -1) {
+        isize slot = heavyHitters->index.positions[position];
+        heavyHitters->counts[slot] = scu_saturating_add(
+            heavyHitters->counts[slot],
+            count
+        );
+        scu_heavy_hitters_sift_down(
+            heavyHitters,
+            heavyHitters->heapPositions[slot]
+        );
+        return;
+    }
+    isize slot;
+    if (heavyHitters->count < heavyHitters->capacity) {
+        slot = heavyHitters->count;
+        heavyHitters->counts[slot] = count;
+        heavyHitters->errors[slot] = 0;
+        heavyHitters->heap[slot] = slot;
+        heavyHitters->heapPositions[slot] = slot;
+        heavyHitters->count++;
+    }
+    else {
+        // Replace the monitored element with the lowest count, which becomes
+        // the maximum overestimation of the new element.
+        slot = heavyHitters->heap[0];
+        scu_open_index_remove(&heavyHitters->index, slot);
+        u64 minCount = heavyHitters->counts[slot];
+        heavyHitters->counts[slot] = scu_saturating_add(minCount, count);
+        heavyHitters->errors[slot] = minCount;
+    }
+    heavyHitters->hashes[slot] = hash;
+    scu_memcpy(
+        scu_heavy_hitters_elem_at(heavyHitters, slot),
+        elem,
+        heavyHitters->elemSize
+    );
+    scu_open_index_insert(&heavyHitters->index, slot);
+    scu_heavy_hitters_sift_up(heavyHitters, heavyHitters->heapPositions[slot]);
+    scu_heavy_hitters_sift_down(
+        heavyHitters,
+        heavyHitters->heapPositions[slot]
+    );
+}
+
+bool scu_heavy_hitters_try_get(
+    const ScuHeavyHitters* restrict heavyHitters,
+    const void* restrict elem,
+    ScuHeavyHitter* restrict hitter
+) {
+    SCU_ASSERT(heavyHitters != nullptr);
+    SCU_ASSERT(elem != nullptr);
+    SCU_ASSERT(hitter != nullptr);
+    usize hash = heavyHitters->hashFunc(elem);
+    isize position = scu_open_index_find(&heavyHitters->index, elem, hash);
+    if (position == -1) {
+        return false;
+    }
+    isize slot = heavyHitters->index.positions[position];
+    hitter->elem = scu_heavy_hitters_elem_at(heavyHitters, slot);
+    hitter->count = heavyHitters->counts[slot];
+    hitter->error = heavyHitters->errors[slot];
+    return true;
+}
+
+/**
+ * @brief Compares two heavy hitters by their counts in descending order.
+ *
+ * @param[in] a A pointer to the first heavy hitter.
+ * @param[in] b A pointer to the second heavy hitter.
+ * @return A negative value if `a` has a higher count than `b`, a positive value
+ * if `a` has a lower count than `b`, or zero if both counts are equal.
+ */
+static int scu_heavy_hitter_compare_rev(const void* a, const void* b) {
+    SCU_ASSERT(a != nullptr);
+    SCU_ASSERT(b != nullptr);
+    u64 left = ((const ScuHeavyHitter*) a)->count;
+    u64 right = ((const ScuHeavyHitter*) b)->count;
+    return (left < right) - (left > right);
+}
+
+/**
+ * @brief Moves an entry of a min-heap of heavy hitters down until the heap
+ * property is restored.
+ *
+ * @param[in, out] hitters  The heap of heavy hitters.
+ * @param[in]      count    The number of heavy hitters in the heap.
+ * @param[in]      position The position of the entry.
+ */
+static inline void scu_heavy_hitter_sift_down(
+    ScuHeavyHitter* hitters,
+    isize count,
+    isize position
+) {
+    SCU_ASSERT(hitters != nullptr);
+    while (true) {
+        isize smallest = position;
+        isize left = (2 * position) + 1;
+        isize right = left + 1;
+        if ((left < count) && (hitters[left].count < hitters[smallest].count)) {
+            smallest = left;
+        }
+        if (
+            (right < count) && (hitters[right].count < hitters[smallest].count)
+        ) {
+            smallest = right;
+        }
+        if (smallest == position) {
+            break;
+        }
+        ScuHeavyHitter hitter = hitters[smallest];
+        hitters[smallest] = hitters[position];
+        hitters[position] = hitter;
+        position = smallest;
+    }
+}
+
+isize scu_heavy_hitters_top(
+    const ScuHeavyHitters* restrict heavyHitters,
+    ScuHeavyHitter* restrict hitters,
+    isize count
+) {
+    SCU_ASSERT(heavyHitters != nullptr);
+    SCU_ASSERT((hitters != nullptr) || (count == 0));
+    SCU_ASSERT(count >= 0);
+    // Select the highest counts by maintaining a min-heap of the best
+    // candidates within the output array, then sort the result.
+    isize resultCount = 0;
+    for (isize slot = 0; slot < heavyHitters->count; slot++) {
+        ScuHeavyHitter hitter = {
+            .elem = scu_heavy_hitters_elem_at(heavyHitters, slot),
+            .count = heavyHitters->counts[slot],
+            .error = heavyHitters->errors[slot]
+        };
+        if (resultCount < count) {
+            hitters[resultCount] = hitter;
+            resultCount++;
+            if (resultCount == count) {
+                for (isize i = (resultCount / 2) - 1; i >= 0; i--) {
+                    scu_heavy_hitter_sift_down(hitters, resultCount, i);
+                }
+            }
+        }
+        else if ((count > 0) && (hitter.count > hitters[0].count)) {
+            hitters[0] = hitter;
+            scu_heavy_hitter_sift_down(hitters, resultCount, 0);
+        }
+    }
+    scu_array_sort(
+        hitters,
+        resultCount,
+        SCU_SIZEOF(ScuHeavyHitter),
+        scu_heavy_hitter_compare_rev
+    );
+    return resultCount;
+}
+
+void scu_heavy_hitters_clear(ScuHeavyHitters* heavyHitters) {
+    SCU_ASSERT(heavyHitters != nullptr);
+    scu_open_index_clear(&heavyHitters->index);
+    heavyHitters->count = 0;
+    heavyHitters->total = 0;
+}
+
+void scu_heavy_hitters_free(ScuHeavyHitters* heavyHitters) {
+    if (heavyHitters != nullptr) {
+        // All arrays share a single allocation starting with the counts.
+        scu_free(heavyHitters->counts);
+        heavyHitters->counts = nullptr;
+        heavyHitters->capacity = 0;
+        heavyHitters->count = 0;
+        scu_free(heavyHitters);
+    }
+}
@@ -0,0 +1,536 @@
+#define SCU_SHORT_ALIASES
+
+#include <math.h>
+#include "scu/alloc.h"
+#include "scu/assert.h"
+#include "scu/hyper-log-log.h"
+#include "scu/math.h"
+#include "scu/memory.h"
+#include "bits.h"
+
+struct ScuHyperLogLog {
+
+    /** @brief The precision, i.e., the base-2 logarithm of the register count. */
+    isize precision;
+
+    /** @brief A function used for hashing elements. */
+    ScuHashFunc* hashFunc;
+
+    /** @brief The maximum number of entries of the sparse representation. */
+    isize sparseCapacity;
+
+    /** @brief The current number of entries of the sparse representation. */
+    isize sparseCount;
+
+    /**
+     * @brief The entries of the sparse representation.
+     *
+     * @note This is a dynamically allocated array of `sparseCapacity` entries
+     * sorted by register index, or `nullptr` if `sparseCapacity` is zero. Each
+     * entry stores the index of a register at `SCU_SPARSE_PRECISION` in its
+     * upper bits and the value of the register in its lower
+     * `SCU_SPARSE_VALUE_BITS` bits.
+     */
+    u32* sparse;
+
+    /**
+     * @brief The registers of the dense representation.
+     *
+     * @note This is a dynamically allocated array of `2^precision` registers, or
+     * `nullptr` if the sketch uses the sparse representation.
+     */
+    byte* registers;
+
+};
+
+/** @brief The precision of the sparse representation. */
+static constexpr isize SCU_SPARSE_PRECISION = 25;
+
+/** @brief The number of bits used for the register value of a sparse entry. */
+static constexpr isize SCU_SPARSE_VALUE_BITS = 6;
+
+/** @brief The initial capacity of the sparse representation. */
+static constexpr isize SCU_DEFAULT_SPARSE_CAPACITY = 8;
+
+/** @brief The growth factor for increasing the capacity of the sparse array. */
+static constexpr isize SCU_GROWTH_FACTOR = 2;
+
+/**
+ * @brief Computes the register index and value of a specified hash at a
+ * specified precision.
+ *
+ * @param[in]  hash      The (mixed) hash to examine.
+ * @param[in]  precision The precision to use.
+ * @param[out] value     The register value, i.e., the number of leading zeros
+ *                       following the index bits plus one.
+ * @return The register index.
+ */
+static inline isize scu_register_of(u64 hash, isize precision, byte* value) {
+    SCU_ASSERT(value != nullptr);
+    // The sentinel bit caps the value at (64 - precision + 1).
+    u64 rest = (hash << precision) | ((u64) 1 << (precision - 1));
+    *value = (byte) (scu_leading_zeros_u64(rest) + 1);
+    return (isize) (hash >> (64 - precision));
+}
+
+/**
+ * @brief Converts a sparse entry into a register index and value at the
+ * precision of the dense representation.
+ *
+ * @param[in]  entry     The sparse entry to convert.
+ * @param[in]  precision The precision of the dense representation.
+ * @param[out] value     The register value.
+ * @return The register index.
+ */
+static inline isize scu_register_of_entry(
+    u32 entry,
+    isize precision,
+    byte* value
+) {
+    SCU_ASSERT(value != nullptr);
+    isize extraBits = SCU_SPARSE_PRECISION - precision;
+    u32 sparseIndex = entry >> SCU_SPARSE_VALUE_BITS;
+    u32 extra = sparseIndex & (((u32) 1 << extraBits) - 1);
+    if (extra != 0) {
+        // The first one bit lies within the bits that are part of the sparse
+        // index, but not part of the dense index.
+        *value = (byte) (scu_leading_zeros_u64(extra) - (64 - extraBits) + 1);
+    }
+    else {
+        u32 sparseValue = entry & (((u32) 1 << SCU_SPARSE_VALUE_BITS) - 1);
+        *value = (byte) (extraBits + (isize) sparseValue);
+    }
+    return (isize) (sparseIndex >> extraBits);
+}
+
+[[nodiscard]]
+ScuHyperLogLog* scu_hyper_log_log_new(isize precision, ScuHashFunc* hashFunc) {
+    SCU_ASSERT(
+        (precision >= SCU_HYPER_LOG_LOG_MIN_PRECISION)
+            && (precision <= SCU_HYPER_LOG_LOG_MAX_PRECISION)
+    );
+    SCU_ASSERT(hashFunc != nullptr);
+    ScuHyperLogLog* hll = scu_malloc(SCU_SIZEOF(ScuHyperLogLog));
+    if (hll == nullptr) {
+        return nullptr;
+    }
+    hll->precision = precision;
+    hll->hashFunc = hashFunc;
+    hll->sparseCapacity = 0;
+    hll->sparseCount = 0;
+    hll->sparse = nullptr;
+    hll->registers = nullptr;
+    return hll;
+}
+
+[[nodiscard]]
+ScuHyperLogLog* scu_hyper_log_log_clone(const ScuHyperLogLog* hll) {
+    SCU_ASSERT(hll != nullptr);
+    ScuHyperLogLog* clone = scu_hyper_log_log_new(
+        hll->precision,
+        hll->hashFunc
+    );
+    if (clone == nullptr) {
+        return nullptr;
+    }
+    if (hll->registers != nullptr) {
+        isize registerCount = (isize) 1 << hll->precision;
+        clone->registers = scu_malloc(registerCount);
+        if (clone->registers == nullptr) {
+            scu_free(clone);
+            return nullptr;
+        }
+        scu_memcpy(clone->registers, hll->registers, registerCount);
+    }
+    else if (hll->sparseCount > 0) {
+        clone->sparse = scu_malloc(hll->sparseCount * SCU_SIZEOF(u32));
+        if (clone->sparse == nullptr) {
+            scu_free(clone);
+            return nullptr;
+        }
+        scu_memcpy(
+            clone->sparse,
+            hll->sparse,
+            hll->sparseCount * SCU_SIZEOF(u32)
+        );
+        clone->sparseCapacity = hll->sparseCount;
+        clone->sparseCount = hll->sparseCount;
+    }
+    return clone;
+}
+
+isize scu_hyper_log_log_precision(const ScuHyperLogLog* hll) {
+    SCU_ASSERT(hll != nullptr);
+    return hll->precision;
+}
+
+/**
+ * @brief Converts a specified HyperLogLog sketch to the dense representation.
+ *
+ * @param[in, out] hll The sketch to convert.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+static inline ScuError scu_hyper_log_log_densify(ScuHyperLogLog* hll) {
+    SCU_ASSERT(hll != nullptr);
+    SCU_ASSERT(hll->registers == nullptr);
+    byte* registers = scu_calloc((isize) 1 << hll->precision, SCU_SIZEOF(byte));
+    if (registers == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    for (isize i = 0; i < hll->sparseCount; i++) {
+        byte value;
+        isize index = scu_register_of_entry(
+            hll->sparse[i],
+            hll->precision,
+            &value
+        );
+        registers[index] = SCU_MAX(registers[index], value);
+    }
+    scu_free(hll->sparse);
+    hll->sparse = nullptr;
+    hll->sparseCapacity = 0;
+    hll->sparseCount = 0;
+    hll->registers = registers;
+    return SCU_ERROR_NONE;
+}
+
+/**
+ * @brief Returns the maximum number of entries of the sparse representation
+ * of a specified HyperLogLog sketch.
+ *
+ * @note Once the sparse representation would exceed this number of entries, it
+ * occupies more memory than the dense representation.
+ *
+ * @param[in] hll The sketch to examine.
+ * @return The maximum number of entries of the sparse representation.
+ */
+static inline isize scu_hyper_log_log_max_sparse_count(
+    const ScuHyperLogLog* hll
+) {
+    SCU_ASSERT(hll != nullptr);
+    return ((isize) 1 << hll->precision) / SCU_SIZEOF(u32);
+}
+
+/**
+ * @brief Inserts a sparse entry into a specified HyperLogLog sketch using the
+ * sparse representation.
+ *
+ * @param[in, out] hll   The sketch to insert the entry into.
+ * @param[in]      entry The entry to insert.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+static inline ScuError scu_hyper_log_log_insert_sparse(
+    ScuHyperLogLog* hll,
+    u32 entry
+) {
+    SCU_ASSERT(hll != nullptr);
+    SCU_ASSERT(hll->registers == nullptr);
+    u32 index = entry >> SCU_SPARSE_VALUE_BITS;
+    // Find the first entry with an index greater than or equal to the index of
+    // the new entry.
+    isize low = 0;
+    isize high = hll->sparseCount;
+    while (low < high) {
+        isize mid = low + ((high - low) / 2);
+        if ((hll->sparse[mid] >> SCU_SPARSE_VALUE_BITS) < index) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    if (
+        (low < hll->sparseCount)
+            && ((hll->sparse[low] >> SCU_SPARSE_VALUE_BITS) == index)
+    ) {
+        hll->sparse[low] = SCU_MAX(hll->sparse[low], entry);
+        return SCU_ERROR_NONE;
+    }
+    if (hll->sparseCount >= scu_hyper_log_log_max_sparse_count(hll)) {
+        ScuError error = scu_hyper_log_log_densify(hll);
+        if (error != SCU_ERROR_NONE) {
+            return error;
+        }
+        byte value;
+        isize denseIndex = scu_register_of_entry(entry, hll->precision, &value);
+        hll->registers[denseIndex] = SCU_MAX(hll->registers[denseIndex], value);
+        return SCU_ERROR_NONE;
+    }
+    if (hll->sparseCount == hll->sparseCapacity) {
+        isize newCapacity = (hll->sparseCapacity == 0)
+            ? SCU_DEFAULT_SPARSE_CAPACITY
+            : (hll->sparseCapacity * SCU_GROWTH_FACTOR);
+        newCapacity = SCU_MIN(
+            newCapacity,
+            scu_hyper_log_log_max_sparse_count(hll)
+        );
+        u32* newSparse = scu_realloc(
+            hll->sparse,
+            newCapacity * SCU_SIZEOF(u32)
+        );
+        if (newSparse == nullptr) {
+            return SCU_ERROR_OUT_OF_MEMORY;
+        }
+        hll->sparse = newSparse;
+        hll->sparseCapacity = newCapacity;
+    }
+    scu_memmove(
+        &hll->sparse[low + 1],
+        &hll->sparse[low],
+        (hll->sparseCount - low) * SCU_SIZEOF(u32)
+    );
+    hll->sparse[low] = entry;
+    hll->sparseCount++;
+    return SCU_ERROR_NONE;
+}
+
+ScuError scu_hyper_log_log_add(
+    ScuHyperLogLog* restrict hll,
+    const void* restrict elem
+) {
+    SCU_ASSERT(hll != nullptr);
+    SCU_ASSERT(elem != nullptr);
+    return scu_hyper_log_log_add_hash(hll, hll->hashFunc(elem));
+}
+
+ScuError scu_hyper_log_log_add_hash(ScuHyperLogLog* hll, usize hash) {
+    SCU_ASSERT(hll != nullptr);
+    u64 v = scu_mix_u64(hash);
+    byte value;
+    if (hll->registers != nullptr) {
+        isize index = scu_register_of(v, hll->precision, &value);
+        hll->registers[index] = SCU_MAX(hll->registers[index], value);
+        return SCU_ERROR_NONE;
+    }
+    isize index = scu_register_of(v, SCU_SPARSE_PRECISION, &value);
+    u32 entry = ((u32) index << SCU_SPARSE_VALUE_BITS) | value;
+    return scu_hyper_log_log_insert_sparse(hll, entry);
+}
+
+/**
+ * @brief Computes the sigma function of Ertl's improved estimator.
+ *
+ * @param[in] x The argument, which must be in the range `[0, 1]`.
+ * @return The value of the sigma function.
+ */
+static inline f64 scu_sigma(f64 x) {
+    SCU_ASSERT((x >= 0.0) && (x <= 1.0));
+    if (x == 1.0) {
+        return INFINITY;
+    }
+    f64 y = 1.0;
+    f64 z = x;
+    f64 oldZ;
+    do {
+        x *= x;
+        oldZ = z;
+        z += x * y;
+        y += y;
+    }
+    while (z != oldZ);
+    return z;
+}
+
+/**
+ * @brief Computes the tau function of Ertl's improved estimator.
+ *
+ * @param[in] x The argument, which must be in the range `[0, 1]`.
+ * @return The value of the tau function.
+ */
+static inline f64 scu_tau(f64 x) {
+    SCU_ASSERT((x >= 0.0) && (x <= 1.0));
+    if ((x == 0.0) || (x == 1.0)) {
+        return 0.0;
+    }
+    f64 y = 1.0;
+    f64 z = 1.0 - x;
+    f64 oldZ;
+    do {
+        x = sqrt(x);
+        oldZ = z;
+        y *= 0.5;
+        z -= (1.0 - x) * (1.0 - x) * y;
+    }
+    while (z != oldZ);
+    return z / 3.0;
+}
+
+/**
+ * @brief Estimates the cardinality from a histogram of register values.
+ *
+ * @param[in] histogram The number of registers per register value (with
+ *                      `q + 2` entries).
+ * @param[in] precision The precision of the registers.
+ * @return The estimated cardinality.
+ */
+static inline f64 scu_estimate_from_histogram(
+    const isize* histogram,
+    isize precision
+) {
+    SCU_ASSERT(histogram != nullptr);
+    isize q = 64 - precision;
+    f64 m = (f64) ((isize) 1 << precision);
+    f64 z = m * scu_tau(1.0 - ((f64) histogram[q + 1] / m));
+    for (isize k = q; k >= 1; k--) {
+        z = 0.5 * (z + (f64) histogram[k]);
+    }
+    z += m * scu_sigma((f64) histogram[0] / m);
+    if (isinf(z)) {
+        return 0.0;
+    }
+    return (m * m) / (2.0 * log(2.0) * z);
+}
+
+f64 scu_hyper_log_log_estimate(const ScuHyperLogLog* hll) {
+    SCU_ASSERT(hll != nullptr);
+    isize histogram[64 + 2] = { 0 };
+    if (hll->registers != nullptr) {
+        isize registerCount = (isize) 1 << hll->precision;
+        for (isize i = 0; i < registerCount; i++) {
+            histogram[hll->registers[i]]++;
+        }
+        return scu_estimate_from_histogram(histogram, hll->precision);
+    }
+    histogram[0] = ((isize) 1 << SCU_SPARSE_PRECISION) - hll->sparseCount;
+    for (isize i = 0; i < hll->sparseCount; i++) {
+        u32 value = hll->sparse[i] & (((u32) 1 << SCU_SPARSE_VALUE_BITS) - 1);
+        histogram[value]++;
+    }
+    return scu_estimate_from_histogram(histogram, SCU_SPARSE_PRECISION);
+}
+
+/**
+ * @brief Merges two sorted arrays of sparse entries.
+ *
+ * @param[in]  left       The first array of entries.
+ * @param[in]  leftCount  The number of entries of the first array.
+ * @param[in]  right      The second array of entries.
+ * @param[in]  rightCount The number of entries of the second array.
+ * @param[out] merged     The array to store the merged entries in, which must
+ *                        have room for `leftCount + rightCount` entries.
+ * @return The number of merged entries.
+ */
+static inline isize scu_merge_sparse(
+    const u32* restrict left,
+    isize leftCount,
+    const u32* restrict right,
+    isize rightCount,
+    u32* restrict merged
+) {
+    isize i = 0;
+    isize j = 0;
+    isize count = 0;
+    while ((i < leftCount) && (j < rightCount)) {
+        u32 leftIndex = left[i] >> SCU_SPARSE_VALUE_BITS;
+        u32 rightIndex = right[j] >> SCU_SPARSE_VALUE_BITS;
+        if (leftIndex < rightIndex) {
+            merged[count++] = left[i++];
+        }
+        else if (leftIndex > rightIndex) {
+            merged[count++] = right[j++];
+        }
+        else {
+            merged[count++] = SCU_MAX(left[i], right[j]);
+            i++;
+            j++;
+        }
+    }
+    while (i < leftCount) {
+        merged[count++] = left[i++];
+    }
+    while (j < rightCount) {
+        merged[count++] = right[j++];
+    }
+    return count;
+}
+
+ScuError scu_hyper_log_log_merge(
+    ScuHyperLogLog* restrict dest,
+    const ScuHyperLogLog* restrict src
+) {
+    SCU_ASSERT(dest != nullptr);
+    SCU_ASSERT(src != nullptr);
+    SCU_ASSERT(dest->precision == src->precision);
+    SCU_ASSERT(dest->hashFunc == src->hashFunc);
+    if ((dest->registers == nullptr) && (src->registers == nullptr)) {
+        if (src->sparseCount == 0) {
+            return SCU_ERROR_NONE;
+        }
+        u32* merged = scu_malloc(
+            (dest->sparseCount + src->sparseCount) * SCU_SIZEOF(u32)
+        );
+        if (merged == nullptr) {
+            return SCU_ERROR_OUT_OF_MEMORY;
+        }
+        isize mergedCount = scu_merge_sparse(
+            dest->sparse,
+            dest->sparseCount,
+            src->sparse,
+            src->sparseCount,
+            merged
+        );
+        u32* oldSparse = dest->sparse;
+        isize oldCapacity = dest->sparseCapacity;
+        isize oldCount = dest->sparseCount;
+        dest->sparse = merged;
+        dest->sparseCapacity = dest->sparseCount + src->sparseCount;
+        dest->sparseCount = mergedCount;
+        if (mergedCount > scu_hyper_log_log_max_sparse_count(dest)) {
+            ScuError error = scu_hyper_log_log_densify(dest);
+            if (error != SCU_ERROR_NONE) {
+                scu_free(dest->sparse);
+                dest->sparse = oldSparse;
+                dest->sparseCapacity = oldCapacity;
+                dest->sparseCount = oldCount;
+                return error;
+            }
+        }
+        scu_free(oldSparse);
+        return SCU_ERROR_NONE;
+    }
+    if (dest->registers == nullptr) {
+        ScuError error = scu_hyper_log_log_densify(dest);
+        if (error != SCU_ERROR_NONE) {
+            return error;
+        }
+    }
+    if (src->registers != nullptr) {
+        isize registerCount = (isize) 1 << dest->precision;
+        for (isize i = 0; i < registerCount; i++) {
+            dest->registers[i] = SCU_MAX(dest->registers[i], src->registers[i]);
+        }
+    }
+    else {
+        for (isize i = 0; i < src->sparseCount; i++) {
+            byte value;
+            isize index = scu_register_of_entry(
+                src->sparse[i],
+                dest->precision,
+                &value
+            );
+            dest->registers[index] = SCU_MAX(dest->registers[index], value);
+        }
+    }
+    return SCU_ERROR_NONE;
+}
+
+void scu_hyper_log_log_clear(ScuHyperLogLog* hll) {
+    SCU_ASSERT(hll != nullptr);
+    scu_free(hll->registers);
+    hll->registers = nullptr;
+    hll->sparseCount = 0;
+}
+
+void scu_hyper_log_log_free(ScuHyperLogLog* hll) {
+    if (hll != nullptr) {
+        scu_free(hll->sparse);
+        hll->sparse = nullptr;
+        scu_free(hll->registers);
+        hll->registers = nullptr;
+        hll->sparseCapacity = 0;
+        hll->sparseCount = 0;
+        scu_free(hll);
+    }
+}
@@ -1,17 +1,41 @@
 #define SCU_SHORT_ALIASES
 
+#ifdef __linux__
+    #ifndef _GNU_SOURCE
+        #define _GNU_SOURCE
+    #endif
+#endif
 #ifndef _POSIX_C_SOURCE
     #define _POSIX_C_SOURCE 200809L
 #endif
+#ifndef _DEFAULT_SOURCE
+    #define _DEFAULT_SOURCE
+#endif
 #ifndef _FILE_OFFSET_BITS
     #define _FILE_OFFSET_BITS 64
 #endif
 
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <io.h>
+    #include <windows.h>
+#else
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+    #ifdef __linux__
+        #include <sys/sendfile.h>
+    #endif
+#endif
 #include <pthread.h>
 #include <stdio.h>
 #include "scu/alloc.h"
 #include "scu/assert.h"
 #include "scu/io.h"
+#include "scu/math.h"
 #include "scu/memory.h"
 #include "scu/string.h"
 
@@ -20,6 +44,40 @@ struct ScuFile {
     /** @brief The underlying file stream handle. */
     FILE* handle;
 
+    /**
+     * @brief The buffer installed with `scu_fsetbuf()`, or `nullptr` if the
+     * buffer is managed by the C library.
+     */
+    char* buffer;
+
+};
+
+struct ScuMappedFile {
+
+    /**
+     * @brief The start of the mapping, which is aligned to the page size (or
+     * the allocation granularity on Windows), or `nullptr` if no bytes are
+     * mapped.
+     */
+    void* base;
+
+    /** @brief The size of the mapping (in bytes). */
+    isize length;
+
+    /** @brief The first mapped byte requested by the caller. */
+    byte* data;
+
+    /** @brief The number of mapped bytes requested by the caller. */
+    isize size;
+
+    /** @brief The mode in which the file was mapped. */
+    ScuMapMode mode;
+
+#ifdef _WIN32
+    /** @brief The handle of the mapped file, required for flushing it. */
+    HANDLE handle;
+#endif
+
 };
 
 /** @brief The factor used when growing dynamically allocated buffers. */
@@ -28,6 +86,34 @@ static constexpr isize SCU_GROWTH_FACTOR = 2;
 /** @brief The chunk size used when reading from a file stream. */
 static constexpr isize SCU_CHUNK_SIZE = 4096;
 
+/** @brief The maximum number of buffers passed to a vectored system call. */
+static constexpr isize SCU_IOV_BATCH = 64;
+
+/** @brief The block size used when copying through user space (in bytes). */
+static constexpr isize SCU_COPY_BLOCK_SIZE = 1024 * 1024;
+
+#ifdef __linux__
+    /** @brief The maximum number of bytes copied by a single system call. */
+    static constexpr isize SCU_COPY_CHUNK_SIZE = 1024 * 1024 * 1024;
+
+    /** @brief Represents a method of copying data within the kernel. */
+    typedef enum ScuCopyMethod {
+
+        /** @brief Indicates to use `copy_file_range()`. */
+        SCU_COPY_METHOD_COPY_FILE_RANGE,
+
+        /** @brief Indicates to use `sendfile()`. */
+        SCU_COPY_METHOD_SENDFILE,
+
+        /** @brief Indicates to use `splice()` through a pipe. */
+        SCU_COPY_METHOD_SPLICE,
+
+        /** @brief Indicates that no method is left to try. */
+        SCU_COPY_METHOD_NONE
+
+    } ScuCopyMethod;
+#endif
+
 /**
  * @brief A flag to ensure the file stream associated with the standard input
  * stream is only initialized once.
@@ -60,6 +146,7 @@ static ScuFile scuStderr;
  */
 static void scu_init_stdin() {
     scuStdin.handle = stdin;
+    scuStdin.buffer = nullptr;
 }
 
 /**
@@ -68,6 +155,7 @@ static void scu_init_stdin() {
  */
 static void scu_init_stdout() {
     scuStdout.handle = stdout;
+    scuStdout.buffer = nullptr;
 }
 
 /**
@@ -75,6 +163,7 @@ static void scu_init_stdout() {
  */
 static void scu_init_stderr() {
     scuStderr.handle = stderr;
+    scuStderr.buffer = nullptr;
 }
 
 ScuFile* scu_stdin() {
@@ -111,6 +200,7 @@ ScuError scu_fopen(
         return SCU_ERROR_OUT_OF_MEMORY;
     }
     (*file)->handle = handle;
+    (*file)->buffer = nullptr;
     return SCU_ERROR_NONE;
 }
 
@@ -126,9 +216,99 @@ ScuError scu_fopentmp(ScuFile** file) {
         return SCU_ERROR_OUT_OF_MEMORY;
     }
     (*file)->handle = handle;
+    (*file)->buffer = nullptr;
     return SCU_ERROR_NONE;
 }
 
+/**
+ * @brief Wraps a specified file stream handle into a new file stream.
+ *
+ * @note The handle is closed if an out-of-memory condition occurs.
+ *
+ * @param[out] file   A pointer to the new file stream, or `nullptr` on failure.
+ * @param[in]  handle The file stream handle to wrap.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+static ScuError scu_fwrap(ScuFile* restrict* file, FILE* handle) {
+    *file = scu_malloc(SCU_SIZEOF(ScuFile));
+    if (*file == nullptr) {
+        fclose(handle);
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    (*file)->handle = handle;
+    (*file)->buffer = nullptr;
+    return SCU_ERROR_NONE;
+}
+
+ScuError scu_fopenmem(
+    ScuFile* restrict* restrict file,
+    void* restrict buffer,
+    isize size,
+    const char* restrict mode
+) {
+    SCU_ASSERT(file != nullptr);
+    SCU_ASSERT(buffer != nullptr);
+    SCU_ASSERT(size >= 1);
+    SCU_ASSERT(mode != nullptr);
+#ifdef _WIN32
+    *file = nullptr;
+    return SCU_ERROR_OPENING_FILE;
+#else
+    FILE* handle = fmemopen(buffer, (usize) size, mode);
+    if (handle == nullptr) {
+        *file = nullptr;
+        return SCU_ERROR_OPENING_FILE;
+    }
+    return scu_fwrap(file, handle);
+#endif
+}
+
+ScuError scu_fopen_dynamic(
+    ScuFile* restrict* restrict file,
+    char** restrict buffer,
+    isize* restrict size
+) {
+    SCU_ASSERT(file != nullptr);
+    SCU_ASSERT(buffer != nullptr);
+    SCU_ASSERT(size != nullptr);
+#ifdef _WIN32
+    *file = nullptr;
+    return SCU_ERROR_OPENING_FILE;
+#else
+    // The C library keeps updating the size through the pointer it is given,
+    // so it is passed directly. Accessing an `isize` through a pointer to its
+    // corresponding unsigned type is well-defined.
+    FILE* handle = open_memstream(buffer, (usize*) size);
+    if (handle == nullptr) {
+        *file = nullptr;
+        return SCU_ERROR_OPENING_FILE;
+    }
+    return scu_fwrap(file, handle);
+#endif
+}
+
+ScuError scu_fopen_memfd(ScuFile** file, const char* name) {
+    SCU_ASSERT(file != nullptr);
+    SCU_ASSERT(name != nullptr);
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+    int fd = memfd_create(name, MFD_CLOEXEC);
+    if (fd < 0) {
+        *file = nullptr;
+        return SCU_ERROR_OPENING_FILE;
+    }
+    FILE* handle = fdopen(fd, "wb+");
+    if (handle == nullptr) {
+        close(fd);
+        *file = nullptr;
+        return SCU_ERROR_OPENING_FILE;
+    }
+    return scu_fwrap(file, handle);
+#else
+    return scu_fopentmp(file);
+#endif
+}
+
 ScuError scu_freopen(
     ScuFile* restrict file,
     const char* restrict name,
@@ -150,6 +330,10 @@ ScuError scu_fclose(ScuFile* file) {
     SCU_ASSERT(file->handle != nullptr);
     int result = fclose(file->handle);
     file->handle = nullptr;
+    // The buffer may only be released after the file stream has been closed,
+    // which flushes any pending output from it.
+    scu_free(file->buffer);
+    file->buffer = nullptr;
     scu_free(file);
     return (result == EOF) ? SCU_ERROR_CLOSING_FILE : SCU_ERROR_NONE;
 }
@@ -166,6 +350,64 @@ ScuError scu_fflush(ScuFile* file) {
         : SCU_ERROR_NONE;
 }
 
+ScuError scu_fsetbuf(ScuFile* file, isize size, ScuBufferMode mode) {
+    SCU_ASSERT(file != nullptr);
+    SCU_ASSERT(file->handle != nullptr);
+    SCU_ASSERT(
+        (mode == SCU_BUFFER_MODE_FULL)
+            || (mode == SCU_BUFFER_MODE_LINE)
+            || (mode == SCU_BUFFER_MODE_NONE)
+    );
+    if (mode == SCU_BUFFER_MODE_NONE) {
+        if (setvbuf(file->handle, nullptr, _IONBF, 0) != 0) {
+            return SCU_ERROR_OUT_OF_MEMORY;
+        }
+        scu_free(file->buffer);
+        file->buffer = nullptr;
+        return SCU_ERROR_NONE;
+    }
+    SCU_ASSERT(size >= 1);
+    // The C library is free to ignore the size if it allocates the buffer
+    // itself, so the buffer is allocated explicitly.
+    char* buffer = scu_malloc(size * SCU_SIZEOF(char));
+    if (buffer == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    int result = setvbuf(
+        file->handle,
+        buffer,
+        (mode == SCU_BUFFER_MODE_FULL) ? _IOFBF : _IOLBF,
+        (usize) size
+    );
+    if (result != 0) {
+        scu_free(buffer);
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    scu_free(file->buffer);
+    file->buffer = buffer;
+    return SCU_ERROR_NONE;
+}
+
+void scu_flock(ScuFile* file) {
+    SCU_ASSERT(file != nullptr);
+    SCU_ASSERT(file->handle != nullptr);
+#ifdef _WIN32
+    _lock_file(file->handle);
+#else
+    flockfile(file->handle);
+#endif
+}
+
+void scu_funlock(ScuFile* file) {
+    SCU_ASSERT(file != nullptr);
+    SCU_ASSERT(file->handle != nullptr);
+#ifdef _WIN32
+    _unlock_file(file->handle);
+#else
+    funlockfile(file->handle);
+#endif
+}
+
 ScuError scu_fremove(const char* name) {
     SCU_ASSERT(name != nullptr);
     return (remove(name) != 0) ? SCU_ERROR_REMOVING_FILE : SCU_ERROR_NONE;
@@ -179,6 +421,456 @@ ScuError scu_frename(const char* oldName, const char* newName) {
         : SCU_ERROR_NONE;
 }
 
+/**
+ * @brief Reads from a file stream at a specified offset, bypassing its buffer
+ * and without affecting its file position indicator.
+ *
+ * @param[in]  handle The file stream to read from.
+ * @param[out] buffer The buffer to read into.
+ * @param[in]  count  The maximum number of bytes to read.
+ * @param[in]  offset The offset within the file to start reading at.
+ * @return The number of bytes read, which is zero at the end of the file, or
+ * `-1` if an error occurred.
+ */
+static isize scu_pread(FILE* handle, void* buffer, isize count, isize offset) {
+#ifdef _WIN32
+    HANDLE file = (HANDLE) _get_osfhandle(_fileno(handle));
+    // Positional reads still move the file pointer of synchronous handles,
+    // which the C library relies on, so it is restored afterwards. This
+    // requires the file stream to be locked in the meantime.
+    _lock_file(handle);
+    LARGE_INTEGER position;
+    LARGE_INTEGER zero = { .QuadPart = 0 };
+    if (!SetFilePointerEx(file, zero, &position, FILE_CURRENT)) {
+        _unlock_file(handle);
+        return -1;
+    }
+    OVERLAPPED overlapped = {
+        .Offset = (DWORD) offset,
+        .OffsetHigh = (DWORD) ((u64) offset >> 32)
+    };
+    DWORD transferred;
+    BOOL success = ReadFile(
+        file,
+        buffer,
+        (DWORD) SCU_MIN(count, (isize) INT32_MAX),
+        &transferred,
+        &overlapped
+    );
+    DWORD error = GetLastError();
+    SetFilePointerEx(file, position, nullptr, FILE_BEGIN);
+    _unlock_file(handle);
+    if (!success) {
+        return (error == ERROR_HANDLE_EOF) ? 0 : -1;
+    }
+    return (isize) transferred;
+#else
+    while (true) {
+        isize transferred = pread(
+            fileno(handle),
+            buffer,
+            (usize) count,
+            (off_t) offset
+        );
+        if ((transferred >= 0) || (errno != EINTR)) {
+            return transferred;
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Writes to a file stream at a specified offset, bypassing its buffer
+ * and without affecting its file position indicator.
+ *
+ * @param[in] handle The file stream to write to.
+ * @param[in] buffer The buffer to write from.
+ * @param[in] count  The maximum number of bytes to write.
+ * @param[in] offset The offset within the file to start writing at.
+ * @return The number of bytes written, or `-1` if an error occurred.
+ */
+static isize scu_pwrite(
+    FILE* handle,
+    const void* buffer,
+    isize count,
+    isize offset
+) {
+#ifdef _WIN32
+    HANDLE file = (HANDLE) _get_osfhandle(_fileno(handle));
+    // See `scu_pread()`.
+    _lock_file(handle);
+    LARGE_INTEGER position;
+    LARGE_INTEGER zero = { .QuadPart = 0 };
+    if (!SetFilePointerEx(file, zero, &position, FILE_CURRENT)) {
+        _unlock_file(handle);
+        return -1;
+    }
+    OVERLAPPED overlapped = {
+        .Offset = (DWORD) offset,
+        .OffsetHigh = (DWORD) ((u64) offset >> 32)
+    };
+    DWORD transferred;
+    BOOL success = WriteFile(
+        file,
+        buffer,
+        (DWORD) SCU_MIN(count, (isize) INT32_MAX),
+        &transferred,
+        &overlapped
+    );
+    SetFilePointerEx(file, position, nullptr, FILE_BEGIN);
+    _unlock_file(handle);
+    return success ? (isize) transferred : -1;
+#else
+    while (true) {
+        isize transferred = pwrite(
+            fileno(handle),
+            buffer,
+            (usize) count,
+            (off_t) offset
+        );
+        if ((transferred >= 0) || (errno != EINTR)) {
+            return transferred;
+        }
+    }
+#endif
+}
+
+#ifdef __linux__
+    /**
+     * @brief Determines whether an error reported by a kernel copy method
+     * indicates that the method is not supported for the file descriptors
+     * involved, so the next method should be tried.
+     *
+     * @param[in] error The error number to examine.
+     * @return `true` if the method is not supported, otherwise `false`.
+     */
+    static bool scu_is_unsupported_copy(int error) {
+        return (error == ENOSYS)
+            || (error == EXDEV)
+            || (error == EINVAL)
+            || (error == EBADF)
+            || (error == EOPNOTSUPP);
+    }
+
+    /**
+     * @brief Copies data from one file descriptor to another by splicing it
+     * through a pipe.
+     *
+     * @param[in]      in      The file descriptor to copy from.
+     * @param[in]      out     The file descriptor to copy to.
+     * @param[in, out] offset  The offset within `in` to copy from, which is
+     *                         advanced by the number of bytes copied.
+     * @param[in]      count   The maximum number of bytes to copy.
+     * @param[in]      pipeFds The read and write end of the pipe.
+     * @return The number of bytes copied, which is zero at the end of the file,
+     * or `-1` if an error occurred.
+     */
+    static isize scu_splice(
+        int in,
+        int out,
+        off_t* offset,
+        usize count,
+        const int pipeFds[static 2]
+    ) {
+        isize spliced = splice(
+            in,
+            offset,
+            pipeFds[1],
+            nullptr,
+            count,
+            SPLICE_F_MOVE
+        );
+        if (spliced <= 0) {
+            return spliced;
+        }
+        isize drained = 0;
+        while (drained < spliced) {
+            isize moved = splice(
+                pipeFds[0],
+                nullptr,
+                out,
+                nullptr,
+                (usize) (spliced - drained),
+                SPLICE_F_MOVE
+            );
+            if ((moved < 0) && (errno == EINTR)) {
+                continue;
+            }
+            if (moved <= 0) {
+                int error = (moved == 0) ? EIO : errno;
+                // Discard the bytes left in the pipe and rewind the offset, so
+                // they can be copied again by another method.
+                *offset -= spliced - drained;
+                byte discarded[SCU_CHUNK_SIZE];
+                isize remaining = spliced - drained;
+                while (remaining > 0) {
+                    isize discardedCount = read(
+                        pipeFds[0],
+                        discarded,
+                        (usize) SCU_MIN(remaining, SCU_CHUNK_SIZE)
+                    );
+                    if (discardedCount > 0) {
+                        remaining -= discardedCount;
+                    }
+                    else if (errno != EINTR) {
+                        break;
+                    }
+                }
+                if (drained > 0) {
+                    return drained;
+                }
+                errno = error;
+                return -1;
+            }
+            drained += moved;
+        }
+        return spliced;
+    }
+
+    /**
+     * @brief Copies data from one file descriptor to another within the kernel
+     * using a specified method.
+     *
+     * @param[in]      method  The method to use.
+     * @param[in]      in      The file descriptor to copy from.
+     * @param[in]      out     The file descriptor to copy to.
+     * @param[in, out] offset  The offset within `in` to copy from, which is
+     *                         advanced by the number of bytes copied.
+     * @param[in]      count   The maximum number of bytes to copy.
+     * @param[in]      pipeFds The pipe used by `SCU_COPY_METHOD_SPLICE`.
+     * @return The number of bytes copied, which is zero at the end of the file,
+     * or `-1` if an error occurred.
+     */
+    static isize scu_copy_chunk(
+        ScuCopyMethod method,
+        int in,
+        int out,
+        off_t* offset,
+        usize count,
+        const int pipeFds[static 2]
+    ) {
+        SCU_ASSERT(method != SCU_COPY_METHOD_NONE);
+        if (method == SCU_COPY_METHOD_COPY_FILE_RANGE) {
+            return copy_file_range(in, offset, out, nullptr, count, 0);
+        }
+        if (method == SCU_COPY_METHOD_SENDFILE) {
+            return sendfile(out, in, offset, count);
+        }
+        return scu_splice(in, out, offset, count, pipeFds);
+    }
+
+    /**
+     * @brief Copies as much data as possible from one file stream to another
+     * within the kernel.
+     *
+     * @note The methods are tried in order, moving on to the next one as soon
+     * as a method turns out to be unsupported. The file descriptor of the
+     * destination is positioned at the file position indicator of its file
+     * stream before copying, and the file stream is repositioned afterwards.
+     *
+     * @param[in, out] source      The file stream to copy from.
+     * @param[in, out] destination The file stream to copy to, which must have
+     *                             been flushed.
+     * @param[in, out] offset      The offset within `source` to copy from,
+     *                             which is advanced by the number of bytes
+     *                             copied.
+     * @param[in, out] remaining   The number of bytes left to copy, which is
+     *                             decreased by the number of bytes copied, or
+     *                             set to zero if the end of `source` has been
+     *                             reached.
+     * @return `SCU_ERROR_WRITING_FILE` if an error occurred while copying, or
+     * `SCU_ERROR_NONE` otherwise (even if no method is supported).
+     */
+    static ScuError scu_fcopy_kernel(
+        ScuFile* restrict source,
+        ScuFile* restrict destination,
+        isize* restrict offset,
+        isize* restrict remaining
+    ) {
+        int in = fileno(source->handle);
+        int out = fileno(destination->handle);
+        off_t position = ftello(destination->handle);
+        if (position >= 0) {
+            lseek(out, position, SEEK_SET);
+        }
+        off_t inOffset = (off_t) *offset;
+        ScuCopyMethod method = SCU_COPY_METHOD_COPY_FILE_RANGE;
+        int pipeFds[2] = { -1, -1 };
+        ScuError error = SCU_ERROR_NONE;
+        while ((*remaining > 0) && (method != SCU_COPY_METHOD_NONE)) {
+            if (
+                (method == SCU_COPY_METHOD_SPLICE)
+                && (pipeFds[0] < 0)
+                && (pipe(pipeFds) != 0)
+            ) {
+                method = SCU_COPY_METHOD_NONE;
+                continue;
+            }
+            isize copied = scu_copy_chunk(
+                method,
+                in,
+                out,
+                &inOffset,
+                (usize) SCU_MIN(*remaining, SCU_COPY_CHUNK_SIZE),
+                pipeFds
+            );
+            if (copied < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (!scu_is_unsupported_copy(errno)) {
+                    error = SCU_ERROR_WRITING_FILE;
+                    break;
+                }
+                method = (ScuCopyMethod) (method + 1);
+                continue;
+            }
+            if (copied == 0) {
+                *remaining = 0;
+                break;
+            }
+            *remaining -= copied;
+        }
+        if (pipeFds[0] >= 0) {
+            close(pipeFds[0]);
+            close(pipeFds[1]);
+        }
+        *offset = (isize) inOffset;
+        position = lseek(out, 0, SEEK_CUR);
+        if (position >= 0) {
+            fseeko(destination->handle, position, SEEK_SET);
+        }
+        return error;
+    }
+#endif
+
+/**
+ * @brief Copies data from one file stream to another through a buffer in user
+ * space.
+ *
+ * @param[in, out] source      The file stream to copy from.
+ * @param[in, out] destination The file stream to copy to.
+ * @param[in]      offset      The offset within `source` to copy from.
+ * @param[in]      remaining   The number of bytes left to copy.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * `SCU_ERROR_READING_FILE` or `SCU_ERROR_WRITING_FILE` if an error occurred
+ * while copying, or `SCU_ERROR_NONE` on success.
+ */
+static ScuError scu_fcopy_blocks(
+    ScuFile* restrict source,
+    ScuFile* restrict destination,
+    isize offset,
+    isize remaining
+) {
+    if (remaining == 0) {
+        return SCU_ERROR_NONE;
+    }
+    byte* buffer = scu_malloc(SCU_COPY_BLOCK_SIZE * SCU_SIZEOF(byte));
+    if (buffer == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    ScuError error = SCU_ERROR_NONE;
+    while (remaining > 0) {
+        isize count = scu_pread(
+            source->handle,
+            buffer,
+            SCU_MIN(remaining, SCU_COPY_BLOCK_SIZE),
+            offset
+        );
+        if (count < 0) {
+            error = SCU_ERROR_READING_FILE;
+            break;
+        }
+        if (count == 0) {
+            break;
+        }
+        // Blocks of this size bypass the buffer of the destination.
+        if (scu_fwrite_unlocked(destination, buffer, count, 1) != count) {
+            error = SCU_ERROR_WRITING_FILE;
+            break;
+        }
+        offset += count;
+        remaining -= count;
+    }
+    scu_free(buffer);
+    return error;
+}
+
+ScuError scu_fcopy(
+    ScuFile* restrict source,
+    ScuFile* restrict destination,
+    isize offset,
+    isize count
+) {
+    SCU_ASSERT(source != nullptr);
+    SCU_ASSERT(source->handle != nullptr);
+    SCU_ASSERT(destination != nullptr);
+    SCU_ASSERT(destination->handle != nullptr);
+    SCU_ASSERT(offset >= 0);
+    SCU_ASSERT(count >= -1);
+    if (fflush(source->handle) == EOF) {
+        return SCU_ERROR_FLUSHING_FILE;
+    }
+    scu_flock(destination);
+    ScuError error = (fflush(destination->handle) == EOF)
+        ? SCU_ERROR_FLUSHING_FILE
+        : SCU_ERROR_NONE;
+    isize remaining = (count < 0) ? ISIZE_MAX : count;
+#ifdef __linux__
+    if (error == SCU_ERROR_NONE) {
+        error = scu_fcopy_kernel(source, destination, &offset, &remaining);
+    }
+#endif
+    if (error == SCU_ERROR_NONE) {
+        error = scu_fcopy_blocks(source, destination, offset, remaining);
+    }
+    scu_funlock(destination);
+    return error;
+}
+
+ScuError scu_fcopy_path(
+    const char* restrict sourceName,
+    const char* restrict destinationName
+) {
+    SCU_ASSERT(sourceName != nullptr);
+    SCU_ASSERT(destinationName != nullptr);
+#ifdef _WIN32
+    if (!CopyFileA(sourceName, destinationName, FALSE)) {
+        DWORD error = GetLastError();
+        return (
+            (error == ERROR_FILE_NOT_FOUND)
+                || (error == ERROR_PATH_NOT_FOUND)
+                || (error == ERROR_ACCESS_DENIED)
+        )
+            ? SCU_ERROR_OPENING_FILE
+            : SCU_ERROR_WRITING_FILE;
+    }
+    return SCU_ERROR_NONE;
+#else
+    ScuFile* source;
+    ScuError error = scu_fopen(&source, sourceName, "rb");
+    if (error != SCU_ERROR_NONE) {
+        return error;
+    }
+    ScuFile* destination;
+    error = scu_fopen(&destination, destinationName, "wb");
+    if (error != SCU_ERROR_NONE) {
+        (void) scu_fclose(source);
+        return error;
+    }
+    error = scu_fcopy(source, destination, 0, -1);
+    ScuError closeError = scu_fclose(destination);
+    if (error == SCU_ERROR_NONE) {
+        error = closeError;
+    }
+    closeError = scu_fclose(source);
+    if (error == SCU_ERROR_NONE) {
+        error = closeError;
+    }
+    return error;
+#endif
+}
+
 isize scu_fread(
     ScuFile* restrict file,
     void* restrict buffer,
@@ -197,6 +889,42 @@ isize scu_fread(
     return (isize) fread(buffer, (usize) size, (usize) count, file->handle);
 }
 
+isize scu_fread_unlocked(
+    ScuFile* restrict file,
+    void* restrict buffer,
+    isize count,
+    isize size
+) {
+    SCU_ASSERT(file != nullptr);
+    SCU_ASSERT(file->handle != nullptr);
+    SCU_ASSERT(count >= 0);
+    SCU_ASSERT(size >= 0);
+    if ((count == 0) || (size == 0)) {
+        return 0;
+    }
+    SCU_ASSERT(buffer != nullptr);
+    SCU_ASSERT(size <= (INT64_MAX / count));
+#if defined(_WIN32)
+    return (isize) _fread_nolock(
+        buffer,
+        (usize) size,
+        (usize) count,
+        file->handle
+    );
+#elif defined(__GLIBC__)
+    // The parentheses suppress the macro version of glibc, which triggers
+    // conversion warnings.
+    return (isize) (fread_unlocked)(
+        buffer,
+        (usize) size,
+        (usize) count,
+        file->handle
+    );
+#else
+    return (isize) fread(buffer, (usize) size, (usize) count, file->handle);
+#endif
+}
+
 isize scu_read(void* buffer, isize count, isize size) {
     return scu_fread(SCU_STDIN, buffer, count, size);
 }
@@ -219,10 +947,293 @@ isize scu_fwrite(
     return (isize) fwrite(buffer, (usize) size, (usize) count, file->handle);
 }
 
+isize scu_fwrite_unlocked(
+    ScuFile* restrict file,
+    const void* restrict buffer,
+    isize count,
+    isize size
+) {
+    SCU_ASSERT(file != nullptr);
+    SCU_ASSERT(file->handle != nullptr);
+    SCU_ASSERT(count >= 0);
+    SCU_ASSERT(size >= 0);
+    if ((count == 0) || (size == 0)) {
+        return 0;
+    }
+    SCU_ASSERT(buffer != nullptr);
+    SCU_ASSERT(size <= (INT64_MAX / count));
+#if defined(_WIN32)
+    return (isize) _fwrite_nolock(
+        buffer,
+        (usize) size,
+        (usize) count,
+        file->handle
+    );
+#elif defined(__GLIBC__)
+    // See `scu_fread_unlocked()` for the parentheses.
+    return (isize) (fwrite_unlocked)(
+        buffer,
+        (usize) size,
+        (usize) count,
+        file->handle
+    );
+#else
+    return (isize) fwrite(buffer, (usize) size, (usize) count, file->handle);
+#endif
+}
+
 isize scu_write(const void* buffer, isize count, isize size) {
     return scu_fwrite(SCU_STDOUT, buffer, count, size);
 }
 
+/**
+ * @brief Transfers data between a locked file stream and multiple buffers, one
+ * buffer after another through the buffer of the file stream.
+ *
+ * @param[in, out] file    The file stream to transfer data from or to.
+ * @param[in]      iov     The buffers to transfer.
+ * @param[in]      count   The number of buffers.
+ * @param[in]      isWrite Whether to write to the file stream instead of
+ *                         reading from it.
+ * @return The number of bytes transferred.
+ */
+static isize scu_ftransferv_buffered(
+    ScuFile* restrict file,
+    const ScuIoVec* restrict iov,
+    isize count,
+    bool isWrite
+) {
+    isize total = 0;
+    for (isize i = 0; i < count; i++) {
+        isize transferred = isWrite
+            ? scu_fwrite_unlocked(file, iov[i].buffer, iov[i].count, 1)
+            : scu_fread_unlocked(file, iov[i].buffer, iov[i].count, 1);
+        total += transferred;
+        if (transferred < iov[i].count) {
+            break;
+        }
+    }
+    return total;
+}
+
+#ifndef _WIN32
+    /**
+     * @brief Transfers data between a file descriptor and multiple buffers
+     * using vectored system calls.
+     *
+     * @note Partial transfers are continued until all buffers have been
+     * transferred, the end of the file is reached, or an error occurs.
+     *
+     * @param[in] fd      The file descriptor to transfer data from or to.
+     * @param[in] iov     The buffers to transfer.
+     * @param[in] count   The number of buffers.
+     * @param[in] isWrite Whether to write to the file descriptor instead of
+     *                    reading from it.
+     * @return The number of bytes transferred.
+     */
+    static isize scu_transferv(
+        int fd,
+        const ScuIoVec* iov,
+        isize count,
+        bool isWrite
+    ) {
+        struct iovec vecs[SCU_IOV_BATCH];
+        isize total = 0;
+        isize index = 0;
+        // The number of bytes of `iov[index]` already transferred.
+        isize skip = 0;
+        while (index < count) {
+            isize n = SCU_MIN(count - index, SCU_IOV_BATCH);
+            for (isize i = 0; i < n; i++) {
+                isize offset = (i == 0) ? skip : 0;
+                vecs[i].iov_base = (byte*) iov[index + i].buffer + offset;
+                vecs[i].iov_len = (usize) (iov[index + i].count - offset);
+            }
+            isize transferred = isWrite
+                ? writev(fd, vecs, (int) n)
+                : readv(fd, vecs, (int) n);
+            if (transferred < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            if (transferred == 0) {
+                break;
+            }
+            total += transferred;
+            while (
+                (index < count)
+                && (transferred >= iov[index].count - skip)
+            ) {
+                transferred -= iov[index].count - skip;
+                skip = 0;
+                index++;
+            }
+            skip += transferred;
+        }
+        return total;
+    }
+
+    /**
+     * @brief Transfers data between a file stream and multiple buffers using
+     * vectored system calls on its file descriptor.
+     *
+     * @note File streams that cannot be repositioned are read using
+     * `scu_ftransferv_buffered()` instead.
+     *
+     * @param[in, out] file    The file stream to transfer data from or to.
+     * @param[in]      iov     The buffers to transfer.
+     * @param[in]      count   The number of buffers.
+     * @param[in]      isWrite Whether to write to the file stream instead of
+     *                         reading from it.
+     * @return The number of bytes transferred.
+     */
+    static isize scu_ftransferv(
+        ScuFile* restrict file,
+        const ScuIoVec* restrict iov,
+        isize count,
+        bool isWrite
+    ) {
+        int fd = fileno(file->handle);
+        flockfile(file->handle);
+        // The read-ahead of a file stream that cannot be repositioned (e.g., a
+        // pipe) cannot be handed back to the file descriptor, so such a file
+        // stream is read through its buffer instead.
+        off_t position = ftello(file->handle);
+        if ((position < 0) && !isWrite) {
+            isize transferred = scu_ftransferv_buffered(
+                file,
+                iov,
+                count,
+                isWrite
+            );
+            funlockfile(file->handle);
+            return transferred;
+        }
+        // Pending output must reach the file first. If that fails, the error
+        // indicator of the file stream is set, and nothing is transferred.
+        if (fflush(file->handle) == EOF) {
+            funlockfile(file->handle);
+            return 0;
+        }
+        // Afterwards, the position of the file descriptor is aligned with the
+        // logical position of the file stream, which may differ because of
+        // read-ahead.
+        if (position >= 0) {
+            lseek(fd, position, SEEK_SET);
+        }
+        isize transferred = scu_transferv(fd, iov, count, isWrite);
+        // Conversely, the file stream must continue where the system calls
+        // left off.
+        position = lseek(fd, 0, SEEK_CUR);
+        if (position >= 0) {
+            fseeko(file->handle, position, SEEK_SET);
+        }
+        funlockfile(file->handle);
+        return transferred;
+    }
+#endif
+
+isize scu_freadv(
+    ScuFile* restrict file,
+    const ScuIoVec* restrict iov,
+    isize count
+) {
+    SCU_ASSERT(file != nullptr);
+    SCU_ASSERT(file->handle != nullptr);
+    SCU_ASSERT(count >= 0);
+    SCU_ASSERT((count == 0) || (iov != nullptr));
+#ifdef _WIN32
+    // Windows only supports vectored I/O for unbuffered, page-aligned
+    // transfers, so the buffers are read one after another.
+    _lock_file(file->handle);
+    isize total = scu_ftransferv_buffered(file, iov, count, false);
+    _unlock_file(file->handle);
+    return total;
+#else
+    return scu_ftransferv(file, iov, count, false);
+#endif
+}
+
+isize scu_fwritev(
+    ScuFile* restrict file,
+    const ScuIoVec* restrict iov,
+    isize count
+) {
+    SCU_ASSERT(file != nullptr);
+    SCU_ASSERT(file->handle != nullptr);
+    SCU_ASSERT(count >= 0);
+    SCU_ASSERT((count == 0) || (iov != nullptr));
+#ifdef _WIN32
+    // See `scu_freadv()`.
+    _lock_file(file->handle);
+    isize total = scu_ftransferv_buffered(file, iov, count, true);
+    _unlock_file(file->handle);
+    return total;
+#else
+    return scu_ftransferv(file, iov, count, true);
+#endif
+}
+
+isize scu_fread_at(
+    ScuFile* restrict file,
+    void* restrict buffer,
+    isize count,
+    isize offset
+) {
+    SCU_ASSERT(file != nullptr);
+    SCU_ASSERT(file->handle != nullptr);
+    SCU_ASSERT(count >= 0);
+    SCU_ASSERT(offset >= 0);
+    SCU_ASSERT((count == 0) || (buffer != nullptr));
+    byte* bytes = buffer;
+    isize total = 0;
+    // Short reads are continued, so that fewer bytes than requested are only
+    // returned at the end of the file or on error.
+    while (total < count) {
+        isize transferred = scu_pread(
+            file->handle,
+            &bytes[total],
+            count - total,
+            offset + total
+        );
+        if (transferred <= 0) {
+            break;
+        }
+        total += transferred;
+    }
+    return total;
+}
+
+isize scu_fwrite_at(
+    ScuFile* restrict file,
+    const void* restrict buffer,
+    isize count,
+    isize offset
+) {
+    SCU_ASSERT(file != nullptr);
+    SCU_ASSERT(file->handle != nullptr);
+    SCU_ASSERT(count >= 0);
+    SCU_ASSERT(offset >= 0);
+    SCU_ASSERT((count == 0) || (buffer != nullptr));
+    const byte* bytes = buffer;
+    isize total = 0;
+    while (total < count) {
+        isize transferred = scu_pwrite(
+            file->handle,
+            &bytes[total],
+            count - total,
+            offset + total
+        );
+        if (transferred <= 0) {
+            break;
+        }
+        total += transferred;
+    }
+    return total;
+}
+
 ScuError scu_freadc(ScuFile* restrict file, char* restrict c) {
     SCU_ASSERT(file != nullptr);
     SCU_ASSERT(file->handle != nullptr);
@@ -238,6 +1249,25 @@ ScuError scu_freadc(ScuFile* restrict file, char* restrict c) {
     return SCU_ERROR_NONE;
 }
 
+ScuError scu_freadc_unlocked(ScuFile* restrict file, char* restrict c) {
+    SCU_ASSERT(file != nullptr);
+    SCU_ASSERT(file->handle != nullptr);
+    SCU_ASSERT(c != nullptr);
+#ifdef _WIN32
+    int result = _getc_nolock(file->handle);
+#else
+    int result = getc_unlocked(file->handle);
+#endif
+    if (result == EOF) {
+        *c = '\0';
+        return feof(file->handle)
+            ? SCU_ERROR_END_OF_FILE
+            : SCU_ERROR_READING_FILE;
+    }
+    *c = (char) result;
+    return SCU_ERROR_NONE;
+}
+
 ScuError scu_readc(char* c) {
     return scu_freadc(SCU_STDIN, c);
 }
@@ -250,6 +1280,17 @@ ScuError scu_fwritec(ScuFile* file, char c) {
         : SCU_ERROR_NONE;
 }
 
+ScuError scu_fwritec_unlocked(ScuFile* file, char c) {
+    SCU_ASSERT(file != nullptr);
+    SCU_ASSERT(file->handle != nullptr);
+#ifdef _WIN32
+    int result = _putc_nolock(c, file->handle);
+#else
+    int result = putc_unlocked(c, file->handle);
+#endif
+    return (result == EOF) ? SCU_ERROR_WRITING_FILE : SCU_ERROR_NONE;
+}
+
 ScuError scu_writec(char c) {
     return scu_fwritec(SCU_STDOUT, c);
 }
@@ -732,4 +1773,315 @@ bool scu_ferror(ScuFile* file) {
     SCU_ASSERT(file != nullptr);
     SCU_ASSERT(file->handle != nullptr);
     return ferror(file->handle) != 0;
+}
+
+int scu_fileno(ScuFile* file) {
+    SCU_ASSERT(file != nullptr);
+    SCU_ASSERT(file->handle != nullptr);
+#ifdef _WIN32
+    return _fileno(file->handle);
+#else
+    return fileno(file->handle);
+#endif
+}
+
+#ifdef _WIN32
+    /**
+     * @brief Maps a range of an opened file into memory.
+     *
+     * @param[in, out] map    The mapped file to initialize.
+     * @param[in]      handle The handle of the file to map.
+     * @param[in]      offset The offset of the first byte to map.
+     * @param[in]      size   The number of bytes to map, or `-1` to map all
+     *                        bytes up to the end of the file.
+     * @return `SCU_ERROR_MAPPING_FILE` if the range does not lie within the
+     * file or could not be mapped into memory, or `SCU_ERROR_NONE` on success.
+     */
+    static ScuError scu_map_handle(
+        ScuMappedFile* map,
+        HANDLE handle,
+        isize offset,
+        isize size
+    ) {
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(handle, &fileSize)) {
+            return SCU_ERROR_MAPPING_FILE;
+        }
+        if (size < 0) {
+            size = fileSize.QuadPart - offset;
+        }
+        if (
+            (offset > fileSize.QuadPart)
+                || (size > fileSize.QuadPart - offset)
+        ) {
+            return SCU_ERROR_MAPPING_FILE;
+        }
+        map->size = size;
+        if (size == 0) {
+            map->base = nullptr;
+            map->length = 0;
+            map->data = nullptr;
+            return SCU_ERROR_NONE;
+        }
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        isize padding = offset % (isize) info.dwAllocationGranularity;
+        map->length = size + padding;
+        bool isWritable = map->mode == SCU_MAP_MODE_READ_WRITE;
+        HANDLE mapping = CreateFileMappingA(
+            handle,
+            nullptr,
+            isWritable ? PAGE_READWRITE : PAGE_READONLY,
+            0,
+            0,
+            nullptr
+        );
+        if (mapping == nullptr) {
+            return SCU_ERROR_MAPPING_FILE;
+        }
+        u64 start = (u64) (offset - padding);
+        map->base = MapViewOfFile(
+            mapping,
+            isWritable ? FILE_MAP_WRITE : FILE_MAP_READ,
+            (DWORD) (start >> 32),
+            (DWORD) start,
+            (SIZE_T) map->length
+        );
+        // The view keeps the mapping alive, so its handle can be closed.
+        CloseHandle(mapping);
+        if (map->base == nullptr) {
+            return SCU_ERROR_MAPPING_FILE;
+        }
+        map->data = (byte*) map->base + padding;
+        return SCU_ERROR_NONE;
+    }
+#else
+    /**
+     * @brief Maps a range of an opened file into memory.
+     *
+     * @param[in, out] map    The mapped file to initialize.
+     * @param[in]      fd     The file descriptor of the file to map.
+     * @param[in]      offset The offset of the first byte to map.
+     * @param[in]      size   The number of bytes to map, or `-1` to map all
+     *                        bytes up to the end of the file.
+     * @return `SCU_ERROR_MAPPING_FILE` if the range does not lie within the
+     * file or could not be mapped into memory, or `SCU_ERROR_NONE` on success.
+     */
+    static ScuError scu_map_descriptor(
+        ScuMappedFile* map,
+        int fd,
+        isize offset,
+        isize size
+    ) {
+        struct stat status;
+        if (fstat(fd, &status) != 0) {
+            return SCU_ERROR_MAPPING_FILE;
+        }
+        isize fileSize = (isize) status.st_size;
+        if (size < 0) {
+            size = fileSize - offset;
+        }
+        if ((offset > fileSize) || (size > fileSize - offset)) {
+            return SCU_ERROR_MAPPING_FILE;
+        }
+        map->size = size;
+        if (size == 0) {
+            map->base = nullptr;
+            map->length = 0;
+            map->data = nullptr;
+            return SCU_ERROR_NONE;
+        }
+        isize padding = offset % (isize) sysconf(_SC_PAGESIZE);
+        map->length = size + padding;
+        void* base = mmap(
+            nullptr,
+            (usize) map->length,
+            (map->mode == SCU_MAP_MODE_READ_WRITE)
+                ? (PROT_READ | PROT_WRITE)
+                : PROT_READ,
+            MAP_SHARED,
+            fd,
+            (off_t) (offset - padding)
+        );
+        if (base == MAP_FAILED) {
+            map->base = nullptr;
+            return SCU_ERROR_MAPPING_FILE;
+        }
+        map->base = base;
+        map->data = (byte*) base + padding;
+        return SCU_ERROR_NONE;
+    }
+#endif
+
+/**
+ * @brief Maps a range of the file with a specified name into memory.
+ *
+ * @param[out] map    A pointer to the mapped file, or `nullptr` on failure.
+ * @param[in]  name   The name of the file to map.
+ * @param[in]  mode   The mode in which to map the file.
+ * @param[in]  offset The offset of the first byte to map.
+ * @param[in]  size   The number of bytes to map, or `-1` to map all bytes up
+ *                    to the end of the file.
+ * @return `SCU_ERROR_OPENING_FILE` if the file could not be opened,
+ * `SCU_ERROR_MAPPING_FILE` if the range does not lie within the file or could
+ * not be mapped into memory, `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory
+ * condition occurred, or `SCU_ERROR_NONE` on success.
+ */
+static ScuError scu_fmap_impl(
+    ScuMappedFile* restrict* restrict map,
+    const char* restrict name,
+    ScuMapMode mode,
+    isize offset,
+    isize size
+) {
+    SCU_ASSERT(map != nullptr);
+    SCU_ASSERT(name != nullptr);
+    SCU_ASSERT(
+        (mode == SCU_MAP_MODE_READ) || (mode == SCU_MAP_MODE_READ_WRITE)
+    );
+    *map = scu_malloc(SCU_SIZEOF(ScuMappedFile));
+    if (*map == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    (*map)->mode = mode;
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(
+        name,
+        (mode == SCU_MAP_MODE_READ_WRITE)
+            ? (GENERIC_READ | GENERIC_WRITE)
+            : GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    ScuError error = (handle == INVALID_HANDLE_VALUE)
+        ? SCU_ERROR_OPENING_FILE
+        : scu_map_handle(*map, handle, offset, size);
+    if ((error != SCU_ERROR_NONE) && (handle != INVALID_HANDLE_VALUE)) {
+        CloseHandle(handle);
+    }
+    (*map)->handle = handle;
+#else
+    int fd = open(name, (mode == SCU_MAP_MODE_READ_WRITE) ? O_RDWR : O_RDONLY);
+    ScuError error = (fd == -1)
+        ? SCU_ERROR_OPENING_FILE
+        : scu_map_descriptor(*map, fd, offset, size);
+    // The mapping remains valid after the file descriptor has been closed.
+    if (fd != -1) {
+        close(fd);
+    }
+#endif
+    if (error != SCU_ERROR_NONE) {
+        scu_free(*map);
+        *map = nullptr;
+    }
+    return error;
+}
+
+ScuError scu_fmap(
+    ScuMappedFile* restrict* restrict map,
+    const char* restrict name,
+    ScuMapMode mode
+) {
+    return scu_fmap_impl(map, name, mode, 0, -1);
+}
+
+ScuError scu_fmaprange(
+    ScuMappedFile* restrict* restrict map,
+    const char* restrict name,
+    ScuMapMode mode,
+    isize offset,
+    isize size
+) {
+    SCU_ASSERT(offset >= 0);
+    SCU_ASSERT(size >= 0);
+    return scu_fmap_impl(map, name, mode, offset, size);
+}
+
+void* scu_fmapdata(const ScuMappedFile* map) {
+    SCU_ASSERT(map != nullptr);
+    return map->data;
+}
+
+isize scu_fmapsize(const ScuMappedFile* map) {
+    SCU_ASSERT(map != nullptr);
+    return map->size;
+}
+
+void scu_fmadvise(ScuMappedFile* map, ScuMapAdvice advice) {
+    SCU_ASSERT(map != nullptr);
+    SCU_ASSERT(
+        (advice == SCU_MAP_ADVICE_NORMAL)
+            || (advice == SCU_MAP_ADVICE_SEQUENTIAL)
+            || (advice == SCU_MAP_ADVICE_RANDOM)
+            || (advice == SCU_MAP_ADVICE_WILL_NEED)
+            || (advice == SCU_MAP_ADVICE_HUGE_PAGE)
+    );
+#ifdef _WIN32
+    (void) advice;
+#else
+    if (map->base == nullptr) {
+        return;
+    }
+    usize length = (usize) map->length;
+    switch (advice) {
+        case SCU_MAP_ADVICE_NORMAL:
+            (void) posix_madvise(map->base, length, POSIX_MADV_NORMAL);
+            break;
+        case SCU_MAP_ADVICE_SEQUENTIAL:
+            (void) posix_madvise(map->base, length, POSIX_MADV_SEQUENTIAL);
+            break;
+        case SCU_MAP_ADVICE_RANDOM:
+            (void) posix_madvise(map->base, length, POSIX_MADV_RANDOM);
+            break;
+        case SCU_MAP_ADVICE_WILL_NEED:
+            (void) posix_madvise(map->base, length, POSIX_MADV_WILLNEED);
+            break;
+        case SCU_MAP_ADVICE_HUGE_PAGE:
+    #ifdef MADV_HUGEPAGE
+            (void) madvise(map->base, length, MADV_HUGEPAGE);
+    #endif
+            break;
+        default:
+            SCU_UNREACHABLE();
+    }
+#endif
+}
+
+ScuError scu_fmsync(ScuMappedFile* map) {
+    SCU_ASSERT(map != nullptr);
+    if ((map->mode == SCU_MAP_MODE_READ) || (map->base == nullptr)) {
+        return SCU_ERROR_NONE;
+    }
+#ifdef _WIN32
+    bool success = FlushViewOfFile(map->base, 0)
+        && FlushFileBuffers(map->handle);
+    return success ? SCU_ERROR_NONE : SCU_ERROR_FLUSHING_FILE;
+#else
+    return (msync(map->base, (usize) map->length, MS_SYNC) != 0)
+        ? SCU_ERROR_FLUSHING_FILE
+        : SCU_ERROR_NONE;
+#endif
+}
+
+ScuError scu_funmap(ScuMappedFile* map) {
+    SCU_ASSERT(map != nullptr);
+    bool success = true;
+    if (map->base != nullptr) {
+#ifdef _WIN32
+        success = UnmapViewOfFile(map->base);
+#else
+        success = munmap(map->base, (usize) map->length) == 0;
+#endif
+    }
+#ifdef _WIN32
+    success = CloseHandle(map->handle) && success;
+    map->handle = nullptr;
+#endif
+    map->base = nullptr;
+    map->data = nullptr;
+    scu_free(map);
+    return success ? SCU_ERROR_NONE : SCU_ERROR_CLOSING_FILE;
 }
\ No newline at end of file
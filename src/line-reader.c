@@ -0,0 +1,173 @@
+#define SCU_SHORT_ALIASES
+
+#include "scu/alloc.h"
+#include "scu/assert.h"
+#include "scu/line-reader.h"
+#include "scu/memory.h"
+
+/** @brief The default capacity of the buffer (in bytes). */
+static constexpr isize SCU_DEFAULT_CAPACITY = 1024 * 1024;
+
+/** @brief The factor used when growing the buffer. */
+static constexpr isize SCU_GROWTH_FACTOR = 2;
+
+struct ScuLineReader {
+
+    /** @brief The file stream to read from. */
+    ScuFile* file;
+
+    /** @brief The buffer holding the bytes read ahead. */
+    char* buffer;
+
+    /** @brief The capacity of the buffer (in bytes). */
+    isize capacity;
+
+    /** @brief The index of the first byte not yet returned in a line. */
+    isize start;
+
+    /** @brief The index one past the last byte read into the buffer. */
+    isize end;
+
+    /**
+     * @brief The number of bytes after `start` already known not to contain a
+     * newline, so they are not searched again after refilling the buffer.
+     */
+    isize scanned;
+
+    /** @brief Whether the end of the file stream has been reached. */
+    bool isEof;
+
+};
+
+[[nodiscard]]
+ScuLineReader* scu_line_reader_new(ScuFile* file) {
+    return scu_line_reader_new_with_capacity(file, SCU_DEFAULT_CAPACITY);
+}
+
+[[nodiscard]]
+ScuLineReader* scu_line_reader_new_with_capacity(
+    ScuFile* file,
+    isize capacity
+) {
+    SCU_ASSERT(file != nullptr);
+    SCU_ASSERT(capacity >= 1);
+    ScuLineReader* reader = scu_malloc(SCU_SIZEOF(ScuLineReader));
+    if (reader == nullptr) {
+        return nullptr;
+    }
+    reader->buffer = scu_malloc(capacity * SCU_SIZEOF(char));
+    if (reader->buffer == nullptr) {
+        scu_free(reader);
+        return nullptr;
+    }
+    reader->file = file;
+    reader->capacity = capacity;
+    reader->start = 0;
+    reader->end = 0;
+    reader->scanned = 0;
+    reader->isEof = false;
+    return reader;
+}
+
+/**
+ * @brief Reads more bytes from the file stream of a specified line reader.
+ *
+ * @note If the buffer is full, the bytes not yet returned are moved to its
+ * beginning first. If they already occupy the whole buffer, i.e., the current
+ * line does not fit, the buffer is grown instead.
+ *
+ * @param[in, out] reader The line reader to fill.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * `SCU_ERROR_READING_FILE` if an error occurred while reading from the file
+ * stream, or `SCU_ERROR_NONE` on success (even if the end of the file stream
+ * has been reached).
+ */
+static ScuError scu_line_reader_fill(ScuLineReader* reader) {
+    if (reader->end == reader->capacity) {
+        if (reader->start > 0) {
+            reader->end -= reader->start;
+            scu_memmove(
+                reader->buffer,
+                &reader->buffer[reader->start],
+                reader->end * SCU_SIZEOF(char)
+            );
+            reader->start = 0;
+        }
+        else {
+            isize newCapacity = reader->capacity * SCU_GROWTH_FACTOR;
+            char* newBuffer = scu_realloc(
+                reader->buffer,
+                newCapacity * SCU_SIZEOF(char)
+            );
+            if (newBuffer == nullptr) {
+                return SCU_ERROR_OUT_OF_MEMORY;
+            }
+            reader->buffer = newBuffer;
+            reader->capacity = newCapacity;
+        }
+    }
+    // Large reads bypass the buffer of the file stream and are performed
+    // directly into the buffer of the line reader.
+    isize count = scu_fread(
+        reader->file,
+        &reader->buffer[reader->end],
+        reader->capacity - reader->end,
+        SCU_SIZEOF(char)
+    );
+    if (count == 0) {
+        if (scu_ferror(reader->file)) {
+            return SCU_ERROR_READING_FILE;
+        }
+        reader->isEof = true;
+    }
+    reader->end += count;
+    return SCU_ERROR_NONE;
+}
+
+ScuError scu_line_reader_next(
+    ScuLineReader* restrict reader,
+    const char* restrict* restrict line,
+    isize* restrict length
+) {
+    SCU_ASSERT(reader != nullptr);
+    SCU_ASSERT(line != nullptr);
+    SCU_ASSERT(length != nullptr);
+    while (true) {
+        isize from = reader->start + reader->scanned;
+        const char* newline = scu_memchr(
+            &reader->buffer[from],
+            '\n',
+            reader->end - from
+        );
+        if (newline != nullptr) {
+            *line = &reader->buffer[reader->start];
+            *length = newline - *line;
+            reader->start += *length + 1;
+            reader->scanned = 0;
+            return SCU_ERROR_NONE;
+        }
+        reader->scanned = reader->end - reader->start;
+        if (reader->isEof) {
+            if (reader->start == reader->end) {
+                return SCU_ERROR_END_OF_FILE;
+            }
+            *line = &reader->buffer[reader->start];
+            *length = reader->end - reader->start;
+            reader->start = reader->end;
+            reader->scanned = 0;
+            return SCU_ERROR_NONE;
+        }
+        ScuError error = scu_line_reader_fill(reader);
+        if (error != SCU_ERROR_NONE) {
+            return error;
+        }
+    }
+}
+
+void scu_line_reader_free(ScuLineReader* reader) {
+    if (reader != nullptr) {
+        scu_free(reader->buffer);
+        reader->buffer = nullptr;
+        scu_free(reader);
+    }
+}
\ No newline at end of file
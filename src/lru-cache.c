@@ -0,0 +1,495 @@
+#define SCU_SHORT_ALIASES
+
+#include <stddef.h>
+#include "scu/alloc.h"
+#include "scu/assert.h"
+#include "scu/lru-cache.h"
+#include "scu/memory.h"
+#include "open-index.h"
+
+struct ScuLruCache {
+
+    /** @brief The size of each key (in bytes). */
+    isize keySize;
+
+    /** @brief The size of each value (in bytes). */
+    isize valueSize;
+
+    /** @brief The maximum number of entries. */
+    isize capacity;
+
+    /** @brief The current number of entries. */
+    isize count;
+
+    /** @brief The maximum total charge of all entries. */
+    isize maxCharge;
+
+    /** @brief The current total charge of all entries. */
+    isize charge;
+
+    /** @brief The most recently used entry, or `-1` if the cache is empty. */
+    isize head;
+
+    /** @brief The least recently used entry, or `-1` if the cache is empty. */
+    isize tail;
+
+    /** @brief The first unused entry, or `-1` if all entries are in use. */
+    isize freeHead;
+
+    /** @brief A function used for hashing keys. */
+    ScuHashFunc* hashFunc;
+
+    /** @brief A function called whenever an entry leaves the cache. */
+    ScuLruCacheEvictFunc* evictFunc;
+
+    /** @brief The context passed to `evictFunc`. */
+    void* evictContext;
+
+    /** @brief The statistics of the cache. */
+    ScuLruCacheStats stats;
+
+    /**
+     * @brief The previous (more recently used) entry of each entry.
+     *
+     * @note This and all following arrays point into a single dynamically
+     * allocated block of memory. All arrays except for `index`, `keys` and
+     * `values` have `capacity` entries.
+     */
+    isize* prev;
+
+    /**
+     * @brief The next (less recently used) entry of each entry.
+     *
+     * @note For unused entries, this is the next unused entry instead.
+     */
+    isize* next;
+
+    /** @brief The charge of each entry. */
+    isize* charges;
+
+    /** @brief The hash of the key of each entry. */
+    usize* hashes;
+
+    /**
+     * @brief An open addressing hash table mapping keys to their entries.
+     *
+     * @note The positions of the index are an array of `index.capacity`
+     * entry numbers within the same block of memory.
+     */
+    ScuOpenIndex index;
+
+    /** @brief The keys of the entries (`capacity * keySize` bytes). */
+    byte* keys;
+
+    /** @brief The values of the entries (`capacity * valueSize` bytes). */
+    byte* values;
+
+};
+
+/**
+ * @brief Rounds up a value to the next multiple of a specified alignment.
+ *
+ * @warning The behavior is undefined if `alignment` is not a power of two.
+ *
+ * @param[in] value     The value to round up.
+ * @param[in] alignment The required alignment.
+ * @return The smallest multiple of `alignment` greater than or equal to
+ * `value`.
+ */
+static inline isize scu_align_up(isize value, isize alignment) {
+    SCU_ASSERT(value >= 0);
+    SCU_ASSERT(alignment > 0);
+    SCU_ASSERT((alignment & (alignment - 1)) == 0);
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+[[nodiscard]]
+ScuLruCache* scu_lru_cache_new(
+    isize keySize,
+    isize valueSize,
+    isize capacity,
+    ScuHashFunc* hashFunc,
+    ScuEqualFunc* equalFunc
+) {
+    return scu_lru_cache_new_with_charge(
+        keySize,
+        valueSize,
+        capacity,
+        capacity,
+        hashFunc,
+        equalFunc
+    );
+}
+
+[[nodiscard]]
+ScuLruCache* scu_lru_cache_new_with_charge(
+    isize keySize,
+    isize valueSize,
+    isize capacity,
+    isize maxCharge,
+    ScuHashFunc* hashFunc,
+    ScuEqualFunc* equalFunc
+) {
+    SCU_ASSERT(keySize > 0);
+    SCU_ASSERT(valueSize > 0);
+    SCU_ASSERT(capacity > 0);
+    SCU_ASSERT(maxCharge > 0);
+    SCU_ASSERT(hashFunc != nullptr);
+    SCU_ASSERT(equalFunc != nullptr);
+    if (
+        (capacity > (ISIZE_MAX / 8 / SCU_SIZEOF(isize)))
+            || (capacity > (ISIZE_MAX / 4 / keySize))
+            || (capacity > (ISIZE_MAX / 4 / valueSize))
+    ) {
+        return nullptr;
+    }
+    ScuLruCache* cache = scu_malloc(SCU_SIZEOF(ScuLruCache));
+    if (cache == nullptr) {
+        return nullptr;
+    }
+    isize indexCapacity = scu_open_index_capacity_for(capacity);
+    isize entrySize = (3 * SCU_SIZEOF(isize)) + SCU_SIZEOF(usize);
+    isize keysOffset = scu_align_up(
+        (capacity * entrySize) + (indexCapacity * SCU_SIZEOF(isize)),
+        SCU_ALIGNOF(max_align_t)
+    );
+    isize valuesOffset = scu_align_up(
+        keysOffset + (capacity * keySize),
+        SCU_ALIGNOF(max_align_t)
+    );
+    byte* storage = scu_malloc(valuesOffset + (capacity * valueSize));
+    if (storage == nullptr) {
+        scu_free(cache);
+        return nullptr;
+    }
+    cache->keySize = keySize;
+    cache->valueSize = valueSize;
+    cache->capacity = capacity;
+    cache->maxCharge = maxCharge;
+    cache->hashFunc = hashFunc;
+    cache->evictFunc = nullptr;
+    cache->evictContext = nullptr;
+    cache->stats = (ScuLruCacheStats) { };
+    cache->prev = (isize*) (void*) storage;
+    cache->next = cache->prev + capacity;
+    cache->charges = cache->next + capacity;
+    cache->hashes = (usize*) (void*) (cache->charges + capacity);
+    cache->index = (ScuOpenIndex) {
+        .capacity = indexCapacity,
+        .positions = (isize*) (void*) (cache->hashes + capacity),
+        .hashes = cache->hashes,
+        .keys = storage + keysOffset,
+        .keySize = keySize,
+        .equalFunc = equalFunc
+    };
+    cache->keys = storage + keysOffset;
+    cache->values = storage + valuesOffset;
+    // There are no entries yet, so clearing only resets the bookkeeping.
+    cache->count = 0;
+    scu_lru_cache_clear(cache);
+    return cache;
+}
+
+void scu_lru_cache_set_evict_func(
+    ScuLruCache* cache,
+    ScuLruCacheEvictFunc* evictFunc,
+    void* context
+) {
+    SCU_ASSERT(cache != nullptr);
+    cache->evictFunc = evictFunc;
+    cache->evictContext = context;
+}
+
+isize scu_lru_cache_capacity(const ScuLruCache* cache) {
+    SCU_ASSERT(cache != nullptr);
+    return cache->capacity;
+}
+
+isize scu_lru_cache_count(const ScuLruCache* cache) {
+    SCU_ASSERT(cache != nullptr);
+    return cache->count;
+}
+
+isize scu_lru_cache_charge(const ScuLruCache* cache) {
+    SCU_ASSERT(cache != nullptr);
+    return cache->charge;
+}
+
+isize scu_lru_cache_max_charge(const ScuLruCache* cache) {
+    SCU_ASSERT(cache != nullptr);
+    return cache->maxCharge;
+}
+
+/**
+ * @brief Returns a pointer to the key of an entry.
+ *
+ * @param[in] cache The cache to examine.
+ * @param[in] entry The entry to examine.
+ * @return A pointer to the key of the entry.
+ */
+static inline byte* scu_lru_cache_key_at(
+    const ScuLruCache* cache,
+    isize entry
+) {
+    SCU_ASSERT(cache != nullptr);
+    SCU_ASSERT((entry >= 0) && (entry < cache->capacity));
+    return &cache->keys[entry * cache->keySize];
+}
+
+/**
+ * @brief Returns a pointer to the value of an entry.
+ *
+ * @param[in] cache The cache to examine.
+ * @param[in] entry The entry to examine.
+ * @return A pointer to the value of the entry.
+ */
+static inline byte* scu_lru_cache_value_at(
+    const ScuLruCache* cache,
+    isize entry
+) {
+    SCU_ASSERT(cache != nullptr);
+    SCU_ASSERT((entry >= 0) && (entry < cache->capacity));
+    return &cache->values[entry * cache->valueSize];
+}
+
+/**
+ * @brief Unlinks an entry from the recency list of a specified cache.
+ *
+ * @param[in, out] cache The cache to modify.
+ * @param[in]      entry The entry to unlink.
+ */
+static inline void scu_lru_cache_unlink(ScuLruCache* cache, isize entry) {
+    SCU_ASSERT(cache != nullptr);
+    isize prev = cache->prev[entry];
+    isize next = cache->next[entry];
+    if (prev != -1) {
+        cache->next[prev] = next;
+    }
+    else {
+        cache->head = next;
+    }
+    if (next != -1) {
+        cache->prev[next] = prev;
+    }
+    else {
+        cache->tail = prev;
+    }
+}
+
+/**
+ * @brief Links an entry as the most recently used one into the recency list of
+ * a specified cache.
+ *
+ * @param[in, out] cache The cache to modify.
+ * @param[in]      entry The entry to link.
+ */
+static inline void scu_lru_cache_push_front(ScuLruCache* cache, isize entry) {
+    SCU_ASSERT(cache != nullptr);
+    cache->prev[entry] = -1;
+    cache->next[entry] = cache->head;
+    if (cache->head != -1) {
+        cache->prev[cache->head] = entry;
+    }
+    else {
+        cache->tail = entry;
+    }
+    cache->head = entry;
+}
+
+/**
+ * @brief Removes an entry from a specified cache, calling the eviction function
+ * (if any).
+ *
+ * @param[in, out] cache The cache to modify.
+ * @param[in]      entry The entry to remove.
+ */
+static inline void scu_lru_cache_remove_entry(ScuLruCache* cache, isize entry) {
+    SCU_ASSERT(cache != nullptr);
+    if (cache->evictFunc != nullptr) {
+        cache->evictFunc(
+            cache->evictContext,
+            scu_lru_cache_key_at(cache, entry),
+            scu_lru_cache_value_at(cache, entry)
+        );
+    }
+    scu_open_index_remove(&cache->index, entry);
+    scu_lru_cache_unlink(cache, entry);
+    cache->charge -= cache->charges[entry];
+    cache->count--;
+    cache->next[entry] = cache->freeHead;
+    cache->freeHead = entry;
+}
+
+bool scu_lru_cache_try_get_impl(
+    ScuLruCache* restrict cache,
+    const void* restrict key,
+    void* restrict* restrict value
+) {
+    SCU_ASSERT(cache != nullptr);
+    SCU_ASSERT(key != nullptr);
+    SCU_ASSERT(value != nullptr);
+    isize position = scu_open_index_find(
+        &cache->index,
+        key,
+        cache->hashFunc(key)
+    );
+    if (position == -1) {
+        cache->stats.misses++;
+        *value = nullptr;
+        return false;
+    }
+    isize entry = cache->index.positions[position];
+    if (cache->head != entry) {
+        scu_lru_cache_unlink(cache, entry);
+        scu_lru_cache_push_front(cache, entry);
+    }
+    cache->stats.hits++;
+    *value = scu_lru_cache_value_at(cache, entry);
+    return true;
+}
+
+bool scu_lru_cache_contains(
+    const ScuLruCache* restrict cache,
+    const void* restrict key
+) {
+    SCU_ASSERT(cache != nullptr);
+    SCU_ASSERT(key != nullptr);
+    usize hash = cache->hashFunc(key);
+    return scu_open_index_find(&cache->index, key, hash) != -1;
+}
+
+void scu_lru_cache_put(
+    ScuLruCache* restrict cache,
+    const void* restrict key,
+    const void* restrict value
+) {
+    SCU_ASSERT(cache != nullptr);
+    scu_lru_cache_put_with_charge(cache, key, value, 1);
+}
+
+bool scu_lru_cache_put_with_charge(
+    ScuLruCache* restrict cache,
+    const void* restrict key,
+    const void* restrict value,
+    isize charge
+) {
+    SCU_ASSERT(cache != nullptr);
+    SCU_ASSERT(key != nullptr);
+    SCU_ASSERT(value != nullptr);
+    SCU_ASSERT(charge >= 0);
+    if (charge > cache->maxCharge) {
+        return false;
+    }
+    usize hash = cache->hashFunc(key);
+    isize position = scu_open_index_find(&cache->index, key, hash);
+    isize entry;
+    if (position != -1) {
+        entry = cache->index.positions[position];
+        if (cache->evictFunc != nullptr) {
+            cache->evictFunc(
+                cache->evictContext,
+                scu_lru_cache_key_at(cache, entry),
+                scu_lru_cache_value_at(cache, entry)
+            );
+        }
+        scu_lru_cache_unlink(cache, entry);
+        cache->charge -= cache->charges[entry];
+    }
+    else {
+        // Evict the least recently used entries until there is room for the
+        // new entry.
+        while (
+            (cache->count == cache->capacity)
+                || (charge > (cache->maxCharge - cache->charge))
+        ) {
+            SCU_ASSERT(cache->tail != -1);
+            scu_lru_cache_remove_entry(cache, cache->tail);
+            cache->stats.evictions++;
+        }
+        entry = cache->freeHead;
+        cache->freeHead = cache->next[entry];
+        cache->hashes[entry] = hash;
+        scu_memcpy(scu_lru_cache_key_at(cache, entry), key, cache->keySize);
+        scu_open_index_insert(&cache->index, entry);
+        cache->count++;
+        cache->stats.insertions++;
+    }
+    scu_memcpy(scu_lru_cache_value_at(cache, entry), value, cache->valueSize);
+    cache->charges[entry] = charge;
+    cache->charge += charge;
+    scu_lru_cache_push_front(cache, entry);
+    // A replaced entry may have a larger charge than before.
+    while (cache->charge > cache->maxCharge) {
+        SCU_ASSERT(cache->tail != entry);
+        scu_lru_cache_remove_entry(cache, cache->tail);
+        cache->stats.evictions++;
+    }
+    return true;
+}
+
+bool scu_lru_cache_remove(
+    ScuLruCache* restrict cache,
+    const void* restrict key
+) {
+    SCU_ASSERT(cache != nullptr);
+    SCU_ASSERT(key != nullptr);
+    isize position = scu_open_index_find(
+        &cache->index,
+        key,
+        cache->hashFunc(key)
+    );
+    if (position == -1) {
+        return false;
+    }
+    scu_lru_cache_remove_entry(cache, cache->index.positions[position]);
+    return true;
+}
+
+void scu_lru_cache_clear(ScuLruCache* cache) {
+    SCU_ASSERT(cache != nullptr);
+    if (cache->evictFunc != nullptr) {
+        isize entry = cache->head;
+        while (entry != -1) {
+            cache->evictFunc(
+                cache->evictContext,
+                scu_lru_cache_key_at(cache, entry),
+                scu_lru_cache_value_at(cache, entry)
+            );
+            entry = cache->next[entry];
+        }
+    }
+    scu_open_index_clear(&cache->index);
+    for (isize i = 0; i < cache->capacity; i++) {
+        cache->next[i] = ((i + 1) < cache->capacity) ? (i + 1) : -1;
+    }
+    cache->count = 0;
+    cache->charge = 0;
+    cache->head = -1;
+    cache->tail = -1;
+    cache->freeHead = 0;
+}
+
+ScuLruCacheStats scu_lru_cache_stats(const ScuLruCache* cache) {
+    SCU_ASSERT(cache != nullptr);
+    return cache->stats;
+}
+
+void scu_lru_cache_reset_stats(ScuLruCache* cache) {
+    SCU_ASSERT(cache != nullptr);
+    cache->stats = (ScuLruCacheStats) { };
+}
+
+void scu_lru_cache_free(ScuLruCache* cache) {
+    if (cache != nullptr) {
+        scu_free(cache->prev);
+        cache->prev = nullptr;
+        cache->next = nullptr;
+        cache->charges = nullptr;
+        cache->hashes = nullptr;
+        cache->index = (ScuOpenIndex) { };
+        cache->keys = nullptr;
+        cache->values = nullptr;
+        cache->count = 0;
+        scu_free(cache);
+    }
+}
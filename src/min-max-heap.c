@@ -0,0 +1,631 @@
+#define SCU_SHORT_ALIASES
+
+#include <stddef.h>
+#include "scu/alloc.h"
+#include "scu/assert.h"
+#include "scu/math.h"
+#include "scu/memory.h"
+#include "scu/min-max-heap.h"
+#include "bits.h"
+
+struct ScuMinMaxHeap {
+
+    /** @brief The size of each element (in bytes). */
+    isize elemSize;
+
+    /** @brief The size of each priority (in bytes). */
+    isize prioSize;
+
+    /** @brief The offset of the element within a node (in bytes). */
+    isize elemOffset;
+
+    /** @brief The effective size of a node (in bytes). */
+    isize nodeSize;
+
+    /** @brief The maximum number of elements that can be stored. */
+    isize capacity;
+
+    /** @brief The current number of elements. */
+    isize count;
+
+    /** @brief A function used for comparing priorities. */
+    ScuCompareFunc* prioCmpFunc;
+
+    /**
+     * @brief The nodes storing the elements and their priorities.
+     *
+     * @note This is a dynamically allocated array of `capacity` nodes, or
+     * `nullptr` if `capacity` is zero.
+     */
+    byte* nodes;
+
+};
+
+/** @brief The default capacity of a min-max heap. */
+static constexpr isize SCU_DEFAULT_CAPACITY = 8;
+
+/** @brief The growth factor for increasing the capacity of a min-max heap. */
+static constexpr isize SCU_GROWTH_FACTOR = 2;
+
+[[nodiscard]]
+ScuMinMaxHeap* scu_min_max_heap_new(
+    isize elemSize,
+    isize prioSize,
+    ScuCompareFunc prioCmpFunc
+) {
+    return scu_min_max_heap_new_with_capacity(
+        elemSize,
+        prioSize,
+        SCU_DEFAULT_CAPACITY,
+        prioCmpFunc
+    );
+}
+
+/**
+ * @brief Rounds up a value to the next multiple of a specified alignment.
+ *
+ * @warning The behavior is undefined if `alignment` is not a power of two.
+ *
+ * @param[in] value     The value to round up.
+ * @param[in] alignment The required alignment.
+ * @return The smallest multiple of `alignment` greater than or equal to
+ * `value`.
+ */
+static inline isize scu_align_up(isize value, isize alignment) {
+    SCU_ASSERT(value >= 0);
+    SCU_ASSERT(alignment > 0);
+    SCU_ASSERT((alignment & (alignment - 1)) == 0);
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+[[nodiscard]]
+ScuMinMaxHeap* scu_min_max_heap_new_with_capacity(
+    isize elemSize,
+    isize prioSize,
+    isize capacity,
+    ScuCompareFunc prioCmpFunc
+) {
+    SCU_ASSERT(elemSize > 0);
+    SCU_ASSERT(prioSize > 0);
+    SCU_ASSERT(capacity >= 0);
+    SCU_ASSERT(prioCmpFunc != nullptr);
+    ScuMinMaxHeap* minMaxHeap = scu_malloc(SCU_SIZEOF(ScuMinMaxHeap));
+    if (minMaxHeap == nullptr) {
+        return nullptr;
+    }
+    minMaxHeap->elemSize = elemSize;
+    minMaxHeap->prioSize = prioSize;
+    minMaxHeap->elemOffset = scu_align_up(prioSize, SCU_ALIGNOF(max_align_t));
+    minMaxHeap->nodeSize = scu_align_up(
+        minMaxHeap->elemOffset + elemSize,
+        SCU_ALIGNOF(max_align_t)
+    );
+    minMaxHeap->capacity = capacity;
+    minMaxHeap->count = 0;
+    minMaxHeap->prioCmpFunc = prioCmpFunc;
+    if (capacity > 0) {
+        minMaxHeap->nodes = scu_malloc(minMaxHeap->nodeSize * capacity);
+        if (minMaxHeap->nodes == nullptr) {
+            scu_free(minMaxHeap);
+            return nullptr;
+        }
+    }
+    else {
+        minMaxHeap->nodes = nullptr;
+    }
+    return minMaxHeap;
+}
+
+[[nodiscard]]
+ScuMinMaxHeap* scu_min_max_heap_clone(const ScuMinMaxHeap* minMaxHeap) {
+    SCU_ASSERT(minMaxHeap != nullptr);
+    ScuMinMaxHeap* clone = scu_malloc(SCU_SIZEOF(ScuMinMaxHeap));
+    if (clone == nullptr) {
+        return nullptr;
+    }
+    clone->elemSize = minMaxHeap->elemSize;
+    clone->prioSize = minMaxHeap->prioSize;
+    clone->elemOffset = minMaxHeap->elemOffset;
+    clone->nodeSize = minMaxHeap->nodeSize;
+    clone->capacity = minMaxHeap->capacity;
+    clone->count = minMaxHeap->count;
+    clone->prioCmpFunc = minMaxHeap->prioCmpFunc;
+    if (clone->capacity > 0) {
+        clone->nodes = scu_malloc(clone->nodeSize * clone->capacity);
+        if (clone->nodes == nullptr) {
+            scu_free(clone);
+            return nullptr;
+        }
+        scu_memcpy(
+            clone->nodes,
+            minMaxHeap->nodes,
+            clone->nodeSize * clone->count
+        );
+    }
+    else {
+        clone->nodes = nullptr;
+    }
+    return clone;
+}
+
+isize scu_min_max_heap_capacity(const ScuMinMaxHeap* minMaxHeap) {
+    SCU_ASSERT(minMaxHeap != nullptr);
+    return minMaxHeap->capacity;
+}
+
+isize scu_min_max_heap_count(const ScuMinMaxHeap* minMaxHeap) {
+    SCU_ASSERT(minMaxHeap != nullptr);
+    return minMaxHeap->count;
+}
+
+ScuError scu_min_max_heap_ensure_capacity(
+    ScuMinMaxHeap* minMaxHeap,
+    isize capacity
+) {
+    SCU_ASSERT(minMaxHeap != nullptr);
+    SCU_ASSERT(capacity >= 0);
+    if (minMaxHeap->capacity < capacity) {
+        isize newCapacity = (minMaxHeap->capacity > 0)
+            ? minMaxHeap->capacity
+            : 1;
+        while (newCapacity < capacity) {
+            newCapacity *= SCU_GROWTH_FACTOR;
+        }
+        byte* newNodes = scu_realloc(
+            minMaxHeap->nodes,
+            minMaxHeap->nodeSize * newCapacity
+        );
+        if (newNodes == nullptr) {
+            return SCU_ERROR_OUT_OF_MEMORY;
+        }
+        minMaxHeap->nodes = newNodes;
+        minMaxHeap->capacity = newCapacity;
+    }
+    return SCU_ERROR_NONE;
+}
+
+/**
+ * @brief Returns a pointer to the priority of a node at a specified index.
+ *
+ * @param[in] minMaxHeap The min-max heap to examine.
+ * @param[in] index     The index of the node to retrieve the priority of.
+ * @return A pointer to the priority of the node at the specified index.
+ */
+static inline byte* scu_node_prio(
+    const ScuMinMaxHeap* minMaxHeap,
+    isize index
+) {
+    SCU_ASSERT(minMaxHeap != nullptr);
+    SCU_ASSERT((index >= 0) && (index < minMaxHeap->capacity));
+    return minMaxHeap->nodes + (index * minMaxHeap->nodeSize);
+}
+
+/**
+ * @brief Returns a pointer to the element of a node at a specified index.
+ *
+ * @param[in] minMaxHeap The min-max heap to examine.
+ * @param[in] index     The index of the node to retrieve the element of.
+ * @return A pointer to the element of the node at the specified index.
+ */
+static inline byte* scu_node_elem(
+    const ScuMinMaxHeap* minMaxHeap,
+    isize index
+) {
+    SCU_ASSERT(minMaxHeap != nullptr);
+    SCU_ASSERT((index >= 0) && (index < minMaxHeap->capacity));
+    return minMaxHeap->nodes + (index * minMaxHeap->nodeSize)
+        + minMaxHeap->elemOffset;
+}
+
+/**
+ * @brief Determines whether the node at a specified index is on a min level.
+ *
+ * @note The levels of the heap alternate between min and max levels, starting
+ * with the root on a min level. A node on a min level has a priority less than
+ * or equal to the priorities of all its descendants, and a node on a max level
+ * has a priority greater than or equal to the priorities of all its
+ * descendants.
+ *
+ * @param[in] index The index of the node.
+ * @return `true` if the node is on a min level, otherwise `false`.
+ */
+static inline bool scu_is_min_level(isize index) {
+    SCU_ASSERT(index >= 0);
+    isize level = 63 - scu_leading_zeros_u64((u64) index + 1);
+    return (level % 2) == 0;
+}
+
+/**
+ * @brief Determines whether a node belongs above another node with respect to
+ * a min or max level.
+ *
+ * @param[in] minMaxHeap The min-max heap to examine.
+ * @param[in] index      The index of the first node.
+ * @param[in] otherIndex The index of the second node.
+ * @param[in] isMinLevel Indicates whether the nodes are compared with respect
+ *                       to a min level (`true`) or a max level (`false`).
+ * @return `true` if the priority of the first node is less than (on a min
+ * level) or greater than (on a max level) the priority of the second node,
+ * otherwise `false`.
+ */
+static inline bool scu_node_precedes(
+    const ScuMinMaxHeap* minMaxHeap,
+    isize index,
+    isize otherIndex,
+    bool isMinLevel
+) {
+    int cmp = minMaxHeap->prioCmpFunc(
+        scu_node_prio(minMaxHeap, index),
+        scu_node_prio(minMaxHeap, otherIndex)
+    );
+    return isMinLevel ? (cmp < 0) : (cmp > 0);
+}
+
+/**
+ * @brief Swaps two nodes of a specified min-max heap.
+ *
+ * @param[in, out] minMaxHeap The min-max heap to modify.
+ * @param[in]      index      The index of the first node.
+ * @param[in]      otherIndex The index of the second node.
+ */
+static inline void scu_node_swap(
+    ScuMinMaxHeap* minMaxHeap,
+    isize index,
+    isize otherIndex
+) {
+    scu_memswap(
+        scu_node_prio(minMaxHeap, index),
+        scu_node_prio(minMaxHeap, otherIndex),
+        minMaxHeap->nodeSize
+    );
+}
+
+/**
+ * @brief Moves the node at a specified index up until the heap property is
+ * restored.
+ *
+ * @param[in, out] minMaxHeap The min-max heap to modify.
+ * @param[in]      index      The index of the node to move up.
+ */
+static void scu_min_max_heap_bubble_up(ScuMinMaxHeap* minMaxHeap, isize index) {
+    if (index == 0) {
+        return;
+    }
+    bool isMinLevel = scu_is_min_level(index);
+    isize parentIndex = (index - 1) / 2;
+    if (scu_node_precedes(minMaxHeap, index, parentIndex, !isMinLevel)) {
+        // The node belongs to the levels of the other kind, which it can reach
+        // by moving past its parent.
+        scu_node_swap(minMaxHeap, index, parentIndex);
+        index = parentIndex;
+        isMinLevel = !isMinLevel;
+    }
+    while (index > 2) {
+        isize grandparentIndex = (((index - 1) / 2) - 1) / 2;
+        if (
+            !scu_node_precedes(minMaxHeap, index, grandparentIndex, isMinLevel)
+        ) {
+            break;
+        }
+        scu_node_swap(minMaxHeap, index, grandparentIndex);
+        index = grandparentIndex;
+    }
+}
+
+/**
+ * @brief Moves the node at a specified index down until the heap property is
+ * restored.
+ *
+ * @param[in, out] minMaxHeap The min-max heap to modify.
+ * @param[in]      index      The index of the node to move down.
+ */
+static void scu_min_max_heap_trickle_down(
+    ScuMinMaxHeap* minMaxHeap,
+    isize index
+) {
+    bool isMinLevel = scu_is_min_level(index);
+    while (true) {
+        isize firstChildIndex = (index * 2) + 1;
+        if (firstChildIndex >= minMaxHeap->count) {
+            break;
+        }
+        // Find the most extreme node among the children and grandchildren.
+        isize lastChildIndex = SCU_MIN(firstChildIndex + 2, minMaxHeap->count);
+        isize firstGrandchildIndex = (firstChildIndex * 2) + 1;
+        isize lastGrandchildIndex = SCU_MIN(
+            firstGrandchildIndex + 4,
+            minMaxHeap->count
+        );
+        isize extremeIndex = firstChildIndex;
+        for (isize i = firstChildIndex + 1; i < lastChildIndex; i++) {
+            if (scu_node_precedes(minMaxHeap, i, extremeIndex, isMinLevel)) {
+                extremeIndex = i;
+            }
+        }
+        for (isize i = firstGrandchildIndex; i < lastGrandchildIndex; i++) {
+            if (scu_node_precedes(minMaxHeap, i, extremeIndex, isMinLevel)) {
+                extremeIndex = i;
+            }
+        }
+        if (!scu_node_precedes(minMaxHeap, extremeIndex, index, isMinLevel)) {
+            break;
+        }
+        scu_node_swap(minMaxHeap, extremeIndex, index);
+        if (extremeIndex < firstGrandchildIndex) {
+            // A child has no descendants that would have to be considered.
+            break;
+        }
+        isize parentIndex = (extremeIndex - 1) / 2;
+        // The node has moved past a node of the other kind, which it may have
+        // to swap places with.
+        bool isMaxLevel = !isMinLevel;
+        if (
+            scu_node_precedes(minMaxHeap, extremeIndex, parentIndex, isMaxLevel)
+        ) {
+            scu_node_swap(minMaxHeap, extremeIndex, parentIndex);
+        }
+        index = extremeIndex;
+    }
+}
+
+/**
+ * @brief Returns the index of the node with the highest priority of a
+ * specified min-max heap.
+ *
+ * @warning The behavior is undefined if the min-max heap is empty.
+ *
+ * @param[in] minMaxHeap The min-max heap to examine.
+ * @return The index of the node with the highest priority.
+ */
+static inline isize scu_min_max_heap_max_index(
+    const ScuMinMaxHeap* minMaxHeap
+) {
+    SCU_ASSERT(minMaxHeap->count > 0);
+    if (minMaxHeap->count <= 2) {
+        return minMaxHeap->count - 1;
+    }
+    return scu_node_precedes(minMaxHeap, 2, 1, false) ? 2 : 1;
+}
+
+/**
+ * @brief Removes the node at a specified index from a specified min-max heap.
+ *
+ * @param[in, out] minMaxHeap The min-max heap to remove the node from.
+ * @param[in]      index      The index of the node to remove.
+ * @param[out]     elem       The element of the removed node.
+ * @param[out]     prio       The priority of the removed node.
+ */
+static void scu_min_max_heap_remove_at(
+    ScuMinMaxHeap* restrict minMaxHeap,
+    isize index,
+    void* restrict elem,
+    void* restrict prio
+) {
+    scu_memcpy(elem, scu_node_elem(minMaxHeap, index), minMaxHeap->elemSize);
+    scu_memcpy(prio, scu_node_prio(minMaxHeap, index), minMaxHeap->prioSize);
+    minMaxHeap->count--;
+    if (index < minMaxHeap->count) {
+        scu_memcpy(
+            scu_node_prio(minMaxHeap, index),
+            scu_node_prio(minMaxHeap, minMaxHeap->count),
+            minMaxHeap->nodeSize
+        );
+        scu_min_max_heap_trickle_down(minMaxHeap, index);
+    }
+}
+
+ScuError scu_min_max_heap_enqueue(
+    ScuMinMaxHeap* restrict minMaxHeap,
+    const void* restrict elem,
+    const void* restrict prio
+) {
+    SCU_ASSERT(minMaxHeap != nullptr);
+    SCU_ASSERT(elem != nullptr);
+    SCU_ASSERT(prio != nullptr);
+    ScuError error = scu_min_max_heap_ensure_capacity(
+        minMaxHeap,
+        minMaxHeap->count + 1
+    );
+    if (error != SCU_ERROR_NONE) {
+        return error;
+    }
+    isize index = minMaxHeap->count;
+    scu_memcpy(scu_node_prio(minMaxHeap, index), prio, minMaxHeap->prioSize);
+    scu_memcpy(scu_node_elem(minMaxHeap, index), elem, minMaxHeap->elemSize);
+    minMaxHeap->count++;
+    scu_min_max_heap_bubble_up(minMaxHeap, index);
+    return SCU_ERROR_NONE;
+}
+
+void scu_min_max_heap_dequeue_min(
+    ScuMinMaxHeap* restrict minMaxHeap,
+    void* restrict elem,
+    void* restrict prio
+) {
+    if (!scu_min_max_heap_try_dequeue_min(minMaxHeap, elem, prio)) {
+        SCU_FATAL("The specified min-max heap is empty.\n");
+    }
+}
+
+bool scu_min_max_heap_try_dequeue_min(
+    ScuMinMaxHeap* restrict minMaxHeap,
+    void* restrict elem,
+    void* restrict prio
+) {
+    SCU_ASSERT(minMaxHeap != nullptr);
+    SCU_ASSERT(elem != nullptr);
+    SCU_ASSERT(prio != nullptr);
+    if (minMaxHeap->count == 0) {
+        return false;
+    }
+    scu_min_max_heap_remove_at(minMaxHeap, 0, elem, prio);
+    return true;
+}
+
+void scu_min_max_heap_dequeue_max(
+    ScuMinMaxHeap* restrict minMaxHeap,
+    void* restrict elem,
+    void* restrict prio
+) {
+    if (!scu_min_max_heap_try_dequeue_max(minMaxHeap, elem, prio)) {
+        SCU_FATAL("The specified min-max heap is empty.\n");
+    }
+}
+
+bool scu_min_max_heap_try_dequeue_max(
+    ScuMinMaxHeap* restrict minMaxHeap,
+    void* restrict elem,
+    void* restrict prio
+) {
+    SCU_ASSERT(minMaxHeap != nullptr);
+    SCU_ASSERT(elem != nullptr);
+    SCU_ASSERT(prio != nullptr);
+    if (minMaxHeap->count == 0) {
+        return false;
+    }
+    scu_min_max_heap_remove_at(
+        minMaxHeap,
+        scu_min_max_heap_max_index(minMaxHeap),
+        elem,
+        prio
+    );
+    return true;
+}
+
+void scu_min_max_heap_peek_min_impl(
+    const ScuMinMaxHeap* restrict minMaxHeap,
+    void** restrict elem,
+    void** restrict prio
+) {
+    if (!scu_min_max_heap_try_peek_min_impl(minMaxHeap, elem, prio)) {
+        SCU_FATAL("The specified min-max heap is empty.\n");
+    }
+}
+
+bool scu_min_max_heap_try_peek_min_impl(
+    const ScuMinMaxHeap* restrict minMaxHeap,
+    void** restrict elem,
+    void** restrict prio
+) {
+    SCU_ASSERT(minMaxHeap != nullptr);
+    SCU_ASSERT(elem != nullptr);
+    SCU_ASSERT(prio != nullptr);
+    if (minMaxHeap->count == 0) {
+        *elem = nullptr;
+        *prio = nullptr;
+        return false;
+    }
+    *elem = scu_node_elem(minMaxHeap, 0);
+    *prio = scu_node_prio(minMaxHeap, 0);
+    return true;
+}
+
+void scu_min_max_heap_peek_max_impl(
+    const ScuMinMaxHeap* restrict minMaxHeap,
+    void** restrict elem,
+    void** restrict prio
+) {
+    if (!scu_min_max_heap_try_peek_max_impl(minMaxHeap, elem, prio)) {
+        SCU_FATAL("The specified min-max heap is empty.\n");
+    }
+}
+
+bool scu_min_max_heap_try_peek_max_impl(
+    const ScuMinMaxHeap* restrict minMaxHeap,
+    void** restrict elem,
+    void** restrict prio
+) {
+    SCU_ASSERT(minMaxHeap != nullptr);
+    SCU_ASSERT(elem != nullptr);
+    SCU_ASSERT(prio != nullptr);
+    if (minMaxHeap->count == 0) {
+        *elem = nullptr;
+        *prio = nullptr;
+        return false;
+    }
+    isize index = scu_min_max_heap_max_index(minMaxHeap);
+    *elem = scu_node_elem(minMaxHeap, index);
+    *prio = scu_node_prio(minMaxHeap, index);
+    return true;
+}
+
+void scu_min_max_heap_clear(ScuMinMaxHeap* minMaxHeap) {
+    SCU_ASSERT(minMaxHeap != nullptr);
+    minMaxHeap->count = 0;
+}
+
+ScuError scu_min_max_heap_trim_excess(ScuMinMaxHeap* minMaxHeap) {
+    SCU_ASSERT(minMaxHeap != nullptr);
+    if (minMaxHeap->capacity > minMaxHeap->count) {
+        if (minMaxHeap->count == 0) {
+            scu_free(minMaxHeap->nodes);
+            minMaxHeap->nodes = nullptr;
+            minMaxHeap->capacity = 0;
+        }
+        else {
+            isize newCapacity = minMaxHeap->count;
+            byte* newNodes = scu_realloc(
+                minMaxHeap->nodes,
+                minMaxHeap->nodeSize * newCapacity
+            );
+            if (newNodes == nullptr) {
+                return SCU_ERROR_OUT_OF_MEMORY;
+            }
+            minMaxHeap->nodes = newNodes;
+            minMaxHeap->capacity = newCapacity;
+        }
+    }
+    return SCU_ERROR_NONE;
+}
+
+ScuMinMaxHeapIter scu_min_max_heap_iter(const ScuMinMaxHeap* minMaxHeap) {
+    SCU_ASSERT(minMaxHeap != nullptr);
+    return (ScuMinMaxHeapIter) {
+        .minMaxHeap = SCU_CONST_CAST(ScuMinMaxHeap*, minMaxHeap),
+        .index = -1
+    };
+}
+
+bool scu_min_max_heap_iter_move_next(ScuMinMaxHeapIter* iter) {
+    SCU_ASSERT(iter != nullptr);
+    ScuMinMaxHeap* minMaxHeap = iter->minMaxHeap;
+    isize index = iter->index;
+    SCU_ASSERT(minMaxHeap != nullptr);
+    SCU_ASSERT((index >= -1) && (index < minMaxHeap->count));
+    if ((index + 1) < minMaxHeap->count) {
+        iter->index++;
+        return true;
+    }
+    return false;
+}
+
+ScuMinMaxHeapEntry scu_min_max_heap_iter_current(
+    const ScuMinMaxHeapIter* iter
+) {
+    SCU_ASSERT(iter != nullptr);
+    ScuMinMaxHeap* minMaxHeap = iter->minMaxHeap;
+    isize index = iter->index;
+    SCU_ASSERT(minMaxHeap != nullptr);
+    SCU_ASSERT((index >= 0) && (index < minMaxHeap->count));
+    return (ScuMinMaxHeapEntry) {
+        .elem = scu_node_elem(minMaxHeap, index),
+        .prio = scu_node_prio(minMaxHeap, index)
+    };
+}
+
+void scu_min_max_heap_iter_reset(ScuMinMaxHeapIter* iter) {
+    SCU_ASSERT(iter != nullptr);
+    SCU_ASSERT(iter->minMaxHeap != nullptr);
+    SCU_ASSERT((iter->index >= -1) && (iter->index < iter->minMaxHeap->count));
+    iter->index = -1;
+}
+
+void scu_min_max_heap_free(ScuMinMaxHeap* minMaxHeap) {
+    if (minMaxHeap != nullptr) {
+        scu_free(minMaxHeap->nodes);
+        minMaxHeap->nodes = nullptr;
+        minMaxHeap->capacity = 0;
+        minMaxHeap->count = 0;
+        scu_free(minMaxHeap);
+    }
+}
\ No newline at end of file
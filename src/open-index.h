@@ -0,0 +1,165 @@
+#ifndef SCU_OPEN_INDEX_H
+#define SCU_OPEN_INDEX_H
+
+// An open addressing hash table mapping keys to the entries of a fixed-capacity
+// data structure, shared by the implementation files. This header is internal
+// to the library and expects `SCU_SHORT_ALIASES` to be defined.
+
+#include "scu/assert.h"
+#include "scu/equal.h"
+#include "scu/types.h"
+#include "bits.h"
+
+/**
+ * @brief Represents an open addressing hash table mapping keys to entries.
+ *
+ * The index only stores entry numbers. The hash and key of each entry live in
+ * arrays owned by the data structure using the index, which the index refers
+ * to. Collisions are resolved using linear probing, and removals shift
+ * subsequent entries of the probe sequence backwards, so no tombstones are
+ * required.
+ */
+typedef struct ScuOpenIndex {
+
+    /** @brief The number of positions (always a power of two). */
+    isize capacity;
+
+    /**
+     * @brief The entry stored at each position, or `-1` if the position is
+     * empty.
+     */
+    isize* positions;
+
+    /** @brief The hash of the key of each entry. */
+    const usize* hashes;
+
+    /** @brief The keys of the entries, stored contiguously. */
+    const byte* keys;
+
+    /** @brief The size of each key (in bytes). */
+    isize keySize;
+
+    /** @brief A function used for comparing keys for equality. */
+    ScuEqualFunc* equalFunc;
+
+} ScuOpenIndex;
+
+/**
+ * @brief Returns the number of positions of an index for a specified maximum
+ * number of entries.
+ *
+ * @note The load factor is kept at or below one half, so that probe sequences
+ * stay short.
+ *
+ * @param[in] entryCount The maximum number of entries.
+ * @return The number of positions (always a power of two).
+ */
+static inline isize scu_open_index_capacity_for(isize entryCount) {
+    SCU_ASSERT(entryCount > 0);
+    return scu_next_power_of_two(entryCount * 2);
+}
+
+/**
+ * @brief Removes all entries from a specified index.
+ *
+ * @param[in, out] index The index to clear.
+ */
+static inline void scu_open_index_clear(ScuOpenIndex* index) {
+    SCU_ASSERT(index != nullptr);
+    for (isize i = 0; i < index->capacity; i++) {
+        index->positions[i] = -1;
+    }
+}
+
+/**
+ * @brief Finds the position of a key within a specified index.
+ *
+ * @param[in] index The index to search.
+ * @param[in] key   The key to search for.
+ * @param[in] hash  The hash of the key.
+ * @return The position of the key within the index, or `-1` if the key is not
+ * present.
+ */
+static inline isize scu_open_index_find(
+    const ScuOpenIndex* restrict index,
+    const void* restrict key,
+    usize hash
+) {
+    SCU_ASSERT(index != nullptr);
+    SCU_ASSERT(key != nullptr);
+    usize mask = (usize) index->capacity - 1;
+    isize position = (isize) (hash & mask);
+    while (index->positions[position] != -1) {
+        isize entry = index->positions[position];
+        if (
+            (index->hashes[entry] == hash)
+                && index->equalFunc(
+                    &index->keys[entry * index->keySize],
+                    key
+                )
+        ) {
+            return position;
+        }
+        position = (isize) ((usize) (position + 1) & mask);
+    }
+    return -1;
+}
+
+/**
+ * @brief Inserts an entry into a specified index.
+ *
+ * @warning The hash of the entry must already be stored, and the key must not
+ * be present in the index yet.
+ *
+ * @param[in, out] index The index to modify.
+ * @param[in]      entry The entry to insert.
+ */
+static inline void scu_open_index_insert(ScuOpenIndex* index, isize entry) {
+    SCU_ASSERT(index != nullptr);
+    usize mask = (usize) index->capacity - 1;
+    isize position = (isize) (index->hashes[entry] & mask);
+    while (index->positions[position] != -1) {
+        position = (isize) ((usize) (position + 1) & mask);
+    }
+    index->positions[position] = entry;
+}
+
+/**
+ * @brief Removes an entry from a specified index.
+ *
+ * @note Subsequent entries of the probe sequence are shifted backwards to close
+ * the gap.
+ *
+ * @param[in, out] index The index to modify.
+ * @param[in]      entry The entry to remove, which must be present.
+ */
+static inline void scu_open_index_remove(ScuOpenIndex* index, isize entry) {
+    SCU_ASSERT(index != nullptr);
+    usize mask = (usize) index->capacity - 1;
+    isize position = (isize) (index->hashes[entry] & mask);
+    while (index->positions[position] != entry) {
+        SCU_ASSERT(index->positions[position] != -1);
+        position = (isize) ((usize) (position + 1) & mask);
+    }
+    isize next = position;
+    while (true) {
+        next = (isize) ((usize) (next + 1) & mask);
+        isize nextEntry = index->positions[next];
+        if (nextEntry == -1) {
+            break;
+        }
+        isize ideal = (isize) (index->hashes[nextEntry] & mask);
+        // Leave the entry in place if its ideal position lies cyclically within
+        // (position, next], as moving it would break its probe sequence.
+        bool isInPlace = (position <= next)
+            ? ((position < ideal) && (ideal <= next))
+            : ((position < ideal) || (ideal <= next));
+        if (!isInPlace) {
+            index->positions[position] = nextEntry;
+            position = next;
+        }
+    }
+    index->positions[position] = -1;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,1000 @@
+#define SCU_SHORT_ALIASES
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include "scu/alloc.h"
+#include "scu/array.h"
+#include "scu/assert.h"
+#include "scu/error.h"
+#include "scu/memory.h"
+#include "scu/persistent-map.h"
+#include "bits.h"
+
+/** @brief The number of hash bits consumed by each level of the trie. */
+static constexpr isize SCU_BITS_PER_LEVEL = 5;
+
+/** @brief A mask for extracting the hash bits of a single level. */
+static constexpr usize SCU_LEVEL_MASK = 31;
+
+/**
+ * @brief Represents a node of a hash array mapped trie.
+ *
+ * Each node has up to 32 slots, one for each possible value of the hash bits
+ * of its level. A slot is either empty, holds a single entry, or refers to a
+ * child node. Only occupied slots are stored, and their positions are derived
+ * from two bitmaps using popcounts. Entries whose hashes are equal in all bits
+ * are stored in a collision node below the last regular level.
+ *
+ * @note Nodes are immutable once they are reachable from a persistent map, and
+ * may be shared by any number of versions of the map.
+ */
+typedef struct ScuNode {
+
+    /** @brief The number of references to the node (parents and maps). */
+    _Atomic(isize) refCount;
+
+    /** @brief The slots holding an entry. */
+    u32 dataMap;
+
+    /** @brief The slots referring to a child node. */
+    u32 nodeMap;
+
+    /** @brief The number of entries of the node. */
+    isize entryCount;
+
+    /** @brief The number of children of the node. */
+    isize childCount;
+
+    /** @brief Indicates whether the node is a collision node. */
+    bool isCollision;
+
+    /**
+     * @brief The entries of the node, followed by the pointers to its children.
+     *
+     * @note This is a flexible array member, which is aligned as strictly as
+     * `max_align_t`. Each entry consists of the hash of the key, the key and
+     * the value, each one aligned as strictly as `max_align_t`. The offsets and
+     * the size of the entries are stored by the persistent map owning the node.
+     */
+    alignas(max_align_t) byte entries[];
+
+} ScuNode;
+
+struct ScuPersistentMap {
+
+    /** @brief The size of each key (in bytes). */
+    isize keySize;
+
+    /** @brief The size of each value (in bytes). */
+    isize valueSize;
+
+    /** @brief The offset of the key within an entry (in bytes). */
+    isize keyOffset;
+
+    /** @brief The offset of the value within an entry (in bytes). */
+    isize valueOffset;
+
+    /** @brief The effective size of an entry (in bytes). */
+    isize entrySize;
+
+    /** @brief The number of key-value pairs. */
+    isize count;
+
+    /** @brief A function used for hashing keys. */
+    ScuHashFunc* hashFunc;
+
+    /** @brief A function used for comparing keys for equality. */
+    ScuEqualFunc* equalFunc;
+
+    /** @brief The root node of the trie, or `nullptr` if the map is empty. */
+    ScuNode* root;
+
+};
+
+/**
+ * @brief Rounds up a value to the next multiple of a specified alignment.
+ *
+ * @warning The behavior is undefined if `alignment` is not a power of two.
+ *
+ * @param[in] value     The value to round up.
+ * @param[in] alignment The required alignment.
+ * @return The smallest multiple of `alignment` greater than or equal to
+ * `value`.
+ */
+static inline isize scu_align_up(isize value, isize alignment) {
+    SCU_ASSERT(value >= 0);
+    SCU_ASSERT(alignment > 0);
+    SCU_ASSERT((alignment & (alignment - 1)) == 0);
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * @brief Returns the slot bit of a hash on the level with a specified shift.
+ *
+ * @param[in] hash  The hash to examine.
+ * @param[in] shift The number of hash bits consumed by the levels above.
+ * @return A `u32` with only the bit of the slot set.
+ */
+static inline u32 scu_slot_bit(usize hash, isize shift) {
+    SCU_ASSERT((shift >= 0) && (shift < USIZE_WIDTH));
+    return (u32) 1 << ((hash >> shift) & SCU_LEVEL_MASK);
+}
+
+/**
+ * @brief Returns the index of a slot among the occupied slots of a bitmap.
+ *
+ * @param[in] bitmap The bitmap of occupied slots.
+ * @param[in] bit    The bit of the slot.
+ * @return The number of occupied slots before the slot.
+ */
+static inline isize scu_slot_index(u32 bitmap, u32 bit) {
+    return scu_popcount_u32(bitmap & (bit - 1));
+}
+
+/**
+ * @brief Returns a pointer to an entry of a specified node.
+ *
+ * @param[in] map   The persistent map owning the node.
+ * @param[in] node  The node to examine.
+ * @param[in] index The index of the entry.
+ * @return A pointer to the entry.
+ */
+static inline byte* scu_node_entry(
+    const ScuPersistentMap* map,
+    ScuNode* node,
+    isize index
+) {
+    SCU_ASSERT((index >= 0) && (index < node->entryCount));
+    return (byte*) &node->entries[index * map->entrySize];
+}
+
+/**
+ * @brief Returns a pointer to the array of children of a specified node.
+ *
+ * @param[in] map  The persistent map owning the node.
+ * @param[in] node The node to examine.
+ * @return A pointer to the array of children.
+ */
+static inline ScuNode** scu_node_children(
+    const ScuPersistentMap* map,
+    ScuNode* node
+) {
+    isize offset = node->entryCount * map->entrySize;
+    return (ScuNode**) (void*) &node->entries[offset];
+}
+
+/**
+ * @brief Returns the hash stored in a specified entry.
+ *
+ * @param[in] entry The entry to examine.
+ * @return The hash of the key of the entry.
+ */
+static inline usize scu_entry_hash(const byte* entry) {
+    return *(const usize*) (const void*) entry;
+}
+
+/**
+ * @brief Determines whether a specified entry holds a specified key.
+ *
+ * @param[in] map   The persistent map owning the entry.
+ * @param[in] entry The entry to examine.
+ * @param[in] hash  The hash of the key.
+ * @param[in] key   The key to compare with.
+ * @return `true` if the entry holds the key, otherwise `false`.
+ */
+static inline bool scu_entry_matches(
+    const ScuPersistentMap* map,
+    const byte* entry,
+    usize hash,
+    const void* key
+) {
+    return (scu_entry_hash(entry) == hash)
+        && map->equalFunc(&entry[map->keyOffset], key);
+}
+
+/**
+ * @brief Writes a key-value pair into a specified entry.
+ *
+ * @param[in]  map   The persistent map owning the entry.
+ * @param[out] entry The entry to write.
+ * @param[in]  hash  The hash of the key.
+ * @param[in]  key   The key to write.
+ * @param[in]  value The value to write.
+ */
+static inline void scu_entry_write(
+    const ScuPersistentMap* map,
+    byte* entry,
+    usize hash,
+    const void* key,
+    const void* value
+) {
+    *(usize*) (void*) entry = hash;
+    scu_memcpy(&entry[map->keyOffset], key, map->keySize);
+    scu_memcpy(&entry[map->valueOffset], value, map->valueSize);
+}
+
+/**
+ * @brief Allocates a new node with a specified number of entries and children.
+ *
+ * @note The entries, children and bitmaps of the node are left for the caller
+ * to initialize. The reference count of the node is one.
+ *
+ * @param[in] map        The persistent map owning the node.
+ * @param[in] entryCount The number of entries.
+ * @param[in] childCount The number of children.
+ * @return A pointer to the new node, or `nullptr` on failure.
+ */
+static inline ScuNode* scu_node_new(
+    const ScuPersistentMap* map,
+    isize entryCount,
+    isize childCount
+) {
+    ScuNode* node = scu_malloc(
+        SCU_SIZEOF(ScuNode)
+            + (entryCount * map->entrySize)
+            + (childCount * SCU_SIZEOF(ScuNode*))
+    );
+    if (node == nullptr) {
+        return nullptr;
+    }
+    atomic_init(&node->refCount, 1);
+    node->dataMap = 0;
+    node->nodeMap = 0;
+    node->entryCount = entryCount;
+    node->childCount = childCount;
+    node->isCollision = false;
+    return node;
+}
+
+/**
+ * @brief Increments the reference count of a specified node.
+ *
+ * @param[in, out] node The node to retain.
+ */
+static inline void scu_node_retain(ScuNode* node) {
+    SCU_ASSERT(node != nullptr);
+    atomic_fetch_add_explicit(&node->refCount, 1, memory_order_relaxed);
+}
+
+/**
+ * @brief Decrements the reference count of a specified node, deallocating it
+ * (and releasing its children) once it is no longer referenced.
+ *
+ * @param[in]      map  The persistent map owning the node.
+ * @param[in, out] node The node to release, or `nullptr`.
+ */
+static void scu_node_release(const ScuPersistentMap* map, ScuNode* node) {
+    if (node == nullptr) {
+        return;
+    }
+    if (
+        atomic_fetch_sub_explicit(&node->refCount, 1, memory_order_acq_rel) != 1
+    ) {
+        return;
+    }
+    ScuNode** children = scu_node_children(map, node);
+    for (isize i = 0; i < node->childCount; i++) {
+        scu_node_release(map, children[i]);
+    }
+    scu_free(node);
+}
+
+/**
+ * @brief Creates a copy of a specified node sharing all of its children.
+ *
+ * @param[in] map  The persistent map owning the node.
+ * @param[in] node The node to copy.
+ * @return A pointer to the copy, or `nullptr` on failure.
+ */
+static inline ScuNode* scu_node_copy(
+    const ScuPersistentMap* map,
+    ScuNode* node
+) {
+    ScuNode* copy = scu_node_new(map, node->entryCount, node->childCount);
+    if (copy == nullptr) {
+        return nullptr;
+    }
+    copy->dataMap = node->dataMap;
+    copy->nodeMap = node->nodeMap;
+    copy->isCollision = node->isCollision;
+    scu_memcpy(
+        copy->entries,
+        node->entries,
+        (node->entryCount * map->entrySize)
+            + (node->childCount * SCU_SIZEOF(ScuNode*))
+    );
+    ScuNode** children = scu_node_children(map, copy);
+    for (isize i = 0; i < copy->childCount; i++) {
+        scu_node_retain(children[i]);
+    }
+    return copy;
+}
+
+/**
+ * @brief Creates a node holding an existing entry and a new key-value pair,
+ * whose hashes agree in all bits consumed by the levels above.
+ *
+ * @param[in] map   The persistent map owning the node.
+ * @param[in] entry The existing entry.
+ * @param[in] hash  The hash of the new key.
+ * @param[in] key   The new key.
+ * @param[in] value The new value.
+ * @param[in] shift The number of hash bits consumed by the levels above.
+ * @return A pointer to the new node, or `nullptr` on failure.
+ */
+static ScuNode* scu_node_merge(
+    const ScuPersistentMap* map,
+    const byte* entry,
+    usize hash,
+    const void* key,
+    const void* value,
+    isize shift
+) {
+    usize entryHash = scu_entry_hash(entry);
+    if (shift >= USIZE_WIDTH) {
+        ScuNode* node = scu_node_new(map, 2, 0);
+        if (node == nullptr) {
+            return nullptr;
+        }
+        node->isCollision = true;
+        scu_memcpy(scu_node_entry(map, node, 0), entry, map->entrySize);
+        scu_entry_write(map, scu_node_entry(map, node, 1), hash, key, value);
+        return node;
+    }
+    u32 entryBit = scu_slot_bit(entryHash, shift);
+    u32 bit = scu_slot_bit(hash, shift);
+    if (entryBit == bit) {
+        ScuNode* child = scu_node_merge(
+            map,
+            entry,
+            hash,
+            key,
+            value,
+            shift + SCU_BITS_PER_LEVEL
+        );
+        if (child == nullptr) {
+            return nullptr;
+        }
+        ScuNode* node = scu_node_new(map, 0, 1);
+        if (node == nullptr) {
+            scu_node_release(map, child);
+            return nullptr;
+        }
+        node->nodeMap = bit;
+        scu_node_children(map, node)[0] = child;
+        return node;
+    }
+    ScuNode* node = scu_node_new(map, 2, 0);
+    if (node == nullptr) {
+        return nullptr;
+    }
+    node->dataMap = entryBit | bit;
+    isize entryIndex = (entryBit < bit) ? 0 : 1;
+    scu_memcpy(scu_node_entry(map, node, entryIndex), entry, map->entrySize);
+    scu_entry_write(
+        map,
+        scu_node_entry(map, node, 1 - entryIndex),
+        hash,
+        key,
+        value
+    );
+    return node;
+}
+
+/**
+ * @brief Creates a copy of a specified node with a key associated with a value.
+ *
+ * @param[in]  map     The persistent map owning the node.
+ * @param[in]  node    The node to update.
+ * @param[in]  hash    The hash of the key.
+ * @param[in]  key     The key to associate with the value.
+ * @param[in]  value   The value to associate with the key.
+ * @param[in]  shift   The number of hash bits consumed by the levels above.
+ * @param[out] isAdded Set to `true` if the key was not present before.
+ * @return A pointer to the updated copy, or `nullptr` on failure.
+ */
+static ScuNode* scu_node_set(
+    const ScuPersistentMap* map,
+    ScuNode* node,
+    usize hash,
+    const void* key,
+    const void* value,
+    isize shift,
+    bool* isAdded
+) {
+    if (node->isCollision) {
+        for (isize i = 0; i < node->entryCount; i++) {
+            byte* entry = scu_node_entry(map, node, i);
+            if (scu_entry_matches(map, entry, hash, key)) {
+                ScuNode* copy = scu_node_copy(map, node);
+                if (copy == nullptr) {
+                    return nullptr;
+                }
+                scu_entry_write(
+                    map,
+                    scu_node_entry(map, copy, i),
+                    hash,
+                    key,
+                    value
+                );
+                *isAdded = false;
+                return copy;
+            }
+        }
+        ScuNode* copy = scu_node_new(map, node->entryCount + 1, 0);
+        if (copy == nullptr) {
+            return nullptr;
+        }
+        copy->isCollision = true;
+        scu_memcpy(
+            copy->entries,
+            node->entries,
+            node->entryCount * map->entrySize
+        );
+        scu_entry_write(
+            map,
+            scu_node_entry(map, copy, node->entryCount),
+            hash,
+            key,
+            value
+        );
+        *isAdded = true;
+        return copy;
+    }
+    u32 bit = scu_slot_bit(hash, shift);
+    ScuNode** children = scu_node_children(map, node);
+    if ((node->dataMap & bit) != 0) {
+        isize index = scu_slot_index(node->dataMap, bit);
+        byte* entry = scu_node_entry(map, node, index);
+        if (scu_entry_matches(map, entry, hash, key)) {
+            ScuNode* copy = scu_node_copy(map, node);
+            if (copy == nullptr) {
+                return nullptr;
+            }
+            scu_entry_write(
+                map,
+                scu_node_entry(map, copy, index),
+                hash,
+                key,
+                value
+            );
+            *isAdded = false;
+            return copy;
+        }
+        // Push the existing entry down into a new child shared with the key.
+        ScuNode* child = scu_node_merge(
+            map,
+            entry,
+            hash,
+            key,
+            value,
+            shift + SCU_BITS_PER_LEVEL
+        );
+        if (child == nullptr) {
+            return nullptr;
+        }
+        ScuNode* copy = scu_node_new(
+            map,
+            node->entryCount - 1,
+            node->childCount + 1
+        );
+        if (copy == nullptr) {
+            scu_node_release(map, child);
+            return nullptr;
+        }
+        copy->dataMap = node->dataMap ^ bit;
+        copy->nodeMap = node->nodeMap | bit;
+        scu_memcpy(copy->entries, node->entries, index * map->entrySize);
+        scu_memcpy(
+            &copy->entries[index * map->entrySize],
+            &node->entries[(index + 1) * map->entrySize],
+            (node->entryCount - index - 1) * map->entrySize
+        );
+        isize childIndex = scu_slot_index(copy->nodeMap, bit);
+        ScuNode** copyChildren = scu_node_children(map, copy);
+        for (isize i = 0, j = 0; i < copy->childCount; i++) {
+            if (i == childIndex) {
+                copyChildren[i] = child;
+            }
+            else {
+                copyChildren[i] = children[j++];
+                scu_node_retain(copyChildren[i]);
+            }
+        }
+        *isAdded = true;
+        return copy;
+    }
+    if ((node->nodeMap & bit) != 0) {
+        isize childIndex = scu_slot_index(node->nodeMap, bit);
+        ScuNode* child = scu_node_set(
+            map,
+            children[childIndex],
+            hash,
+            key,
+            value,
+            shift + SCU_BITS_PER_LEVEL,
+            isAdded
+        );
+        if (child == nullptr) {
+            return nullptr;
+        }
+        ScuNode* copy = scu_node_copy(map, node);
+        if (copy == nullptr) {
+            scu_node_release(map, child);
+            return nullptr;
+        }
+        ScuNode** copyChildren = scu_node_children(map, copy);
+        scu_node_release(map, copyChildren[childIndex]);
+        copyChildren[childIndex] = child;
+        return copy;
+    }
+    ScuNode* copy = scu_node_new(map, node->entryCount + 1, node->childCount);
+    if (copy == nullptr) {
+        return nullptr;
+    }
+    copy->dataMap = node->dataMap | bit;
+    copy->nodeMap = node->nodeMap;
+    isize index = scu_slot_index(copy->dataMap, bit);
+    scu_memcpy(copy->entries, node->entries, index * map->entrySize);
+    scu_entry_write(map, scu_node_entry(map, copy, index), hash, key, value);
+    scu_memcpy(
+        &copy->entries[(index + 1) * map->entrySize],
+        &node->entries[index * map->entrySize],
+        ((node->entryCount - index) * map->entrySize)
+            + (node->childCount * SCU_SIZEOF(ScuNode*))
+    );
+    ScuNode** copyChildren = scu_node_children(map, copy);
+    for (isize i = 0; i < copy->childCount; i++) {
+        scu_node_retain(copyChildren[i]);
+    }
+    *isAdded = true;
+    return copy;
+}
+
+/**
+ * @brief Creates a copy of a specified node without a key.
+ *
+ * @note A resulting node with a single entry and no children is inlined into
+ * its parent by the caller, so that the trie stays as shallow as possible.
+ *
+ * @param[in]  map       The persistent map owning the node.
+ * @param[in]  node      The node to update.
+ * @param[in]  hash      The hash of the key.
+ * @param[in]  key       The key to remove.
+ * @param[in]  shift     The number of hash bits consumed by the levels above.
+ * @param[out] result    The updated copy, or `nullptr` if it would be empty.
+ * @param[out] isRemoved Set to `true` if the key was present, in which case
+ *                       `result` is set as well.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+static ScuError scu_node_remove(
+    const ScuPersistentMap* map,
+    ScuNode* node,
+    usize hash,
+    const void* key,
+    isize shift,
+    ScuNode** result,
+    bool* isRemoved
+) {
+    *isRemoved = false;
+    if (node->isCollision) {
+        for (isize i = 0; i < node->entryCount; i++) {
+            byte* entry = scu_node_entry(map, node, i);
+            if (scu_entry_matches(map, entry, hash, key)) {
+                ScuNode* copy = scu_node_new(map, node->entryCount - 1, 0);
+                if (copy == nullptr) {
+                    return SCU_ERROR_OUT_OF_MEMORY;
+                }
+                copy->isCollision = true;
+                scu_memcpy(copy->entries, node->entries, i * map->entrySize);
+                scu_memcpy(
+                    &copy->entries[i * map->entrySize],
+                    &node->entries[(i + 1) * map->entrySize],
+                    (node->entryCount - i - 1) * map->entrySize
+                );
+                *result = copy;
+                *isRemoved = true;
+                return SCU_ERROR_NONE;
+            }
+        }
+        return SCU_ERROR_NONE;
+    }
+    u32 bit = scu_slot_bit(hash, shift);
+    ScuNode** children = scu_node_children(map, node);
+    if ((node->dataMap & bit) != 0) {
+        isize index = scu_slot_index(node->dataMap, bit);
+        byte* entry = scu_node_entry(map, node, index);
+        if (!scu_entry_matches(map, entry, hash, key)) {
+            return SCU_ERROR_NONE;
+        }
+        if ((node->entryCount == 1) && (node->childCount == 0)) {
+            *result = nullptr;
+            *isRemoved = true;
+            return SCU_ERROR_NONE;
+        }
+        ScuNode* copy = scu_node_new(
+            map,
+            node->entryCount - 1,
+            node->childCount
+        );
+        if (copy == nullptr) {
+            return SCU_ERROR_OUT_OF_MEMORY;
+        }
+        copy->dataMap = node->dataMap ^ bit;
+        copy->nodeMap = node->nodeMap;
+        scu_memcpy(copy->entries, node->entries, index * map->entrySize);
+        scu_memcpy(
+            &copy->entries[index * map->entrySize],
+            &node->entries[(index + 1) * map->entrySize],
+            ((node->entryCount - index - 1) * map->entrySize)
+                + (node->childCount * SCU_SIZEOF(ScuNode*))
+        );
+        ScuNode** copyChildren = scu_node_children(map, copy);
+        for (isize i = 0; i < copy->childCount; i++) {
+            scu_node_retain(copyChildren[i]);
+        }
+        *result = copy;
+        *isRemoved = true;
+        return SCU_ERROR_NONE;
+    }
+    if ((node->nodeMap & bit) == 0) {
+        return SCU_ERROR_NONE;
+    }
+    isize childIndex = scu_slot_index(node->nodeMap, bit);
+    ScuNode* child = nullptr;
+    ScuError error = scu_node_remove(
+        map,
+        children[childIndex],
+        hash,
+        key,
+        shift + SCU_BITS_PER_LEVEL,
+        &child,
+        isRemoved
+    );
+    if ((error != SCU_ERROR_NONE) || !*isRemoved) {
+        return error;
+    }
+    // A child always holds at least two entries, so it can not become empty.
+    SCU_ASSERT(child != nullptr);
+    bool isSingleEntry = (child->entryCount == 1) && (child->childCount == 0);
+    if (!isSingleEntry) {
+        ScuNode* copy = scu_node_copy(map, node);
+        if (copy == nullptr) {
+            scu_node_release(map, child);
+            return SCU_ERROR_OUT_OF_MEMORY;
+        }
+        ScuNode** copyChildren = scu_node_children(map, copy);
+        scu_node_release(map, copyChildren[childIndex]);
+        copyChildren[childIndex] = child;
+        *result = copy;
+        return SCU_ERROR_NONE;
+    }
+    if ((shift > 0) && (node->entryCount == 0) && (node->childCount == 1)) {
+        // This node would be left with the single entry as well, so let the
+        // parent inline it instead.
+        *result = child;
+        return SCU_ERROR_NONE;
+    }
+    // Inline the single remaining entry of the child into this node.
+    ScuNode* copy = scu_node_new(
+        map,
+        node->entryCount + 1,
+        node->childCount - 1
+    );
+    if (copy == nullptr) {
+        scu_node_release(map, child);
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    copy->dataMap = node->dataMap | bit;
+    copy->nodeMap = node->nodeMap ^ bit;
+    isize index = scu_slot_index(copy->dataMap, bit);
+    scu_memcpy(copy->entries, node->entries, index * map->entrySize);
+    scu_memcpy(
+        scu_node_entry(map, copy, index),
+        scu_node_entry(map, child, 0),
+        map->entrySize
+    );
+    scu_memcpy(
+        &copy->entries[(index + 1) * map->entrySize],
+        &node->entries[index * map->entrySize],
+        (node->entryCount - index) * map->entrySize
+    );
+    ScuNode** copyChildren = scu_node_children(map, copy);
+    for (isize i = 0, j = 0; i < node->childCount; i++) {
+        if (i != childIndex) {
+            copyChildren[j] = children[i];
+            scu_node_retain(copyChildren[j]);
+            j++;
+        }
+    }
+    scu_node_release(map, child);
+    *result = copy;
+    return SCU_ERROR_NONE;
+}
+
+/**
+ * @brief Allocates a new handle for a version of a specified persistent map.
+ *
+ * @note On success, the new handle takes over the reference to `root`.
+ *
+ * @param[in] map   The persistent map to derive the version from.
+ * @param[in] root  The root node of the new version.
+ * @param[in] count The number of key-value pairs of the new version.
+ * @return A pointer to the new version, or `nullptr` on failure.
+ */
+static inline ScuPersistentMap* scu_persistent_map_with_root(
+    const ScuPersistentMap* map,
+    ScuNode* root,
+    isize count
+) {
+    ScuPersistentMap* version = scu_malloc(SCU_SIZEOF(ScuPersistentMap));
+    if (version == nullptr) {
+        return nullptr;
+    }
+    *version = *map;
+    version->root = root;
+    version->count = count;
+    return version;
+}
+
+[[nodiscard]]
+ScuPersistentMap* scu_persistent_map_new(
+    isize keySize,
+    isize valueSize,
+    ScuHashFunc* hashFunc,
+    ScuEqualFunc* equalFunc
+) {
+    SCU_ASSERT(keySize > 0);
+    SCU_ASSERT(valueSize > 0);
+    SCU_ASSERT(hashFunc != nullptr);
+    SCU_ASSERT(equalFunc != nullptr);
+    ScuPersistentMap* map = scu_malloc(SCU_SIZEOF(ScuPersistentMap));
+    if (map == nullptr) {
+        return nullptr;
+    }
+    map->keySize = keySize;
+    map->valueSize = valueSize;
+    map->keyOffset = scu_align_up(SCU_SIZEOF(usize), SCU_ALIGNOF(max_align_t));
+    map->valueOffset = scu_align_up(
+        map->keyOffset + keySize,
+        SCU_ALIGNOF(max_align_t)
+    );
+    map->entrySize = scu_align_up(
+        map->valueOffset + valueSize,
+        SCU_ALIGNOF(max_align_t)
+    );
+    map->count = 0;
+    map->hashFunc = hashFunc;
+    map->equalFunc = equalFunc;
+    map->root = nullptr;
+    return map;
+}
+
+[[nodiscard]]
+ScuPersistentMap* scu_persistent_map_clone(const ScuPersistentMap* map) {
+    SCU_ASSERT(map != nullptr);
+    ScuPersistentMap* clone = scu_persistent_map_with_root(
+        map,
+        map->root,
+        map->count
+    );
+    if ((clone != nullptr) && (clone->root != nullptr)) {
+        scu_node_retain(clone->root);
+    }
+    return clone;
+}
+
+isize scu_persistent_map_count(const ScuPersistentMap* map) {
+    SCU_ASSERT(map != nullptr);
+    return map->count;
+}
+
+/**
+ * @brief Finds the entry holding a specified key in a specified persistent map.
+ *
+ * @param[in] map The persistent map to search.
+ * @param[in] key The key to search for.
+ * @return A pointer to the entry holding the key, or `nullptr` if the key is
+ * not present.
+ */
+static inline const byte* scu_persistent_map_find(
+    const ScuPersistentMap* restrict map,
+    const void* restrict key
+) {
+    SCU_ASSERT(map != nullptr);
+    SCU_ASSERT(key != nullptr);
+    usize hash = map->hashFunc(key);
+    ScuNode* node = map->root;
+    isize shift = 0;
+    while (node != nullptr) {
+        if (node->isCollision) {
+            for (isize i = 0; i < node->entryCount; i++) {
+                const byte* entry = scu_node_entry(map, node, i);
+                if (scu_entry_matches(map, entry, hash, key)) {
+                    return entry;
+                }
+            }
+            return nullptr;
+        }
+        u32 bit = scu_slot_bit(hash, shift);
+        if ((node->dataMap & bit) != 0) {
+            const byte* entry = scu_node_entry(
+                map,
+                node,
+                scu_slot_index(node->dataMap, bit)
+            );
+            return scu_entry_matches(map, entry, hash, key) ? entry : nullptr;
+        }
+        if ((node->nodeMap & bit) == 0) {
+            return nullptr;
+        }
+        node = scu_node_children(map, node)[scu_slot_index(node->nodeMap, bit)];
+        shift += SCU_BITS_PER_LEVEL;
+    }
+    return nullptr;
+}
+
+bool scu_persistent_map_try_get_impl(
+    const ScuPersistentMap* restrict map,
+    const void* restrict key,
+    const void* restrict* restrict value
+) {
+    SCU_ASSERT(value != nullptr);
+    const byte* entry = scu_persistent_map_find(map, key);
+    if (entry == nullptr) {
+        *value = nullptr;
+        return false;
+    }
+    *value = &entry[map->valueOffset];
+    return true;
+}
+
+bool scu_persistent_map_contains_key(
+    const ScuPersistentMap* restrict map,
+    const void* restrict key
+) {
+    return scu_persistent_map_find(map, key) != nullptr;
+}
+
+[[nodiscard]]
+ScuPersistentMap* scu_persistent_map_set(
+    const ScuPersistentMap* restrict map,
+    const void* restrict key,
+    const void* restrict value
+) {
+    SCU_ASSERT(map != nullptr);
+    SCU_ASSERT(key != nullptr);
+    SCU_ASSERT(value != nullptr);
+    usize hash = map->hashFunc(key);
+    ScuNode* root;
+    bool isAdded;
+    if (map->root == nullptr) {
+        root = scu_node_new(map, 1, 0);
+        if (root == nullptr) {
+            return nullptr;
+        }
+        root->dataMap = scu_slot_bit(hash, 0);
+        scu_entry_write(map, scu_node_entry(map, root, 0), hash, key, value);
+        isAdded = true;
+    }
+    else {
+        root = scu_node_set(map, map->root, hash, key, value, 0, &isAdded);
+        if (root == nullptr) {
+            return nullptr;
+        }
+    }
+    ScuPersistentMap* version = scu_persistent_map_with_root(
+        map,
+        root,
+        map->count + (isAdded ? 1 : 0)
+    );
+    if (version == nullptr) {
+        scu_node_release(map, root);
+    }
+    return version;
+}
+
+[[nodiscard]]
+ScuPersistentMap* scu_persistent_map_remove(
+    const ScuPersistentMap* restrict map,
+    const void* restrict key
+) {
+    SCU_ASSERT(map != nullptr);
+    SCU_ASSERT(key != nullptr);
+    if (map->root == nullptr) {
+        return scu_persistent_map_clone(map);
+    }
+    ScuNode* root = nullptr;
+    bool isRemoved;
+    ScuError error = scu_node_remove(
+        map,
+        map->root,
+        map->hashFunc(key),
+        key,
+        0,
+        &root,
+        &isRemoved
+    );
+    if (error != SCU_ERROR_NONE) {
+        return nullptr;
+    }
+    if (!isRemoved) {
+        return scu_persistent_map_clone(map);
+    }
+    ScuPersistentMap* version = scu_persistent_map_with_root(
+        map,
+        root,
+        map->count - 1
+    );
+    if (version == nullptr) {
+        scu_node_release(map, root);
+    }
+    return version;
+}
+
+ScuPersistentMapIter scu_persistent_map_iter(const ScuPersistentMap* map) {
+    SCU_ASSERT(map != nullptr);
+    ScuPersistentMapIter iter = { .map = map };
+    scu_persistent_map_iter_reset(&iter);
+    return iter;
+}
+
+bool scu_persistent_map_iter_move_next(ScuPersistentMapIter* iter) {
+    SCU_ASSERT(iter != nullptr);
+    while (iter->depth >= 0) {
+        ScuNode* node = iter->nodes[iter->depth];
+        isize position = iter->positions[iter->depth];
+        if (position < node->entryCount) {
+            iter->positions[iter->depth]++;
+            return true;
+        }
+        if (position < (node->entryCount + node->childCount)) {
+            SCU_ASSERT((iter->depth + 1) < SCU_COUNTOF(iter->nodes));
+            iter->positions[iter->depth]++;
+            iter->depth++;
+            iter->nodes[iter->depth] = scu_node_children(
+                iter->map,
+                node
+            )[position - node->entryCount];
+            iter->positions[iter->depth] = 0;
+        }
+        else {
+            iter->depth--;
+        }
+    }
+    return false;
+}
+
+ScuPersistentMapEntry scu_persistent_map_iter_current(
+    const ScuPersistentMapIter* iter
+) {
+    SCU_ASSERT(iter != nullptr);
+    SCU_ASSERT(iter->depth >= 0);
+    ScuNode* node = iter->nodes[iter->depth];
+    const byte* entry = scu_node_entry(
+        iter->map,
+        node,
+        iter->positions[iter->depth] - 1
+    );
+    return (ScuPersistentMapEntry) {
+        .key = &entry[iter->map->keyOffset],
+        .value = &entry[iter->map->valueOffset]
+    };
+}
+
+void scu_persistent_map_iter_reset(ScuPersistentMapIter* iter) {
+    SCU_ASSERT(iter != nullptr);
+    iter->depth = (iter->map->root != nullptr) ? 0 : -1;
+    iter->nodes[0] = iter->map->root;
+    iter->positions[0] = 0;
+}
+
+void scu_persistent_map_free(ScuPersistentMap* map) {
+    if (map != nullptr) {
+        scu_node_release(map, map->root);
+        map->root = nullptr;
+        map->count = 0;
+        scu_free(map);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,2096 @@
+#define SCU_SHORT_ALIASES
+
+#include "scu/alloc.h"
+#include "scu/assert.h"
+#include "scu/math.h"
+#include "scu/memory.h"
+#include "scu/roaring-bitmap.h"
+#include "bits.h"
+
+#ifdef SCU_AVX2_DISPATCH
+    #include <immintrin.h>
+#endif
+
+/** @brief Represents the type of a container. */
+typedef enum ScuContainerType {
+
+    /** @brief A sorted array of values. */
+    SCU_CONTAINER_TYPE_ARRAY,
+
+    /** @brief A bitmap of 2^16 bits. */
+    SCU_CONTAINER_TYPE_BITMAP,
+
+    /** @brief A sorted array of runs of consecutive values. */
+    SCU_CONTAINER_TYPE_RUN
+
+} ScuContainerType;
+
+/** @brief Represents a run of consecutive values of a run container. */
+typedef struct ScuRun {
+
+    /** @brief The first value of the run. */
+    u16 start;
+
+    /** @brief The number of values of the run minus one. */
+    u16 length;
+
+} ScuRun;
+
+/**
+ * @brief Represents a container storing all values of a roaring bitmap that
+ * share the same upper 16 bits.
+ */
+typedef struct ScuContainer {
+
+    /** @brief The upper 16 bits shared by all values of the container. */
+    u16 key;
+
+    /** @brief The type of the container. */
+    ScuContainerType type;
+
+    /** @brief The number of values in the container. */
+    isize cardinality;
+
+    /**
+     * @brief The number of values (for array containers) or runs (for run
+     * containers) stored in the container.
+     */
+    isize count;
+
+    /**
+     * @brief The number of values (for array containers) or runs (for run
+     * containers) the container can store before it has to be resized.
+     */
+    isize capacity;
+
+    /** @brief The dynamically allocated data of the container. */
+    union {
+
+        /** @brief The sorted values (for array containers). */
+        u16* values;
+
+        /** @brief The words of the bitmap (for bitmap containers). */
+        u64* words;
+
+        /** @brief The sorted runs (for run containers). */
+        ScuRun* runs;
+
+        /** @brief An untyped pointer to the data. */
+        void* data;
+
+    };
+
+} ScuContainer;
+
+struct ScuRoaringBitmap {
+
+    /** @brief The number of containers. */
+    isize count;
+
+    /** @brief The number of containers the roaring bitmap can store. */
+    isize capacity;
+
+    /**
+     * @brief The containers.
+     *
+     * @note This is a dynamically allocated array of containers, sorted by
+     * their keys in ascending order.
+     */
+    ScuContainer* containers;
+
+};
+
+/** @brief Represents a set operation between two roaring bitmaps. */
+typedef enum ScuSetOperation {
+
+    /** @brief The intersection of two sets. */
+    SCU_SET_OPERATION_AND,
+
+    /** @brief The union of two sets. */
+    SCU_SET_OPERATION_OR,
+
+    /** @brief The difference of two sets. */
+    SCU_SET_OPERATION_ANDNOT,
+
+    /** @brief The symmetric difference of two sets. */
+    SCU_SET_OPERATION_XOR
+
+} ScuSetOperation;
+
+/** @brief The number of words of a bitmap container. */
+static constexpr isize SCU_BITMAP_WORD_COUNT = 1024;
+
+/** @brief The size of a bitmap container (in bytes). */
+static constexpr isize SCU_BITMAP_SIZE = 8192;
+
+/** @brief The maximum number of values of an array container. */
+static constexpr isize SCU_ARRAY_MAX_COUNT = 4096;
+
+/** @brief The maximum number of runs of a run container. */
+static constexpr isize SCU_RUN_MAX_COUNT = 32768;
+
+/**
+ * @brief The initial capacity of array and run containers (in values or runs,
+ * respectively).
+ */
+static constexpr isize SCU_CONTAINER_MIN_CAPACITY = 4;
+
+/** @brief The initial capacity of a roaring bitmap (in containers). */
+static constexpr isize SCU_BITMAP_MIN_CAPACITY = 4;
+
+/**
+ * @brief The number of words of the scratch space used by set operations.
+ *
+ * @note The scratch space holds the expanded bitmaps of both operands and the
+ * result. Merging two array containers requires at most 8192 values, which fit
+ * into the space of the first two bitmaps.
+ */
+static constexpr isize SCU_SCRATCH_WORD_COUNT = 3072;
+
+/** @brief The magic number identifying a serialized roaring bitmap. */
+static constexpr u32 SCU_SERIAL_MAGIC = 0x524F4152;
+
+/** @brief The version of the serialization format. */
+static constexpr u32 SCU_SERIAL_VERSION = 1;
+
+/** @brief The size of the header of a serialized roaring bitmap (in bytes). */
+static constexpr isize SCU_SERIAL_HEADER_SIZE = 12;
+
+/** @brief The size of the header of a serialized container (in bytes). */
+static constexpr isize SCU_SERIAL_CONTAINER_HEADER_SIZE = 8;
+
+/**
+ * @brief Returns the index of the first value in a sorted array that is greater
+ * than or equal to a specified value.
+ *
+ * @param[in] values The sorted array to search.
+ * @param[in] count  The number of values in the array.
+ * @param[in] value  The value to search for.
+ * @return The index of the first value greater than or equal to `value`, or
+ * `count` if there is no such value.
+ */
+static inline isize scu_lower_bound_u16(
+    const u16* values,
+    isize count,
+    u16 value
+) {
+    SCU_ASSERT((values != nullptr) || (count == 0));
+    isize low = 0;
+    isize high = count;
+    while (low < high) {
+        isize middle = low + ((high - low) / 2);
+        if (values[middle] < value) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Returns the index of the last run in a sorted array of runs that
+ * starts at or before a specified value.
+ *
+ * @param[in] runs  The sorted array of runs to search.
+ * @param[in] count The number of runs in the array.
+ * @param[in] value The value to search for.
+ * @return The index of the last run starting at or before `value`, or `-1` if
+ * there is no such run.
+ */
+static inline isize scu_find_run(const ScuRun* runs, isize count, u16 value) {
+    SCU_ASSERT((runs != nullptr) || (count == 0));
+    isize low = 0;
+    isize high = count;
+    while (low < high) {
+        isize middle = low + ((high - low) / 2);
+        if (runs[middle].start <= value) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    return low - 1;
+}
+
+/**
+ * @brief Sets all bits in a specified range of a bitmap.
+ *
+ * @param[in, out] words The words of the bitmap.
+ * @param[in]      start The index of the first bit to set (inclusive).
+ * @param[in]      end   The index of the last bit to set (exclusive).
+ */
+static inline void scu_words_set_range(u64* words, isize start, isize end) {
+    SCU_ASSERT(words != nullptr);
+    SCU_ASSERT((start >= 0) && (start < end) && (end <= (1 << 16)));
+    isize first = start >> 6;
+    isize last = (end - 1) >> 6;
+    u64 firstMask = U64_MAX << (start & 63);
+    u64 lastMask = U64_MAX >> (63 - ((end - 1) & 63));
+    if (first == last) {
+        words[first] |= firstMask & lastMask;
+        return;
+    }
+    words[first] |= firstMask;
+    for (isize i = first + 1; i < last; i++) {
+        words[i] = U64_MAX;
+    }
+    words[last] |= lastMask;
+}
+
+/**
+ * @brief Returns the number of runs of consecutive set bits of a bitmap.
+ *
+ * @param[in] words The words of the bitmap.
+ * @return The number of runs of consecutive set bits.
+ */
+static inline isize scu_words_run_count(const u64* words) {
+    SCU_ASSERT(words != nullptr);
+    isize count = 0;
+    u64 carry = 0;
+    for (isize i = 0; i < SCU_BITMAP_WORD_COUNT; i++) {
+        // A run starts at every set bit whose predecessor is not set.
+        u64 word = words[i];
+        count += scu_popcount_u64(word & ~((word << 1) | carry));
+        carry = word >> 63;
+    }
+    return count;
+}
+
+/**
+ * @brief Returns the size of a container of a specified type (in bytes).
+ *
+ * @param[in] type        The type of the container.
+ * @param[in] cardinality The number of values of the container.
+ * @param[in] runCount    The number of runs of the container.
+ * @return The size of the container.
+ */
+static inline isize scu_container_size(
+    ScuContainerType type,
+    isize cardinality,
+    isize runCount
+) {
+    switch (type) {
+        case SCU_CONTAINER_TYPE_ARRAY:
+            return cardinality * SCU_SIZEOF(u16);
+        case SCU_CONTAINER_TYPE_BITMAP:
+            return SCU_BITMAP_SIZE;
+        case SCU_CONTAINER_TYPE_RUN:
+            return runCount * SCU_SIZEOF(ScuRun);
+    }
+    SCU_UNREACHABLE();
+}
+
+/**
+ * @brief Returns the natural type of a container with a specified cardinality,
+ * i.e., the more compact one of an array and a bitmap container.
+ *
+ * @param[in] cardinality The number of values of the container.
+ * @return The natural type of the container.
+ */
+static inline ScuContainerType scu_container_natural_type(isize cardinality) {
+    return (cardinality <= SCU_ARRAY_MAX_COUNT)
+        ? SCU_CONTAINER_TYPE_ARRAY
+        : SCU_CONTAINER_TYPE_BITMAP;
+}
+
+/**
+ * @brief Deallocates the data of a specified container.
+ *
+ * @param[in, out] container The container to deallocate.
+ */
+static inline void scu_container_free(ScuContainer* container) {
+    SCU_ASSERT(container != nullptr);
+    scu_free(container->data);
+    container->data = nullptr;
+    container->cardinality = 0;
+    container->count = 0;
+    container->capacity = 0;
+}
+
+/**
+ * @brief Ensures that a specified array or run container can store at least a
+ * specified number of values or runs, respectively.
+ *
+ * @note This function dynamically allocates memory using `scu_realloc()`.
+ *
+ * @param[in, out] container The container to resize.
+ * @param[in]      capacity  The minimum capacity of the container.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred
+ * (in which case the container is left unchanged), or `SCU_ERROR_NONE` on
+ * success.
+ */
+static inline ScuError scu_container_reserve(
+    ScuContainer* container,
+    isize capacity
+) {
+    SCU_ASSERT(container != nullptr);
+    SCU_ASSERT(container->type != SCU_CONTAINER_TYPE_BITMAP);
+    if (capacity <= container->capacity) {
+        return SCU_ERROR_NONE;
+    }
+    bool isArray = (container->type == SCU_CONTAINER_TYPE_ARRAY);
+    isize maxCapacity = isArray ? SCU_ARRAY_MAX_COUNT : SCU_RUN_MAX_COUNT;
+    isize elemSize = isArray ? SCU_SIZEOF(u16) : SCU_SIZEOF(ScuRun);
+    SCU_ASSERT(capacity <= maxCapacity);
+    isize newCapacity = SCU_MIN(
+        SCU_MAX(capacity, 2 * container->capacity),
+        maxCapacity
+    );
+    void* data = scu_realloc(container->data, newCapacity * elemSize);
+    if (data == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    container->data = data;
+    container->capacity = newCapacity;
+    return SCU_ERROR_NONE;
+}
+
+/**
+ * @brief Initializes an array container with a copy of a specified array of
+ * values.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @param[out] container The container to initialize.
+ * @param[in]  key       The key of the container.
+ * @param[in]  values    The sorted values of the container.
+ * @param[in]  count     The number of values.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+static inline ScuError scu_container_from_values(
+    ScuContainer* restrict container,
+    u16 key,
+    const u16* restrict values,
+    isize count
+) {
+    SCU_ASSERT(container != nullptr);
+    SCU_ASSERT((values != nullptr) || (count == 0));
+    SCU_ASSERT((count >= 0) && (count <= SCU_ARRAY_MAX_COUNT));
+    isize capacity = SCU_MAX(count, SCU_CONTAINER_MIN_CAPACITY);
+    u16* data = scu_malloc(capacity * SCU_SIZEOF(u16));
+    if (data == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    scu_memcpy(data, values, count * SCU_SIZEOF(u16));
+    container->key = key;
+    container->type = SCU_CONTAINER_TYPE_ARRAY;
+    container->cardinality = count;
+    container->count = count;
+    container->capacity = capacity;
+    container->values = data;
+    return SCU_ERROR_NONE;
+}
+
+/**
+ * @brief Initializes a container of a specified type with the set bits of a
+ * bitmap.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @param[out] container   The container to initialize.
+ * @param[in]  key         The key of the container.
+ * @param[in]  type        The type of the container.
+ * @param[in]  words       The words of the bitmap.
+ * @param[in]  cardinality The number of set bits of the bitmap.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+static ScuError scu_container_from_words(
+    ScuContainer* restrict container,
+    u16 key,
+    ScuContainerType type,
+    const u64* restrict words,
+    isize cardinality
+) {
+    SCU_ASSERT(container != nullptr);
+    SCU_ASSERT(words != nullptr);
+    SCU_ASSERT(
+        (type != SCU_CONTAINER_TYPE_ARRAY)
+            || (cardinality <= SCU_ARRAY_MAX_COUNT)
+    );
+    container->key = key;
+    container->type = type;
+    container->cardinality = cardinality;
+    switch (type) {
+        case SCU_CONTAINER_TYPE_ARRAY: {
+            isize capacity = SCU_MAX(cardinality, SCU_CONTAINER_MIN_CAPACITY);
+            u16* values = scu_malloc(capacity * SCU_SIZEOF(u16));
+            if (values == nullptr) {
+                return SCU_ERROR_OUT_OF_MEMORY;
+            }
+            isize count = 0;
+            for (isize i = 0; i < SCU_BITMAP_WORD_COUNT; i++) {
+                u64 word = words[i];
+                while (word != 0) {
+                    values[count++] = (u16) ((i << 6)
+                        + scu_trailing_zeros_u64(word));
+                    word &= word - 1;
+                }
+            }
+            SCU_ASSERT(count == cardinality);
+            container->values = values;
+            container->count = count;
+            container->capacity = capacity;
+            return SCU_ERROR_NONE;
+        }
+        case SCU_CONTAINER_TYPE_BITMAP: {
+            u64* bitmap = scu_malloc(SCU_BITMAP_SIZE);
+            if (bitmap == nullptr) {
+                return SCU_ERROR_OUT_OF_MEMORY;
+            }
+            scu_memcpy(bitmap, words, SCU_BITMAP_SIZE);
+            container->words = bitmap;
+            container->count = SCU_BITMAP_WORD_COUNT;
+            container->capacity = SCU_BITMAP_WORD_COUNT;
+            return SCU_ERROR_NONE;
+        }
+        case SCU_CONTAINER_TYPE_RUN: {
+            isize runCount = scu_words_run_count(words);
+            isize capacity = SCU_MAX(runCount, SCU_CONTAINER_MIN_CAPACITY);
+            ScuRun* runs = scu_malloc(capacity * SCU_SIZEOF(ScuRun));
+            if (runs == nullptr) {
+                return SCU_ERROR_OUT_OF_MEMORY;
+            }
+            isize count = 0;
+            isize i = 0;
+            u64 word = words[0];
+            while (true) {
+                while ((word == 0) && (i < (SCU_BITMAP_WORD_COUNT - 1))) {
+                    word = words[++i];
+                }
+                if (word == 0) {
+                    break;
+                }
+                isize start = (i << 6) + scu_trailing_zeros_u64(word);
+                // Fill the trailing zeros to find the end of the run.
+                word |= word - 1;
+                while ((word == U64_MAX) && (i < (SCU_BITMAP_WORD_COUNT - 1))) {
+                    word = words[++i];
+                }
+                if (word == U64_MAX) {
+                    runs[count++] = (ScuRun) {
+                        .start = (u16) start,
+                        .length = (u16) ((1 << 16) - start - 1)
+                    };
+                    break;
+                }
+                isize end = (i << 6) + scu_trailing_zeros_u64(~word);
+                runs[count++] = (ScuRun) {
+                    .start = (u16) start,
+                    .length = (u16) (end - start - 1)
+                };
+                // Clear the trailing ones to continue after the run.
+                word &= word + 1;
+            }
+            SCU_ASSERT(count == runCount);
+            container->runs = runs;
+            container->count = count;
+            container->capacity = capacity;
+            return SCU_ERROR_NONE;
+        }
+    }
+    SCU_UNREACHABLE();
+}
+
+/**
+ * @brief Expands a specified container into a bitmap.
+ *
+ * @param[in]  container The container to expand.
+ * @param[out] words     The words of the bitmap.
+ */
+static inline void scu_container_to_words(
+    const ScuContainer* restrict container,
+    u64* restrict words
+) {
+    SCU_ASSERT(container != nullptr);
+    SCU_ASSERT(words != nullptr);
+    switch (container->type) {
+        case SCU_CONTAINER_TYPE_ARRAY:
+            scu_memset(words, 0, SCU_BITMAP_SIZE);
+            for (isize i = 0; i < container->count; i++) {
+                u16 value = container->values[i];
+                words[value >> 6] |= (u64) 1 << (value & 63);
+            }
+            return;
+        case SCU_CONTAINER_TYPE_BITMAP:
+            scu_memcpy(words, container->words, SCU_BITMAP_SIZE);
+            return;
+        case SCU_CONTAINER_TYPE_RUN:
+            scu_memset(words, 0, SCU_BITMAP_SIZE);
+            for (isize i = 0; i < container->count; i++) {
+                isize start = container->runs[i].start;
+                isize end = start + container->runs[i].length + 1;
+                scu_words_set_range(words, start, end);
+            }
+            return;
+    }
+    SCU_UNREACHABLE();
+}
+
+/**
+ * @brief Converts a specified container into a container of another type.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @param[in, out] container The container to convert.
+ * @param[in]      type      The new type of the container.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred
+ * (in which case the container is left unchanged), or `SCU_ERROR_NONE` on
+ * success.
+ */
+static ScuError scu_container_convert(
+    ScuContainer* container,
+    ScuContainerType type
+) {
+    SCU_ASSERT(container != nullptr);
+    if (container->type == type) {
+        return SCU_ERROR_NONE;
+    }
+    if (type == SCU_CONTAINER_TYPE_BITMAP) {
+        u64* words = scu_malloc(SCU_BITMAP_SIZE);
+        if (words == nullptr) {
+            return SCU_ERROR_OUT_OF_MEMORY;
+        }
+        scu_container_to_words(container, words);
+        scu_free(container->data);
+        container->type = SCU_CONTAINER_TYPE_BITMAP;
+        container->count = SCU_BITMAP_WORD_COUNT;
+        container->capacity = SCU_BITMAP_WORD_COUNT;
+        container->words = words;
+        return SCU_ERROR_NONE;
+    }
+    u64* temp = nullptr;
+    const u64* words = container->words;
+    if (container->type != SCU_CONTAINER_TYPE_BITMAP) {
+        temp = scu_malloc(SCU_BITMAP_SIZE);
+        if (temp == nullptr) {
+            return SCU_ERROR_OUT_OF_MEMORY;
+        }
+        scu_container_to_words(container, temp);
+        words = temp;
+    }
+    ScuContainer converted;
+    ScuError error = scu_container_from_words(
+        &converted,
+        container->key,
+        type,
+        words,
+        container->cardinality
+    );
+    scu_free(temp);
+    if (error != SCU_ERROR_NONE) {
+        return error;
+    }
+    scu_free(container->data);
+    *container = converted;
+    return SCU_ERROR_NONE;
+}
+
+/**
+ * @brief Creates a copy of a specified container.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @param[out] clone     The cloned container.
+ * @param[in]  container The container to clone.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+static inline ScuError scu_container_clone(
+    ScuContainer* restrict clone,
+    const ScuContainer* restrict container
+) {
+    SCU_ASSERT(clone != nullptr);
+    SCU_ASSERT(container != nullptr);
+    isize size = scu_container_size(
+        container->type,
+        container->count,
+        container->count
+    );
+    isize capacity = (container->type == SCU_CONTAINER_TYPE_BITMAP)
+        ? SCU_BITMAP_WORD_COUNT
+        : SCU_MAX(container->count, SCU_CONTAINER_MIN_CAPACITY);
+    isize allocSize = scu_container_size(container->type, capacity, capacity);
+    void* data = scu_malloc(allocSize);
+    if (data == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    scu_memcpy(data, container->data, size);
+    *clone = *container;
+    clone->capacity = capacity;
+    clone->data = data;
+    return SCU_ERROR_NONE;
+}
+
+/**
+ * @brief Determines if a specified container contains a value.
+ *
+ * @param[in] container The container to search.
+ * @param[in] value     The lower 16 bits of the value to search for.
+ * @return `true` if the value is contained in the container, otherwise
+ * `false`.
+ */
+static inline bool scu_container_contains(
+    const ScuContainer* container,
+    u16 value
+) {
+    SCU_ASSERT(container != nullptr);
+    switch (container->type) {
+        case SCU_CONTAINER_TYPE_ARRAY: {
+            isize i = scu_lower_bound_u16(
+                container->values,
+                container->count,
+                value
+            );
+            return (i < container->count) && (container->values[i] == value);
+        }
+        case SCU_CONTAINER_TYPE_BITMAP:
+            return ((container->words[value >> 6] >> (value & 63)) & 1) != 0;
+        case SCU_CONTAINER_TYPE_RUN: {
+            isize i = scu_find_run(container->runs, container->count, value);
+            return (i >= 0)
+                && (value <= (container->runs[i].start
+                    + container->runs[i].length));
+        }
+    }
+    SCU_UNREACHABLE();
+}
+
+/**
+ * @brief Adds a value to a specified container.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()` and
+ * `scu_realloc()`.
+ *
+ * @param[in, out] container The container to add the value to.
+ * @param[in]      value     The lower 16 bits of the value to add.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred
+ * (in which case the container is left unchanged), or `SCU_ERROR_NONE` on
+ * success.
+ */
+static ScuError scu_container_add(ScuContainer* container, u16 value) {
+    SCU_ASSERT(container != nullptr);
+    switch (container->type) {
+        case SCU_CONTAINER_TYPE_ARRAY: {
+            isize i = scu_lower_bound_u16(
+                container->values,
+                container->count,
+                value
+            );
+            if ((i < container->count) && (container->values[i] == value)) {
+                return SCU_ERROR_NONE;
+            }
+            if (container->count < SCU_ARRAY_MAX_COUNT) {
+                ScuError error = scu_container_reserve(
+                    container,
+                    container->count + 1
+                );
+                if (error != SCU_ERROR_NONE) {
+                    return error;
+                }
+                scu_memmove(
+                    &container->values[i + 1],
+                    &container->values[i],
+                    (container->count - i) * SCU_SIZEOF(u16)
+                );
+                container->values[i] = value;
+                container->count++;
+                container->cardinality++;
+                return SCU_ERROR_NONE;
+            }
+            ScuError error = scu_container_convert(
+                container,
+                SCU_CONTAINER_TYPE_BITMAP
+            );
+            if (error != SCU_ERROR_NONE) {
+                return error;
+            }
+            container->words[value >> 6] |= (u64) 1 << (value & 63);
+            container->cardinality++;
+            return SCU_ERROR_NONE;
+        }
+        case SCU_CONTAINER_TYPE_BITMAP: {
+            u64 mask = (u64) 1 << (value & 63);
+            if ((container->words[value >> 6] & mask) == 0) {
+                container->words[value >> 6] |= mask;
+                container->cardinality++;
+            }
+            return SCU_ERROR_NONE;
+        }
+        case SCU_CONTAINER_TYPE_RUN: {
+            ScuRun* runs = container->runs;
+            isize i = scu_find_run(runs, container->count, value);
+            if (i >= 0) {
+                isize end = runs[i].start + runs[i].length;
+                if (value <= end) {
+                    return SCU_ERROR_NONE;
+                }
+                if (value == (end + 1)) {
+                    runs[i].length++;
+                    container->cardinality++;
+                    // Merge the run with its successor if they are adjacent.
+                    if (
+                        ((i + 1) < container->count)
+                            && (runs[i + 1].start == (value + 1))
+                    ) {
+                        runs[i].length = (u16) (runs[i].length
+                            + runs[i + 1].length + 1);
+                        scu_memmove(
+                            &runs[i + 1],
+                            &runs[i + 2],
+                            (container->count - i - 2) * SCU_SIZEOF(ScuRun)
+                        );
+                        container->count--;
+                    }
+                    return SCU_ERROR_NONE;
+                }
+            }
+            if (
+                ((i + 1) < container->count)
+                    && (runs[i + 1].start == (value + 1))
+            ) {
+                runs[i + 1].start--;
+                runs[i + 1].length++;
+                container->cardinality++;
+                return SCU_ERROR_NONE;
+            }
+            ScuError error = scu_container_reserve(
+                container,
+                container->count + 1
+            );
+            if (error != SCU_ERROR_NONE) {
+                return error;
+            }
+            runs = container->runs;
+            scu_memmove(
+                &runs[i + 2],
+                &runs[i + 1],
+                (container->count - i - 1) * SCU_SIZEOF(ScuRun)
+            );
+            runs[i + 1] = (ScuRun) { .start = value, .length = 0 };
+            container->count++;
+            container->cardinality++;
+            // Fall back to the natural representation if the runs have become
+            // too fragmented. Failing to do so does not affect correctness.
+            ScuContainerType naturalType = scu_container_natural_type(
+                container->cardinality
+            );
+            if (
+                scu_container_size(
+                    SCU_CONTAINER_TYPE_RUN,
+                    container->cardinality,
+                    container->count
+                ) > scu_container_size(
+                    naturalType,
+                    container->cardinality,
+                    container->count
+                )
+            ) {
+                (void) scu_container_convert(container, naturalType);
+            }
+            return SCU_ERROR_NONE;
+        }
+    }
+    SCU_UNREACHABLE();
+}
+
+/**
+ * @brief Removes a value from a specified container.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()` and
+ * `scu_realloc()`.
+ *
+ * @param[in, out] container The container to remove the value from.
+ * @param[in]      value     The lower 16 bits of the value to remove.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred
+ * (in which case the container is left unchanged), or `SCU_ERROR_NONE` on
+ * success.
+ */
+static ScuError scu_container_remove(ScuContainer* container, u16 value) {
+    SCU_ASSERT(container != nullptr);
+    switch (container->type) {
+        case SCU_CONTAINER_TYPE_ARRAY: {
+            isize i = scu_lower_bound_u16(
+                container->values,
+                container->count,
+                value
+            );
+            if ((i == container->count) || (container->values[i] != value)) {
+                return SCU_ERROR_NONE;
+            }
+            scu_memmove(
+                &container->values[i],
+                &container->values[i + 1],
+                (container->count - i - 1) * SCU_SIZEOF(u16)
+            );
+            container->count--;
+            container->cardinality--;
+            return SCU_ERROR_NONE;
+        }
+        case SCU_CONTAINER_TYPE_BITMAP: {
+            u64 mask = (u64) 1 << (value & 63);
+            if ((container->words[value >> 6] & mask) == 0) {
+                return SCU_ERROR_NONE;
+            }
+            container->words[value >> 6] &= ~mask;
+            container->cardinality--;
+            // Failing to convert the container does not affect correctness, as
+            // a bitmap can represent any number of values.
+            if (container->cardinality <= SCU_ARRAY_MAX_COUNT) {
+                (void) scu_container_convert(
+                    container,
+                    SCU_CONTAINER_TYPE_ARRAY
+                );
+            }
+            return SCU_ERROR_NONE;
+        }
+        case SCU_CONTAINER_TYPE_RUN: {
+            ScuRun* runs = container->runs;
+            isize i = scu_find_run(runs, container->count, value);
+            if ((i < 0) || (value > (runs[i].start + runs[i].length))) {
+                return SCU_ERROR_NONE;
+            }
+            isize start = runs[i].start;
+            isize end = start + runs[i].length;
+            if (start == end) {
+                scu_memmove(
+                    &runs[i],
+                    &runs[i + 1],
+                    (container->count - i - 1) * SCU_SIZEOF(ScuRun)
+                );
+                container->count--;
+            }
+            else if (value == start) {
+                runs[i].start++;
+                runs[i].length--;
+            }
+            else if (value == end) {
+                runs[i].length--;
+            }
+            else {
+                // Split the run into two runs around the value.
+                ScuError error = scu_container_reserve(
+                    container,
+                    container->count + 1
+                );
+                if (error != SCU_ERROR_NONE) {
+                    return error;
+                }
+                runs = container->runs;
+                scu_memmove(
+                    &runs[i + 2],
+                    &runs[i + 1],
+                    (container->count - i - 1) * SCU_SIZEOF(ScuRun)
+                );
+                runs[i] = (ScuRun) {
+                    .start = (u16) start,
+                    .length = (u16) (value - start - 1)
+                };
+                runs[i + 1] = (ScuRun) {
+                    .start = (u16) (value + 1),
+                    .length = (u16) (end - value - 1)
+                };
+                container->count++;
+            }
+            container->cardinality--;
+            return SCU_ERROR_NONE;
+        }
+    }
+    SCU_UNREACHABLE();
+}
+
+/**
+ * @brief Performs a set operation on two sorted arrays of values.
+ *
+ * @param[in]  operation  The set operation to perform.
+ * @param[in]  left       The first sorted array.
+ * @param[in]  leftCount  The number of values of the first array.
+ * @param[in]  right      The second sorted array.
+ * @param[in]  rightCount The number of values of the second array.
+ * @param[out] result     The sorted array to store the result in, which must
+ *                        be large enough to store `leftCount + rightCount`
+ *                        values.
+ * @return The number of values stored in `result`.
+ */
+static isize scu_values_operation(
+    ScuSetOperation operation,
+    const u16* restrict left,
+    isize leftCount,
+    const u16* restrict right,
+    isize rightCount,
+    u16* restrict result
+) {
+    SCU_ASSERT((left != nullptr) || (leftCount == 0));
+    SCU_ASSERT((right != nullptr) || (rightCount == 0));
+    SCU_ASSERT(result != nullptr);
+    isize count = 0;
+    isize i = 0;
+    isize j = 0;
+    if (operation == SCU_SET_OPERATION_AND) {
+        // If one array is much smaller than the other one, it is faster to
+        // search for its values than to merge both arrays.
+        if ((leftCount * 32) < rightCount) {
+            for (; i < leftCount; i++) {
+                j += scu_lower_bound_u16(&right[j], rightCount - j, left[i]);
+                if ((j < rightCount) && (right[j] == left[i])) {
+                    result[count++] = left[i];
+                }
+            }
+            return count;
+        }
+        if ((rightCount * 32) < leftCount) {
+            for (; j < rightCount; j++) {
+                i += scu_lower_bound_u16(&left[i], leftCount - i, right[j]);
+                if ((i < leftCount) && (left[i] == right[j])) {
+                    result[count++] = right[j];
+                }
+            }
+            return count;
+        }
+    }
+    while ((i < leftCount) && (j < rightCount)) {
+        if (left[i] < right[j]) {
+            if (operation != SCU_SET_OPERATION_AND) {
+                result[count++] = left[i];
+            }
+            i++;
+        }
+        else if (right[j] < left[i]) {
+            if (
+                (operation == SCU_SET_OPERATION_OR)
+                    || (operation == SCU_SET_OPERATION_XOR)
+            ) {
+                result[count++] = right[j];
+            }
+            j++;
+        }
+        else {
+            if (
+                (operation == SCU_SET_OPERATION_AND)
+                    || (operation == SCU_SET_OPERATION_OR)
+            ) {
+                result[count++] = left[i];
+            }
+            i++;
+            j++;
+        }
+    }
+    if (operation != SCU_SET_OPERATION_AND) {
+        for (; i < leftCount; i++) {
+            result[count++] = left[i];
+        }
+    }
+    if (
+        (operation == SCU_SET_OPERATION_OR)
+            || (operation == SCU_SET_OPERATION_XOR)
+    ) {
+        for (; j < rightCount; j++) {
+            result[count++] = right[j];
+        }
+    }
+    return count;
+}
+
+#ifdef SCU_AVX2_DISPATCH
+    /**
+     * @brief Returns the number of set bits of each byte of a specified
+     * vector.
+     *
+     * @note Each nibble is looked up in a table of 16 entries, which avoids
+     * extracting the four words for the scalar population count instruction.
+     *
+     * @param[in] v The vector to examine.
+     * @return The number of set bits of each byte.
+     */
+    __attribute__((target("avx2")))
+    static inline __m256i scu_popcount_bytes(__m256i v) {
+        const __m256i table = _mm256_setr_epi8(
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+        );
+        const __m256i mask = _mm256_set1_epi8(0x0F);
+        __m256i low = _mm256_and_si256(v, mask);
+        __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), mask);
+        return _mm256_add_epi8(
+            _mm256_shuffle_epi8(table, low),
+            _mm256_shuffle_epi8(table, high)
+        );
+    }
+
+    /**
+     * @brief Returns the number of set bits of a bitmap using AVX2.
+     *
+     * @param[in] words The words of the bitmap.
+     * @return The number of set bits.
+     */
+    __attribute__((target("avx2")))
+    static isize scu_words_cardinality_avx2(const u64* words) {
+        // The byte counts of each word are summed against zero, which yields
+        // one partial cardinality per word of the accumulator.
+        __m256i total = _mm256_setzero_si256();
+        isize i = 0;
+        for (; (i + 4) <= SCU_BITMAP_WORD_COUNT; i += 4) {
+            __m256i v = _mm256_loadu_si256((const __m256i*) &words[i]);
+            total = _mm256_add_epi64(
+                total,
+                _mm256_sad_epu8(scu_popcount_bytes(v), _mm256_setzero_si256())
+            );
+        }
+        isize cardinality = _mm256_extract_epi64(total, 0)
+            + _mm256_extract_epi64(total, 1)
+            + _mm256_extract_epi64(total, 2)
+            + _mm256_extract_epi64(total, 3);
+        for (; i < SCU_BITMAP_WORD_COUNT; i++) {
+            cardinality += scu_popcount_u64(words[i]);
+        }
+        return cardinality;
+    }
+
+    /**
+     * @brief Performs a set operation on two bitmaps using AVX2, four words at
+     * a time.
+     *
+     * @param[in]  operation The set operation to perform.
+     * @param[in]  left      The words of the first bitmap.
+     * @param[in]  right     The words of the second bitmap.
+     * @param[out] result    The words of the resulting bitmap.
+     * @return The number of words processed, which is the number of words of a
+     * bitmap rounded down to a multiple of four.
+     */
+    __attribute__((target("avx2")))
+    static isize scu_words_operation_avx2(
+        ScuSetOperation operation,
+        const u64* restrict left,
+        const u64* restrict right,
+        u64* restrict result
+    ) {
+        isize i = 0;
+        switch (operation) {
+            case SCU_SET_OPERATION_AND:
+                for (; (i + 4) <= SCU_BITMAP_WORD_COUNT; i += 4) {
+                    __m256i a = _mm256_loadu_si256((const __m256i*) &left[i]);
+                    __m256i b = _mm256_loadu_si256(
+                        (const __m256i*) &right[i]
+                    );
+                    _mm256_storeu_si256(
+                        (__m256i*) &result[i],
+                        _mm256_and_si256(a, b)
+                    );
+                }
+                break;
+            case SCU_SET_OPERATION_OR:
+                for (; (i + 4) <= SCU_BITMAP_WORD_COUNT; i += 4) {
+                    __m256i a = _mm256_loadu_si256((const __m256i*) &left[i]);
+                    __m256i b = _mm256_loadu_si256(
+                        (const __m256i*) &right[i]
+                    );
+                    _mm256_storeu_si256(
+                        (__m256i*) &result[i],
+                        _mm256_or_si256(a, b)
+                    );
+                }
+                break;
+            case SCU_SET_OPERATION_ANDNOT:
+                for (; (i + 4) <= SCU_BITMAP_WORD_COUNT; i += 4) {
+                    __m256i a = _mm256_loadu_si256((const __m256i*) &left[i]);
+                    __m256i b = _mm256_loadu_si256(
+                        (const __m256i*) &right[i]
+                    );
+                    _mm256_storeu_si256(
+                        (__m256i*) &result[i],
+                        _mm256_andnot_si256(b, a)
+                    );
+                }
+                break;
+            case SCU_SET_OPERATION_XOR:
+                for (; (i + 4) <= SCU_BITMAP_WORD_COUNT; i += 4) {
+                    __m256i a = _mm256_loadu_si256((const __m256i*) &left[i]);
+                    __m256i b = _mm256_loadu_si256(
+                        (const __m256i*) &right[i]
+                    );
+                    _mm256_storeu_si256(
+                        (__m256i*) &result[i],
+                        _mm256_xor_si256(a, b)
+                    );
+                }
+                break;
+        }
+        return i;
+    }
+#endif
+
+/**
+ * @brief Returns the number of set bits of a bitmap.
+ *
+ * @param[in] words The words of the bitmap.
+ * @return The number of set bits.
+ */
+static isize scu_words_cardinality(const u64* words) {
+    SCU_ASSERT(words != nullptr);
+#ifdef SCU_AVX2_DISPATCH
+    if (scu_has_avx2()) {
+        return scu_words_cardinality_avx2(words);
+    }
+#endif
+    isize cardinality = 0;
+    for (isize i = 0; i < SCU_BITMAP_WORD_COUNT; i++) {
+        cardinality += scu_popcount_u64(words[i]);
+    }
+    return cardinality;
+}
+
+/**
+ * @brief Performs a set operation on two bitmaps.
+ *
+ * @note If the processor supports AVX2, four words are processed at once.
+ * Otherwise, the loops are kept free of dependencies between iterations, so
+ * that the compiler can vectorize them.
+ *
+ * @param[in]  operation The set operation to perform.
+ * @param[in]  left      The words of the first bitmap.
+ * @param[in]  right     The words of the second bitmap.
+ * @param[out] result    The words of the resulting bitmap.
+ * @return The number of set bits of the resulting bitmap.
+ */
+static isize scu_words_operation(
+    ScuSetOperation operation,
+    const u64* restrict left,
+    const u64* restrict right,
+    u64* restrict result
+) {
+    SCU_ASSERT(left != nullptr);
+    SCU_ASSERT(right != nullptr);
+    SCU_ASSERT(result != nullptr);
+    isize i = 0;
+#ifdef SCU_AVX2_DISPATCH
+    if (scu_has_avx2()) {
+        i = scu_words_operation_avx2(operation, left, right, result);
+    }
+#endif
+    switch (operation) {
+        case SCU_SET_OPERATION_AND:
+            for (; i < SCU_BITMAP_WORD_COUNT; i++) {
+                result[i] = left[i] & right[i];
+            }
+            break;
+        case SCU_SET_OPERATION_OR:
+            for (; i < SCU_BITMAP_WORD_COUNT; i++) {
+                result[i] = left[i] | right[i];
+            }
+            break;
+        case SCU_SET_OPERATION_ANDNOT:
+            for (; i < SCU_BITMAP_WORD_COUNT; i++) {
+                result[i] = left[i] & ~right[i];
+            }
+            break;
+        case SCU_SET_OPERATION_XOR:
+            for (; i < SCU_BITMAP_WORD_COUNT; i++) {
+                result[i] = left[i] ^ right[i];
+            }
+            break;
+    }
+    return scu_words_cardinality(result);
+}
+
+/**
+ * @brief Performs a set operation on two containers with the same key.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @param[in]  operation The set operation to perform.
+ * @param[in]  left      The first container.
+ * @param[in]  right     The second container.
+ * @param[in]  scratch   A scratch space of `SCU_SCRATCH_WORD_COUNT` words.
+ * @param[out] result    The resulting container, whose cardinality is zero and
+ *                       which has no data if the result is empty.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+static ScuError scu_container_operation(
+    ScuSetOperation operation,
+    const ScuContainer* left,
+    const ScuContainer* right,
+    u64* restrict scratch,
+    ScuContainer* restrict result
+) {
+    SCU_ASSERT(left != nullptr);
+    SCU_ASSERT(right != nullptr);
+    SCU_ASSERT(left->key == right->key);
+    SCU_ASSERT(scratch != nullptr);
+    SCU_ASSERT(result != nullptr);
+    *result = (ScuContainer) { .key = left->key, .data = nullptr };
+    u16* values = (u16*) scratch;
+    u64* resultWords = &scratch[2 * SCU_BITMAP_WORD_COUNT];
+    if (
+        (left->type == SCU_CONTAINER_TYPE_ARRAY)
+            && (right->type == SCU_CONTAINER_TYPE_ARRAY)
+    ) {
+        isize count = scu_values_operation(
+            operation,
+            left->values,
+            left->count,
+            right->values,
+            right->count,
+            values
+        );
+        if (count == 0) {
+            return SCU_ERROR_NONE;
+        }
+        if (count <= SCU_ARRAY_MAX_COUNT) {
+            return scu_container_from_values(result, left->key, values, count);
+        }
+        scu_memset(resultWords, 0, SCU_BITMAP_SIZE);
+        for (isize i = 0; i < count; i++) {
+            resultWords[values[i] >> 6] |= (u64) 1 << (values[i] & 63);
+        }
+        return scu_container_from_words(
+            result,
+            left->key,
+            SCU_CONTAINER_TYPE_BITMAP,
+            resultWords,
+            count
+        );
+    }
+    // The result of an intersection or difference with a small array is at most
+    // as large as the array, so it suffices to probe the other container.
+    const ScuContainer* probed = nullptr;
+    const ScuContainer* probing = nullptr;
+    if (
+        (left->type == SCU_CONTAINER_TYPE_ARRAY)
+            && (
+                (operation == SCU_SET_OPERATION_AND)
+                    || (operation == SCU_SET_OPERATION_ANDNOT)
+            )
+    ) {
+        probing = left;
+        probed = right;
+    }
+    else if (
+        (right->type == SCU_CONTAINER_TYPE_ARRAY)
+            && (operation == SCU_SET_OPERATION_AND)
+    ) {
+        probing = right;
+        probed = left;
+    }
+    if (probing != nullptr) {
+        bool keep = (operation == SCU_SET_OPERATION_AND);
+        isize count = 0;
+        for (isize i = 0; i < probing->count; i++) {
+            u16 value = probing->values[i];
+            if (scu_container_contains(probed, value) == keep) {
+                values[count++] = value;
+            }
+        }
+        if (count == 0) {
+            return SCU_ERROR_NONE;
+        }
+        return scu_container_from_values(result, left->key, values, count);
+    }
+    const u64* leftWords = left->words;
+    if (left->type != SCU_CONTAINER_TYPE_BITMAP) {
+        scu_container_to_words(left, scratch);
+        leftWords = scratch;
+    }
+    const u64* rightWords = right->words;
+    if (right->type != SCU_CONTAINER_TYPE_BITMAP) {
+        scu_container_to_words(right, &scratch[SCU_BITMAP_WORD_COUNT]);
+        rightWords = &scratch[SCU_BITMAP_WORD_COUNT];
+    }
+    isize cardinality = scu_words_operation(
+        operation,
+        leftWords,
+        rightWords,
+        resultWords
+    );
+    if (cardinality == 0) {
+        return SCU_ERROR_NONE;
+    }
+    return scu_container_from_words(
+        result,
+        left->key,
+        scu_container_natural_type(cardinality),
+        resultWords,
+        cardinality
+    );
+}
+
+/**
+ * @brief Ensures that a specified roaring bitmap can store at least a specified
+ * number of containers.
+ *
+ * @note This function dynamically allocates memory using `scu_realloc()`.
+ *
+ * @param[in, out] bitmap   The roaring bitmap to resize.
+ * @param[in]      capacity The minimum capacity of the roaring bitmap.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred
+ * (in which case the roaring bitmap is left unchanged), or `SCU_ERROR_NONE` on
+ * success.
+ */
+static inline ScuError scu_roaring_bitmap_reserve(
+    ScuRoaringBitmap* bitmap,
+    isize capacity
+) {
+    SCU_ASSERT(bitmap != nullptr);
+    if (capacity <= bitmap->capacity) {
+        return SCU_ERROR_NONE;
+    }
+    isize newCapacity = SCU_MAX(
+        SCU_MAX(capacity, 2 * bitmap->capacity),
+        SCU_BITMAP_MIN_CAPACITY
+    );
+    ScuContainer* containers = scu_realloc(
+        bitmap->containers,
+        newCapacity * SCU_SIZEOF(ScuContainer)
+    );
+    if (containers == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    bitmap->containers = containers;
+    bitmap->capacity = newCapacity;
+    return SCU_ERROR_NONE;
+}
+
+/**
+ * @brief Returns the index of the first container of a specified roaring
+ * bitmap whose key is greater than or equal to a specified key.
+ *
+ * @param[in] bitmap The roaring bitmap to search.
+ * @param[in] key    The key to search for.
+ * @return The index of the first container whose key is greater than or equal
+ * to `key`, or the number of containers if there is no such container.
+ */
+static inline isize scu_roaring_bitmap_lower_bound(
+    const ScuRoaringBitmap* bitmap,
+    u16 key
+) {
+    SCU_ASSERT(bitmap != nullptr);
+    isize low = 0;
+    isize high = bitmap->count;
+    while (low < high) {
+        isize middle = low + ((high - low) / 2);
+        if (bitmap->containers[middle].key < key) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+[[nodiscard]]
+ScuRoaringBitmap* scu_roaring_bitmap_new() {
+    ScuRoaringBitmap* bitmap = scu_malloc(SCU_SIZEOF(ScuRoaringBitmap));
+    if (bitmap == nullptr) {
+        return nullptr;
+    }
+    bitmap->count = 0;
+    bitmap->capacity = 0;
+    bitmap->containers = nullptr;
+    return bitmap;
+}
+
+[[nodiscard]]
+ScuRoaringBitmap* scu_roaring_bitmap_clone(const ScuRoaringBitmap* bitmap) {
+    SCU_ASSERT(bitmap != nullptr);
+    ScuRoaringBitmap* clone = scu_roaring_bitmap_new();
+    if (clone == nullptr) {
+        return nullptr;
+    }
+    if (scu_roaring_bitmap_reserve(clone, bitmap->count) != SCU_ERROR_NONE) {
+        scu_roaring_bitmap_free(clone);
+        return nullptr;
+    }
+    for (isize i = 0; i < bitmap->count; i++) {
+        ScuError error = scu_container_clone(
+            &clone->containers[i],
+            &bitmap->containers[i]
+        );
+        if (error != SCU_ERROR_NONE) {
+            scu_roaring_bitmap_free(clone);
+            return nullptr;
+        }
+        clone->count++;
+    }
+    return clone;
+}
+
+isize scu_roaring_bitmap_count(const ScuRoaringBitmap* bitmap) {
+    SCU_ASSERT(bitmap != nullptr);
+    isize count = 0;
+    for (isize i = 0; i < bitmap->count; i++) {
+        count += bitmap->containers[i].cardinality;
+    }
+    return count;
+}
+
+ScuError scu_roaring_bitmap_add(ScuRoaringBitmap* bitmap, u32 value) {
+    SCU_ASSERT(bitmap != nullptr);
+    u16 key = (u16) (value >> 16);
+    u16 low = (u16) value;
+    isize i = scu_roaring_bitmap_lower_bound(bitmap, key);
+    if ((i < bitmap->count) && (bitmap->containers[i].key == key)) {
+        return scu_container_add(&bitmap->containers[i], low);
+    }
+    ScuError error = scu_roaring_bitmap_reserve(bitmap, bitmap->count + 1);
+    if (error != SCU_ERROR_NONE) {
+        return error;
+    }
+    ScuContainer container;
+    error = scu_container_from_values(&container, key, &low, 1);
+    if (error != SCU_ERROR_NONE) {
+        return error;
+    }
+    scu_memmove(
+        &bitmap->containers[i + 1],
+        &bitmap->containers[i],
+        (bitmap->count - i) * SCU_SIZEOF(ScuContainer)
+    );
+    bitmap->containers[i] = container;
+    bitmap->count++;
+    return SCU_ERROR_NONE;
+}
+
+bool scu_roaring_bitmap_contains(const ScuRoaringBitmap* bitmap, u32 value) {
+    SCU_ASSERT(bitmap != nullptr);
+    u16 key = (u16) (value >> 16);
+    isize i = scu_roaring_bitmap_lower_bound(bitmap, key);
+    return (i < bitmap->count)
+        && (bitmap->containers[i].key == key)
+        && scu_container_contains(&bitmap->containers[i], (u16) value);
+}
+
+ScuError scu_roaring_bitmap_remove(ScuRoaringBitmap* bitmap, u32 value) {
+    SCU_ASSERT(bitmap != nullptr);
+    u16 key = (u16) (value >> 16);
+    isize i = scu_roaring_bitmap_lower_bound(bitmap, key);
+    if ((i == bitmap->count) || (bitmap->containers[i].key != key)) {
+        return SCU_ERROR_NONE;
+    }
+    ScuContainer* container = &bitmap->containers[i];
+    ScuError error = scu_container_remove(container, (u16) value);
+    if (error != SCU_ERROR_NONE) {
+        return error;
+    }
+    if (container->cardinality == 0) {
+        scu_container_free(container);
+        scu_memmove(
+            &bitmap->containers[i],
+            &bitmap->containers[i + 1],
+            (bitmap->count - i - 1) * SCU_SIZEOF(ScuContainer)
+        );
+        bitmap->count--;
+    }
+    return SCU_ERROR_NONE;
+}
+
+void scu_roaring_bitmap_clear(ScuRoaringBitmap* bitmap) {
+    SCU_ASSERT(bitmap != nullptr);
+    for (isize i = 0; i < bitmap->count; i++) {
+        scu_container_free(&bitmap->containers[i]);
+    }
+    bitmap->count = 0;
+}
+
+ScuError scu_roaring_bitmap_run_optimize(ScuRoaringBitmap* bitmap) {
+    SCU_ASSERT(bitmap != nullptr);
+    if (bitmap->count == 0) {
+        return SCU_ERROR_NONE;
+    }
+    u64* scratch = scu_malloc(SCU_BITMAP_SIZE);
+    if (scratch == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    ScuError error = SCU_ERROR_NONE;
+    for (isize i = 0; i < bitmap->count; i++) {
+        ScuContainer* container = &bitmap->containers[i];
+        const u64* words = container->words;
+        if (container->type != SCU_CONTAINER_TYPE_BITMAP) {
+            scu_container_to_words(container, scratch);
+            words = scratch;
+        }
+        isize runCount = scu_words_run_count(words);
+        ScuContainerType naturalType = scu_container_natural_type(
+            container->cardinality
+        );
+        bool preferRuns = scu_container_size(
+            SCU_CONTAINER_TYPE_RUN,
+            container->cardinality,
+            runCount
+        ) < scu_container_size(naturalType, container->cardinality, runCount);
+        ScuContainerType type = preferRuns
+            ? SCU_CONTAINER_TYPE_RUN
+            : naturalType;
+        if (type == container->type) {
+            continue;
+        }
+        ScuContainer optimized;
+        error = scu_container_from_words(
+            &optimized,
+            container->key,
+            type,
+            words,
+            container->cardinality
+        );
+        if (error != SCU_ERROR_NONE) {
+            break;
+        }
+        scu_free(container->data);
+        *container = optimized;
+    }
+    scu_free(scratch);
+    return error;
+}
+
+/**
+ * @brief Performs a set operation on two roaring bitmaps.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @param[in] operation The set operation to perform.
+ * @param[in] left      The first roaring bitmap.
+ * @param[in] right     The second roaring bitmap.
+ * @return A pointer to a new roaring bitmap containing the result, or `nullptr`
+ * on failure.
+ */
+static ScuRoaringBitmap* scu_roaring_bitmap_operation(
+    ScuSetOperation operation,
+    const ScuRoaringBitmap* left,
+    const ScuRoaringBitmap* right
+) {
+    SCU_ASSERT(left != nullptr);
+    SCU_ASSERT(right != nullptr);
+    ScuRoaringBitmap* result = scu_roaring_bitmap_new();
+    if (result == nullptr) {
+        return nullptr;
+    }
+    u64* scratch = scu_malloc(SCU_SCRATCH_WORD_COUNT * SCU_SIZEOF(u64));
+    if (
+        (scratch == nullptr)
+            || (
+                scu_roaring_bitmap_reserve(result, left->count + right->count)
+                    != SCU_ERROR_NONE
+            )
+    ) {
+        scu_free(scratch);
+        scu_roaring_bitmap_free(result);
+        return nullptr;
+    }
+    bool keepLeft = (operation != SCU_SET_OPERATION_AND);
+    bool keepRight = (operation == SCU_SET_OPERATION_OR)
+        || (operation == SCU_SET_OPERATION_XOR);
+    isize i = 0;
+    isize j = 0;
+    while ((i < left->count) || (j < right->count)) {
+        const ScuContainer* leftContainer = (i < left->count)
+            ? &left->containers[i]
+            : nullptr;
+        const ScuContainer* rightContainer = (j < right->count)
+            ? &right->containers[j]
+            : nullptr;
+        ScuContainer container = { .data = nullptr };
+        ScuError error = SCU_ERROR_NONE;
+        if (
+            (rightContainer == nullptr)
+                || ((leftContainer != nullptr)
+                    && (leftContainer->key < rightContainer->key))
+        ) {
+            if (keepLeft) {
+                error = scu_container_clone(&container, leftContainer);
+            }
+            i++;
+        }
+        else if (
+            (leftContainer == nullptr)
+                || (rightContainer->key < leftContainer->key)
+        ) {
+            if (keepRight) {
+                error = scu_container_clone(&container, rightContainer);
+            }
+            j++;
+        }
+        else {
+            error = scu_container_operation(
+                operation,
+                leftContainer,
+                rightContainer,
+                scratch,
+                &container
+            );
+            i++;
+            j++;
+        }
+        if (error != SCU_ERROR_NONE) {
+            scu_free(scratch);
+            scu_roaring_bitmap_free(result);
+            return nullptr;
+        }
+        if (container.data != nullptr) {
+            result->containers[result->count++] = container;
+        }
+    }
+    scu_free(scratch);
+    return result;
+}
+
+[[nodiscard]]
+ScuRoaringBitmap* scu_roaring_bitmap_and(
+    const ScuRoaringBitmap* left,
+    const ScuRoaringBitmap* right
+) {
+    return scu_roaring_bitmap_operation(SCU_SET_OPERATION_AND, left, right);
+}
+
+[[nodiscard]]
+ScuRoaringBitmap* scu_roaring_bitmap_or(
+    const ScuRoaringBitmap* left,
+    const ScuRoaringBitmap* right
+) {
+    return scu_roaring_bitmap_operation(SCU_SET_OPERATION_OR, left, right);
+}
+
+[[nodiscard]]
+ScuRoaringBitmap* scu_roaring_bitmap_andnot(
+    const ScuRoaringBitmap* left,
+    const ScuRoaringBitmap* right
+) {
+    return scu_roaring_bitmap_operation(SCU_SET_OPERATION_ANDNOT, left, right);
+}
+
+[[nodiscard]]
+ScuRoaringBitmap* scu_roaring_bitmap_xor(
+    const ScuRoaringBitmap* left,
+    const ScuRoaringBitmap* right
+) {
+    return scu_roaring_bitmap_operation(SCU_SET_OPERATION_XOR, left, right);
+}
+
+isize scu_roaring_bitmap_serialized_size(const ScuRoaringBitmap* bitmap) {
+    SCU_ASSERT(bitmap != nullptr);
+    isize size = SCU_SERIAL_HEADER_SIZE;
+    for (isize i = 0; i < bitmap->count; i++) {
+        const ScuContainer* container = &bitmap->containers[i];
+        size += SCU_SERIAL_CONTAINER_HEADER_SIZE + scu_container_size(
+            container->type,
+            container->count,
+            container->count
+        );
+    }
+    return size;
+}
+
+/**
+ * @brief Stores a `u16` value in little-endian byte order.
+ *
+ * @param[out] p The buffer to store the value in.
+ * @param[in]  v The value to store.
+ */
+static inline void scu_store_u16_le(byte* p, u16 v) {
+    SCU_ASSERT(p != nullptr);
+    p[0] = (byte) v;
+    p[1] = (byte) (v >> 8);
+}
+
+/**
+ * @brief Stores a `u32` value in little-endian byte order.
+ *
+ * @param[out] p The buffer to store the value in.
+ * @param[in]  v The value to store.
+ */
+static inline void scu_store_u32_le(byte* p, u32 v) {
+    SCU_ASSERT(p != nullptr);
+    for (isize i = 0; i < 4; i++) {
+        p[i] = (byte) (v >> (8 * i));
+    }
+}
+
+/**
+ * @brief Stores a `u64` value in little-endian byte order.
+ *
+ * @param[out] p The buffer to store the value in.
+ * @param[in]  v The value to store.
+ */
+static inline void scu_store_u64_le(byte* p, u64 v) {
+    SCU_ASSERT(p != nullptr);
+    for (isize i = 0; i < 8; i++) {
+        p[i] = (byte) (v >> (8 * i));
+    }
+}
+
+/**
+ * @brief Loads a `u16` value stored in little-endian byte order.
+ *
+ * @param[in] p The buffer to load the value from.
+ * @return The loaded value.
+ */
+static inline u16 scu_load_u16_le(const byte* p) {
+    SCU_ASSERT(p != nullptr);
+    return (u16) (p[0] | (p[1] << 8));
+}
+
+/**
+ * @brief Loads a `u32` value stored in little-endian byte order.
+ *
+ * @param[in] p The buffer to load the value from.
+ * @return The loaded value.
+ */
+static inline u32 scu_load_u32_le(const byte* p) {
+    SCU_ASSERT(p != nullptr);
+    u32 v = 0;
+    for (isize i = 0; i < 4; i++) {
+        v |= (u32) p[i] << (8 * i);
+    }
+    return v;
+}
+
+/**
+ * @brief Loads a `u64` value stored in little-endian byte order.
+ *
+ * @param[in] p The buffer to load the value from.
+ * @return The loaded value.
+ */
+static inline u64 scu_load_u64_le(const byte* p) {
+    SCU_ASSERT(p != nullptr);
+    u64 v = 0;
+    for (isize i = 0; i < 8; i++) {
+        v |= (u64) p[i] << (8 * i);
+    }
+    return v;
+}
+
+void scu_roaring_bitmap_serialize(
+    const ScuRoaringBitmap* restrict bitmap,
+    void* restrict buffer
+) {
+    SCU_ASSERT(bitmap != nullptr);
+    SCU_ASSERT(buffer != nullptr);
+    byte* p = (byte*) buffer;
+    scu_store_u32_le(&p[0], SCU_SERIAL_MAGIC);
+    scu_store_u32_le(&p[4], SCU_SERIAL_VERSION);
+    scu_store_u32_le(&p[8], (u32) bitmap->count);
+    p += SCU_SERIAL_HEADER_SIZE;
+    for (isize i = 0; i < bitmap->count; i++) {
+        const ScuContainer* container = &bitmap->containers[i];
+        // Bitmap containers store their cardinality instead of the (fixed)
+        // number of words, which allows validating them when deserializing.
+        isize count = (container->type == SCU_CONTAINER_TYPE_BITMAP)
+            ? container->cardinality
+            : container->count;
+        scu_store_u16_le(&p[0], container->key);
+        p[2] = (byte) container->type;
+        p[3] = 0;
+        scu_store_u32_le(&p[4], (u32) count);
+        p += SCU_SERIAL_CONTAINER_HEADER_SIZE;
+        switch (container->type) {
+            case SCU_CONTAINER_TYPE_ARRAY:
+                for (isize j = 0; j < container->count; j++) {
+                    scu_store_u16_le(p, container->values[j]);
+                    p += SCU_SIZEOF(u16);
+                }
+                break;
+            case SCU_CONTAINER_TYPE_BITMAP:
+                for (isize j = 0; j < SCU_BITMAP_WORD_COUNT; j++) {
+                    scu_store_u64_le(p, container->words[j]);
+                    p += SCU_SIZEOF(u64);
+                }
+                break;
+            case SCU_CONTAINER_TYPE_RUN:
+                for (isize j = 0; j < container->count; j++) {
+                    scu_store_u16_le(&p[0], container->runs[j].start);
+                    scu_store_u16_le(&p[2], container->runs[j].length);
+                    p += SCU_SIZEOF(ScuRun);
+                }
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Deserializes the payload of a container and validates it.
+ *
+ * @note This function dynamically allocates memory using `scu_malloc()`.
+ *
+ * @param[out] container The container to deserialize.
+ * @param[in]  key       The key of the container.
+ * @param[in]  type      The type of the container.
+ * @param[in]  count     The number of values (for array and bitmap containers)
+ *                       or runs (for run containers) of the container.
+ * @param[in]  p         The buffer containing the payload, which must be large
+ *                       enough.
+ * @return `SCU_ERROR_INVALID_FORMAT` if the payload is invalid,
+ * `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+static ScuError scu_container_deserialize(
+    ScuContainer* restrict container,
+    u16 key,
+    ScuContainerType type,
+    isize count,
+    const byte* restrict p
+) {
+    SCU_ASSERT(container != nullptr);
+    SCU_ASSERT(p != nullptr);
+    isize capacity = (type == SCU_CONTAINER_TYPE_BITMAP)
+        ? SCU_BITMAP_WORD_COUNT
+        : SCU_MAX(count, SCU_CONTAINER_MIN_CAPACITY);
+    void* data = scu_malloc(scu_container_size(type, capacity, capacity));
+    if (data == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    *container = (ScuContainer) {
+        .key = key,
+        .type = type,
+        .cardinality = count,
+        .count = count,
+        .capacity = capacity,
+        .data = data
+    };
+    switch (type) {
+        case SCU_CONTAINER_TYPE_ARRAY:
+            for (isize i = 0; i < count; i++) {
+                u16 value = scu_load_u16_le(&p[i * SCU_SIZEOF(u16)]);
+                if ((i > 0) && (value <= container->values[i - 1])) {
+                    scu_container_free(container);
+                    return SCU_ERROR_INVALID_FORMAT;
+                }
+                container->values[i] = value;
+            }
+            return SCU_ERROR_NONE;
+        case SCU_CONTAINER_TYPE_BITMAP: {
+            isize cardinality = 0;
+            for (isize i = 0; i < SCU_BITMAP_WORD_COUNT; i++) {
+                container->words[i] = scu_load_u64_le(&p[i * SCU_SIZEOF(u64)]);
+                cardinality += scu_popcount_u64(container->words[i]);
+            }
+            if (cardinality != count) {
+                scu_container_free(container);
+                return SCU_ERROR_INVALID_FORMAT;
+            }
+            container->count = SCU_BITMAP_WORD_COUNT;
+            return SCU_ERROR_NONE;
+        }
+        case SCU_CONTAINER_TYPE_RUN: {
+            isize cardinality = 0;
+            isize previousEnd = -2;
+            for (isize i = 0; i < count; i++) {
+                const byte* run = &p[i * SCU_SIZEOF(ScuRun)];
+                ScuRun* current = &container->runs[i];
+                current->start = scu_load_u16_le(&run[0]);
+                current->length = scu_load_u16_le(&run[2]);
+                isize end = current->start + current->length;
+                // Runs must be sorted, disjoint and not adjacent.
+                if (
+                    (current->start <= (previousEnd + 1))
+                        || (end >= (1 << 16))
+                ) {
+                    scu_container_free(container);
+                    return SCU_ERROR_INVALID_FORMAT;
+                }
+                cardinality += current->length + 1;
+                previousEnd = end;
+            }
+            container->cardinality = cardinality;
+            return SCU_ERROR_NONE;
+        }
+    }
+    SCU_UNREACHABLE();
+}
+
+ScuError scu_roaring_bitmap_deserialize(
+    ScuRoaringBitmap* restrict* restrict bitmap,
+    const void* restrict buffer,
+    isize size
+) {
+    SCU_ASSERT(bitmap != nullptr);
+    SCU_ASSERT(buffer != nullptr);
+    SCU_ASSERT(size >= 0);
+    *bitmap = nullptr;
+    const byte* p = (const byte*) buffer;
+    if (
+        (size < SCU_SERIAL_HEADER_SIZE)
+            || (scu_load_u32_le(&p[0]) != SCU_SERIAL_MAGIC)
+            || (scu_load_u32_le(&p[4]) != SCU_SERIAL_VERSION)
+    ) {
+        return SCU_ERROR_INVALID_FORMAT;
+    }
+    isize containerCount = scu_load_u32_le(&p[8]);
+    if (containerCount > (1 << 16)) {
+        return SCU_ERROR_INVALID_FORMAT;
+    }
+    ScuRoaringBitmap* newBitmap = scu_roaring_bitmap_new();
+    if (
+        (newBitmap == nullptr)
+            || (
+                scu_roaring_bitmap_reserve(newBitmap, containerCount)
+                    != SCU_ERROR_NONE
+            )
+    ) {
+        scu_roaring_bitmap_free(newBitmap);
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    isize offset = SCU_SERIAL_HEADER_SIZE;
+    isize previousKey = -1;
+    for (isize i = 0; i < containerCount; i++) {
+        if ((size - offset) < SCU_SERIAL_CONTAINER_HEADER_SIZE) {
+            scu_roaring_bitmap_free(newBitmap);
+            return SCU_ERROR_INVALID_FORMAT;
+        }
+        u16 key = scu_load_u16_le(&p[offset]);
+        isize type = p[offset + 2];
+        isize reserved = p[offset + 3];
+        isize count = scu_load_u32_le(&p[offset + 4]);
+        offset += SCU_SERIAL_CONTAINER_HEADER_SIZE;
+        bool isValid = (key > previousKey) && (reserved == 0);
+        switch (type) {
+            case SCU_CONTAINER_TYPE_ARRAY:
+                isValid = isValid
+                    && (count >= 1)
+                    && (count <= SCU_ARRAY_MAX_COUNT);
+                break;
+            case SCU_CONTAINER_TYPE_BITMAP:
+                isValid = isValid && (count >= 1) && (count <= (1 << 16));
+                break;
+            case SCU_CONTAINER_TYPE_RUN:
+                isValid = isValid
+                    && (count >= 1)
+                    && (count <= SCU_RUN_MAX_COUNT);
+                break;
+            default:
+                isValid = false;
+                break;
+        }
+        if (
+            !isValid
+                || (
+                    (size - offset)
+                        < scu_container_size(
+                            (ScuContainerType) type,
+                            count,
+                            count
+                        )
+                )
+        ) {
+            scu_roaring_bitmap_free(newBitmap);
+            return SCU_ERROR_INVALID_FORMAT;
+        }
+        ScuError error = scu_container_deserialize(
+            &newBitmap->containers[i],
+            key,
+            (ScuContainerType) type,
+            count,
+            &p[offset]
+        );
+        if (error != SCU_ERROR_NONE) {
+            scu_roaring_bitmap_free(newBitmap);
+            return error;
+        }
+        newBitmap->count++;
+        offset += scu_container_size((ScuContainerType) type, count, count);
+        previousKey = key;
+    }
+    if (offset != size) {
+        scu_roaring_bitmap_free(newBitmap);
+        return SCU_ERROR_INVALID_FORMAT;
+    }
+    *bitmap = newBitmap;
+    return SCU_ERROR_NONE;
+}
+
+ScuRoaringBitmapIter scu_roaring_bitmap_iter(const ScuRoaringBitmap* bitmap) {
+    SCU_ASSERT(bitmap != nullptr);
+    return (ScuRoaringBitmapIter) {
+        .bitmap = bitmap,
+        .containerIndex = 0,
+        .position = -1,
+        .offset = 0,
+        .value = 0
+    };
+}
+
+bool scu_roaring_bitmap_iter_move_next(ScuRoaringBitmapIter* iter) {
+    SCU_ASSERT(iter != nullptr);
+    const ScuRoaringBitmap* bitmap = iter->bitmap;
+    while (iter->containerIndex < bitmap->count) {
+        const ScuContainer* container
+            = &bitmap->containers[iter->containerIndex];
+        u32 base = (u32) container->key << 16;
+        switch (container->type) {
+            case SCU_CONTAINER_TYPE_ARRAY:
+                iter->position++;
+                if (iter->position < container->count) {
+                    iter->value = base | container->values[iter->position];
+                    return true;
+                }
+                break;
+            case SCU_CONTAINER_TYPE_BITMAP: {
+                isize bit = iter->position + 1;
+                if (bit >= (1 << 16)) {
+                    break;
+                }
+                isize i = bit >> 6;
+                u64 word = container->words[i] & (U64_MAX << (bit & 63));
+                while ((word == 0) && (++i < SCU_BITMAP_WORD_COUNT)) {
+                    word = container->words[i];
+                }
+                if (word != 0) {
+                    iter->position = (i << 6) + scu_trailing_zeros_u64(word);
+                    iter->value = base | (u32) iter->position;
+                    return true;
+                }
+                break;
+            }
+            case SCU_CONTAINER_TYPE_RUN:
+                if (iter->position < 0) {
+                    iter->position = 0;
+                    iter->offset = 0;
+                }
+                else if (
+                    ++iter->offset > container->runs[iter->position].length
+                ) {
+                    iter->position++;
+                    iter->offset = 0;
+                }
+                if (iter->position < container->count) {
+                    iter->value = base | (u32) (
+                        container->runs[iter->position].start + iter->offset
+                    );
+                    return true;
+                }
+                break;
+        }
+        iter->containerIndex++;
+        iter->position = -1;
+        iter->offset = 0;
+    }
+    return false;
+}
+
+u32 scu_roaring_bitmap_iter_current(const ScuRoaringBitmapIter* iter) {
+    SCU_ASSERT(iter != nullptr);
+    return iter->value;
+}
+
+void scu_roaring_bitmap_iter_reset(ScuRoaringBitmapIter* iter) {
+    SCU_ASSERT(iter != nullptr);
+    iter->containerIndex = 0;
+    iter->position = -1;
+    iter->offset = 0;
+    iter->value = 0;
+}
+
+void scu_roaring_bitmap_free(ScuRoaringBitmap* bitmap) {
+    if (bitmap != nullptr) {
+        for (isize i = 0; i < bitmap->count; i++) {
+            scu_container_free(&bitmap->containers[i]);
+        }
+        scu_free(bitmap->containers);
+        bitmap->containers = nullptr;
+        bitmap->count = 0;
+        bitmap->capacity = 0;
+        scu_free(bitmap);
+    }
+}
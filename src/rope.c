@@ -0,0 +1,798 @@
+#define SCU_SHORT_ALIASES
+
+#include "scu/alloc.h"
+#include "scu/array.h"
+#include "scu/assert.h"
+#include "scu/math.h"
+#include "scu/memory.h"
+#include "scu/rope.h"
+
+/** @brief The maximum number of bytes of a leaf. */
+static constexpr isize SCU_LEAF_CAPACITY = 1024;
+
+/**
+ * @brief The number of bytes leaves are filled with when building a rope from
+ * a sequence of bytes.
+ *
+ * @note Leaving some room allows subsequent small insertions to be performed
+ * in place.
+ */
+static constexpr isize SCU_LEAF_FILL = (SCU_LEAF_CAPACITY / 4) * 3;
+
+/**
+ * @brief Represents a node of a rope.
+ *
+ * @note A node is either a leaf holding up to `SCU_LEAF_CAPACITY` bytes, or an
+ * inner node with exactly two children. The tree is kept balanced in the same
+ * way as an AVL tree, i.e., the heights of the children of each inner node
+ * differ by at most one.
+ */
+typedef struct ScuNode {
+
+    /** @brief The number of bytes within the subtree. */
+    isize length;
+
+    /** @brief The number of newlines within the subtree. */
+    isize newlines;
+
+    /** @brief The height of the subtree, which is zero for leaves. */
+    isize height;
+
+    /** @brief The left child, or `nullptr` for leaves. */
+    struct ScuNode* left;
+
+    /** @brief The right child, or `nullptr` for leaves. */
+    struct ScuNode* right;
+
+    /**
+     * @brief The bytes of the node.
+     *
+     * @note This is a flexible array member of `SCU_LEAF_CAPACITY` bytes for
+     * leaves, and absent for inner nodes.
+     */
+    char bytes[];
+
+} ScuNode;
+
+struct ScuRope {
+
+    /** @brief The root of the tree, or `nullptr` if the rope is empty. */
+    ScuNode* root;
+
+};
+
+/**
+ * @brief Counts the newlines within a specified sequence of bytes.
+ *
+ * @param[in] bytes The bytes to examine.
+ * @param[in] count The number of bytes to examine.
+ * @return The number of newlines.
+ */
+static inline isize scu_count_newlines(const char* bytes, isize count) {
+    isize newlines = 0;
+    for (isize i = 0; i < count; i++) {
+        newlines += (bytes[i] == '\n') ? 1 : 0;
+    }
+    return newlines;
+}
+
+/**
+ * @brief Allocates a new leaf containing a copy of a specified sequence of
+ * bytes.
+ *
+ * @param[in] bytes The bytes to copy.
+ * @param[in] count The number of bytes to copy.
+ * @return A pointer to the new leaf, or `nullptr` on failure.
+ */
+static ScuNode* scu_leaf_new(const char* bytes, isize count) {
+    SCU_ASSERT((count >= 0) && (count <= SCU_LEAF_CAPACITY));
+    ScuNode* leaf = scu_malloc(SCU_SIZEOF(ScuNode) + SCU_LEAF_CAPACITY);
+    if (leaf == nullptr) {
+        return nullptr;
+    }
+    leaf->length = count;
+    leaf->newlines = scu_count_newlines(bytes, count);
+    leaf->height = 0;
+    leaf->left = nullptr;
+    leaf->right = nullptr;
+    scu_memcpy(leaf->bytes, bytes, count);
+    return leaf;
+}
+
+/**
+ * @brief Allocates a new inner node.
+ *
+ * @note The children and cached values of the node are left for the caller to
+ * initialize.
+ *
+ * @return A pointer to the new inner node, or `nullptr` on failure.
+ */
+static inline ScuNode* scu_inner_new() {
+    return scu_malloc(SCU_SIZEOF(ScuNode));
+}
+
+/**
+ * @brief Deallocates a specified subtree.
+ *
+ * @param[in, out] node The root of the subtree, or `nullptr`.
+ */
+static void scu_node_free(ScuNode* node) {
+    while (node != nullptr) {
+        ScuNode* right = node->right;
+        scu_node_free(node->left);
+        scu_free(node);
+        node = right;
+    }
+}
+
+/**
+ * @brief Recomputes the cached values of an inner node from its children.
+ *
+ * @param[in, out] node The inner node to update.
+ */
+static inline void scu_node_update(ScuNode* node) {
+    SCU_ASSERT((node->left != nullptr) && (node->right != nullptr));
+    node->length = node->left->length + node->right->length;
+    node->newlines = node->left->newlines + node->right->newlines;
+    node->height = SCU_MAX(node->left->height, node->right->height) + 1;
+}
+
+/**
+ * @brief Rotates a specified subtree to the left.
+ *
+ * @param[in, out] node The root of the subtree.
+ * @return The new root of the subtree.
+ */
+static inline ScuNode* scu_node_rotate_left(ScuNode* node) {
+    ScuNode* right = node->right;
+    node->right = right->left;
+    right->left = node;
+    scu_node_update(node);
+    scu_node_update(right);
+    return right;
+}
+
+/**
+ * @brief Rotates a specified subtree to the right.
+ *
+ * @param[in, out] node The root of the subtree.
+ * @return The new root of the subtree.
+ */
+static inline ScuNode* scu_node_rotate_right(ScuNode* node) {
+    ScuNode* left = node->left;
+    node->left = left->right;
+    left->right = node;
+    scu_node_update(node);
+    scu_node_update(left);
+    return left;
+}
+
+/**
+ * @brief Updates a specified inner node and restores its balance, assuming the
+ * heights of its children differ by at most two.
+ *
+ * @param[in, out] node The inner node to rebalance.
+ * @return The new root of the subtree.
+ */
+static ScuNode* scu_node_rebalance(ScuNode* node) {
+    scu_node_update(node);
+    isize balance = node->left->height - node->right->height;
+    if (balance > 1) {
+        if (node->left->left->height < node->left->right->height) {
+            node->left = scu_node_rotate_left(node->left);
+        }
+        return scu_node_rotate_right(node);
+    }
+    if (balance < -1) {
+        if (node->right->right->height < node->right->left->height) {
+            node->right = scu_node_rotate_right(node->right);
+        }
+        return scu_node_rotate_left(node);
+    }
+    return node;
+}
+
+/**
+ * @brief Concatenates two subtrees, reusing a specified inner node to connect
+ * them.
+ *
+ * @note This function never allocates memory, so it can not fail. If one of
+ * the subtrees is empty, the connecting node is deallocated instead. Two small
+ * leaves are merged into one.
+ *
+ * @param[in, out] left  The left subtree, or `nullptr`.
+ * @param[in, out] inner The inner node to reuse.
+ * @param[in, out] right The right subtree, or `nullptr`.
+ * @return The root of the concatenated subtree, or `nullptr` if both subtrees
+ * are empty.
+ */
+static ScuNode* scu_node_join(ScuNode* left, ScuNode* inner, ScuNode* right) {
+    SCU_ASSERT(inner != nullptr);
+    if ((left == nullptr) || (right == nullptr)) {
+        scu_free(inner);
+        return (left != nullptr) ? left : right;
+    }
+    if (
+        (left->height == 0)
+            && (right->height == 0)
+            && ((left->length + right->length) <= SCU_LEAF_CAPACITY)
+    ) {
+        scu_memcpy(&left->bytes[left->length], right->bytes, right->length);
+        left->length += right->length;
+        left->newlines += right->newlines;
+        scu_free(right);
+        scu_free(inner);
+        return left;
+    }
+    if (left->height > (right->height + 1)) {
+        left->right = scu_node_join(left->right, inner, right);
+        return scu_node_rebalance(left);
+    }
+    if (right->height > (left->height + 1)) {
+        right->left = scu_node_join(left, inner, right->left);
+        return scu_node_rebalance(right);
+    }
+    inner->left = left;
+    inner->right = right;
+    scu_node_update(inner);
+    return inner;
+}
+
+/**
+ * @brief Splits a specified subtree at a specified index.
+ *
+ * @note At most one leaf is allocated, which happens before the subtree is
+ * modified in any way. If it fails, the subtree is left unchanged.
+ *
+ * @param[in, out] node  The root of the subtree.
+ * @param[in]      index The index at which to split the subtree.
+ * @param[out]     left  The subtree holding the bytes before `index`, or
+ *                       `nullptr` if there are none.
+ * @param[out]     right The subtree holding the bytes at and after `index`, or
+ *                       `nullptr` if there are none.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+static ScuError scu_node_split(
+    ScuNode* node,
+    isize index,
+    ScuNode** left,
+    ScuNode** right
+) {
+    SCU_ASSERT((index >= 0) && (index <= node->length));
+    if (index == 0) {
+        *left = nullptr;
+        *right = node;
+        return SCU_ERROR_NONE;
+    }
+    if (index == node->length) {
+        *left = node;
+        *right = nullptr;
+        return SCU_ERROR_NONE;
+    }
+    if (node->height == 0) {
+        ScuNode* suffix = scu_leaf_new(
+            &node->bytes[index],
+            node->length - index
+        );
+        if (suffix == nullptr) {
+            return SCU_ERROR_OUT_OF_MEMORY;
+        }
+        node->length = index;
+        node->newlines -= suffix->newlines;
+        *left = node;
+        *right = suffix;
+        return SCU_ERROR_NONE;
+    }
+    ScuNode* nodeLeft = node->left;
+    ScuNode* nodeRight = node->right;
+    if (index <= nodeLeft->length) {
+        ScuNode* middle;
+        ScuError error = scu_node_split(nodeLeft, index, left, &middle);
+        if (error != SCU_ERROR_NONE) {
+            return error;
+        }
+        *right = scu_node_join(middle, node, nodeRight);
+        return SCU_ERROR_NONE;
+    }
+    ScuNode* middle;
+    ScuError error = scu_node_split(
+        nodeRight,
+        index - nodeLeft->length,
+        &middle,
+        right
+    );
+    if (error != SCU_ERROR_NONE) {
+        return error;
+    }
+    *left = scu_node_join(nodeLeft, node, middle);
+    return SCU_ERROR_NONE;
+}
+
+/**
+ * @brief Builds a balanced subtree from a specified sequence of bytes.
+ *
+ * @param[in] bytes The bytes to copy.
+ * @param[in] count The number of bytes to copy, which must be positive.
+ * @return The root of the new subtree, or `nullptr` on failure.
+ */
+static ScuNode* scu_node_build(const char* bytes, isize count) {
+    SCU_ASSERT(count > 0);
+    if (count <= SCU_LEAF_FILL) {
+        return scu_leaf_new(bytes, count);
+    }
+    isize leafCount = (count + SCU_LEAF_FILL - 1) / SCU_LEAF_FILL;
+    isize leftCount = (leafCount / 2) * SCU_LEAF_FILL;
+    ScuNode* node = scu_inner_new();
+    if (node == nullptr) {
+        return nullptr;
+    }
+    node->left = scu_node_build(bytes, leftCount);
+    if (node->left == nullptr) {
+        scu_free(node);
+        return nullptr;
+    }
+    node->right = scu_node_build(&bytes[leftCount], count - leftCount);
+    if (node->right == nullptr) {
+        scu_node_free(node->left);
+        scu_free(node);
+        return nullptr;
+    }
+    scu_node_update(node);
+    return node;
+}
+
+/**
+ * @brief Creates a deep copy of a specified subtree.
+ *
+ * @param[in] node The root of the subtree, or `nullptr`.
+ * @param[out] copy The root of the copy.
+ * @return `SCU_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, or
+ * `SCU_ERROR_NONE` on success.
+ */
+static ScuError scu_node_clone(const ScuNode* node, ScuNode** copy) {
+    if (node == nullptr) {
+        *copy = nullptr;
+        return SCU_ERROR_NONE;
+    }
+    if (node->height == 0) {
+        *copy = scu_leaf_new(node->bytes, node->length);
+        return (*copy != nullptr) ? SCU_ERROR_NONE : SCU_ERROR_OUT_OF_MEMORY;
+    }
+    ScuNode* clone = scu_inner_new();
+    if (clone == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    *clone = *node;
+    if (scu_node_clone(node->left, &clone->left) != SCU_ERROR_NONE) {
+        scu_free(clone);
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    if (scu_node_clone(node->right, &clone->right) != SCU_ERROR_NONE) {
+        scu_node_free(clone->left);
+        scu_free(clone);
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    *copy = clone;
+    return SCU_ERROR_NONE;
+}
+
+/**
+ * @brief Finds the leaf containing a specified index, optionally adjusting the
+ * cached values of all inner nodes on the way.
+ *
+ * @param[in, out] node          The root of the tree.
+ * @param[in, out] index         The index to search for, which is replaced by
+ *                               the corresponding index within the leaf.
+ * @param[in]      preferLeft    Indicates whether an index at the boundary of
+ *                               two leaves belongs to the left one (`true`)
+ *                               or the right one (`false`).
+ * @param[in]      lengthDelta   The value to add to the cached lengths.
+ * @param[in]      newlinesDelta The value to add to the cached newline counts.
+ * @return The leaf containing the index.
+ */
+static ScuNode* scu_node_descend(
+    ScuNode* node,
+    isize* index,
+    bool preferLeft,
+    isize lengthDelta,
+    isize newlinesDelta
+) {
+    while (node->height > 0) {
+        node->length += lengthDelta;
+        node->newlines += newlinesDelta;
+        isize leftLength = node->left->length;
+        if ((*index < leftLength) || (preferLeft && (*index == leftLength))) {
+            node = node->left;
+        }
+        else {
+            *index -= leftLength;
+            node = node->right;
+        }
+    }
+    return node;
+}
+
+/**
+ * @brief Copies a range of bytes of a specified subtree into a buffer.
+ *
+ * @param[in]  node   The root of the subtree.
+ * @param[in]  index  The index of the first byte to copy.
+ * @param[in]  count  The number of bytes to copy.
+ * @param[out] buffer The buffer to copy the bytes into.
+ */
+static void scu_node_copy_to(
+    const ScuNode* node,
+    isize index,
+    isize count,
+    char* buffer
+) {
+    while (count > 0) {
+        if (node->height == 0) {
+            scu_memcpy(buffer, &node->bytes[index], count);
+            return;
+        }
+        isize leftLength = node->left->length;
+        if (index < leftLength) {
+            isize leftCount = SCU_MIN(count, leftLength - index);
+            scu_node_copy_to(node->left, index, leftCount, buffer);
+            buffer += leftCount;
+            count -= leftCount;
+            index = 0;
+        }
+        else {
+            index -= leftLength;
+        }
+        node = node->right;
+    }
+}
+
+[[nodiscard]]
+ScuRope* scu_rope_new() {
+    ScuRope* rope = scu_malloc(SCU_SIZEOF(ScuRope));
+    if (rope == nullptr) {
+        return nullptr;
+    }
+    rope->root = nullptr;
+    return rope;
+}
+
+[[nodiscard]]
+ScuRope* scu_rope_from_bytes(const char* bytes, isize count) {
+    SCU_ASSERT(count >= 0);
+    SCU_ASSERT((count == 0) || (bytes != nullptr));
+    ScuRope* rope = scu_rope_new();
+    if ((rope == nullptr) || (count == 0)) {
+        return rope;
+    }
+    rope->root = scu_node_build(bytes, count);
+    if (rope->root == nullptr) {
+        scu_free(rope);
+        return nullptr;
+    }
+    return rope;
+}
+
+[[nodiscard]]
+ScuRope* scu_rope_clone(const ScuRope* rope) {
+    SCU_ASSERT(rope != nullptr);
+    ScuRope* clone = scu_rope_new();
+    if (clone == nullptr) {
+        return nullptr;
+    }
+    if (scu_node_clone(rope->root, &clone->root) != SCU_ERROR_NONE) {
+        scu_free(clone);
+        return nullptr;
+    }
+    return clone;
+}
+
+isize scu_rope_length(const ScuRope* rope) {
+    SCU_ASSERT(rope != nullptr);
+    return (rope->root != nullptr) ? rope->root->length : 0;
+}
+
+isize scu_rope_line_count(const ScuRope* rope) {
+    SCU_ASSERT(rope != nullptr);
+    return ((rope->root != nullptr) ? rope->root->newlines : 0) + 1;
+}
+
+char scu_rope_byte_at(const ScuRope* rope, isize index) {
+    SCU_ASSERT(rope != nullptr);
+    SCU_ASSERT((index >= 0) && (index < scu_rope_length(rope)));
+    ScuNode* leaf = scu_node_descend(rope->root, &index, false, 0, 0);
+    return leaf->bytes[index];
+}
+
+void scu_rope_copy_to(
+    const ScuRope* restrict rope,
+    isize index,
+    isize count,
+    char* restrict buffer
+) {
+    SCU_ASSERT(rope != nullptr);
+    SCU_ASSERT((index >= 0) && (count >= 0));
+    SCU_ASSERT(index <= (scu_rope_length(rope) - count));
+    SCU_ASSERT((count == 0) || (buffer != nullptr));
+    if (count > 0) {
+        scu_node_copy_to(rope->root, index, count, buffer);
+    }
+}
+
+ScuError scu_rope_insert(
+    ScuRope* restrict rope,
+    isize index,
+    const char* restrict bytes,
+    isize count
+) {
+    SCU_ASSERT(rope != nullptr);
+    SCU_ASSERT((index >= 0) && (index <= scu_rope_length(rope)));
+    SCU_ASSERT(count >= 0);
+    SCU_ASSERT((count == 0) || (bytes != nullptr));
+    if (count == 0) {
+        return SCU_ERROR_NONE;
+    }
+    if (rope->root != nullptr) {
+        isize leafIndex = index;
+        ScuNode* leaf = scu_node_descend(rope->root, &leafIndex, true, 0, 0);
+        if ((leaf->length + count) <= SCU_LEAF_CAPACITY) {
+            // The bytes fit into the existing leaf, so no allocation is needed.
+            isize newlines = scu_count_newlines(bytes, count);
+            leafIndex = index;
+            scu_node_descend(rope->root, &leafIndex, true, count, newlines);
+            scu_memmove(
+                &leaf->bytes[leafIndex + count],
+                &leaf->bytes[leafIndex],
+                leaf->length - leafIndex
+            );
+            scu_memcpy(&leaf->bytes[leafIndex], bytes, count);
+            leaf->length += count;
+            leaf->newlines += newlines;
+            return SCU_ERROR_NONE;
+        }
+    }
+    ScuNode* middle = scu_node_build(bytes, count);
+    if (middle == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    if (rope->root == nullptr) {
+        rope->root = middle;
+        return SCU_ERROR_NONE;
+    }
+    ScuNode* inners[2] = { scu_inner_new(), scu_inner_new() };
+    ScuNode* left;
+    ScuNode* right;
+    if (
+        (inners[0] == nullptr)
+            || (inners[1] == nullptr)
+            || (
+                scu_node_split(rope->root, index, &left, &right)
+                    != SCU_ERROR_NONE
+            )
+    ) {
+        scu_free(inners[0]);
+        scu_free(inners[1]);
+        scu_node_free(middle);
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    rope->root = scu_node_join(
+        scu_node_join(left, inners[0], middle),
+        inners[1],
+        right
+    );
+    return SCU_ERROR_NONE;
+}
+
+ScuError scu_rope_remove_range(ScuRope* rope, isize index, isize count) {
+    SCU_ASSERT(rope != nullptr);
+    SCU_ASSERT((index >= 0) && (count >= 0));
+    SCU_ASSERT(index <= (scu_rope_length(rope) - count));
+    if (count == 0) {
+        return SCU_ERROR_NONE;
+    }
+    isize leafIndex = index;
+    ScuNode* leaf = scu_node_descend(rope->root, &leafIndex, false, 0, 0);
+    if (
+        ((leafIndex + count) <= leaf->length)
+            && ((count < leaf->length) || (leaf == rope->root))
+    ) {
+        // The range lies within a single leaf, which does not become empty.
+        isize newlines = scu_count_newlines(&leaf->bytes[leafIndex], count);
+        leafIndex = index;
+        scu_node_descend(rope->root, &leafIndex, false, -count, -newlines);
+        scu_memmove(
+            &leaf->bytes[leafIndex],
+            &leaf->bytes[leafIndex + count],
+            leaf->length - leafIndex - count
+        );
+        leaf->length -= count;
+        leaf->newlines -= newlines;
+        if (leaf->length == 0) {
+            scu_free(leaf);
+            rope->root = nullptr;
+        }
+        return SCU_ERROR_NONE;
+    }
+    ScuNode* inner = scu_inner_new();
+    if (inner == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    ScuNode* prefix;
+    ScuNode* suffix;
+    ScuError error = scu_node_split(
+        rope->root,
+        index + count,
+        &prefix,
+        &suffix
+    );
+    if (error != SCU_ERROR_NONE) {
+        scu_free(inner);
+        return error;
+    }
+    ScuNode* left;
+    ScuNode* middle;
+    error = scu_node_split(prefix, index, &left, &middle);
+    if (error != SCU_ERROR_NONE) {
+        rope->root = scu_node_join(prefix, inner, suffix);
+        return error;
+    }
+    scu_node_free(middle);
+    rope->root = scu_node_join(left, inner, suffix);
+    return SCU_ERROR_NONE;
+}
+
+[[nodiscard]]
+ScuRope* scu_rope_slice(const ScuRope* rope, isize index, isize count) {
+    SCU_ASSERT(rope != nullptr);
+    SCU_ASSERT((index >= 0) && (count >= 0));
+    SCU_ASSERT(index <= (scu_rope_length(rope) - count));
+    ScuRope* slice = scu_rope_new();
+    if ((slice == nullptr) || (count == 0)) {
+        return slice;
+    }
+    char* buffer = scu_malloc(count);
+    if (buffer == nullptr) {
+        scu_free(slice);
+        return nullptr;
+    }
+    scu_node_copy_to(rope->root, index, count, buffer);
+    slice->root = scu_node_build(buffer, count);
+    scu_free(buffer);
+    if (slice->root == nullptr) {
+        scu_free(slice);
+        return nullptr;
+    }
+    return slice;
+}
+
+[[nodiscard]]
+ScuRope* scu_rope_split_off(ScuRope* rope, isize index) {
+    SCU_ASSERT(rope != nullptr);
+    SCU_ASSERT((index >= 0) && (index <= scu_rope_length(rope)));
+    ScuRope* suffix = scu_rope_new();
+    if ((suffix == nullptr) || (rope->root == nullptr)) {
+        return suffix;
+    }
+    if (
+        scu_node_split(rope->root, index, &rope->root, &suffix->root)
+            != SCU_ERROR_NONE
+    ) {
+        scu_free(suffix);
+        return nullptr;
+    }
+    return suffix;
+}
+
+ScuError scu_rope_append(ScuRope* restrict rope, ScuRope* restrict other) {
+    SCU_ASSERT(rope != nullptr);
+    SCU_ASSERT(other != nullptr);
+    if (other->root == nullptr) {
+        return SCU_ERROR_NONE;
+    }
+    ScuNode* inner = scu_inner_new();
+    if (inner == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    rope->root = scu_node_join(rope->root, inner, other->root);
+    other->root = nullptr;
+    return SCU_ERROR_NONE;
+}
+
+isize scu_rope_line_start(const ScuRope* rope, isize line) {
+    SCU_ASSERT(rope != nullptr);
+    SCU_ASSERT((line >= 0) && (line < scu_rope_line_count(rope)));
+    if (line == 0) {
+        return 0;
+    }
+    // Find the newline terminating the previous line.
+    const ScuNode* node = rope->root;
+    isize offset = 0;
+    while (node->height > 0) {
+        if (line <= node->left->newlines) {
+            node = node->left;
+        }
+        else {
+            line -= node->left->newlines;
+            offset += node->left->length;
+            node = node->right;
+        }
+    }
+    for (isize i = 0; i < node->length; i++) {
+        if (node->bytes[i] == '\n') {
+            line--;
+            if (line == 0) {
+                return offset + i + 1;
+            }
+        }
+    }
+    SCU_UNREACHABLE();
+}
+
+isize scu_rope_line_of(const ScuRope* rope, isize index) {
+    SCU_ASSERT(rope != nullptr);
+    SCU_ASSERT((index >= 0) && (index <= scu_rope_length(rope)));
+    if (index == scu_rope_length(rope)) {
+        return scu_rope_line_count(rope) - 1;
+    }
+    const ScuNode* node = rope->root;
+    isize line = 0;
+    while (node->height > 0) {
+        if (index < node->left->length) {
+            node = node->left;
+        }
+        else {
+            index -= node->left->length;
+            line += node->left->newlines;
+            node = node->right;
+        }
+    }
+    return line + scu_count_newlines(node->bytes, index);
+}
+
+ScuRopeIter scu_rope_iter(const ScuRope* rope) {
+    SCU_ASSERT(rope != nullptr);
+    ScuRopeIter iter = { .rope = rope };
+    scu_rope_iter_reset(&iter);
+    return iter;
+}
+
+bool scu_rope_iter_move_next(ScuRopeIter* iter) {
+    SCU_ASSERT(iter != nullptr);
+    if (iter->depth == 0) {
+        iter->current = nullptr;
+        return false;
+    }
+    const ScuNode* node = iter->nodes[--iter->depth];
+    while (node->height > 0) {
+        SCU_ASSERT(iter->depth < SCU_COUNTOF(iter->nodes));
+        iter->nodes[iter->depth++] = node->right;
+        node = node->left;
+    }
+    iter->current = node;
+    return true;
+}
+
+ScuRopeChunk scu_rope_iter_current(const ScuRopeIter* iter) {
+    SCU_ASSERT(iter != nullptr);
+    SCU_ASSERT(iter->current != nullptr);
+    const ScuNode* leaf = iter->current;
+    return (ScuRopeChunk) { .bytes = leaf->bytes, .count = leaf->length };
+}
+
+void scu_rope_iter_reset(ScuRopeIter* iter) {
+    SCU_ASSERT(iter != nullptr);
+    SCU_ASSERT(iter->rope != nullptr);
+    iter->depth = 0;
+    iter->current = nullptr;
+    if (iter->rope->root != nullptr) {
+        iter->nodes[iter->depth++] = iter->rope->root;
+    }
+}
+
+void scu_rope_free(ScuRope* rope) {
+    if (rope != nullptr) {
+        scu_node_free(rope->root);
+        rope->root = nullptr;
+        scu_free(rope);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,568 @@
+#define SCU_SHORT_ALIASES
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include "scu/alloc.h"
+#include "scu/assert.h"
+#include "scu/math.h"
+#include "scu/memory.h"
+#include "scu/skip-list.h"
+#include "bits.h"
+
+/** @brief The maximum height of a node (in number of levels). */
+static constexpr isize SCU_MAX_HEIGHT = 20;
+
+/**
+ * @brief The inverse of the probability that a node of a given height also
+ * occupies the next level.
+ */
+static constexpr isize SCU_BRANCHING_FACTOR = 4;
+
+/** @brief The minimum size of a chunk of the arena (in bytes). */
+static constexpr isize SCU_CHUNK_SIZE = 64 * 1024;
+
+/**
+ * @brief Represents a node of a skip list.
+ *
+ * @note Nodes are only linked into the skip list once they are completely
+ * initialized, so their key, value and height never change while they are
+ * visible to other threads. Only their successors are modified concurrently.
+ */
+typedef struct ScuNode {
+
+    /** @brief The number of levels occupied by the node. */
+    isize height;
+
+    /**
+     * @brief The key, the value and the successors of the node.
+     *
+     * @note This is a flexible array member, which is aligned as strictly as
+     * `max_align_t`. The key is stored at the start, followed by the value and
+     * an array of `height` atomic pointers to the successors on each level. The
+     * offsets are stored by the skip list owning the node.
+     */
+    alignas(max_align_t) byte data[];
+
+} ScuNode;
+
+/** @brief Represents a chunk of memory nodes are allocated from. */
+typedef struct ScuChunk {
+
+    /** @brief The previously allocated chunk, or `nullptr` if there is none. */
+    struct ScuChunk* next;
+
+    /** @brief The size of the usable memory of the chunk (in bytes). */
+    isize capacity;
+
+    /**
+     * @brief The number of bytes already handed out.
+     *
+     * @note This counter may exceed `capacity` once the chunk is exhausted.
+     */
+    _Atomic(isize) used;
+
+    /**
+     * @brief The usable memory of the chunk.
+     *
+     * @note This is a flexible array member, which is aligned as strictly as
+     * `max_align_t`.
+     */
+    alignas(max_align_t) byte data[];
+
+} ScuChunk;
+
+struct ScuSkipList {
+
+    /** @brief The size of each key (in bytes). */
+    isize keySize;
+
+    /** @brief The size of each value (in bytes). */
+    isize valueSize;
+
+    /** @brief The offset of the value within a node (in bytes). */
+    isize valueOffset;
+
+    /** @brief The offset of the successors within a node (in bytes). */
+    isize nextOffset;
+
+    /** @brief The number of key-value pairs. */
+    _Atomic(isize) count;
+
+    /** @brief The height of the highest node ever added. */
+    _Atomic(isize) height;
+
+    /** @brief A comparison function used to determine the order of the keys. */
+    ScuCompareFunc* cmpFunc;
+
+    /**
+     * @brief The sentinel node preceding all other nodes on every level.
+     *
+     * @note The sentinel has the maximum height, but its key and value are
+     * never accessed.
+     */
+    ScuNode* head;
+
+    /** @brief The most recently allocated chunk of the arena. */
+    _Atomic(ScuChunk*) chunks;
+
+};
+
+/**
+ * @brief The state of the pseudorandom number generator used for choosing the
+ * heights of new nodes.
+ *
+ * @note Each thread has its own state, so that adding key-value pairs from
+ * different threads does not cause any contention. A state of zero indicates
+ * that the generator has not been seeded yet.
+ */
+static thread_local u64 scuRandomState = 0;
+
+/** @brief A counter used for giving each thread a different seed. */
+static _Atomic(u64) scuSeedCounter = 0;
+
+/**
+ * @brief Rounds up a value to the next multiple of a specified alignment.
+ *
+ * @warning The behavior is undefined if `alignment` is not a power of two.
+ *
+ * @param[in] value     The value to round up.
+ * @param[in] alignment The required alignment.
+ * @return The smallest multiple of `alignment` greater than or equal to
+ * `value`.
+ */
+static inline isize scu_align_up(isize value, isize alignment) {
+    SCU_ASSERT(value >= 0);
+    SCU_ASSERT(alignment > 0);
+    SCU_ASSERT((alignment & (alignment - 1)) == 0);
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * @brief Returns a random height for a new node.
+ *
+ * @note Each additional level is chosen with a probability of
+ * `1 / SCU_BRANCHING_FACTOR`.
+ *
+ * @return A random height in the range `[1, SCU_MAX_HEIGHT]`.
+ */
+static isize scu_random_height() {
+    if (scuRandomState == 0) {
+        u64 seed = atomic_fetch_add_explicit(
+            &scuSeedCounter,
+            1,
+            memory_order_relaxed
+        );
+        seed ^= (u64) (uptr) &scuRandomState;
+        scuRandomState = scu_mix_u64(seed) | 1;
+    }
+    // Xorshift64 never leaves the state at zero.
+    u64 x = scuRandomState;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    scuRandomState = x;
+    u64 r = scu_mix_u64(x);
+    isize height = 1;
+    while (
+        (height < SCU_MAX_HEIGHT)
+            && ((r % (u64) SCU_BRANCHING_FACTOR) == 0)
+    ) {
+        height++;
+        r /= (u64) SCU_BRANCHING_FACTOR;
+    }
+    return height;
+}
+
+/**
+ * @brief Allocates memory from the arena of a specified skip list.
+ *
+ * @note This function is lock-free. It dynamically allocates memory using
+ * `scu_malloc()` whenever the current chunk is exhausted.
+ *
+ * @param[in, out] skipList The skip list to allocate memory for.
+ * @param[in]      size     The number of bytes to allocate.
+ * @return A pointer to the allocated memory, which is aligned as strictly as
+ * `max_align_t`, or `nullptr` on failure.
+ */
+static void* scu_arena_alloc(ScuSkipList* skipList, isize size) {
+    size = scu_align_up(size, SCU_ALIGNOF(max_align_t));
+    while (true) {
+        ScuChunk* chunk = atomic_load_explicit(
+            &skipList->chunks,
+            memory_order_acquire
+        );
+        if (chunk != nullptr) {
+            isize offset = atomic_fetch_add_explicit(
+                &chunk->used,
+                size,
+                memory_order_relaxed
+            );
+            if (offset <= (chunk->capacity - size)) {
+                return &chunk->data[offset];
+            }
+        }
+        isize capacity = SCU_MAX(size, SCU_CHUNK_SIZE);
+        ScuChunk* newChunk = scu_malloc(SCU_SIZEOF(ScuChunk) + capacity);
+        if (newChunk == nullptr) {
+            return nullptr;
+        }
+        newChunk->next = chunk;
+        newChunk->capacity = capacity;
+        atomic_init(&newChunk->used, size);
+        if (
+            atomic_compare_exchange_strong_explicit(
+                &skipList->chunks,
+                &chunk,
+                newChunk,
+                memory_order_acq_rel,
+                memory_order_acquire
+            )
+        ) {
+            return newChunk->data;
+        }
+        // Another thread has installed a new chunk in the meantime, so try to
+        // allocate from that one instead.
+        scu_free(newChunk);
+    }
+}
+
+/**
+ * @brief Returns a pointer to the array of successors of a specified node.
+ *
+ * @param[in] skipList The skip list owning the node.
+ * @param[in] node     The node to examine.
+ * @return A pointer to the array of successors.
+ */
+static inline _Atomic(ScuNode*)* scu_node_next(
+    const ScuSkipList* skipList,
+    ScuNode* node
+) {
+    return (_Atomic(ScuNode*)*) (void*) &node->data[skipList->nextOffset];
+}
+
+/**
+ * @brief Returns the successor of a specified node on a specified level.
+ *
+ * @param[in] skipList The skip list owning the node.
+ * @param[in] node     The node to examine.
+ * @param[in] level    The level of the successor.
+ * @return A pointer to the successor, or `nullptr` if there is none.
+ */
+static inline ScuNode* scu_node_load_next(
+    const ScuSkipList* skipList,
+    ScuNode* node,
+    isize level
+) {
+    SCU_ASSERT((level >= 0) && (level < node->height));
+    return atomic_load_explicit(
+        &scu_node_next(skipList, node)[level],
+        memory_order_acquire
+    );
+}
+
+/**
+ * @brief Returns the last node on a specified level whose key is less than a
+ * specified key, starting the search at a specified node.
+ *
+ * @param[in]  skipList The skip list to search.
+ * @param[in]  node     The node to start the search at, whose key must be less
+ *                      than `key` (or the sentinel).
+ * @param[in]  key      The key to search for.
+ * @param[in]  level    The level to search on.
+ * @param[out] next     The successor of the returned node on the level.
+ * @return The last node on the level whose key is less than `key`.
+ */
+static inline ScuNode* scu_skip_list_find_predecessor(
+    const ScuSkipList* restrict skipList,
+    ScuNode* node,
+    const void* restrict key,
+    isize level,
+    ScuNode** next
+) {
+    ScuNode* current = scu_node_load_next(skipList, node, level);
+    while (
+        (current != nullptr) && (skipList->cmpFunc(current->data, key) < 0)
+    ) {
+        node = current;
+        current = scu_node_load_next(skipList, node, level);
+    }
+    *next = current;
+    return node;
+}
+
+/**
+ * @brief Returns the last node of a specified skip list whose key is less than
+ * a specified key.
+ *
+ * @param[in] skipList The skip list to search.
+ * @param[in] key      The key to search for.
+ * @return The last node whose key is less than `key`, or the sentinel if there
+ * is no such node.
+ */
+static inline ScuNode* scu_skip_list_find_less(
+    const ScuSkipList* restrict skipList,
+    const void* restrict key
+) {
+    ScuNode* node = skipList->head;
+    ScuNode* next;
+    isize height = atomic_load_explicit(
+        &skipList->height,
+        memory_order_relaxed
+    );
+    for (isize level = height - 1; level >= 0; level--) {
+        node = scu_skip_list_find_predecessor(
+            skipList,
+            node,
+            key,
+            level,
+            &next
+        );
+    }
+    return node;
+}
+
+[[nodiscard]]
+ScuSkipList* scu_skip_list_new(
+    isize keySize,
+    isize valueSize,
+    ScuCompareFunc* cmpFunc
+) {
+    SCU_ASSERT(keySize > 0);
+    SCU_ASSERT(valueSize > 0);
+    SCU_ASSERT(cmpFunc != nullptr);
+    ScuSkipList* skipList = scu_malloc(SCU_SIZEOF(ScuSkipList));
+    if (skipList == nullptr) {
+        return nullptr;
+    }
+    skipList->keySize = keySize;
+    skipList->valueSize = valueSize;
+    skipList->valueOffset = scu_align_up(keySize, SCU_ALIGNOF(max_align_t));
+    skipList->nextOffset = scu_align_up(
+        skipList->valueOffset + valueSize,
+        SCU_ALIGNOF(_Atomic(ScuNode*))
+    );
+    atomic_init(&skipList->count, 0);
+    atomic_init(&skipList->height, 1);
+    skipList->cmpFunc = cmpFunc;
+    atomic_init(&skipList->chunks, nullptr);
+    skipList->head = scu_arena_alloc(
+        skipList,
+        SCU_SIZEOF(ScuNode)
+            + skipList->nextOffset
+            + (SCU_MAX_HEIGHT * SCU_SIZEOF(_Atomic(ScuNode*)))
+    );
+    if (skipList->head == nullptr) {
+        scu_free(skipList);
+        return nullptr;
+    }
+    skipList->head->height = SCU_MAX_HEIGHT;
+    _Atomic(ScuNode*)* next = scu_node_next(skipList, skipList->head);
+    for (isize level = 0; level < SCU_MAX_HEIGHT; level++) {
+        atomic_init(&next[level], nullptr);
+    }
+    return skipList;
+}
+
+isize scu_skip_list_count(const ScuSkipList* skipList) {
+    SCU_ASSERT(skipList != nullptr);
+    return atomic_load_explicit(&skipList->count, memory_order_relaxed);
+}
+
+ScuError scu_skip_list_try_add(
+    ScuSkipList* restrict skipList,
+    const void* restrict key,
+    const void* restrict value
+) {
+    SCU_ASSERT(skipList != nullptr);
+    SCU_ASSERT(key != nullptr);
+    SCU_ASSERT(value != nullptr);
+    ScuNode* preds[SCU_MAX_HEIGHT];
+    ScuNode* succs[SCU_MAX_HEIGHT];
+    isize height = atomic_load_explicit(
+        &skipList->height,
+        memory_order_relaxed
+    );
+    ScuNode* pred = skipList->head;
+    for (isize level = SCU_MAX_HEIGHT - 1; level >= 0; level--) {
+        if (level >= height) {
+            // Levels above the current height are re-examined when linking.
+            preds[level] = skipList->head;
+            succs[level] = nullptr;
+            continue;
+        }
+        pred = scu_skip_list_find_predecessor(
+            skipList,
+            pred,
+            key,
+            level,
+            &succs[level]
+        );
+        preds[level] = pred;
+    }
+    if (
+        (succs[0] != nullptr) && (skipList->cmpFunc(succs[0]->data, key) == 0)
+    ) {
+        return SCU_ERROR_ALREADY_PRESENT;
+    }
+    isize nodeHeight = scu_random_height();
+    ScuNode* node = scu_arena_alloc(
+        skipList,
+        SCU_SIZEOF(ScuNode)
+            + skipList->nextOffset
+            + (nodeHeight * SCU_SIZEOF(_Atomic(ScuNode*)))
+    );
+    if (node == nullptr) {
+        return SCU_ERROR_OUT_OF_MEMORY;
+    }
+    node->height = nodeHeight;
+    scu_memcpy(node->data, key, skipList->keySize);
+    scu_memcpy(&node->data[skipList->valueOffset], value, skipList->valueSize);
+    _Atomic(ScuNode*)* next = scu_node_next(skipList, node);
+    while (height < nodeHeight) {
+        if (
+            atomic_compare_exchange_weak_explicit(
+                &skipList->height,
+                &height,
+                nodeHeight,
+                memory_order_relaxed,
+                memory_order_relaxed
+            )
+        ) {
+            break;
+        }
+    }
+    for (isize level = 0; level < nodeHeight; level++) {
+        while (true) {
+            atomic_store_explicit(
+                &next[level],
+                succs[level],
+                memory_order_relaxed
+            );
+            if (
+                atomic_compare_exchange_strong_explicit(
+                    &scu_node_next(skipList, preds[level])[level],
+                    &succs[level],
+                    node,
+                    memory_order_release,
+                    memory_order_relaxed
+                )
+            ) {
+                break;
+            }
+            // Another thread has linked a node after the predecessor in the
+            // meantime. As nodes are never removed, the predecessor is still
+            // valid and the search can continue from there.
+            preds[level] = scu_skip_list_find_predecessor(
+                skipList,
+                preds[level],
+                key,
+                level,
+                &succs[level]
+            );
+            if (
+                (level == 0)
+                    && (succs[0] != nullptr)
+                    && (skipList->cmpFunc(succs[0]->data, key) == 0)
+            ) {
+                // The node has not been published yet, so its memory simply
+                // stays unused in the arena.
+                return SCU_ERROR_ALREADY_PRESENT;
+            }
+        }
+    }
+    atomic_fetch_add_explicit(&skipList->count, 1, memory_order_relaxed);
+    return SCU_ERROR_NONE;
+}
+
+bool scu_skip_list_try_get_impl(
+    const ScuSkipList* restrict skipList,
+    const void* restrict key,
+    void* restrict* restrict value
+) {
+    SCU_ASSERT(skipList != nullptr);
+    SCU_ASSERT(key != nullptr);
+    SCU_ASSERT(value != nullptr);
+    ScuNode* node = scu_node_load_next(
+        skipList,
+        scu_skip_list_find_less(skipList, key),
+        0
+    );
+    if ((node == nullptr) || (skipList->cmpFunc(node->data, key) != 0)) {
+        *value = nullptr;
+        return false;
+    }
+    *value = &node->data[skipList->valueOffset];
+    return true;
+}
+
+bool scu_skip_list_contains_key(
+    const ScuSkipList* restrict skipList,
+    const void* restrict key
+) {
+    void* value;
+    return scu_skip_list_try_get_impl(skipList, key, &value);
+}
+
+ScuSkipListIter scu_skip_list_iter(const ScuSkipList* skipList) {
+    SCU_ASSERT(skipList != nullptr);
+    return (ScuSkipListIter) {
+        .skipList = SCU_CONST_CAST(ScuSkipList*, skipList),
+        .node = skipList->head
+    };
+}
+
+void scu_skip_list_iter_seek(
+    ScuSkipListIter* restrict iter,
+    const void* restrict key
+) {
+    SCU_ASSERT(iter != nullptr);
+    SCU_ASSERT(iter->skipList != nullptr);
+    SCU_ASSERT(key != nullptr);
+    iter->node = scu_skip_list_find_less(iter->skipList, key);
+}
+
+bool scu_skip_list_iter_move_next(ScuSkipListIter* iter) {
+    SCU_ASSERT(iter != nullptr);
+    SCU_ASSERT(iter->skipList != nullptr);
+    SCU_ASSERT(iter->node != nullptr);
+    ScuNode* next = scu_node_load_next(iter->skipList, iter->node, 0);
+    if (next == nullptr) {
+        return false;
+    }
+    iter->node = next;
+    return true;
+}
+
+ScuSkipListEntry scu_skip_list_iter_current(const ScuSkipListIter* iter) {
+    SCU_ASSERT(iter != nullptr);
+    SCU_ASSERT(iter->skipList != nullptr);
+    SCU_ASSERT((iter->node != nullptr) && (iter->node != iter->skipList->head));
+    ScuNode* node = iter->node;
+    return (ScuSkipListEntry) {
+        .key = node->data,
+        .value = &node->data[iter->skipList->valueOffset]
+    };
+}
+
+void scu_skip_list_iter_reset(ScuSkipListIter* iter) {
+    SCU_ASSERT(iter != nullptr);
+    SCU_ASSERT(iter->skipList != nullptr);
+    iter->node = iter->skipList->head;
+}
+
+void scu_skip_list_free(ScuSkipList* skipList) {
+    if (skipList != nullptr) {
+        ScuChunk* chunk = atomic_load_explicit(
+            &skipList->chunks,
+            memory_order_acquire
+        );
+        while (chunk != nullptr) {
+            ScuChunk* next = chunk->next;
+            scu_free(chunk);
+            chunk = next;
+        }
+        atomic_store_explicit(&skipList->chunks, nullptr, memory_order_relaxed);
+        skipList->head = nullptr;
+        scu_free(skipList);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,673 @@
+#define SCU_SHORT_ALIASES
+
+#include <stddef.h>
+#include "scu/alloc.h"
+#include "scu/assert.h"
+#include "scu/math.h"
+#include "scu/memory.h"
+#include "scu/tiny-lfu-cache.h"
+#include "bits.h"
+#include "open-index.h"
+
+/** @brief The segment of entries that were inserted recently. */
+static constexpr isize SCU_SEGMENT_WINDOW = 0;
+
+/** @brief The segment of the main cache for entries accessed only once. */
+static constexpr isize SCU_SEGMENT_PROBATION = 1;
+
+/** @brief The segment of the main cache for entries accessed repeatedly. */
+static constexpr isize SCU_SEGMENT_PROTECTED = 2;
+
+/** @brief The number of segments. */
+static constexpr isize SCU_SEGMENT_COUNT = 3;
+
+/** @brief The number of rows (i.e., hash functions) of the frequency sketch. */
+static constexpr isize SCU_SKETCH_DEPTH = 4;
+
+/** @brief The maximum value of a counter of the frequency sketch. */
+static constexpr u64 SCU_SKETCH_COUNTER_MAX = 15;
+
+/**
+ * @brief The number of recorded accesses per entry after which all counters of
+ * the frequency sketch are halved.
+ */
+static constexpr isize SCU_SKETCH_SAMPLE_FACTOR = 10;
+
+struct ScuTinyLfuCache {
+
+    /** @brief The size of each key (in bytes). */
+    isize keySize;
+
+    /** @brief The size of each value (in bytes). */
+    isize valueSize;
+
+    /** @brief The maximum number of entries. */
+    isize capacity;
+
+    /** @brief The maximum number of entries of the window. */
+    isize windowCapacity;
+
+    /** @brief The maximum number of entries of the protected segment. */
+    isize protectedCapacity;
+
+    /** @brief The current number of entries. */
+    isize count;
+
+    /** @brief The number of words of the frequency sketch (a power of two). */
+    isize sketchSize;
+
+    /** @brief The number of recorded accesses since the sketch was halved. */
+    isize sketchAdditions;
+
+    /** @brief The number of recorded accesses that triggers halving. */
+    isize sketchSampleSize;
+
+    /** @brief The first unused entry, or `-1` if all entries are in use. */
+    isize freeHead;
+
+    /** @brief The most recently used entry of each segment, or `-1`. */
+    isize heads[SCU_SEGMENT_COUNT];
+
+    /** @brief The least recently used entry of each segment, or `-1`. */
+    isize tails[SCU_SEGMENT_COUNT];
+
+    /** @brief The number of entries of each segment. */
+    isize counts[SCU_SEGMENT_COUNT];
+
+    /** @brief A function used for hashing keys. */
+    ScuHashFunc* hashFunc;
+
+    /** @brief A function called whenever an entry leaves the cache. */
+    ScuTinyLfuCacheEvictFunc* evictFunc;
+
+    /** @brief The context passed to `evictFunc`. */
+    void* evictContext;
+
+    /** @brief The statistics of the cache. */
+    ScuTinyLfuCacheStats stats;
+
+    /**
+     * @brief The counters of the frequency sketch, sixteen 4-bit counters per
+     * word.
+     *
+     * @note This and all following arrays point into a single dynamically
+     * allocated block of memory.
+     */
+    u64* sketch;
+
+    /** @brief The previous (more recently used) entry of each entry. */
+    isize* prev;
+
+    /**
+     * @brief The next (less recently used) entry of each entry.
+     *
+     * @note For unused entries, this is the next unused entry instead.
+     */
+    isize* next;
+
+    /** @brief The segment of each entry. */
+    isize* segments;
+
+    /** @brief The hash of the key of each entry. */
+    usize* hashes;
+
+    /**
+     * @brief An open addressing hash table mapping keys to their entries.
+     *
+     * @note The positions of the index are an array of `index.capacity`
+     * entry numbers within the same block of memory.
+     */
+    ScuOpenIndex index;
+
+    /** @brief The keys of the entries (`capacity * keySize` bytes). */
+    byte* keys;
+
+    /** @brief The values of the entries (`capacity * valueSize` bytes). */
+    byte* values;
+
+};
+
+/**
+ * @brief Rounds up a value to the next multiple of a specified alignment.
+ *
+ * @warning The behavior is undefined if `alignment` is not a power of two.
+ *
+ * @param[in] value     The value to round up.
+ * @param[in] alignment The required alignment.
+ * @return The smallest multiple of `alignment` greater than or equal to
+ * `value`.
+ */
+static inline isize scu_align_up(isize value, isize alignment) {
+    SCU_ASSERT(value >= 0);
+    SCU_ASSERT(alignment > 0);
+    SCU_ASSERT((alignment & (alignment - 1)) == 0);
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+[[nodiscard]]
+ScuTinyLfuCache* scu_tiny_lfu_cache_new(
+    isize keySize,
+    isize valueSize,
+    isize capacity,
+    ScuHashFunc* hashFunc,
+    ScuEqualFunc* equalFunc
+) {
+    SCU_ASSERT(keySize > 0);
+    SCU_ASSERT(valueSize > 0);
+    SCU_ASSERT(capacity > 0);
+    SCU_ASSERT(hashFunc != nullptr);
+    SCU_ASSERT(equalFunc != nullptr);
+    if (
+        (capacity > (ISIZE_MAX / 16 / SCU_SIZEOF(isize)))
+            || (capacity > (ISIZE_MAX / 4 / keySize))
+            || (capacity > (ISIZE_MAX / 4 / valueSize))
+    ) {
+        return nullptr;
+    }
+    ScuTinyLfuCache* cache = scu_malloc(SCU_SIZEOF(ScuTinyLfuCache));
+    if (cache == nullptr) {
+        return nullptr;
+    }
+    isize indexCapacity = scu_open_index_capacity_for(capacity);
+    isize sketchSize = scu_next_power_of_two(SCU_MAX(capacity, 8));
+    isize entrySize = (3 * SCU_SIZEOF(isize)) + SCU_SIZEOF(usize);
+    isize keysOffset = scu_align_up(
+        (sketchSize * SCU_SIZEOF(u64))
+            + (capacity * entrySize)
+            + (indexCapacity * SCU_SIZEOF(isize)),
+        SCU_ALIGNOF(max_align_t)
+    );
+    isize valuesOffset = scu_align_up(
+        keysOffset + (capacity * keySize),
+        SCU_ALIGNOF(max_align_t)
+    );
+    byte* storage = scu_malloc(valuesOffset + (capacity * valueSize));
+    if (storage == nullptr) {
+        scu_free(cache);
+        return nullptr;
+    }
+    cache->keySize = keySize;
+    cache->valueSize = valueSize;
+    cache->capacity = capacity;
+    // The window holds about 1% of the entries, and the protected segment
+    // about 80% of the remaining ones, as recommended by the W-TinyLFU paper.
+    cache->windowCapacity = SCU_MAX(capacity / 100, 1);
+    cache->protectedCapacity = ((capacity - cache->windowCapacity) * 4) / 5;
+    cache->sketchSize = sketchSize;
+    cache->sketchAdditions = 0;
+    cache->sketchSampleSize = capacity * SCU_SKETCH_SAMPLE_FACTOR;
+    cache->hashFunc = hashFunc;
+    cache->evictFunc = nullptr;
+    cache->evictContext = nullptr;
+    cache->stats = (ScuTinyLfuCacheStats) { };
+    cache->sketch = (u64*) (void*) storage;
+    cache->prev = (isize*) (void*) (cache->sketch + sketchSize);
+    cache->next = cache->prev + capacity;
+    cache->segments = cache->next + capacity;
+    cache->hashes = (usize*) (void*) (cache->segments + capacity);
+    cache->index = (ScuOpenIndex) {
+        .capacity = indexCapacity,
+        .positions = (isize*) (void*) (cache->hashes + capacity),
+        .hashes = cache->hashes,
+        .keys = storage + keysOffset,
+        .keySize = keySize,
+        .equalFunc = equalFunc
+    };
+    cache->keys = storage + keysOffset;
+    cache->values = storage + valuesOffset;
+    for (isize i = 0; i < sketchSize; i++) {
+        cache->sketch[i] = 0;
+    }
+    // There are no entries yet, so clearing only resets the bookkeeping.
+    cache->count = 0;
+    scu_tiny_lfu_cache_clear(cache);
+    return cache;
+}
+
+void scu_tiny_lfu_cache_set_evict_func(
+    ScuTinyLfuCache* cache,
+    ScuTinyLfuCacheEvictFunc* evictFunc,
+    void* context
+) {
+    SCU_ASSERT(cache != nullptr);
+    cache->evictFunc = evictFunc;
+    cache->evictContext = context;
+}
+
+isize scu_tiny_lfu_cache_capacity(const ScuTinyLfuCache* cache) {
+    SCU_ASSERT(cache != nullptr);
+    return cache->capacity;
+}
+
+isize scu_tiny_lfu_cache_count(const ScuTinyLfuCache* cache) {
+    SCU_ASSERT(cache != nullptr);
+    return cache->count;
+}
+
+/**
+ * @brief Returns the estimated access frequency of a hash in the frequency
+ * sketch of a specified cache.
+ *
+ * @param[in] cache The cache to examine.
+ * @param[in] hash  The hash of the key whose frequency to estimate.
+ * @return The minimum of the counters of the hash.
+ */
+static inline u64 scu_tiny_lfu_cache_sketch_estimate(
+    const ScuTinyLfuCache* cache,
+    usize hash
+) {
+    SCU_ASSERT(cache != nullptr);
+    u64 h1 = scu_mix_u64(hash);
+    u64 h2 = scu_mix_u64(h1) | 1;
+    u64 mask = (u64) cache->sketchSize - 1;
+    u64 estimate = SCU_SKETCH_COUNTER_MAX;
+    for (isize i = 0; i < SCU_SKETCH_DEPTH; i++) {
+        u64 h = h1 + ((u64) i * h2);
+        // The low bits select the word, the high bits the counter in it.
+        u64 word = cache->sketch[h & mask];
+        u64 counter = (word >> ((h >> 60) * 4)) & SCU_SKETCH_COUNTER_MAX;
+        estimate = SCU_MIN(estimate, counter);
+    }
+    return estimate;
+}
+
+/**
+ * @brief Records an access of a hash in the frequency sketch of a specified
+ * cache.
+ *
+ * @note Once the number of recorded accesses reaches the sample size, all
+ * counters are halved, so that the sketch adapts to changes in popularity.
+ *
+ * @param[in, out] cache The cache to modify.
+ * @param[in]      hash  The hash of the accessed key.
+ */
+static inline void scu_tiny_lfu_cache_sketch_increment(
+    ScuTinyLfuCache* cache,
+    usize hash
+) {
+    SCU_ASSERT(cache != nullptr);
+    u64 h1 = scu_mix_u64(hash);
+    u64 h2 = scu_mix_u64(h1) | 1;
+    u64 mask = (u64) cache->sketchSize - 1;
+    bool isIncremented = false;
+    for (isize i = 0; i < SCU_SKETCH_DEPTH; i++) {
+        u64 h = h1 + ((u64) i * h2);
+        u64* word = &cache->sketch[h & mask];
+        u64 shift = (h >> 60) * 4;
+        u64 counter = (*word >> shift) & SCU_SKETCH_COUNTER_MAX;
+        if (counter < SCU_SKETCH_COUNTER_MAX) {
+            *word += (u64) 1 << shift;
+            isIncremented = true;
+        }
+    }
+    if (!isIncremented) {
+        return;
+    }
+    cache->sketchAdditions++;
+    if (cache->sketchAdditions >= cache->sketchSampleSize) {
+        for (isize i = 0; i < cache->sketchSize; i++) {
+            cache->sketch[i] = (cache->sketch[i] >> 1) & 0x7777777777777777;
+        }
+        cache->sketchAdditions /= 2;
+    }
+}
+
+isize scu_tiny_lfu_cache_frequency(
+    const ScuTinyLfuCache* restrict cache,
+    const void* restrict key
+) {
+    SCU_ASSERT(cache != nullptr);
+    SCU_ASSERT(key != nullptr);
+    return (isize) scu_tiny_lfu_cache_sketch_estimate(
+        cache,
+        cache->hashFunc(key)
+    );
+}
+
+/**
+ * @brief Returns a pointer to the key of an entry.
+ *
+ * @param[in] cache The cache to examine.
+ * @param[in] entry The entry to examine.
+ * @return A pointer to the key of the entry.
+ */
+static inline byte* scu_tiny_lfu_cache_key_at(
+    const ScuTinyLfuCache* cache,
+    isize entry
+) {
+    SCU_ASSERT(cache != nullptr);
+    SCU_ASSERT((entry >= 0) && (entry < cache->capacity));
+    return &cache->keys[entry * cache->keySize];
+}
+
+/**
+ * @brief Returns a pointer to the value of an entry.
+ *
+ * @param[in] cache The cache to examine.
+ * @param[in] entry The entry to examine.
+ * @return A pointer to the value of the entry.
+ */
+static inline byte* scu_tiny_lfu_cache_value_at(
+    const ScuTinyLfuCache* cache,
+    isize entry
+) {
+    SCU_ASSERT(cache != nullptr);
+    SCU_ASSERT((entry >= 0) && (entry < cache->capacity));
+    return &cache->values[entry * cache->valueSize];
+}
+
+/**
+ * @brief Unlinks an entry from the recency list of its segment.
+ *
+ * @param[in, out] cache The cache to modify.
+ * @param[in]      entry The entry to unlink.
+ */
+static inline void scu_tiny_lfu_cache_unlink(
+    ScuTinyLfuCache* cache,
+    isize entry
+) {
+    SCU_ASSERT(cache != nullptr);
+    isize segment = cache->segments[entry];
+    isize prev = cache->prev[entry];
+    isize next = cache->next[entry];
+    if (prev != -1) {
+        cache->next[prev] = next;
+    }
+    else {
+        cache->heads[segment] = next;
+    }
+    if (next != -1) {
+        cache->prev[next] = prev;
+    }
+    else {
+        cache->tails[segment] = prev;
+    }
+    cache->counts[segment]--;
+}
+
+/**
+ * @brief Links an entry as the most recently used one into the recency list of
+ * a specified segment.
+ *
+ * @param[in, out] cache   The cache to modify.
+ * @param[in]      entry   The entry to link.
+ * @param[in]      segment The segment to link the entry into.
+ */
+static inline void scu_tiny_lfu_cache_push_front(
+    ScuTinyLfuCache* cache,
+    isize entry,
+    isize segment
+) {
+    SCU_ASSERT(cache != nullptr);
+    SCU_ASSERT((segment >= 0) && (segment < SCU_SEGMENT_COUNT));
+    cache->segments[entry] = segment;
+    cache->prev[entry] = -1;
+    cache->next[entry] = cache->heads[segment];
+    if (cache->heads[segment] != -1) {
+        cache->prev[cache->heads[segment]] = entry;
+    }
+    else {
+        cache->tails[segment] = entry;
+    }
+    cache->heads[segment] = entry;
+    cache->counts[segment]++;
+}
+
+/**
+ * @brief Removes an entry from a specified cache, calling the eviction function
+ * (if any).
+ *
+ * @param[in, out] cache The cache to modify.
+ * @param[in]      entry The entry to remove.
+ */
+static inline void scu_tiny_lfu_cache_remove_entry(
+    ScuTinyLfuCache* cache,
+    isize entry
+) {
+    SCU_ASSERT(cache != nullptr);
+    if (cache->evictFunc != nullptr) {
+        cache->evictFunc(
+            cache->evictContext,
+            scu_tiny_lfu_cache_key_at(cache, entry),
+            scu_tiny_lfu_cache_value_at(cache, entry)
+        );
+    }
+    scu_open_index_remove(&cache->index, entry);
+    scu_tiny_lfu_cache_unlink(cache, entry);
+    cache->count--;
+    cache->next[entry] = cache->freeHead;
+    cache->freeHead = entry;
+}
+
+/**
+ * @brief Updates the position of an accessed entry.
+ *
+ * Entries in the window and in the protected segment become the most recently
+ * used ones of their segment. Entries in the probation segment are promoted to
+ * the protected segment, which may demote its least recently used entry back
+ * to the probation segment.
+ *
+ * @param[in, out] cache The cache to modify.
+ * @param[in]      entry The accessed entry.
+ */
+static inline void scu_tiny_lfu_cache_touch(
+    ScuTinyLfuCache* cache,
+    isize entry
+) {
+    SCU_ASSERT(cache != nullptr);
+    isize segment = cache->segments[entry];
+    scu_tiny_lfu_cache_unlink(cache, entry);
+    if (segment != SCU_SEGMENT_PROBATION) {
+        scu_tiny_lfu_cache_push_front(cache, entry, segment);
+        return;
+    }
+    scu_tiny_lfu_cache_push_front(cache, entry, SCU_SEGMENT_PROTECTED);
+    if (cache->counts[SCU_SEGMENT_PROTECTED] > cache->protectedCapacity) {
+        isize demoted = cache->tails[SCU_SEGMENT_PROTECTED];
+        scu_tiny_lfu_cache_unlink(cache, demoted);
+        scu_tiny_lfu_cache_push_front(cache, demoted, SCU_SEGMENT_PROBATION);
+    }
+}
+
+/**
+ * @brief Moves the least recently used entry of the window into the main cache
+ * if it is admitted, or evicts it otherwise.
+ *
+ * If the main cache is full, the entry (the candidate) competes with the least
+ * recently used entry of the main cache (the victim), and only the one with the
+ * higher estimated access frequency is kept.
+ *
+ * @param[in, out] cache The cache to modify.
+ */
+static inline void scu_tiny_lfu_cache_evict_window(ScuTinyLfuCache* cache) {
+    SCU_ASSERT(cache != nullptr);
+    isize candidate = cache->tails[SCU_SEGMENT_WINDOW];
+    SCU_ASSERT(candidate != -1);
+    isize mainCount = cache->counts[SCU_SEGMENT_PROBATION]
+        + cache->counts[SCU_SEGMENT_PROTECTED];
+    isize mainCapacity = cache->capacity - cache->windowCapacity;
+    if (mainCount < mainCapacity) {
+        scu_tiny_lfu_cache_unlink(cache, candidate);
+        scu_tiny_lfu_cache_push_front(cache, candidate, SCU_SEGMENT_PROBATION);
+        return;
+    }
+    isize victim = (cache->tails[SCU_SEGMENT_PROBATION] != -1)
+        ? cache->tails[SCU_SEGMENT_PROBATION]
+        : cache->tails[SCU_SEGMENT_PROTECTED];
+    cache->stats.evictions++;
+    // Ties favor the victim, which makes it harder for a scan to displace
+    // entries of the main cache.
+    if (
+        (victim != -1)
+            && (
+                scu_tiny_lfu_cache_sketch_estimate(
+                    cache,
+                    cache->hashes[candidate]
+                ) > scu_tiny_lfu_cache_sketch_estimate(
+                    cache,
+                    cache->hashes[victim]
+                )
+            )
+    ) {
+        scu_tiny_lfu_cache_remove_entry(cache, victim);
+        scu_tiny_lfu_cache_unlink(cache, candidate);
+        scu_tiny_lfu_cache_push_front(cache, candidate, SCU_SEGMENT_PROBATION);
+    }
+    else {
+        scu_tiny_lfu_cache_remove_entry(cache, candidate);
+    }
+}
+
+bool scu_tiny_lfu_cache_try_get_impl(
+    ScuTinyLfuCache* restrict cache,
+    const void* restrict key,
+    void* restrict* restrict value
+) {
+    SCU_ASSERT(cache != nullptr);
+    SCU_ASSERT(key != nullptr);
+    SCU_ASSERT(value != nullptr);
+    usize hash = cache->hashFunc(key);
+    scu_tiny_lfu_cache_sketch_increment(cache, hash);
+    isize position = scu_open_index_find(&cache->index, key, hash);
+    if (position == -1) {
+        cache->stats.misses++;
+        *value = nullptr;
+        return false;
+    }
+    isize entry = cache->index.positions[position];
+    scu_tiny_lfu_cache_touch(cache, entry);
+    cache->stats.hits++;
+    *value = scu_tiny_lfu_cache_value_at(cache, entry);
+    return true;
+}
+
+bool scu_tiny_lfu_cache_contains(
+    const ScuTinyLfuCache* restrict cache,
+    const void* restrict key
+) {
+    SCU_ASSERT(cache != nullptr);
+    SCU_ASSERT(key != nullptr);
+    usize hash = cache->hashFunc(key);
+    return scu_open_index_find(&cache->index, key, hash) != -1;
+}
+
+void scu_tiny_lfu_cache_put(
+    ScuTinyLfuCache* restrict cache,
+    const void* restrict key,
+    const void* restrict value
+) {
+    SCU_ASSERT(cache != nullptr);
+    SCU_ASSERT(key != nullptr);
+    SCU_ASSERT(value != nullptr);
+    usize hash = cache->hashFunc(key);
+    scu_tiny_lfu_cache_sketch_increment(cache, hash);
+    isize position = scu_open_index_find(&cache->index, key, hash);
+    if (position != -1) {
+        isize entry = cache->index.positions[position];
+        if (cache->evictFunc != nullptr) {
+            cache->evictFunc(
+                cache->evictContext,
+                scu_tiny_lfu_cache_key_at(cache, entry),
+                scu_tiny_lfu_cache_value_at(cache, entry)
+            );
+        }
+        scu_memcpy(
+            scu_tiny_lfu_cache_value_at(cache, entry),
+            value,
+            cache->valueSize
+        );
+        scu_tiny_lfu_cache_touch(cache, entry);
+        return;
+    }
+    // Make room in the window first, so that the number of entries never
+    // exceeds the capacity.
+    if (cache->counts[SCU_SEGMENT_WINDOW] == cache->windowCapacity) {
+        scu_tiny_lfu_cache_evict_window(cache);
+    }
+    isize entry = cache->freeHead;
+    SCU_ASSERT(entry != -1);
+    cache->freeHead = cache->next[entry];
+    cache->hashes[entry] = hash;
+    scu_memcpy(scu_tiny_lfu_cache_key_at(cache, entry), key, cache->keySize);
+    scu_memcpy(
+        scu_tiny_lfu_cache_value_at(cache, entry),
+        value,
+        cache->valueSize
+    );
+    scu_open_index_insert(&cache->index, entry);
+    scu_tiny_lfu_cache_push_front(cache, entry, SCU_SEGMENT_WINDOW);
+    cache->count++;
+    cache->stats.insertions++;
+}
+
+bool scu_tiny_lfu_cache_remove(
+    ScuTinyLfuCache* restrict cache,
+    const void* restrict key
+) {
+    SCU_ASSERT(cache != nullptr);
+    SCU_ASSERT(key != nullptr);
+    isize position = scu_open_index_find(
+        &cache->index,
+        key,
+        cache->hashFunc(key)
+    );
+    if (position == -1) {
+        return false;
+    }
+    scu_tiny_lfu_cache_remove_entry(cache, cache->index.positions[position]);
+    return true;
+}
+
+void scu_tiny_lfu_cache_clear(ScuTinyLfuCache* cache) {
+    SCU_ASSERT(cache != nullptr);
+    if (cache->evictFunc != nullptr) {
+        for (isize segment = 0; segment < SCU_SEGMENT_COUNT; segment++) {
+            isize entry = cache->heads[segment];
+            while (entry != -1) {
+                cache->evictFunc(
+                    cache->evictContext,
+                    scu_tiny_lfu_cache_key_at(cache, entry),
+                    scu_tiny_lfu_cache_value_at(cache, entry)
+                );
+                entry = cache->next[entry];
+            }
+        }
+    }
+    scu_open_index_clear(&cache->index);
+    for (isize i = 0; i < cache->capacity; i++) {
+        cache->next[i] = ((i + 1) < cache->capacity) ? (i + 1) : -1;
+    }
+    for (isize segment = 0; segment < SCU_SEGMENT_COUNT; segment++) {
+        cache->heads[segment] = -1;
+        cache->tails[segment] = -1;
+        cache->counts[segment] = 0;
+    }
+    cache->count = 0;
+    cache->freeHead = 0;
+}
+
+ScuTinyLfuCacheStats scu_tiny_lfu_cache_stats(const ScuTinyLfuCache* cache) {
+    SCU_ASSERT(cache != nullptr);
+    return cache->stats;
+}
+
+void scu_tiny_lfu_cache_reset_stats(ScuTinyLfuCache* cache) {
+    SCU_ASSERT(cache != nullptr);
+    cache->stats = (ScuTinyLfuCacheStats) { };
+}
+
+void scu_tiny_lfu_cache_free(ScuTinyLfuCache* cache) {
+    if (cache != nullptr) {
+        scu_free(cache->sketch);
+        cache->sketch = nullptr;
+        cache->prev = nullptr;
+        cache->next = nullptr;
+        cache->segments = nullptr;
+        cache->hashes = nullptr;
+        cache->index = (ScuOpenIndex) { };
+        cache->keys = nullptr;
+        cache->values = nullptr;
+        cache->count = 0;
+        scu_free(cache);
+    }
+}